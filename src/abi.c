@@ -0,0 +1,351 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "resolve.h"
+#include "abi.h"
+
+/* one exported definition */
+typedef struct AbiSym {
+    char *name;
+    char *version;          // NULL if unversioned
+    uint32_t hash;
+    bool hidden;            // non-default version, only bound by older references
+    bool matched;
+    Elf64_Sym sym;
+} abi_sym_t;
+
+/* exports of one object, indexed by name */
+typedef struct AbiSet {
+    abi_sym_t *syms;
+    uint32_t count;
+    uint32_t *slots;        // open addressing, index + 1, 0 is empty
+    uint32_t mask;
+} abi_set_t;
+
+static uint32_t abi_hash(const char *name) {
+    return dl_new_hash(name);
+}
+
+static bool same_version(const char *a, const char *b) {
+    return a == b || (a && b && !strcmp(a, b));
+}
+
+/**
+ * @brief 收集导出的动态符号，并按名称建立哈希索引，版本在查找时比较
+ * collect the exported dynamic symbols and index them by name, the
+ * versions are compared by the lookup
+ */
+static int abi_collect(dso_t *d, abi_set_t *set) {
+    uint32_t size = 16;
+
+    memset(set, 0, sizeof(abi_set_t));
+    set->syms = calloc(d->nsyms + 1, sizeof(abi_sym_t));
+    if (!set->syms) {
+        return ERR_MEM;
+    }
+    for (uint32_t i = 1; i < d->nsyms; i++) {
+        abi_sym_t *s = &set->syms[set->count];
+        s->name = dso_sym(d, i, &s->sym);
+        if (!*s->name || !is_exported_def(&s->sym)) {
+            continue;
+        }
+        s->version = dso_sym_version(d, i);
+        /* V2@@V2 names a version node, abi_versions already compares those */
+        if (s->sym.st_shndx == SHN_ABS && s->version && !strcmp(s->name, s->version)) {
+            continue;
+        }
+        s->hidden = d->versym && d->versym[i] & 0x8000;
+        s->hash = abi_hash(s->name);
+        set->count++;
+    }
+
+    /* load factor below 1/2 */
+    while (size < set->count * 2) {
+        size <<= 1;
+    }
+    set->slots = calloc(size, sizeof(uint32_t));
+    if (!set->slots) {
+        return ERR_MEM;
+    }
+    set->mask = size - 1;
+    for (uint32_t i = 0; i < set->count; i++) {
+        uint32_t h = set->syms[i].hash & set->mask;
+        while (set->slots[h]) {
+            h = (h + 1) & set->mask;
+        }
+        set->slots[h] = i + 1;
+    }
+    return NO_ERR;
+}
+
+static void abi_fini(abi_set_t *set) {
+    free(set->syms);
+    free(set->slots);
+}
+
+/**
+ * @brief 查找对应的新符号。未版本化的旧符号与新的默认版本(@@)匹配，
+ * 与ld.so绑定未版本化引用的方式相同
+ * find the counterpart of an old export. An unversioned old symbol matches
+ * the new default (@@) version, the way ld.so binds unversioned references
+ */
+static abi_sym_t *abi_find(abi_set_t *set, const abi_sym_t *old) {
+    abi_sym_t *fallback = NULL;
+    for (uint32_t h = old->hash & set->mask; set->slots[h]; h = (h + 1) & set->mask) {
+        abi_sym_t *s = &set->syms[set->slots[h] - 1];
+        if (s->hash != old->hash || strcmp(s->name, old->name)) {
+            continue;
+        }
+        if (same_version(s->version, old->version)) {
+            return s;
+        }
+        if (!old->version && !s->hidden) {
+            fallback = s;
+        }
+    }
+    return fallback;
+}
+
+static void print_sym(abi_sym_t *s, const char *status, const char *format, ...) {
+    char label[MAX_PATH_LEN];
+    va_list ap;
+    snprintf(label, sizeof(label), "%s%s%s", s->name, s->version? (s->hidden? "@": "@@"): "", s->version? s->version: "");
+    printf("    %s %-40s ", status, label);
+    va_start(ap, format);
+    vprintf(format, ap);
+    va_end(ap);
+    printf("\n");
+}
+
+static const char *type_name(int type) {
+    static const char *names[] = {"NOTYPE", "OBJECT", "FUNC", "SECTION", "FILE", "COMMON", "TLS"};
+    if (type == STT_GNU_IFUNC) {
+        return "IFUNC";
+    }
+    return type < sizeof(names) / sizeof(names[0])? names[type]: "?";
+}
+
+static const char *bind_name(int bind) {
+    static const char *names[] = {"LOCAL", "GLOBAL", "WEAK"};
+    if (bind == STB_GNU_UNIQUE) {
+        return "UNIQUE";
+    }
+    return bind < sizeof(names) / sizeof(names[0])? names[bind]: "?";
+}
+
+/* a function and its ifunc resolver are interchangeable for callers */
+static bool same_type(int a, int b) {
+    if (a == STT_GNU_IFUNC) {
+        a = STT_FUNC;
+    }
+    if (b == STT_GNU_IFUNC) {
+        b = STT_FUNC;
+    }
+    return a == b;
+}
+
+/**
+ * @brief 比较版本节点集合，删除的节点是不兼容的改变
+ * compare the sets of version nodes, a removed node is an incompatible change
+ */
+static int abi_versions(dso_t *a, dso_t *b, uint32_t *warnings) {
+    int broken = 0;
+    uint32_t na = 0, nb = 0;
+
+    /* index 1 is the base definition, named after the SONAME */
+    for (uint32_t i = 2; i < a->verdef_count; i++) {
+        na += a->verdef[i] != NULL;
+    }
+    for (uint32_t i = 2; i < b->verdef_count; i++) {
+        nb += b->verdef[i] != NULL;
+    }
+    PRINT_INFO("version nodes: %u -> %u\n", na, nb);
+    for (uint32_t i = 2; i < a->verdef_count; i++) {
+        bool found = false;
+        for (uint32_t j = 2; a->verdef[i] && j < b->verdef_count && !found; j++) {
+            found = b->verdef[j] && !strcmp(a->verdef[i], b->verdef[j]);
+        }
+        if (a->verdef[i] && !found) {
+            printf("    [-] %-40s removed\n", a->verdef[i]);
+            broken++;
+        }
+    }
+    for (uint32_t j = 2; j < b->verdef_count; j++) {
+        bool found = false;
+        for (uint32_t i = 2; b->verdef[j] && i < a->verdef_count && !found; i++) {
+            found = a->verdef[i] && !strcmp(a->verdef[i], b->verdef[j]);
+        }
+        if (b->verdef[j] && !found) {
+            printf("    [+] %-40s added\n", b->verdef[j]);
+        }
+    }
+    if (!na && nb) {
+        printf("    [!] %-40s the old object is not versioned\n", "version nodes");
+        (*warnings)++;
+    }
+    return broken;
+}
+
+/**
+ * @brief 比较导出符号：删除、类型改变、对象变小是不兼容的改变，
+ * 对象变大、绑定或可见性改变作为警告
+ * compare the exports: removed symbols, changed types and shrunk objects
+ * are incompatible, grown objects and binding or visibility changes are warnings
+ */
+static int abi_exports(abi_set_t *old, abi_set_t *new, uint32_t rows, uint32_t *warnings) {
+    uint32_t removed = 0, changed = 0, added = 0;
+    int broken = 0;
+
+    for (uint32_t i = 0; i < old->count; i++) {
+        abi_sym_t *s = &old->syms[i];
+        abi_sym_t *t = abi_find(new, s);
+        if (!t) {
+            print_sym(s, "[-]", "removed");
+            removed++;
+            broken++;
+            continue;
+        }
+        t->matched = true;
+        int type = ELF64_ST_TYPE(s->sym.st_info), new_type = ELF64_ST_TYPE(t->sym.st_info);
+        int bind = ELF64_ST_BIND(s->sym.st_info), new_bind = ELF64_ST_BIND(t->sym.st_info);
+        bool data = type == STT_OBJECT || type == STT_TLS || type == STT_COMMON;
+        bool diff = false;
+        if (!same_type(type, new_type)) {
+            print_sym(s, "[-]", "type %s -> %s", type_name(type), type_name(new_type));
+            broken++;
+            diff = true;
+        } else if (data && t->sym.st_size < s->sym.st_size) {
+            /* executables copy the object, and the library now uses less of it */
+            print_sym(s, "[-]", "size %lu -> %lu, shrunk", s->sym.st_size, t->sym.st_size);
+            broken++;
+            diff = true;
+        } else if (data && t->sym.st_size > s->sym.st_size) {
+            /* copy relocations of existing executables only hold the old size */
+            print_sym(s, "[!]", "size %lu -> %lu, grown", s->sym.st_size, t->sym.st_size);
+            (*warnings)++;
+            diff = true;
+        }
+        if (bind != new_bind) {
+            print_sym(s, "[!]", "bind %s -> %s", bind_name(bind), bind_name(new_bind));
+            (*warnings)++;
+            diff = true;
+        }
+        if (ELF64_ST_VISIBILITY(s->sym.st_other) != ELF64_ST_VISIBILITY(t->sym.st_other)) {
+            print_sym(s, "[!]", "visibility %d -> %d", ELF64_ST_VISIBILITY(s->sym.st_other),
+                ELF64_ST_VISIBILITY(t->sym.st_other));
+            (*warnings)++;
+            diff = true;
+        }
+        if (s->hidden != t->hidden) {
+            print_sym(s, "[!]", "%s", t->hidden? "no longer the default version": "now the default version");
+            (*warnings)++;
+            diff = true;
+        }
+        changed += diff;
+    }
+    for (uint32_t i = 0; i < new->count; i++) {
+        if (!new->syms[i].matched) {
+            if (added < rows) {
+                print_sym(&new->syms[i], "[+]", "added");
+            }
+            added++;
+        }
+    }
+    if (added > rows) {
+        printf("    ... %u more added\n", added - rows);
+    }
+    PRINT_INFO("exports: %u -> %u, %u removed, %u changed, %u added\n", old->count, new->count, removed, changed, added);
+    return broken;
+}
+
+/**
+ * @brief 比较两个共享库导出的动态符号：名称、版本、类型、绑定、大小，
+ * 以及.gnu.version_d的版本节点和SONAME
+ * compare the exported dynamic symbols of two shared objects by name,
+ * version, type, binding and size, along with the version nodes of
+ * .gnu.version_d and the SONAME
+ * @param old_name shared object currently in use
+ * @param new_name shared object that replaces it
+ * @param rows added exports printed, 0 means ABI_MAX_ADDED
+ * @param broken output, number of incompatible changes
+ * @return error code
+ */
+int abi_check(char *old_name, char *new_name, uint32_t rows, int *broken) {
+    resolver_t r;
+    abi_set_t old = {0}, new = {0};
+    uint32_t warnings = 0;
+    int err = NO_ERR;
+
+    *broken = 0;
+    resolver_init(&r, NULL);
+    dso_t *a = resolver_open(&r, old_name);
+    dso_t *b = resolver_open(&r, new_name);
+    if (!a || !b) {
+        err = ERR_FILE_OPEN;
+        goto out;
+    }
+    if (a->status != NO_ERR || b->status != NO_ERR) {
+        err = a->status != NO_ERR? a->status: b->status;
+        goto out;
+    }
+    if (a == b) {
+        PRINT_INFO("%s and %s are the same file\n", old_name, new_name);
+        goto out;
+    }
+    err = abi_collect(a, &old);
+    if (err == NO_ERR) {
+        err = abi_collect(b, &new);
+    }
+    if (err != NO_ERR) {
+        goto out;
+    }
+
+    PRINT_INFO("ABI of %s -> %s\n", old_name, new_name);
+    if (a->machine != b->machine || a->elf.class != b->elf.class) {
+        printf("    [-] %-40s %u/%u -> %u/%u\n", "machine/class", a->machine, a->elf.class, b->machine, b->elf.class);
+        (*broken)++;
+    }
+    if (!same_version(a->soname, b->soname)) {
+        /* a new SONAME is the usual way to announce a break, consumers keep the old file */
+        printf("    [!] %-40s %s -> %s\n", "SONAME", a->soname? a->soname: "(none)", b->soname? b->soname: "(none)");
+        warnings++;
+    }
+    *broken += abi_versions(a, b, &warnings);
+    *broken += abi_exports(&old, &new, rows? rows: ABI_MAX_ADDED, &warnings);
+    PRINT_INFO("%d incompatible changes, %u warnings\n", *broken, warnings);
+
+out:
+    abi_fini(&old);
+    abi_fini(&new);
+    resolver_fini(&r);
+    return err;
+}
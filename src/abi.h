@@ -0,0 +1,45 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __ABI_H
+#define __ABI_H
+
+#define ABI_MAX_ADDED       50      // added exports printed
+
+/**
+ * @brief 比较两个共享库导出的动态符号：名称、版本、类型、绑定、大小，
+ * 以及.gnu.version_d的版本节点和SONAME
+ * compare the exported dynamic symbols of two shared objects by name,
+ * version, type, binding and size, along with the version nodes of
+ * .gnu.version_d and the SONAME
+ * @param old_name shared object currently in use
+ * @param new_name shared object that replaces it
+ * @param rows added exports printed, 0 means ABI_MAX_ADDED
+ * @param broken output, number of incompatible changes
+ * @return error code
+ */
+int abi_check(char *old_name, char *new_name, uint32_t rows, int *broken);
+
+#endif
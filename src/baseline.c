@@ -0,0 +1,1113 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "forensic.h"
+#include "rule.h"
+#include "batch.h"
+#include "json.h"
+#include "names.h"
+#include "baseline.h"
+
+/* recorded files, indexed by path */
+typedef struct Baseline {
+    fingerprint_t *files;
+    size_t count;
+    size_t *buckets;        // open addressing, index + 1, 0 is empty
+    size_t nbuckets;
+} baseline_t;
+
+/* growable output buffer of the database writer */
+typedef struct DbBuf {
+    uint8_t *data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+} dbbuf_t;
+
+/* read cursor of the database loader */
+typedef struct DbCursor {
+    const uint8_t *p;
+    const uint8_t *end;
+    bool failed;
+} dbcur_t;
+
+/* file range covered by a section or a segment */
+typedef struct FileRange {
+    uint64_t start;
+    uint64_t end;
+} file_range_t;
+
+/* sections sorted by (name, index), duplicate names such as .group in ET_REL
+ * are told apart by their ordinal among the sections of that name */
+typedef struct SectionIndex {
+    const fp_section_t **sorted;
+    uint32_t *ordinal;      // indexed like fingerprint_t.sections
+} secindex_t;
+
+typedef struct VerifyJob {
+    fileset_t *files;
+    baseline_t *base;
+    fingerprint_t *current;
+    int *state;
+} verify_job_t;
+
+enum VERIFY_STATE {
+    VERIFY_SKIPPED = 1,     // stat unchanged
+    VERIFY_TOUCHED,         // stat changed, content identical
+    VERIFY_CHANGED,
+    VERIFY_NEW,
+    VERIFY_MISSING,
+    VERIFY_IGNORED,         // not an elf and not recorded
+};
+
+/* ------------------------------------------------------------------ */
+/* fingerprint                                                        */
+
+static char *dup_string(const char *s) {
+    return s && s[0]? strdup(s): NULL;
+}
+
+static void fingerprint_fini(fingerprint_t *fp) {
+    free(fp->path);
+    free(fp->interp);
+    free(fp->soname);
+    free(fp->rpath);
+    free(fp->runpath);
+    for (uint32_t i = 0; i < fp->needed_count; i++) {
+        free(fp->needed[i]);
+    }
+    free(fp->needed);
+    for (uint32_t i = 0; i < fp->section_count; i++) {
+        free(fp->sections[i].name);
+    }
+    free(fp->sections);
+    free(fp->segments);
+    memset(fp, 0, sizeof(fingerprint_t));
+}
+
+static void fingerprint_stat(fingerprint_t *fp, struct stat *st) {
+    fp->dev = st->st_dev;
+    fp->ino = st->st_ino;
+    fp->size = st->st_size;
+    fp->mtime = st->st_mtim.tv_sec;
+    fp->mtime_nsec = st->st_mtim.tv_nsec;
+    fp->ctime = st->st_ctim.tv_sec;
+    fp->ctime_nsec = st->st_ctim.tv_nsec;
+    fp->mode = st->st_mode;
+    fp->uid = st->st_uid;
+    fp->gid = st->st_gid;
+}
+
+/*
+ * utimensat() cannot set ctime, the kernel stamps it on every inode change, so
+ * a matching stat means an unchanged file unless root moved the clock or edited
+ * the inode directly (debugfs). The fast path trusts root.
+ */
+static bool same_stat(fingerprint_t *fp, struct stat *st) {
+    return fp->dev == (uint64_t)st->st_dev && fp->ino == (uint64_t)st->st_ino &&
+           fp->size == (uint64_t)st->st_size &&
+           fp->mtime == (uint64_t)st->st_mtim.tv_sec && fp->mtime_nsec == (uint64_t)st->st_mtim.tv_nsec &&
+           fp->ctime == (uint64_t)st->st_ctim.tv_sec && fp->ctime_nsec == (uint64_t)st->st_ctim.tv_nsec;
+}
+
+static int section_ptr_cmp(const void *a, const void *b) {
+    const fp_section_t *x = *(const fp_section_t **)a, *y = *(const fp_section_t **)b;
+    int c = strcmp(x->name, y->name);
+    return c? c: (x > y) - (x < y);
+}
+
+/* without memory the lookups below fall back to linear scans */
+static void secindex_init(secindex_t *x, const fingerprint_t *fp) {
+    uint32_t n = fp->section_count;
+    x->sorted = malloc((n + 1) * sizeof(fp_section_t *));
+    x->ordinal = malloc((n + 1) * sizeof(uint32_t));
+    if (!x->sorted || !x->ordinal) {
+        free(x->sorted);
+        free(x->ordinal);
+        x->sorted = NULL;
+        x->ordinal = NULL;
+        return;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        x->sorted[i] = &fp->sections[i];
+    }
+    qsort(x->sorted, n, sizeof(fp_section_t *), section_ptr_cmp);
+    for (uint32_t i = 0; i < n; i++) {
+        bool same = i && !strcmp(x->sorted[i - 1]->name, x->sorted[i]->name);
+        x->ordinal[x->sorted[i] - fp->sections] = same? x->ordinal[x->sorted[i - 1] - fp->sections] + 1: 0;
+    }
+}
+
+static void secindex_fini(secindex_t *x) {
+    free(x->sorted);
+    free(x->ordinal);
+}
+
+static uint32_t section_ordinal(const secindex_t *x, const fingerprint_t *fp, uint32_t index) {
+    uint32_t ordinal = 0;
+    if (x->ordinal) {
+        return x->ordinal[index];
+    }
+    for (uint32_t i = 0; i < index; i++) {
+        ordinal += !strcmp(fp->sections[i].name, fp->sections[index].name);
+    }
+    return ordinal;
+}
+
+/* the ordinal-th section called name */
+static const fp_section_t *find_section(const secindex_t *x, const fingerprint_t *fp, const char *name, uint32_t ordinal) {
+    if (x->sorted) {
+        size_t lo = 0, hi = fp->section_count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (strcmp(x->sorted[mid]->name, name) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        lo += ordinal;
+        return lo < fp->section_count && !strcmp(x->sorted[lo]->name, name)? x->sorted[lo]: NULL;
+    }
+    for (uint32_t i = 0; i < fp->section_count; i++) {
+        if (!strcmp(fp->sections[i].name, name) && !ordinal--) {
+            return &fp->sections[i];
+        }
+    }
+    return NULL;
+}
+
+static char *dyn_string(facts_t *facts, uint64_t strtab, uint64_t strsz, uint64_t index) {
+    Elf *elf = facts->elf;
+    if (index >= strsz || strtab + strsz > elf->size ||
+        !memchr(elf->mem + strtab + index, '\0', strsz - index)) {
+        return NULL;
+    }
+    return (char *)elf->mem + strtab + index;
+}
+
+static void fingerprint_dynamic(fingerprint_t *fp, facts_t *facts) {
+    Elf *elf = facts->elf;
+    uint64_t strtab = 0, strsz = 0;
+    char *s;
+
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        if (p->p_type == PT_INTERP && p->p_offset + p->p_filesz <= elf->size && p->p_filesz) {
+            fp->interp = strndup((char *)elf->mem + p->p_offset, p->p_filesz);
+        }
+    }
+    for (int i = 0; i < facts->dyn_count; i++) {
+        if (facts->dyn[i].d_tag == DT_STRTAB) strtab = facts->dyn[i].d_un.d_val;
+        if (facts->dyn[i].d_tag == DT_STRSZ) strsz = facts->dyn[i].d_un.d_val;
+    }
+    if (!strtab || vaddr_to_offset(elf, strtab, &strtab) != NO_ERR) {
+        return;
+    }
+    fp->needed = calloc(facts->needed_count + 1, sizeof(char *));
+    for (int i = 0; i < facts->dyn_count; i++) {
+        s = dyn_string(facts, strtab, strsz, facts->dyn[i].d_un.d_val);
+        switch (facts->dyn[i].d_tag) {
+            case DT_NEEDED:
+                if (s && fp->needed && fp->needed_count < (uint32_t)facts->needed_count) {
+                    fp->needed[fp->needed_count++] = strdup(s);
+                }
+                break;
+            case DT_SONAME: free(fp->soname); fp->soname = dup_string(s); break;
+            case DT_RPATH: free(fp->rpath); fp->rpath = dup_string(s); break;
+            case DT_RUNPATH: free(fp->runpath); fp->runpath = dup_string(s); break;
+            default: break;
+        }
+    }
+}
+
+static int file_range_cmp(const void *a, const void *b) {
+    const file_range_t *x = a, *y = b;
+    return x->start < y->start? -1: x->start > y->start;
+}
+
+/* sort and merge overlapping ranges, return the new count */
+static size_t file_range_merge(file_range_t *r, size_t n) {
+    size_t count = 0;
+    qsort(r, n, sizeof(file_range_t), file_range_cmp);
+    for (size_t i = 0; i < n; i++) {
+        if (count && r[i].start <= r[count - 1].end) {
+            if (r[i].end > r[count - 1].end) {
+                r[count - 1].end = r[i].end;
+            }
+        } else {
+            r[count++] = r[i];
+        }
+    }
+    return count;
+}
+
+/* digest of the bytes of [start, end) that no range covers */
+static void digest_gaps(Elf *elf, uint64_t start, uint64_t end, const file_range_t *cov, size_t n, uint8_t *digest) {
+    sha256_t ctx;
+    uint64_t cur = start;
+
+    sha256_init(&ctx);
+    for (size_t i = 0; i < n && cov[i].start < end; i++) {
+        if (cov[i].end <= cur) {
+            continue;
+        }
+        if (cov[i].start > cur) {
+            sha256_update(&ctx, elf->mem + cur, cov[i].start - cur);
+        }
+        cur = cov[i].end;
+    }
+    if (cur < end) {
+        sha256_update(&ctx, elf->mem + cur, end - cur);
+    }
+    sha256_final(&ctx, digest);
+}
+
+/* program headers, and the bytes of the file that the section hashes miss */
+static void fingerprint_layout(fingerprint_t *fp, facts_t *facts) {
+    Elf *elf = facts->elf;
+    size_t ehsize = elf->class == ELFCLASS32? sizeof(Elf32_Ehdr): sizeof(Elf64_Ehdr);
+    size_t n = 0;
+    file_range_t *cov = calloc(facts->shnum + facts->phnum + 1, sizeof(file_range_t));
+
+    sha256(elf->mem, ehsize < elf->size? ehsize: elf->size, fp->header);
+    fp->segments = calloc(facts->phnum + 1, sizeof(fp_segment_t));
+    if (!cov || !fp->segments) {
+        free(cov);
+        return;
+    }
+    for (int i = 1; i < facts->shnum; i++) {
+        Elf64_Shdr *s = &facts->shdr[i].hdr;
+        if (s->sh_type != SHT_NOBITS && s->sh_size && s->sh_offset + s->sh_size <= elf->size) {
+            cov[n].start = s->sh_offset;
+            cov[n++].end = s->sh_offset + s->sh_size;
+        }
+    }
+    size_t nsec = file_range_merge(cov, n);
+
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        fp_segment_t *seg = &fp->segments[fp->segment_count++];
+        seg->type = p->p_type;
+        seg->flags = p->p_flags;
+        seg->offset = p->p_offset;
+        seg->vaddr = p->p_vaddr;
+        seg->filesz = p->p_filesz;
+        seg->memsz = p->p_memsz;
+        if (p->p_type == PT_LOAD && p->p_offset + p->p_filesz <= elf->size) {
+            digest_gaps(elf, p->p_offset, p->p_offset + p->p_filesz, cov, nsec, seg->digest);
+            seg->hashed = true;
+        }
+    }
+
+    /* everything else: section header table, padding and trailing data */
+    n = nsec;
+    for (uint32_t i = 0; i < fp->segment_count; i++) {
+        if (fp->segments[i].hashed) {
+            cov[n].start = fp->segments[i].offset;
+            cov[n++].end = fp->segments[i].offset + fp->segments[i].filesz;
+        }
+    }
+    n = file_range_merge(cov, n);
+    digest_gaps(elf, 0, elf->size, cov, n, fp->rest);
+    free(cov);
+}
+
+/**
+ * @brief 生成文件指纹。old不为空时，只哈希大小与基线相同的节，大小不同的节已经确定被修改
+ * fingerprint one file. With a baseline, only sections whose size matches the
+ * recorded one are hashed, a size change already proves a modification
+ */
+static void fingerprint_collect(fingerprint_t *fp, const char *path, const fingerprint_t *old) {
+    struct stat st;
+    secinfo_t info;
+    facts_t facts;
+    Elf elf;
+    int class;
+    uint16_t machine;
+
+    memset(fp, 0, sizeof(fingerprint_t));
+    fp->path = strdup(path);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fp->status = ERR_FILE_OPEN;
+        return;
+    }
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        fp->status = ERR_FILE_STAT;
+        return;
+    }
+    fingerprint_stat(fp, &st);
+    fp->status = probe_elf(fd, st.st_size, &class, &machine);
+    if (fp->status != NO_ERR) {
+        close(fd);
+        return;
+    }
+
+    /* map the descriptor that was stat'ed, a rename in between cannot swap the file */
+    fp->status = init_fd(fd, &elf, true);
+    if (fp->status != NO_ERR) {
+        return;
+    }
+    fp->status = facts_collect(&elf, &facts);
+    if (fp->status != NO_ERR) {
+        finit(&elf);
+        return;
+    }
+    fp->elf = true;
+    fp->class = elf.class;
+    fp->machine = facts.machine;
+    fp->type = facts.e_type;
+    fp->entry = facts.entry;
+    if (checksec_collect(&elf, &info) == NO_ERR) {
+        fp->security = (info.pie == true? FP_PIE: 0) | (info.nx? FP_NX: 0) | (info.canary? FP_CANARY: 0) |
+                       (info.relro == 1? FP_RELRO_PARTIAL: 0) | (info.relro == 2? FP_RELRO_FULL: 0) |
+                       (info.fortify? FP_FORTIFY: 0) | (info.cet << FP_CET_SHIFT);
+    }
+    fingerprint_dynamic(fp, &facts);
+    fingerprint_layout(fp, &facts);
+
+    fp->sections = calloc(facts.shnum + 1, sizeof(fp_section_t));
+    for (int i = 1; fp->sections && i < facts.shnum; i++) {
+        fp_section_t *sec = &fp->sections[fp->section_count++];
+        Elf64_Shdr *s = &facts.shdr[i].hdr;
+        sec->name = strdup(facts.shdr[i].name);
+        sec->type = s->sh_type;
+        sec->addr = s->sh_addr;
+        sec->offset = s->sh_offset;
+        sec->size = s->sh_size;
+    }
+    secindex_t cur = {0}, prev_index = {0};
+    if (old) {
+        secindex_init(&cur, fp);
+        secindex_init(&prev_index, old);
+    }
+    for (uint32_t i = 0; i < fp->section_count; i++) {
+        fp_section_t *sec = &fp->sections[i];
+        if (sec->type == SHT_NOBITS || sec->offset + sec->size > elf.size) {
+            continue;
+        }
+        if (old) {
+            const fp_section_t *prev = find_section(&prev_index, old, sec->name, section_ordinal(&cur, fp, i));
+            if (prev && prev->size != sec->size) {
+                continue;
+            }
+        }
+        sha256(elf.mem + sec->offset, sec->size, sec->digest);
+        sec->hashed = true;
+    }
+    secindex_fini(&cur);
+    secindex_fini(&prev_index);
+    facts_fini(&facts);
+    finit(&elf);
+}
+
+/* ------------------------------------------------------------------ */
+/* database                                                           */
+
+static void put(dbbuf_t *b, const void *data, size_t size) {
+    if (b->failed) {
+        return;
+    }
+    if (b->size + size > b->capacity) {
+        size_t capacity = b->capacity? b->capacity * 2: 1 << 16;
+        while (capacity < b->size + size) {
+            capacity *= 2;
+        }
+        uint8_t *p = realloc(b->data, capacity);
+        if (!p) {
+            b->failed = true;
+            return;
+        }
+        b->data = p;
+        b->capacity = capacity;
+    }
+    memcpy(b->data + b->size, data, size);
+    b->size += size;
+}
+
+static void put_u8(dbbuf_t *b, uint8_t v) { put(b, &v, 1); }
+static void put_u16(dbbuf_t *b, uint16_t v) { put(b, &v, 2); }
+static void put_u32(dbbuf_t *b, uint32_t v) { put(b, &v, 4); }
+static void put_u64(dbbuf_t *b, uint64_t v) { put(b, &v, 8); }
+
+static void put_str(dbbuf_t *b, const char *s) {
+    uint32_t len = s? strlen(s): 0;
+    put_u32(b, len);
+    put(b, s, len);
+}
+
+static void get(dbcur_t *c, void *data, size_t size) {
+    if (c->failed || (size_t)(c->end - c->p) < size) {
+        c->failed = true;
+        memset(data, 0, size);
+        return;
+    }
+    memcpy(data, c->p, size);
+    c->p += size;
+}
+
+static uint8_t get_u8(dbcur_t *c) { uint8_t v; get(c, &v, 1); return v; }
+static uint16_t get_u16(dbcur_t *c) { uint16_t v; get(c, &v, 2); return v; }
+static uint32_t get_u32(dbcur_t *c) { uint32_t v; get(c, &v, 4); return v; }
+static uint64_t get_u64(dbcur_t *c) { uint64_t v; get(c, &v, 8); return v; }
+
+static char *get_str(dbcur_t *c) {
+    uint32_t len = get_u32(c);
+    if (c->failed || (size_t)(c->end - c->p) < len) {
+        c->failed = true;
+        return NULL;
+    }
+    if (!len) {
+        return NULL;
+    }
+    char *s = strndup((const char *)c->p, len);
+    c->p += len;
+    return s;
+}
+
+static void put_fingerprint(dbbuf_t *b, fingerprint_t *fp) {
+    put_str(b, fp->path);
+    put_u64(b, fp->dev);
+    put_u64(b, fp->ino);
+    put_u64(b, fp->size);
+    put_u64(b, fp->mtime);
+    put_u64(b, fp->mtime_nsec);
+    put_u64(b, fp->ctime);
+    put_u64(b, fp->ctime_nsec);
+    put_u32(b, fp->mode);
+    put_u32(b, fp->uid);
+    put_u32(b, fp->gid);
+    put_u8(b, fp->class);
+    put_u16(b, fp->machine);
+    put_u16(b, fp->type);
+    put_u64(b, fp->entry);
+    put_u32(b, fp->security);
+    put(b, fp->header, SHA256_SIZE);
+    put(b, fp->rest, SHA256_SIZE);
+    put_str(b, fp->interp);
+    put_str(b, fp->soname);
+    put_str(b, fp->rpath);
+    put_str(b, fp->runpath);
+    put_u32(b, fp->needed_count);
+    for (uint32_t i = 0; i < fp->needed_count; i++) {
+        put_str(b, fp->needed[i]);
+    }
+    put_u32(b, fp->section_count);
+    for (uint32_t i = 0; i < fp->section_count; i++) {
+        fp_section_t *s = &fp->sections[i];
+        put_str(b, s->name);
+        put_u32(b, s->type);
+        put_u64(b, s->addr);
+        put_u64(b, s->offset);
+        put_u64(b, s->size);
+        put(b, s->digest, SHA256_SIZE);
+        put_u8(b, s->hashed);
+    }
+    put_u32(b, fp->segment_count);
+    for (uint32_t i = 0; i < fp->segment_count; i++) {
+        fp_segment_t *p = &fp->segments[i];
+        put_u32(b, p->type);
+        put_u32(b, p->flags);
+        put_u64(b, p->offset);
+        put_u64(b, p->vaddr);
+        put_u64(b, p->filesz);
+        put_u64(b, p->memsz);
+        put(b, p->digest, SHA256_SIZE);
+        put_u8(b, p->hashed);
+    }
+}
+
+static int get_fingerprint(dbcur_t *c, fingerprint_t *fp) {
+    memset(fp, 0, sizeof(fingerprint_t));
+    fp->path = get_str(c);
+    fp->dev = get_u64(c);
+    fp->ino = get_u64(c);
+    fp->size = get_u64(c);
+    fp->mtime = get_u64(c);
+    fp->mtime_nsec = get_u64(c);
+    fp->ctime = get_u64(c);
+    fp->ctime_nsec = get_u64(c);
+    fp->mode = get_u32(c);
+    fp->uid = get_u32(c);
+    fp->gid = get_u32(c);
+    fp->class = get_u8(c);
+    fp->machine = get_u16(c);
+    fp->type = get_u16(c);
+    fp->entry = get_u64(c);
+    fp->security = get_u32(c);
+    get(c, fp->header, SHA256_SIZE);
+    get(c, fp->rest, SHA256_SIZE);
+    fp->interp = get_str(c);
+    fp->soname = get_str(c);
+    fp->rpath = get_str(c);
+    fp->runpath = get_str(c);
+    fp->needed_count = get_u32(c);
+    /* every entry takes at least 4 bytes, a corrupt count fails here */
+    if (c->failed || fp->needed_count > (size_t)(c->end - c->p) / 4) {
+        c->failed = true;
+        fp->needed_count = 0;
+        return ERR_ARGS;
+    }
+    fp->needed = calloc(fp->needed_count + 1, sizeof(char *));
+    for (uint32_t i = 0; i < fp->needed_count; i++) {
+        fp->needed[i] = get_str(c);
+        if (!fp->needed[i]) {
+            fp->needed[i] = strdup("");
+        }
+    }
+    fp->section_count = get_u32(c);
+    if (c->failed || fp->section_count > (size_t)(c->end - c->p) / (32 + SHA256_SIZE + 1)) {
+        c->failed = true;
+        fp->section_count = 0;
+        return ERR_ARGS;
+    }
+    fp->sections = calloc(fp->section_count + 1, sizeof(fp_section_t));
+    for (uint32_t i = 0; i < fp->section_count; i++) {
+        fp_section_t *s = &fp->sections[i];
+        s->name = get_str(c);
+        if (!s->name) {
+            s->name = strdup("");
+        }
+        s->type = get_u32(c);
+        s->addr = get_u64(c);
+        s->offset = get_u64(c);
+        s->size = get_u64(c);
+        get(c, s->digest, SHA256_SIZE);
+        s->hashed = get_u8(c);
+    }
+    fp->segment_count = get_u32(c);
+    if (c->failed || fp->segment_count > (size_t)(c->end - c->p) / (40 + SHA256_SIZE + 1)) {
+        c->failed = true;
+        fp->segment_count = 0;
+        return ERR_ARGS;
+    }
+    fp->segments = calloc(fp->segment_count + 1, sizeof(fp_segment_t));
+    for (uint32_t i = 0; i < fp->segment_count; i++) {
+        fp_segment_t *p = &fp->segments[i];
+        p->type = get_u32(c);
+        p->flags = get_u32(c);
+        p->offset = get_u64(c);
+        p->vaddr = get_u64(c);
+        p->filesz = get_u64(c);
+        p->memsz = get_u64(c);
+        get(c, p->digest, SHA256_SIZE);
+        p->hashed = get_u8(c);
+    }
+    fp->elf = true;
+    return c->failed || !fp->path? ERR_ARGS: NO_ERR;
+}
+
+static void baseline_fini(baseline_t *base) {
+    for (size_t i = 0; i < base->count; i++) {
+        fingerprint_fini(&base->files[i]);
+    }
+    free(base->files);
+    free(base->buckets);
+    memset(base, 0, sizeof(baseline_t));
+}
+
+static void baseline_index(baseline_t *base) {
+    base->nbuckets = 16;
+    while (base->nbuckets < base->count * 2) {
+        base->nbuckets <<= 1;
+    }
+    base->buckets = calloc(base->nbuckets, sizeof(size_t));
+    if (!base->buckets) {
+        base->nbuckets = 0;
+        return;
+    }
+    for (size_t i = 0; i < base->count; i++) {
+        size_t h = hash64(base->files[i].path, strlen(base->files[i].path), 0) & (base->nbuckets - 1);
+        while (base->buckets[h]) {
+            h = (h + 1) & (base->nbuckets - 1);
+        }
+        base->buckets[h] = i + 1;
+    }
+}
+
+static fingerprint_t *baseline_find(baseline_t *base, const char *path) {
+    if (!base->nbuckets) {
+        return NULL;
+    }
+    size_t h = hash64(path, strlen(path), 0) & (base->nbuckets - 1);
+    while (base->buckets[h]) {
+        fingerprint_t *fp = &base->files[base->buckets[h] - 1];
+        if (!strcmp(fp->path, path)) {
+            return fp;
+        }
+        h = (h + 1) & (base->nbuckets - 1);
+    }
+    return NULL;
+}
+
+static int baseline_load(const char *db, baseline_t *base) {
+    char *data = NULL;
+    int size = file_to_mem(db, &data);
+    memset(base, 0, sizeof(baseline_t));
+    if (size <= 0 || !data) {
+        free(data);
+        return ERR_FILE_OPEN;
+    }
+
+    dbcur_t c = {(const uint8_t *)data, (const uint8_t *)data + size, false};
+    char magic[4];
+    get(&c, magic, 4);
+    uint32_t version = get_u32(&c);
+    uint64_t count = get_u64(&c);
+    if (c.failed || memcmp(magic, BASELINE_MAGIC, 4) || version != BASELINE_VERSION ||
+        count > (uint64_t)size / 64) {
+        free(data);
+        return ERR_ARGS;
+    }
+    base->files = calloc(count + 1, sizeof(fingerprint_t));
+    if (!base->files) {
+        free(data);
+        return ERR_MEM;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        int err = get_fingerprint(&c, &base->files[base->count++]);
+        if (err != NO_ERR) {
+            free(data);
+            baseline_fini(base);
+            return err;
+        }
+    }
+    free(data);
+    baseline_index(base);
+    return NO_ERR;
+}
+
+/* written to a temporary file first, an interrupted run keeps the old database */
+static int baseline_save(const char *db, fingerprint_t *files, size_t count) {
+    char tmp[MAX_PATH_LEN];
+    dbbuf_t b = {0};
+    uint64_t recorded = 0;
+    int err = NO_ERR;
+
+    for (size_t i = 0; i < count; i++) {
+        recorded += files[i].elf;
+    }
+    put(&b, BASELINE_MAGIC, 4);
+    put_u32(&b, BASELINE_VERSION);
+    put_u64(&b, recorded);
+    for (size_t i = 0; i < count; i++) {
+        if (files[i].elf) {
+            put_fingerprint(&b, &files[i]);
+        }
+    }
+    if (b.failed) {
+        free(b.data);
+        return ERR_MEM;
+    }
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", db);
+    FILE *fp = fopen(tmp, "wb");
+    if (!fp) {
+        free(b.data);
+        return ERR_FILE_OPEN;
+    }
+    if (fwrite(b.data, 1, b.size, fp) != b.size) {
+        err = ERR_FILE_OPEN;
+    }
+    if (fclose(fp) != 0) {
+        err = ERR_FILE_OPEN;
+    }
+    if (err == NO_ERR && rename(tmp, db) != 0) {
+        err = ERR_FILE_OPEN;
+    }
+    if (err != NO_ERR) {
+        unlink(tmp);
+    }
+    free(b.data);
+    return err;
+}
+
+/* ------------------------------------------------------------------ */
+/* record                                                             */
+
+typedef struct RecordJob {
+    fileset_t *files;
+    fingerprint_t *result;
+} record_job_t;
+
+static void record_task(void *arg, size_t index) {
+    record_job_t *job = (record_job_t *)arg;
+    fingerprint_collect(&job->result[index], job->files->paths[index], NULL);
+}
+
+int baseline_record(const char *db, char **args, int count, int workers) {
+    fileset_t files = {0};
+    record_job_t job;
+    size_t elf = 0, failed = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (fileset_add(&files, args[i]) != NO_ERR) {
+            fprintf(stderr, "%s: no such file\n", args[i]);
+        }
+    }
+    job.files = &files;
+    job.result = calloc(files.count + 1, sizeof(fingerprint_t));
+    if (!job.result) {
+        fileset_fini(&files);
+        return ERR_MEM;
+    }
+    pool_run(workers, files.count, record_task, &job);
+
+    for (size_t i = 0; i < files.count; i++) {
+        if (job.result[i].elf) {
+            elf++;
+        } else if (job.result[i].status == ERR_FILE_OPEN || job.result[i].status == ERR_FILE_STAT) {
+            failed++;
+        }
+    }
+    int err = baseline_save(db, job.result, files.count);
+    if (err == NO_ERR) {
+        PRINT_INFO("%zu elf files of %zu recorded into %s\n", elf, files.count, db);
+    }
+    for (size_t i = 0; i < files.count; i++) {
+        fingerprint_fini(&job.result[i]);
+    }
+    free(job.result);
+    fileset_fini(&files);
+    return err != NO_ERR? err: (int)failed;
+}
+
+/* ------------------------------------------------------------------ */
+/* verify                                                             */
+
+typedef struct Reporter {
+    bool ndjson;
+    const char *path;
+    int events;
+} reporter_t;
+
+static void report(reporter_t *r, const char *event, const char *fmt, ...) {
+    char detail[MAX_PATH_LEN * 2];
+    va_list ap;
+
+    va_start(ap, fmt);
+    vsnprintf(detail, sizeof(detail), fmt, ap);
+    va_end(ap);
+    if (r->ndjson) {
+        json_t j;
+        json_init(&j, stdout);
+        json_object_begin(&j);
+        JSON_KV_STRING(&j, "path", r->path);
+        JSON_KV_STRING(&j, "event", event);
+        JSON_KV_STRING(&j, "detail", detail);
+        json_object_end(&j);
+        json_newline(&j);
+        json_fini(&j);
+    } else {
+        if (!r->events) {
+            PRINT_WARNING("%s\n", r->path);
+        }
+        CHECK_ERROR("    %-18s %s\n", event, detail);
+    }
+    r->events++;
+}
+
+static const char *str_or_none(const char *s) {
+    return s? s: "(none)";
+}
+
+static bool str_differ(const char *a, const char *b) {
+    return (a == NULL) != (b == NULL) || (a && strcmp(a, b));
+}
+
+static bool has_needed(const fingerprint_t *fp, const char *name) {
+    for (uint32_t i = 0; i < fp->needed_count; i++) {
+        if (!strcmp(fp->needed[i], name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void diff_security(reporter_t *r, uint32_t old, uint32_t new) {
+    static const struct { uint32_t bit; const char *name; } bits[] = {
+        {FP_PIE, "pie"}, {FP_NX, "nx"}, {FP_CANARY, "canary"}, {FP_FORTIFY, "fortify"},
+        {SEC_CET_IBT << FP_CET_SHIFT, "ibt"}, {SEC_CET_SHSTK << FP_CET_SHIFT, "shstk"},
+        {SEC_ARM_BTI << FP_CET_SHIFT, "bti"}, {SEC_ARM_PAC << FP_CET_SHIFT, "pac"},
+    };
+    for (size_t i = 0; i < sizeof(bits) / sizeof(bits[0]); i++) {
+        if ((old ^ new) & bits[i].bit) {
+            report(r, "security", "%s %s", bits[i].name, new & bits[i].bit? "enabled": "disabled");
+        }
+    }
+    uint32_t relro_old = old & (FP_RELRO_PARTIAL | FP_RELRO_FULL);
+    uint32_t relro_new = new & (FP_RELRO_PARTIAL | FP_RELRO_FULL);
+    if (relro_old != relro_new) {
+        report(r, "security", "relro %s -> %s",
+            relro_old & FP_RELRO_FULL? "full": relro_old? "partial": "none",
+            relro_new & FP_RELRO_FULL? "full": relro_new? "partial": "none");
+    }
+}
+
+static const char *segment_name(uint32_t type, char *buf, size_t size) {
+    const char *name = segment_type_name(type);
+    if (name) {
+        return name;
+    }
+    snprintf(buf, size, "0x%x", type);
+    return buf;
+}
+
+static void diff_segments(reporter_t *r, fingerprint_t *old, fingerprint_t *new) {
+    char a[16], b[16];
+    uint32_t common = old->segment_count < new->segment_count? old->segment_count: new->segment_count;
+
+    for (uint32_t i = 0; i < common; i++) {
+        fp_segment_t *x = &old->segments[i], *y = &new->segments[i];
+        if (x->type != y->type || x->flags != y->flags || x->offset != y->offset || x->vaddr != y->vaddr ||
+            x->filesz != y->filesz || x->memsz != y->memsz) {
+            report(r, "segment_modified", "[%u] %s %c%c%c 0x%lx+0x%lx -> %s %c%c%c 0x%lx+0x%lx", i,
+                segment_name(x->type, a, sizeof(a)), x->flags & PF_R? 'R': '-', x->flags & PF_W? 'W': '-',
+                x->flags & PF_X? 'X': '-', x->vaddr, x->memsz,
+                segment_name(y->type, b, sizeof(b)), y->flags & PF_R? 'R': '-', y->flags & PF_W? 'W': '-',
+                y->flags & PF_X? 'X': '-', y->vaddr, y->memsz);
+        } else if (y->hashed && (!x->hashed || memcmp(x->digest, y->digest, SHA256_SIZE))) {
+            report(r, "segment_content", "[%u] %s, bytes outside sections changed", i, segment_name(y->type, b, sizeof(b)));
+        }
+    }
+    for (uint32_t i = common; i < new->segment_count; i++) {
+        fp_segment_t *y = &new->segments[i];
+        report(r, "segment_added", "[%u] %s, 0x%lx bytes at 0x%lx", i, segment_name(y->type, b, sizeof(b)),
+            y->memsz, y->vaddr);
+    }
+    for (uint32_t i = common; i < old->segment_count; i++) {
+        report(r, "segment_removed", "[%u] %s", i, segment_name(old->segments[i].type, a, sizeof(a)));
+    }
+}
+
+static void diff_fingerprint(reporter_t *r, fingerprint_t *old, fingerprint_t *new) {
+    if (!new->elf) {
+        report(r, "not_elf", "no longer an elf file");
+        return;
+    }
+    if ((old->mode & 07777) != (new->mode & 07777)) {
+        report(r, "mode", "%04o -> %04o", old->mode & 07777, new->mode & 07777);
+    }
+    if (old->uid != new->uid || old->gid != new->gid) {
+        report(r, "owner", "%u:%u -> %u:%u", old->uid, old->gid, new->uid, new->gid);
+    }
+    if (old->size != new->size) {
+        report(r, "size", "%lu -> %lu bytes", old->size, new->size);
+    }
+    if (memcmp(old->header, new->header, SHA256_SIZE)) {
+        report(r, "elf_header", "header bytes changed");
+    }
+    if (old->class != new->class || old->machine != new->machine || old->type != new->type) {
+        report(r, "header", "class %u machine %u type %u -> class %u machine %u type %u",
+            old->class, old->machine, old->type, new->class, new->machine, new->type);
+    }
+    if (old->entry != new->entry) {
+        report(r, "entry", "0x%lx -> 0x%lx", old->entry, new->entry);
+    }
+    if (str_differ(old->interp, new->interp)) {
+        report(r, "interpreter", "%s -> %s", str_or_none(old->interp), str_or_none(new->interp));
+    }
+    if (str_differ(old->soname, new->soname)) {
+        report(r, "soname", "%s -> %s", str_or_none(old->soname), str_or_none(new->soname));
+    }
+    if (str_differ(old->rpath, new->rpath)) {
+        report(r, "rpath", "%s -> %s", str_or_none(old->rpath), str_or_none(new->rpath));
+    }
+    if (str_differ(old->runpath, new->runpath)) {
+        report(r, "runpath", "%s -> %s", str_or_none(old->runpath), str_or_none(new->runpath));
+    }
+    for (uint32_t i = 0; i < new->needed_count; i++) {
+        if (!has_needed(old, new->needed[i])) {
+            report(r, "needed_added", "%s", new->needed[i]);
+        }
+    }
+    for (uint32_t i = 0; i < old->needed_count; i++) {
+        if (!has_needed(new, old->needed[i])) {
+            report(r, "needed_removed", "%s", old->needed[i]);
+        }
+    }
+    diff_security(r, old->security, new->security);
+    diff_segments(r, old, new);
+
+    secindex_t old_index, new_index;
+    secindex_init(&old_index, old);
+    secindex_init(&new_index, new);
+    for (uint32_t i = 0; i < new->section_count; i++) {
+        fp_section_t *s = &new->sections[i];
+        const fp_section_t *prev = find_section(&old_index, old, s->name, section_ordinal(&new_index, new, i));
+        if (!prev) {
+            report(r, "section_added", "%s, 0x%lx bytes at 0x%lx", s->name, s->size, s->addr);
+        } else if (prev->size != s->size) {
+            report(r, "section_modified", "%s, size 0x%lx -> 0x%lx", s->name, prev->size, s->size);
+        } else if (s->hashed && (!prev->hashed || memcmp(prev->digest, s->digest, SHA256_SIZE))) {
+            report(r, "section_modified", "%s, content changed", s->name);
+        } else if (prev->addr != s->addr) {
+            report(r, "section_moved", "%s, 0x%lx -> 0x%lx", s->name, prev->addr, s->addr);
+        }
+    }
+    for (uint32_t i = 0; i < old->section_count; i++) {
+        if (!find_section(&new_index, new, old->sections[i].name, section_ordinal(&old_index, old, i))) {
+            report(r, "section_removed", "%s", old->sections[i].name);
+        }
+    }
+    secindex_fini(&old_index);
+    secindex_fini(&new_index);
+    if (memcmp(old->rest, new->rest, SHA256_SIZE)) {
+        report(r, "unmapped_data", "bytes outside sections and segments changed");
+    }
+}
+
+static void verify_task(void *arg, size_t index) {
+    verify_job_t *job = (verify_job_t *)arg;
+    const char *path = job->files->paths[index];
+    fingerprint_t *old = baseline_find(job->base, path);
+    struct stat st;
+
+    if (stat(path, &st) < 0) {
+        job->state[index] = old? VERIFY_MISSING: VERIFY_IGNORED;
+        return;
+    }
+    if (old && same_stat(old, &st)) {
+        job->state[index] = VERIFY_SKIPPED;
+        return;
+    }
+    fingerprint_collect(&job->current[index], path, old);
+    if (!old) {
+        job->state[index] = job->current[index].elf? VERIFY_NEW: VERIFY_IGNORED;
+    } else {
+        job->state[index] = VERIFY_CHANGED;
+    }
+}
+
+int baseline_verify(const char *db, char **args, int count, int workers, bool ndjson) {
+    baseline_t base;
+    fileset_t files = {0};
+    verify_job_t job;
+    size_t stat_count[VERIFY_IGNORED + 1] = {0};
+    size_t modified = 0;
+    int err;
+
+    err = baseline_load(db, &base);
+    if (err != NO_ERR) {
+        fprintf(stderr, "%s: cannot load the baseline database\n", db);
+        return err;
+    }
+    if (count) {
+        for (int i = 0; i < count; i++) {
+            if (fileset_add(&files, args[i]) != NO_ERR) {
+                fprintf(stderr, "%s: no such file\n", args[i]);
+            }
+        }
+    }
+    /* recorded files which are gone do not show up in a directory walk */
+    for (size_t i = 0; i < base.count; i++) {
+        const char *path = base.files[i].path;
+        if (!count) {
+            fileset_push(&files, path);
+            continue;
+        }
+        for (int j = 0; j < count; j++) {
+            size_t len = strlen(args[j]);
+            /* /a/b covers /a/b and /a/b/c, not /a/bc */
+            bool under = !strncmp(path, args[j], len) &&
+                         (path[len] == '\0' || path[len] == '/' || (len && args[j][len - 1] == '/'));
+            if (under && access(path, F_OK) != 0) {
+                fileset_push(&files, path);
+                break;
+            }
+        }
+    }
+
+    job.files = &files;
+    job.base = &base;
+    job.current = calloc(files.count + 1, sizeof(fingerprint_t));
+    job.state = calloc(files.count + 1, sizeof(int));
+    if (!job.current || !job.state) {
+        free(job.current);
+        free(job.state);
+        fileset_fini(&files);
+        baseline_fini(&base);
+        return ERR_MEM;
+    }
+    if (!ndjson) {
+        setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    }
+    pool_run(workers, files.count, verify_task, &job);
+
+    /* reported in input order, the output does not depend on the scheduling */
+    for (size_t i = 0; i < files.count; i++) {
+        reporter_t r = {ndjson, files.paths[i], 0};
+        fingerprint_t *old = baseline_find(&base, files.paths[i]);
+        stat_count[job.state[i]]++;
+        switch (job.state[i]) {
+            case VERIFY_MISSING:
+                report(&r, "missing", "recorded file is gone");
+                break;
+            case VERIFY_NEW:
+                report(&r, "new", "elf file not in the baseline");
+                break;
+            case VERIFY_CHANGED:
+                diff_fingerprint(&r, old, &job.current[i]);
+                if (!r.events) {
+                    /* every byte is covered by a digest, only the stat data differs */
+                    report(&r, "touched", "mtime %lu -> %lu, content identical", old->mtime, job.current[i].mtime);
+                    stat_count[VERIFY_CHANGED]--;
+                    stat_count[VERIFY_TOUCHED]++;
+                }
+                break;
+            default:
+                break;
+        }
+        if (r.events) {
+            modified++;
+        }
+        fingerprint_fini(&job.current[i]);
+    }
+    fflush(stdout);
+    fprintf(stderr, "files: %zu, unchanged: %zu, touched: %zu, changed: %zu, new: %zu, missing: %zu\n",
+        files.count - stat_count[VERIFY_IGNORED], stat_count[VERIFY_SKIPPED], stat_count[VERIFY_TOUCHED],
+        stat_count[VERIFY_CHANGED],
+        stat_count[VERIFY_NEW], stat_count[VERIFY_MISSING]);
+
+    free(job.current);
+    free(job.state);
+    fileset_fini(&files);
+    baseline_fini(&base);
+    return modified;
+}
@@ -0,0 +1,129 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef __BASELINE_H
+#define __BASELINE_H
+
+#define BASELINE_MAGIC      "ESDB"
+#define BASELINE_VERSION    3
+#define BASELINE_DEFAULT    "elfspirit.db"
+
+/* security properties, from checksec_collect */
+#define FP_PIE              0x01
+#define FP_NX               0x02
+#define FP_CANARY           0x04
+#define FP_RELRO_PARTIAL    0x08
+#define FP_RELRO_FULL       0x10
+#define FP_FORTIFY          0x20
+#define FP_CET_SHIFT        8       // secinfo_t.cet bits
+
+/* one section, its content is hashed with SHA-256 */
+typedef struct FpSection {
+    char *name;
+    uint32_t type;
+    uint64_t addr;
+    uint64_t offset;
+    uint64_t size;
+    uint8_t digest[SHA256_SIZE];
+    bool hashed;
+} fp_section_t;
+
+/* one program header, a PT_LOAD also hashes the bytes no section covers */
+typedef struct FpSegment {
+    uint32_t type;
+    uint32_t flags;
+    uint64_t offset;
+    uint64_t vaddr;
+    uint64_t filesz;
+    uint64_t memsz;
+    uint8_t digest[SHA256_SIZE];
+    bool hashed;
+} fp_segment_t;
+
+/* fingerprint of one elf file */
+typedef struct Fingerprint {
+    char *path;
+    int status;             // NO_ERR, or the reason why it cannot be read
+    bool elf;
+
+    /* stat */
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    uint64_t mtime;
+    uint64_t mtime_nsec;
+    uint64_t ctime;
+    uint64_t ctime_nsec;
+    uint32_t mode;
+    uint32_t uid;
+    uint32_t gid;
+
+    /* header and dynamic facts */
+    uint8_t class;
+    uint16_t machine;
+    uint16_t type;
+    uint64_t entry;
+    uint32_t security;      // FP_* bits
+    uint8_t header[SHA256_SIZE];    // elf header bytes
+    uint8_t rest[SHA256_SIZE];      // bytes outside every section and PT_LOAD
+    char *interp;
+    char *soname;
+    char *rpath;
+    char *runpath;
+    char **needed;
+    uint32_t needed_count;
+
+    fp_section_t *sections;
+    uint32_t section_count;
+    fp_segment_t *segments;
+    uint32_t segment_count;
+} fingerprint_t;
+
+/**
+ * @brief 记录文件的基线指纹到数据库
+ * record the fingerprints of the files into the database
+ * @param db database path
+ * @param args files, directories, globs or @lists
+ * @param count number of args
+ * @param workers worker threads
+ * @return number of files which cannot be read, or error code
+ */
+int baseline_record(const char *db, char **args, int count, int workers);
+
+/**
+ * @brief 根据基线数据库校验文件，stat信息未变的文件直接跳过。ctime可被root伪造，快速路径信任root
+ * verify the files against the database, files whose stat information is
+ * unchanged are skipped. root can forge ctime, so this fast path trusts root
+ * @param db database path
+ * @param args files to verify, every recorded file if count is 0
+ * @param count number of args
+ * @param workers worker threads
+ * @param ndjson print NDJSON events instead of text
+ * @return number of touched, changed, new and missing files, or error code
+ */
+int baseline_verify(const char *db, char **args, int count, int workers, bool ndjson);
+
+#endif
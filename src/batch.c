@@ -0,0 +1,348 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <ftw.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "batch.h"
+
+typedef struct BatchJob {
+    batch_op_t op;
+    char *value;
+    fileset_t *files;
+    size_t done;
+    size_t skipped;
+    size_t failed;
+} batch_job_t;
+
+int fileset_push(fileset_t *fs, const char *path) {
+    if (fs->count == fs->capacity) {
+        size_t cap = fs->capacity? fs->capacity * 2: 256;
+        char **tmp = realloc(fs->paths, cap * sizeof(char *));
+        if (!tmp) {
+            return ERR_MEM;
+        }
+        fs->paths = tmp;
+        fs->capacity = cap;
+    }
+    fs->paths[fs->count] = strdup(path);
+    if (!fs->paths[fs->count]) {
+        return ERR_MEM;
+    }
+    fs->count++;
+    return NO_ERR;
+}
+
+/* nftw has no user argument */
+static __thread fileset_t *g_walk_set;
+
+static int fileset_walk(const char *path, const struct stat *st, int type, struct FTW *ftw) {
+    (void)ftw;      // the signature is fixed by nftw
+    if (type == FTW_F && S_ISREG(st->st_mode)) {
+        if (fileset_push(g_walk_set, path) != NO_ERR) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int fileset_add(fileset_t *fs, const char *arg) {
+    struct stat st;
+
+    /* @list: one path per line */
+    if (arg[0] == '@') {
+        char line[MAX_PATH_LEN];
+        FILE *fp = strcmp(arg, "@-")? fopen(arg + 1, "r"): stdin;
+        if (!fp) {
+            return ERR_FILE_OPEN;
+        }
+        while (fgets(line, sizeof(line), fp)) {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (line[0] && fileset_add(fs, line) != NO_ERR) {
+                PRINT_WARNING("%s: not found\n", line);
+            }
+        }
+        if (fp != stdin) {
+            fclose(fp);
+        }
+        return NO_ERR;
+    }
+
+    if (stat(arg, &st) == 0) {
+        if (S_ISDIR(st.st_mode)) {
+            g_walk_set = fs;
+            /* do not follow symbolic links, a tree is visited once */
+            return nftw(arg, fileset_walk, 64, FTW_PHYS) == 0? NO_ERR: ERR_MEM;
+        }
+        return S_ISREG(st.st_mode)? fileset_push(fs, arg): ERR_FILE_STAT;
+    }
+
+    /* glob pattern */
+    if (strpbrk(arg, "*?[")) {
+        glob_t g;
+        int err = NO_ERR;
+        if (glob(arg, 0, NULL, &g) != 0) {
+            return ERR_FILE_OPEN;
+        }
+        for (size_t i = 0; i < g.gl_pathc && err == NO_ERR; i++) {
+            err = fileset_add(fs, g.gl_pathv[i]);
+        }
+        globfree(&g);
+        return err;
+    }
+    return ERR_FILE_STAT;
+}
+
+void fileset_fini(fileset_t *fs) {
+    for (size_t i = 0; i < fs->count; i++) {
+        free(fs->paths[i]);
+    }
+    free(fs->paths);
+    memset(fs, 0, sizeof(fileset_t));
+}
+
+/* the string of a dynamic entry, NULL if the tag is absent */
+static char *get_dyn_string(Elf *elf, int tag) {
+    Elf64_Dyn dyn;
+    uint64_t strtab = 0, offset = 0, value = 0;
+    int found = 0;
+    int count = elf->class == ELFCLASS32? elf->data.elf32.dyn_count: elf->data.elf64.dyn_count;
+
+    for (int i = 0; i < count; i++) {
+        get_dyn_by_index(elf, i, &dyn);
+        if (dyn.d_tag == DT_STRTAB) {
+            strtab = dyn.d_un.d_ptr;
+        } else if (dyn.d_tag == tag) {
+            value = dyn.d_un.d_val;
+            found = 1;
+        }
+    }
+    if (!found || vaddr_to_offset(elf, strtab, &offset) != NO_ERR || offset + value >= elf->size) {
+        return NULL;
+    }
+    return (char *)elf->mem + offset + value;
+}
+
+/**
+ * @brief 检查.gnu.hash中每个符号的哈希值是否与.dynsym一致
+ * check that every hash value of .gnu.hash matches .dynsym
+ */
+static bool is_gnuhash_consistent(Elf *elf) {
+    int index = get_section_index_by_name(elf, ".gnu.hash");
+    Elf64_Shdr shdr;
+    Elf64_Sym sym;
+    void *dynsym;
+    char *dynstr;
+    size_t count;
+
+    if (index < 0 || get_section_by_index(elf, index, &shdr) != NO_ERR || shdr.sh_offset + shdr.sh_size > elf->size) {
+        return false;
+    }
+    if (elf->class == ELFCLASS32) {
+        if (!elf->data.elf32.dynsym || !elf->data.elf32.dynstrtab) return false;
+        dynsym = elf->data.elf32.dynsym_entry;
+        dynstr = (char *)elf->mem + elf->data.elf32.dynstrtab->sh_offset;
+        count = elf->data.elf32.dynsym_count;
+    } else {
+        if (!elf->data.elf64.dynsym || !elf->data.elf64.dynstrtab) return false;
+        dynsym = elf->data.elf64.dynsym_entry;
+        dynstr = (char *)elf->mem + elf->data.elf64.dynstrtab->sh_offset;
+        count = elf->data.elf64.dynsym_count;
+    }
+
+    uint32_t *gh = (uint32_t *)(elf->mem + shdr.sh_offset);
+    size_t word = elf->class == ELFCLASS32? 4: 8;
+    uint32_t nbuckets = gh[0], symndx = gh[1], maskwords = gh[2];
+    uint32_t *chain = (uint32_t *)((uint8_t *)&gh[4] + maskwords * word) + nbuckets;
+    if (16 + maskwords * word + (nbuckets + (count > symndx? count - symndx: 0)) * 4 > shdr.sh_size) {
+        return false;
+    }
+    for (size_t i = symndx; i < count; i++) {
+        get_sym_by_table(elf, dynsym, i, &sym);
+        if ((chain[i - symndx] | 1) != (dl_new_hash(dynstr + sym.st_name) | 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 检查文件是否已经处于目标状态
+ * check whether the file is already in the target state
+ * @return TRUE, FALSE or error code
+ */
+static int is_target_state(Elf *elf, batch_op_t op, char *value, const char **reason) {
+    Elf64_Phdr phdr;
+    char *str;
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    int shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+
+    switch (op) {
+        case BATCH_SET_INTERPRETER:
+            for (int i = 0; i < phnum; i++) {
+                get_segment_by_index(elf, i, &phdr);
+                if (phdr.p_type == PT_INTERP) {
+                    *reason = "interpreter already set";
+                    return phdr.p_offset + phdr.p_filesz <= elf->size &&
+                        !strncmp((char *)elf->mem + phdr.p_offset, value, phdr.p_filesz)? TRUE: FALSE;
+                }
+            }
+            /* static binaries and shared libraries have no interpreter */
+            *reason = "no PT_INTERP";
+            return TRUE;
+
+        case BATCH_SET_RPATH:
+        case BATCH_SET_RUNPATH:
+            str = get_dyn_string(elf, op == BATCH_SET_RPATH? DT_RPATH: DT_RUNPATH);
+            *reason = "path already set";
+            return str && !strcmp(str, value)? TRUE: FALSE;
+
+        case BATCH_STRIP:
+            for (int i = shnum - 1; i >= 0; i--) {
+                bool flag = false;
+                Elf64_Shdr shdr;
+                get_section_by_index(elf, i, &shdr);
+                if (is_isolated_section_by_index(elf, i, &flag) == NO_ERR && flag &&
+                    shdr.sh_type != SHT_NULL && strcmp(get_section_name(elf, i), ".shstrtab")) {
+                    return FALSE;
+                }
+            }
+            *reason = "already stripped";
+            return TRUE;
+
+        case BATCH_REFRESH_HASH:
+            *reason = ".gnu.hash is up to date";
+            return is_gnuhash_consistent(elf)? TRUE: FALSE;
+
+        default:
+            return ERR_ARGS;
+    }
+}
+
+static int batch_apply(Elf *elf, batch_op_t op, char *value) {
+    switch (op) {
+        case BATCH_SET_INTERPRETER:
+            return set_interpreter(elf, value);
+        case BATCH_SET_RPATH:
+            return set_rpath(elf, value);
+        case BATCH_SET_RUNPATH:
+            return set_runpath(elf, value);
+        case BATCH_STRIP:
+            return strip(elf);
+        case BATCH_REFRESH_HASH:
+            return refresh_hash_table(elf);
+        default:
+            return ERR_ARGS;
+    }
+}
+
+/**
+ * @brief 处理一个文件：只打开一次(读写)，检查状态，执行修改
+ * process one file: open it once for writing, check the state, apply the edit
+ */
+static void batch_task(void *arg, size_t index) {
+    batch_job_t *job = (batch_job_t *)arg;
+    char *path = job->files->paths[index];
+    const char *reason = "";
+    struct stat st;
+    Elf elf;
+    int class;
+    uint16_t machine;
+    int err;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        err = ERR_FILE_OPEN;
+        goto fail;
+    }
+    err = fstat(fd, &st) < 0? ERR_FILE_STAT: probe_elf(fd, st.st_size, &class, &machine);
+    close(fd);
+    if (err != NO_ERR) {
+        /* directory trees are full of scripts and data */
+        __atomic_add_fetch(&job->skipped, 1, __ATOMIC_RELAXED);
+        printf("[*] %s: skipped, not an elf\n", path);
+        return;
+    }
+
+    err = init(path, &elf, false);
+    if (err != NO_ERR) {
+        goto fail;
+    }
+    err = is_target_state(&elf, job->op, job->value, &reason);
+    if (err == TRUE) {
+        finit(&elf);
+        __atomic_add_fetch(&job->skipped, 1, __ATOMIC_RELAXED);
+        printf("[*] %s: skipped, %s\n", path, reason);
+        return;
+    }
+    err = err == FALSE? batch_apply(&elf, job->op, job->value): err;
+    finit(&elf);
+    if (err < 0 && err != NO_ERR) {
+        goto fail;
+    }
+    __atomic_add_fetch(&job->done, 1, __ATOMIC_RELAXED);
+    PRINT_INFO("%s: done\n", path);
+    return;
+
+fail:
+    __atomic_add_fetch(&job->failed, 1, __ATOMIC_RELAXED);
+    PRINT_WARNING("%s: failed (%d)\n", path, err);
+}
+
+int batch_run(batch_op_t op, char *value, char **args, int count, int workers) {
+    fileset_t files = {0};
+    batch_job_t job = {0};
+
+    if ((op == BATCH_SET_INTERPRETER || op == BATCH_SET_RPATH || op == BATCH_SET_RUNPATH) && (!value || !*value)) {
+        return ERR_ARGS;
+    }
+    for (int i = 0; i < count; i++) {
+        if (fileset_add(&files, args[i]) != NO_ERR) {
+            PRINT_WARNING("%s: no such file\n", args[i]);
+            job.failed++;
+        }
+    }
+
+    job.op = op;
+    job.value = value;
+    job.files = &files;
+    pool_run(workers, files.count, batch_task, &job);
+
+    PRINT_INFO("%zu files: %zu done, %zu skipped, %zu failed\n", files.count, job.done, job.skipped, job.failed);
+    fileset_fini(&files);
+    return job.failed;
+}
@@ -0,0 +1,78 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stddef.h>
+#ifndef __BATCH_H
+#define __BATCH_H
+
+/* operations supported by the batch driver */
+typedef enum BATCH_OP {
+    BATCH_SET_INTERPRETER = 1,
+    BATCH_SET_RPATH,
+    BATCH_SET_RUNPATH,
+    BATCH_STRIP,
+    BATCH_REFRESH_HASH,
+} batch_op_t;
+
+/* a list of input files */
+typedef struct FileSet {
+    char **paths;
+    size_t count;
+    size_t capacity;
+} fileset_t;
+
+/**
+ * @brief 添加输入文件：普通文件、目录(递归)、通配符或者@列表文件(@-表示标准输入)
+ * add input files: a regular file, a directory (recursive), a glob pattern,
+ * or @list with one path per line (@- reads stdin)
+ * @param fs file set
+ * @param arg command line argument
+ * @return error code
+ */
+int fileset_add(fileset_t *fs, const char *arg);
+void fileset_fini(fileset_t *fs);
+
+/**
+ * @brief 添加一个路径，不检查文件是否存在
+ * add one path as it is, without checking that it exists
+ * @param fs file set
+ * @param path file path
+ * @return error code
+ */
+int fileset_push(fileset_t *fs, const char *path);
+
+/**
+ * @brief 使用线程池对所有文件执行同一个修改操作，已经处于目标状态的文件会被跳过
+ * apply one edit operation to every file on a thread pool,
+ * files already in the target state are skipped
+ * @param op operation
+ * @param value string argument of the operation (interpreter, rpath, ...)
+ * @param args input arguments, see fileset_add
+ * @param count argument count
+ * @param workers worker count, <= 0 means one per CPU
+ * @return number of failed files, or error code
+ */
+int batch_run(batch_op_t op, char *value, char **args, int count, int workers);
+
+#endif
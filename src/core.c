@@ -0,0 +1,451 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "core.h"
+
+#ifndef NT_SIGINFO
+#define NT_SIGINFO  0x53494749
+#endif
+#ifndef NT_FILE
+#define NT_FILE     0x46494c45
+#endif
+
+static const char *regs_x86_64[] = {
+    "r15", "r14", "r13", "r12", "rbp", "rbx", "r11", "r10", "r9", "r8", "rax", "rcx", "rdx", "rsi",
+    "rdi", "orig_rax", "rip", "cs", "eflags", "rsp", "ss", "fs_base", "gs_base", "ds", "es", "fs", "gs",
+};
+static const char *regs_386[] = {
+    "ebx", "ecx", "edx", "esi", "edi", "ebp", "eax", "ds", "es", "fs", "gs", "orig_eax", "eip", "cs",
+    "eflags", "esp", "ss",
+};
+static const char *regs_aarch64[] = {
+    "x0", "x1", "x2", "x3", "x4", "x5", "x6", "x7", "x8", "x9", "x10", "x11", "x12", "x13", "x14", "x15",
+    "x16", "x17", "x18", "x19", "x20", "x21", "x22", "x23", "x24", "x25", "x26", "x27", "x28", "x29",
+    "x30", "sp", "pc", "pstate",
+};
+static const char *regs_arm[] = {
+    "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7", "r8", "r9", "r10", "fp", "ip", "sp", "lr", "pc",
+    "cpsr", "orig_r0",
+};
+static const char *regs_riscv[] = {
+    "pc", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6",
+};
+
+static const char *signals[] = {
+    "0", "SIGHUP", "SIGINT", "SIGQUIT", "SIGILL", "SIGTRAP", "SIGABRT", "SIGBUS", "SIGFPE", "SIGKILL",
+    "SIGUSR1", "SIGSEGV", "SIGUSR2", "SIGPIPE", "SIGALRM", "SIGTERM", "SIGSTKFLT", "SIGCHLD", "SIGCONT",
+    "SIGSTOP", "SIGTSTP", "SIGTTIN", "SIGTTOU", "SIGURG", "SIGXCPU", "SIGXFSZ", "SIGVTALRM", "SIGPROF",
+    "SIGWINCH", "SIGIO", "SIGPWR", "SIGSYS",
+};
+
+static const char *auxv_name(uint64_t type) {
+    switch (type) {
+        case AT_PHDR: return "AT_PHDR";
+        case AT_PHENT: return "AT_PHENT";
+        case AT_PHNUM: return "AT_PHNUM";
+        case AT_PAGESZ: return "AT_PAGESZ";
+        case AT_BASE: return "AT_BASE";
+        case AT_FLAGS: return "AT_FLAGS";
+        case AT_ENTRY: return "AT_ENTRY";
+        case AT_UID: return "AT_UID";
+        case AT_EUID: return "AT_EUID";
+        case AT_GID: return "AT_GID";
+        case AT_EGID: return "AT_EGID";
+        case AT_PLATFORM: return "AT_PLATFORM";
+        case AT_HWCAP: return "AT_HWCAP";
+        case AT_CLKTCK: return "AT_CLKTCK";
+        case AT_SECURE: return "AT_SECURE";
+        case AT_BASE_PLATFORM: return "AT_BASE_PLATFORM";
+        case AT_RANDOM: return "AT_RANDOM";
+        case AT_HWCAP2: return "AT_HWCAP2";
+        case AT_EXECFN: return "AT_EXECFN";
+        case AT_SYSINFO: return "AT_SYSINFO";
+        case AT_SYSINFO_EHDR: return "AT_SYSINFO_EHDR";
+        case 27: return "AT_RSEQ_FEATURE_SIZE";
+        case 28: return "AT_RSEQ_ALIGN";
+        case 29: return "AT_HWCAP3";
+        case 30: return "AT_HWCAP4";
+        case 51: return "AT_MINSIGSTKSZ";
+        default: return NULL;
+    }
+}
+
+static uint64_t get_word(const uint8_t *p, int word) {
+    return word == 4? *(uint32_t *)p: *(uint64_t *)p;
+}
+
+static const char *signal_name(uint32_t sig) {
+    return sig < sizeof(signals) / sizeof(signals[0])? signals[sig]: "?";
+}
+
+static int compare_map(const void *a, const void *b) {
+    const core_map_t *x = a, *y = b;
+    return x->start < y->start? -1: x->start > y->start;
+}
+
+static int add_note(core_t *core, uint32_t type, const uint8_t *desc, uint32_t descsz) {
+    int word = core->word;
+
+    switch (type) {
+        case NT_PRSTATUS:
+            if (core->thread_count % 16 == 0) {
+                const uint8_t **threads = realloc(core->threads, (core->thread_count + 16) * sizeof(*core->threads));
+                if (!threads) {
+                    return ERR_MEM;
+                }
+                core->threads = threads;
+            }
+            core->threads[core->thread_count++] = desc;
+            core->prstatus_size = descsz;
+            break;
+
+        case NT_PRPSINFO:
+            /* pr_fname[16] and pr_psargs[80] close the structure on every arch */
+            if (descsz >= 96) {
+                core->fname = (const char *)desc + descsz - 96;
+                core->psargs = (const char *)desc + descsz - 80;
+            }
+            break;
+
+        case NT_AUXV:
+            core->auxv = desc;
+            core->auxv_size = descsz;
+            break;
+
+        case NT_SIGINFO:
+            core->siginfo = desc;
+            core->siginfo_size = descsz;
+            break;
+
+        case NT_FILE: {
+            /* count, page size, count * {start, end, page offset}, count names */
+            if (descsz < 2 * word || core->files) {
+                break;
+            }
+            uint64_t count = get_word(desc, word), page = get_word(desc + word, word);
+            /* the table must fit before any pointer is derived from count */
+            if (count > (descsz - 2 * word) / (3 * word)) {
+                break;
+            }
+            const char *name = (const char *)desc + 2 * word + count * 3 * word;
+            const char *end = (const char *)desc + descsz;
+            core->files = calloc(count + 1, sizeof(core_file_t));
+            if (!core->files) {
+                return ERR_MEM;
+            }
+            for (uint64_t i = 0; i < count && name < end; i++) {
+                const uint8_t *e = desc + 2 * word + i * 3 * word;
+                core->files[i].start = get_word(e, word);
+                core->files[i].end = get_word(e + word, word);
+                core->files[i].offset = get_word(e + 2 * word, word) * page;
+                core->files[i].name = name;
+                name += strnlen(name, end - name) + 1;
+                core->file_count++;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+    return NO_ERR;
+}
+
+int core_open(Elf *elf, core_t *core) {
+    Elf64_Ehdr *ehdr = (Elf64_Ehdr *)elf->mem;
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+
+    if (ehdr->e_type != ET_CORE) {
+        return ERR_ELF_TYPE;
+    }
+    memset(core, 0, sizeof(*core));
+    core->elf = elf;
+    core->word = elf->class == ELFCLASS32? 4: 8;
+
+    /* more than 65535 mappings, the real count is in the first section header */
+    if (phnum == PN_XNUM) {
+        Elf64_Shdr shdr;
+        get_section_by_index(elf, 0, &shdr);
+        phnum = shdr.sh_info;
+    }
+
+    core->maps = calloc(phnum, sizeof(core_map_t));
+    if (!core->maps) {
+        return ERR_MEM;
+    }
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        get_segment_by_index(elf, i, &phdr);
+        if (phdr.p_offset >= elf->size) {
+            phdr.p_filesz = 0;
+        } else if (phdr.p_filesz > elf->size - phdr.p_offset) {
+            phdr.p_filesz = elf->size - phdr.p_offset;
+            core->truncated += phdr.p_type == PT_LOAD;
+        }
+
+        if (phdr.p_type == PT_LOAD) {
+            core_map_t *m = &core->maps[core->map_count++];
+            m->start = phdr.p_vaddr;
+            m->end = phdr.p_vaddr + phdr.p_memsz;
+            m->offset = phdr.p_offset;
+            m->filesz = phdr.p_filesz < phdr.p_memsz? phdr.p_filesz: phdr.p_memsz;
+            m->flags = phdr.p_flags;
+        }
+
+        if (phdr.p_type == PT_NOTE) {
+            /* core notes are 4 byte aligned on both classes */
+            const uint8_t *p = elf->mem + phdr.p_offset, *end = p + phdr.p_filesz;
+            while (p + 12 <= end) {
+                uint32_t namesz = ((uint32_t *)p)[0], descsz = ((uint32_t *)p)[1], type = ((uint32_t *)p)[2];
+                const uint8_t *desc = p + 12 + ((namesz + 3) & ~3);
+                if (desc + descsz > end || desc < p) {
+                    break;
+                }
+                if (namesz == 5 && !memcmp(p + 12, "CORE", 5) && add_note(core, type, desc, descsz) != NO_ERR) {
+                    core_close(core);
+                    return ERR_MEM;
+                }
+                p = desc + ((descsz + 3) & ~3);
+            }
+        }
+    }
+
+    /* the kernel writes them in order, sort anyway for a crafted core */
+    qsort(core->maps, core->map_count, sizeof(core_map_t), compare_map);
+    return NO_ERR;
+}
+
+void core_close(core_t *core) {
+    free(core->maps);
+    free(core->threads);
+    free(core->files);
+    memset(core, 0, sizeof(*core));
+}
+
+static core_map_t *find_map(core_t *core, uint64_t addr) {
+    int lo = 0, hi = core->map_count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (core->maps[mid].start <= addr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (found < 0 || addr >= core->maps[found].end) {
+        return NULL;
+    }
+    return &core->maps[found];
+}
+
+const uint8_t *core_read(core_t *core, uint64_t addr, uint64_t *avail) {
+    core_map_t *m = find_map(core, addr);
+    if (!m || addr - m->start >= m->filesz) {
+        *avail = 0;
+        return NULL;
+    }
+    *avail = m->filesz - (addr - m->start);
+    return core->elf->mem + m->offset + (addr - m->start);
+}
+
+const core_file_t *core_file_at(core_t *core, uint64_t addr) {
+    for (int i = 0; i < core->file_count; i++) {
+        if (core->files[i].start <= addr && addr < core->files[i].end) {
+            return &core->files[i];
+        }
+    }
+    return NULL;
+}
+
+/* a NUL terminated string of the crashed process, if it was dumped */
+static const char *core_string(core_t *core, uint64_t addr) {
+    uint64_t avail;
+    const char *s = (const char *)core_read(core, addr, &avail);
+    return s && strnlen(s, avail) < avail? s: NULL;
+}
+
+static void display_threads(core_t *core, uint16_t machine) {
+    int word = core->word;
+    /* pr_info, pr_cursig, pr_sigpend, pr_sighold, then pid ppid pgrp sid and 4 timevals */
+    uint32_t pid_off = word == 8? 32: 24, reg_off = word == 8? 112: 72;
+    const char **names = NULL;
+    size_t known = 0;
+
+    switch (machine) {
+        case EM_X86_64: names = regs_x86_64; known = sizeof(regs_x86_64) / sizeof(char *); break;
+        case EM_386: names = regs_386; known = sizeof(regs_386) / sizeof(char *); break;
+        case EM_AARCH64: names = regs_aarch64; known = sizeof(regs_aarch64) / sizeof(char *); break;
+        case EM_ARM: names = regs_arm; known = sizeof(regs_arm) / sizeof(char *); break;
+        case EM_RISCV: names = regs_riscv; known = sizeof(regs_riscv) / sizeof(char *); break;
+        default: break;
+    }
+
+    PRINT_INFO("Threads (NT_PRSTATUS)\n");
+    if (core->prstatus_size < reg_off + word) {
+        return;
+    }
+    /* pr_reg is followed by the int pr_fpvalid, padded to a word */
+    size_t count = (core->prstatus_size - reg_off - word) / word;
+    for (int t = 0; t < core->thread_count; t++) {
+        const uint8_t *d = core->threads[t];
+        printf("    [%2d] tid %u ppid %u signal %u (%s)%s\n", t, *(uint32_t *)(d + pid_off),
+            *(uint32_t *)(d + pid_off + 4), *(uint16_t *)(d + 12), signal_name(*(uint16_t *)(d + 12)),
+            t == 0? " <- crashed": "");
+        for (size_t i = 0; i < count; i++) {
+            char reg[16];
+            if (names && i < known)
+                snprintf(reg, sizeof(reg), "%s", names[i]);
+            else
+                snprintf(reg, sizeof(reg), "r%lu", i);
+            printf("%s%-8s %0*lx", i % 4? "  ": "         ", reg, word * 2, get_word(d + reg_off + i * word, word));
+            if (i % 4 == 3 || i == count - 1)
+                printf("\n");
+        }
+    }
+}
+
+static void display_siginfo(core_t *core) {
+    if (core->siginfo_size < 16) {
+        return;
+    }
+    const uint8_t *s = core->siginfo;
+    int32_t signo = *(int32_t *)s, code = *(int32_t *)(s + 8);
+    /* the union starts after signo, errno, code, aligned to a word */
+    const uint8_t *u = s + (core->word == 8? 16: 12);
+
+    PRINT_INFO("Signal (NT_SIGINFO)\n");
+    printf("    signal %d (%s), errno %d, code %d", signo, signal_name(signo), *(int32_t *)(s + 4), code);
+    if (code > 0 && (signo == 4 || signo == 5 || signo == 7 || signo == 8 || signo == 11)) {
+        printf(", fault address 0x%lx", get_word(u, core->word));
+    } else if (code <= 0) {
+        printf(", sent by pid %d uid %u", *(int32_t *)u, *(uint32_t *)(u + 4));
+    }
+    printf("\n");
+}
+
+static void display_auxv(core_t *core) {
+    int word = core->word;
+    PRINT_INFO("Auxiliary vector (NT_AUXV)\n");
+    for (size_t i = 0; i + 2 * word <= core->auxv_size; i += 2 * word) {
+        uint64_t type = get_word(core->auxv + i, word), value = get_word(core->auxv + i + word, word);
+        const char *name = auxv_name(type), *str = NULL;
+        if (type == AT_NULL) {
+            break;
+        }
+        if (type == AT_PLATFORM || type == AT_BASE_PLATFORM || type == AT_EXECFN) {
+            str = core_string(core, value);
+        }
+        if (name)
+            printf("    %-20s 0x%lx", name, value);
+        else
+            printf("    AT_%-17lu 0x%lx", type, value);
+        printf(str? " \"%s\"\n": "\n", str);
+    }
+}
+
+static void display_files(core_t *core) {
+    PRINT_INFO("Mapped files (NT_FILE)\n");
+    printf("    [%2s] %-16s %-16s %-10s %s\n", "Nr", "Start", "End", "Offset", "Path");
+    for (int i = 0; i < core->file_count; i++) {
+        core_file_t *f = &core->files[i];
+        printf("    [%2d] %016lx %016lx %-10lx %s\n", i, f->start, f->end, f->offset, f->name);
+    }
+}
+
+static void display_memory(core_t *core, uint64_t addr, uint64_t size) {
+    uint64_t avail;
+    const uint8_t *p = core_read(core, addr, &avail);
+
+    PRINT_INFO("Memory at 0x%lx\n", addr);
+    if (!p) {
+        const core_file_t *f = core_file_at(core, addr);
+        if (find_map(core, addr))
+            PRINT_WARNING("not dumped");
+        else
+            PRINT_WARNING("unmapped");
+        if (f)
+            printf(", backed by %s at file offset 0x%lx", f->name, f->offset + addr - f->start);
+        printf("\n");
+        return;
+    }
+    if (size > avail) {
+        PRINT_WARNING("only 0x%lx bytes dumped from 0x%lx\n", avail, addr);
+        size = avail;
+    }
+    for (uint64_t i = 0; i < size; i += 16) {
+        printf("    %016lx ", addr + i);
+        for (uint64_t j = i; j < i + 16; j++) {
+            if (j < size)
+                printf(" %02x", p[j]);
+            else
+                printf("   ");
+        }
+        printf("  ");
+        for (uint64_t j = i; j < i + 16 && j < size; j++) {
+            printf("%c", p[j] >= 0x20 && p[j] < 0x7f? p[j]: '.');
+        }
+        printf("\n");
+    }
+}
+
+int core_report(Elf *elf, uint64_t addr, uint64_t size) {
+    core_t core;
+    uint64_t mapped = 0, dumped = 0;
+    int err = core_open(elf, &core);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    for (int i = 0; i < core.map_count; i++) {
+        mapped += core.maps[i].end - core.maps[i].start;
+        dumped += core.maps[i].filesz;
+    }
+    PRINT_INFO("Core of %.16s: %.80s\n", core.fname? core.fname: "?", core.psargs? core.psargs: "");
+    printf("    %d threads, %d mappings, 0x%lx of 0x%lx bytes dumped, %d files\n",
+        core.thread_count, core.map_count, dumped, mapped, core.file_count);
+    if (core.truncated) {
+        PRINT_WARNING("%d PT_LOAD cut off, the core is truncated\n", core.truncated);
+    }
+
+    if (size) {
+        display_memory(&core, addr, size);
+    } else {
+        display_siginfo(&core);
+        display_threads(&core, ((Elf64_Ehdr *)elf->mem)->e_machine);
+        display_auxv(&core);
+        display_files(&core);
+    }
+
+    core_close(&core);
+    return NO_ERR;
+}
@@ -0,0 +1,115 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#ifndef __CORE_H
+#define __CORE_H
+
+/* one dumped PT_LOAD, sorted by start for the address index */
+typedef struct CoreMap {
+    uint64_t start;
+    uint64_t end;           // start + p_memsz
+    uint64_t offset;        // p_offset
+    uint64_t filesz;        // bytes present in the file, clamped for a truncated core
+    uint32_t flags;
+} core_map_t;
+
+/* one entry of NT_FILE */
+typedef struct CoreFile {
+    uint64_t start;
+    uint64_t end;
+    uint64_t offset;        // file offset in bytes
+    const char *name;       // points into the core
+} core_file_t;
+
+typedef struct Core {
+    Elf *elf;
+    int word;
+    core_map_t *maps;
+    int map_count;
+    int truncated;          // PT_LOADs cut off by the end of the file
+    const uint8_t **threads;// NT_PRSTATUS descriptors, in note order
+    uint32_t prstatus_size;
+    int thread_count;
+    core_file_t *files;
+    int file_count;
+    const uint8_t *auxv;
+    size_t auxv_size;
+    const uint8_t *siginfo;
+    size_t siginfo_size;
+    const char *fname;      // NT_PRPSINFO pr_fname and pr_psargs
+    const char *psargs;
+} core_t;
+
+/**
+ * @brief 索引ET_CORE：按地址排序PT_LOAD，记录NT_PRSTATUS、NT_FILE、NT_AUXV、
+ * NT_SIGINFO在映射中的位置，不拷贝任何数据
+ * index an ET_CORE: sort the PT_LOADs by address and record where
+ * NT_PRSTATUS, NT_FILE, NT_AUXV and NT_SIGINFO sit in the mapping, nothing
+ * is copied
+ * @param elf core file custom structure
+ * @param core output
+ * @return error code
+ */
+int core_open(Elf *elf, core_t *core);
+
+/**
+ * @brief 释放索引
+ * free the index
+ * @param core core
+ */
+void core_close(core_t *core);
+
+/**
+ * @brief 二分查找地址所在的PT_LOAD，返回指向映射的指针
+ * binary search the PT_LOAD holding addr and point into the mapping
+ * @param core core
+ * @param addr virtual address of the crashed process
+ * @param avail contiguous bytes readable from the pointer
+ * @return pointer, NULL if addr is unmapped or was not dumped
+ */
+const uint8_t *core_read(core_t *core, uint64_t addr, uint64_t *avail);
+
+/**
+ * @brief 查找映射地址的文件，用于没有转储的只读页
+ * find the file mapped at addr, for read-only pages which were not dumped
+ * @param core core
+ * @param addr virtual address
+ * @return NT_FILE entry, or NULL
+ */
+const core_file_t *core_file_at(core_t *core, uint64_t addr);
+
+/**
+ * @brief 打印线程寄存器、信号、auxv和文件映射表，size不为0时打印addr处的内存
+ * print the thread registers, the signal, auxv and the mapped files, and a
+ * hex dump of the memory at addr when size is not 0
+ * @param elf core file custom structure
+ * @param addr virtual address to dump
+ * @param size bytes to dump
+ * @return error code
+ */
+int core_report(Elf *elf, uint64_t addr, uint64_t size);
+
+#endif
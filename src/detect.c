@@ -0,0 +1,243 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "forensic.h"
+#include "rule.h"
+#include "detect.h"
+
+/* padding is only read up to this size, larger gaps are not a cave */
+#define CAVE_MAX (16 * ONE_PAGE)
+
+typedef struct DetectCtx {
+    infect_report_t report;
+    void *arg;
+    int score;
+} detect_ctx_t;
+
+static void emit(detect_ctx_t *ctx, int sig, int weight, const char *name, const char *fmt, ...) {
+    infect_sig_t s;
+    va_list ap;
+
+    s.sig = sig;
+    s.weight = weight;
+    s.name = name;
+    va_start(ap, fmt);
+    vsnprintf(s.evidence, DETECT_EVIDENCE_LEN, fmt, ap);
+    va_end(ap);
+    ctx->score += weight;
+    if (ctx->report) {
+        ctx->report(ctx->arg, &s);
+    }
+}
+
+static bool is_zero(const uint8_t *p, uint64_t size) {
+    for (uint64_t i = 0; i < size; i++) {
+        if (p[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool is_exec_load(Elf64_Phdr *p) {
+    return p->p_type == PT_LOAD && (p->p_flags & PF_X);
+}
+
+/* file range of the sections inside a segment, false if there is none */
+static bool section_span(facts_t *facts, Elf64_Phdr *p, uint64_t *end, int *last) {
+    bool found = false;
+    *end = 0;
+    *last = -1;
+    for (int i = 0; i < facts->shnum; i++) {
+        Elf64_Shdr *s = &facts->shdr[i].hdr;
+        if (!(s->sh_flags & SHF_ALLOC) || !s->sh_size || s->sh_type == SHT_NOBITS) {
+            continue;
+        }
+        if (s->sh_offset < p->p_offset || s->sh_offset >= p->p_offset + p->p_filesz) {
+            continue;
+        }
+        found = true;
+        if (s->sh_offset + s->sh_size >= *end) {
+            *end = s->sh_offset + s->sh_size;
+            *last = i;
+        }
+    }
+    return found;
+}
+
+/* silvio and data infection leave bytes which no section describes */
+static void detect_segments(facts_t *facts, detect_ctx_t *ctx) {
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        uint64_t end;
+        int last;
+        if (p->p_type != PT_LOAD) {
+            continue;
+        }
+        /* silvio shifts the following segments by one page in the file only */
+        if (p->p_align > ONE_PAGE && (p->p_align & (p->p_align - 1)) == 0 &&
+            (p->p_offset & (p->p_align - 1)) != (p->p_vaddr & (p->p_align - 1))) {
+            emit(ctx, SIG_MISALIGNED, 40, "segment shifted", "[%d] offset 0x%lx, vaddr 0x%lx, align 0x%lx", i,
+                p->p_offset, p->p_vaddr, p->p_align);
+        }
+        if ((p->p_flags & PF_W) && (p->p_flags & PF_X)) {
+            emit(ctx, SIG_EXEC_DATA, 40, "executable data segment", "[%d] 0x%lx is RWX", i, p->p_vaddr);
+        }
+        if (!facts->shnum || !p->p_filesz) {
+            continue;
+        }
+        if (!section_span(facts, p, &end, &last)) {
+            /* the segment at offset 0 may hold nothing but the headers */
+            if (p->p_offset != 0) {
+                emit(ctx, SIG_ORPHAN_SEGMENT, 30, "orphan segment", "[%d] 0x%lx has no section", i, p->p_vaddr);
+            }
+        } else if (p->p_offset + p->p_filesz > end && p->p_offset + p->p_filesz <= facts->elf->size) {
+            /* alignment slack of the linker is short and zero */
+            uint64_t size = p->p_offset + p->p_filesz - end;
+            if (size >= ONE_PAGE || !is_zero(facts->elf->mem + end, size)) {
+                emit(ctx, SIG_TRAILING, 30, "trailing bytes", "[%d] 0x%lx bytes after %.24s", i,
+                    size, facts->shdr[last].name);
+            }
+        }
+    }
+}
+
+/* skeksi moves the text segment below the segments which precede it in the file */
+static void detect_order(facts_t *facts, detect_ctx_t *ctx) {
+    Elf64_Phdr *prev = NULL;
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        if (p->p_type != PT_LOAD) {
+            continue;
+        }
+        if (prev && p->p_offset > prev->p_offset && p->p_vaddr < prev->p_vaddr && is_exec_load(p)) {
+            uint64_t delta = prev->p_vaddr - p->p_vaddr;
+            emit(ctx, SIG_TEXT_BACKWARD, 50, "text extended backwards", "[%d] 0x%lx below 0x%lx%s", i,
+                p->p_vaddr, prev->p_vaddr, delta % ONE_PAGE? "": ", page multiple");
+        }
+        prev = p;
+    }
+}
+
+/* a code cave is the padding between an executable segment and the next one in the file */
+static void detect_caves(facts_t *facts, detect_ctx_t *ctx) {
+    Elf *elf = facts->elf;
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        uint64_t start, next = elf->size;
+        if (!is_exec_load(p)) {
+            continue;
+        }
+        start = p->p_offset + p->p_filesz;
+        for (int j = 0; j < facts->phnum; j++) {
+            Elf64_Phdr *q = &facts->phdr[j];
+            if (q->p_type == PT_LOAD && q->p_offset >= start && q->p_offset < next) {
+                next = q->p_offset;
+            }
+        }
+        if (next <= start || next - start > CAVE_MAX || next > elf->size) {
+            continue;
+        }
+        uint64_t used = 0;
+        for (uint64_t off = start; off < next; off++) {
+            if (elf->mem[off]) {
+                used++;
+            }
+        }
+        if (used) {
+            emit(ctx, SIG_CAVE_USED, 30, "code cave used", "0x%lx of 0x%lx padding bytes after [%d]",
+                used, next - start, i);
+        }
+    }
+}
+
+static void detect_entry(facts_t *facts, detect_ctx_t *ctx) {
+    Elf64_Phdr *seg;
+    uint64_t end;
+    int last;
+
+    if (facts->type == ELF_SHARED && facts->entry == 0) {
+        return;
+    }
+    seg = facts->entry_segment >= 0? &facts->phdr[facts->entry_segment]: NULL;
+    if (!seg || !(seg->p_flags & PF_X)) {
+        emit(ctx, SIG_ENTRY_OUTSIDE, 60, "entry outside text", "0x%lx is not executable", facts->entry);
+        return;
+    }
+    if (!facts->shnum) {
+        return;
+    }
+    if (facts->entry_section < 0) {
+        emit(ctx, SIG_ENTRY_PADDING, 40, "entry in padding", "0x%lx is in no section", facts->entry);
+    } else if (facts->entry_section != facts->text) {
+        /* silvio grows the section which ends the text segment */
+        if (section_span(facts, seg, &end, &last) && last == facts->entry_section) {
+            emit(ctx, SIG_ENTRY_PADDING, 40, "entry in padding", "0x%lx at the tail of %.24s", facts->entry,
+                facts->shdr[last].name);
+        } else {
+            emit(ctx, SIG_ENTRY_SECTION, 20, "entry section", "0x%lx in %.24s", facts->entry,
+                facts->shdr[facts->entry_section].name);
+        }
+    }
+}
+
+int infect_detect(facts_t *facts, infect_report_t report, void *arg) {
+    detect_ctx_t ctx = {report, arg, 0};
+
+    detect_segments(facts, &ctx);
+    detect_order(facts, &ctx);
+    detect_caves(facts, &ctx);
+    detect_entry(facts, &ctx);
+    return ctx.score > 100? 100: ctx.score;
+}
+
+static void print_sig(void *arg, infect_sig_t *sig) {
+    CHECK_ERROR("    %-24s +%-3d %s\n", sig->name, sig->weight, sig->evidence);
+}
+
+int infect_report(Elf *elf) {
+    facts_t facts;
+    int err = facts_collect(elf, &facts);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    PRINT_INFO("infection signatures\n");
+    int score = infect_detect(&facts, print_sig, NULL);
+    if (score) {
+        PRINT_WARNING("score: %d/100\n", score);
+    } else {
+        PRINT_INFO("score: 0/100, no signature\n");
+    }
+    facts_fini(&facts);
+    return score;
+}
@@ -0,0 +1,72 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __DETECT_H
+#define __DETECT_H
+
+#define DETECT_EVIDENCE_LEN 96
+
+/* footprints of the layouts produced by infect.c */
+enum INFECT_SIG {
+    SIG_ENTRY_PADDING   = 1 << 0,   // entry in the tail of the text segment (silvio)
+    SIG_TEXT_BACKWARD   = 1 << 1,   // text segment extended backwards (skeksi)
+    SIG_EXEC_DATA       = 1 << 2,   // writable and executable segment (data infection)
+    SIG_TRAILING        = 1 << 3,   // bytes after the last section inside PT_LOAD
+    SIG_ORPHAN_SEGMENT  = 1 << 4,   // PT_LOAD with file content but no section
+    SIG_CAVE_USED       = 1 << 5,   // padding after an executable segment is not zero
+    SIG_ENTRY_OUTSIDE   = 1 << 6,   // entry not in an executable PT_LOAD
+    SIG_ENTRY_SECTION   = 1 << 7,   // entry in a section other than .text
+    SIG_MISALIGNED      = 1 << 8,   // p_offset shifted against p_vaddr (silvio)
+};
+
+typedef struct InfectSig {
+    int sig;                // enum INFECT_SIG
+    int weight;             // contribution to the score
+    const char *name;
+    char evidence[DETECT_EVIDENCE_LEN];
+} infect_sig_t;
+
+typedef void (*infect_report_t)(void *arg, infect_sig_t *sig);
+
+/**
+ * @brief 检测infect.c中感染算法留下的痕迹，并对入口点和代码洞评分
+ * detect the footprints of the infection layouts in infect.c, and score
+ * the entry point and the code caves
+ * @param facts facts of the elf file
+ * @param report callback for each signature, may be NULL
+ * @param arg callback argument
+ * @return score {0:clean, 1~100:suspicious}
+ */
+int infect_detect(facts_t *facts, infect_report_t report, void *arg);
+
+/**
+ * @brief 打印感染检测结果
+ * print the infection signatures of the elf file
+ * @param elf elf file custom structure
+ * @return score, or error code
+ */
+int infect_report(Elf *elf);
+
+#endif
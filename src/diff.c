@@ -0,0 +1,943 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "rule.h"
+#include "reloc.h"
+#include "names.h"
+#include "diff.h"
+
+#define HASH_SEED 0x656c667370697269ULL
+
+typedef struct DiffSection {
+    uint64_t hash;          // hash64 of the chunk hashes
+    uint64_t *chunks;       // hash64 of every DIFF_CHUNK bytes
+    uint32_t nchunks;
+    int match;              // section index in the other file, -1 if none
+} diff_section_t;
+
+typedef struct DiffFile {
+    char *name;
+    Elf elf;
+    facts_t facts;
+    Elf64_Ehdr ehdr;
+    reloc_info_t reloc;
+    bool has_reloc;
+    diff_section_t *sections;   // indexed by section index
+} diff_file_t;
+
+typedef struct HashJob {
+    diff_file_t *file;
+    int section;
+    uint32_t chunk;
+} hash_job_t;
+
+/* sort key of sections, symbols and relocations */
+typedef struct DiffKey {
+    const char *name;
+    uint32_t type;
+    uint32_t table;
+    int index;
+    Elf64_Sym sym;
+    uint64_t offset;
+    int64_t addend;
+} diff_key_t;
+
+typedef struct DiffRows {
+    uint32_t limit;
+    uint32_t printed;
+    uint32_t hidden;
+} diff_rows_t;
+
+static void read_ehdr(Elf *elf, Elf64_Ehdr *ehdr) {
+    if (elf->class == ELFCLASS32) {
+        Elf32_Ehdr *h = elf->data.elf32.ehdr;
+        memcpy(ehdr->e_ident, h->e_ident, EI_NIDENT);
+        ehdr->e_type = h->e_type; ehdr->e_machine = h->e_machine; ehdr->e_version = h->e_version;
+        ehdr->e_entry = h->e_entry; ehdr->e_phoff = h->e_phoff; ehdr->e_shoff = h->e_shoff;
+        ehdr->e_flags = h->e_flags; ehdr->e_ehsize = h->e_ehsize;
+        ehdr->e_phentsize = h->e_phentsize; ehdr->e_phnum = h->e_phnum;
+        ehdr->e_shentsize = h->e_shentsize; ehdr->e_shnum = h->e_shnum; ehdr->e_shstrndx = h->e_shstrndx;
+    } else {
+        *ehdr = *elf->data.elf64.ehdr;
+    }
+}
+
+static int diff_open(char *name, diff_file_t *f) {
+    memset(f, 0, sizeof(diff_file_t));
+    f->name = name;
+    int err = init(name, &f->elf, true);
+    if (err != NO_ERR) {
+        return err;
+    }
+    err = facts_collect(&f->elf, &f->facts);
+    if (err != NO_ERR) {
+        finit(&f->elf);
+        return err;
+    }
+    read_ehdr(&f->elf, &f->ehdr);
+    f->has_reloc = reloc_info(&f->elf, &f->reloc) == NO_ERR;
+    f->sections = calloc(f->facts.shnum + 1, sizeof(diff_section_t));
+    if (!f->sections) {
+        facts_fini(&f->facts);
+        finit(&f->elf);
+        return ERR_MEM;
+    }
+    for (int i = 0; i < f->facts.shnum; i++) {
+        f->sections[i].match = -1;
+    }
+    return NO_ERR;
+}
+
+static void diff_close(diff_file_t *f) {
+    for (int i = 0; i < f->facts.shnum; i++) {
+        free(f->sections[i].chunks);
+    }
+    free(f->sections);
+    facts_fini(&f->facts);
+    finit(&f->elf);
+}
+
+static bool has_content(diff_file_t *f, int i) {
+    Elf64_Shdr *s = &f->facts.shdr[i].hdr;
+    return s->sh_type != SHT_NOBITS && s->sh_size && s->sh_offset + s->sh_size <= f->elf.size;
+}
+
+/* hash64 is not collision resistant, equal hashes are confirmed with memcmp */
+static bool same_content(diff_file_t *a, int i, diff_file_t *b, int j) {
+    Elf64_Shdr *x = &a->facts.shdr[i].hdr, *y = &b->facts.shdr[j].hdr;
+    return x->sh_size == y->sh_size && a->sections[i].hash == b->sections[j].hash &&
+           !memcmp(a->elf.mem + x->sh_offset, b->elf.mem + y->sh_offset, x->sh_size);
+}
+
+static void hash_task(void *arg, size_t index) {
+    hash_job_t *job = &((hash_job_t *)arg)[index];
+    Elf64_Shdr *s = &job->file->facts.shdr[job->section].hdr;
+    uint64_t off = (uint64_t)job->chunk * DIFF_CHUNK;
+    uint64_t len = s->sh_size - off < DIFF_CHUNK? s->sh_size - off: DIFF_CHUNK;
+    job->file->sections[job->section].chunks[job->chunk] = hash64(job->file->elf.mem + s->sh_offset + off, len, HASH_SEED);
+}
+
+/**
+ * @brief 按DIFF_CHUNK分块计算两个文件所有节的哈希，总量较大时并行计算
+ * hash the sections of both files in DIFF_CHUNK pieces, in parallel when
+ * there is enough data
+ */
+static int hash_sections(diff_file_t *files, int workers) {
+    size_t count = 0, n = 0;
+    uint64_t total = 0;
+
+    for (int k = 0; k < 2; k++) {
+        for (int i = 1; i < files[k].facts.shnum; i++) {
+            if (!has_content(&files[k], i)) {
+                continue;
+            }
+            diff_section_t *d = &files[k].sections[i];
+            uint64_t size = files[k].facts.shdr[i].hdr.sh_size;
+            d->nchunks = (size + DIFF_CHUNK - 1) / DIFF_CHUNK;
+            d->chunks = calloc(d->nchunks, sizeof(uint64_t));
+            if (!d->chunks) {
+                return ERR_MEM;
+            }
+            count += d->nchunks;
+            total += size;
+        }
+    }
+    hash_job_t *jobs = malloc((count + 1) * sizeof(hash_job_t));
+    if (!jobs) {
+        return ERR_MEM;
+    }
+    for (int k = 0; k < 2; k++) {
+        for (int i = 1; i < files[k].facts.shnum; i++) {
+            for (uint32_t c = 0; c < files[k].sections[i].nchunks; c++) {
+                jobs[n++] = (hash_job_t){&files[k], i, c};
+            }
+        }
+    }
+    pool_run(total >= DIFF_PARALLEL_SIZE? workers: 1, count, hash_task, jobs);
+    free(jobs);
+
+    for (int k = 0; k < 2; k++) {
+        for (int i = 1; i < files[k].facts.shnum; i++) {
+            diff_section_t *d = &files[k].sections[i];
+            if (d->nchunks) {
+                d->hash = hash64(d->chunks, d->nchunks * sizeof(uint64_t), HASH_SEED);
+            }
+        }
+    }
+    return NO_ERR;
+}
+
+static int key_name_cmp(const void *a, const void *b) {
+    const diff_key_t *x = a, *y = b;
+    int c = strcmp(x->name, y->name);
+    if (c) {
+        return c;
+    }
+    if (x->table != y->table) {
+        return x->table < y->table? -1: 1;
+    }
+    if (x->type != y->type) {
+        return x->type < y->type? -1: 1;
+    }
+    return x->index < y->index? -1: x->index > y->index;
+}
+
+/* the same group: name, table and type are equal */
+static bool same_group(const diff_key_t *x, const diff_key_t *y) {
+    return x->table == y->table && x->type == y->type && !strcmp(x->name, y->name);
+}
+
+/**
+ * @brief 合并两个已排序的键列表，同组内按出现顺序配对，回调收到NULL表示另一侧缺失
+ * merge two sorted key lists, keys of a group are paired in order, the
+ * callback receives NULL for the missing side
+ */
+static int merge_keys(diff_key_t *a, size_t na, diff_key_t *b, size_t nb,
+                      int (*pair)(void *arg, diff_key_t *x, diff_key_t *y), void *arg) {
+    size_t i = 0, j = 0;
+    int n = 0;
+    while (i < na || j < nb) {
+        int c = i == na? 1: j == nb? -1: key_name_cmp(&a[i], &b[j]);
+        if (i < na && j < nb && same_group(&a[i], &b[j])) {
+            c = 0;
+        }
+        if (c < 0) {
+            n += pair(arg, &a[i++], NULL);
+        } else if (c > 0) {
+            n += pair(arg, NULL, &b[j++]);
+        } else {
+            n += pair(arg, &a[i++], &b[j++]);
+        }
+    }
+    return n;
+}
+
+static bool row_visible(diff_rows_t *rows) {
+    if (rows->printed < rows->limit) {
+        rows->printed++;
+        return true;
+    }
+    rows->hidden++;
+    return false;
+}
+
+static void rows_done(diff_rows_t *rows) {
+    if (rows->hidden) {
+        printf("    ... %u more\n", rows->hidden);
+    }
+}
+
+/* start a row with the label, or continue it with a comma */
+static void add_change(bool *first, const char *label, const char *format, ...) {
+    va_list ap;
+    if (*first) {
+        printf("    %-24s ", label);
+    } else {
+        printf(", ");
+    }
+    *first = false;
+    va_start(ap, format);
+    vprintf(format, ap);
+    va_end(ap);
+}
+
+/* ------------------------------------------------------------------ */
+
+#define DIFF_FIELD(label, x, y) do {                                                    \
+    if ((uint64_t)(x) != (uint64_t)(y)) {                                               \
+        printf("    %-24s 0x%lx -> 0x%lx\n", label, (uint64_t)(x), (uint64_t)(y));      \
+        n++;                                                                            \
+    }                                                                                   \
+} while (0)
+
+static int diff_header(diff_file_t *a, diff_file_t *b) {
+    Elf64_Ehdr *x = &a->ehdr, *y = &b->ehdr;
+    int n = 0;
+
+    PRINT_INFO("header\n");
+    DIFF_FIELD("EI_CLASS", x->e_ident[EI_CLASS], y->e_ident[EI_CLASS]);
+    DIFF_FIELD("EI_DATA", x->e_ident[EI_DATA], y->e_ident[EI_DATA]);
+    DIFF_FIELD("EI_OSABI", x->e_ident[EI_OSABI], y->e_ident[EI_OSABI]);
+    DIFF_FIELD("EI_ABIVERSION", x->e_ident[EI_ABIVERSION], y->e_ident[EI_ABIVERSION]);
+    DIFF_FIELD("e_type", x->e_type, y->e_type);
+    DIFF_FIELD("e_machine", x->e_machine, y->e_machine);
+    DIFF_FIELD("e_version", x->e_version, y->e_version);
+    DIFF_FIELD("e_entry", x->e_entry, y->e_entry);
+    DIFF_FIELD("e_phoff", x->e_phoff, y->e_phoff);
+    DIFF_FIELD("e_shoff", x->e_shoff, y->e_shoff);
+    DIFF_FIELD("e_flags", x->e_flags, y->e_flags);
+    DIFF_FIELD("e_ehsize", x->e_ehsize, y->e_ehsize);
+    DIFF_FIELD("e_phentsize", x->e_phentsize, y->e_phentsize);
+    DIFF_FIELD("e_phnum", x->e_phnum, y->e_phnum);
+    DIFF_FIELD("e_shentsize", x->e_shentsize, y->e_shentsize);
+    DIFF_FIELD("e_shnum", x->e_shnum, y->e_shnum);
+    DIFF_FIELD("e_shstrndx", x->e_shstrndx, y->e_shstrndx);
+    return n;
+}
+
+static void segment_label(Elf64_Phdr *phdr, int ordinal, char *label, size_t size) {
+    const char *type = segment_type_name(phdr->p_type);
+    if (type) {
+        snprintf(label, size, "%s#%d", type, ordinal);
+    } else {
+        snprintf(label, size, "0x%x#%d", phdr->p_type, ordinal);
+    }
+}
+
+/* ordinal of the segment among the segments of the same type */
+static int segment_ordinal(facts_t *facts, int index) {
+    int ordinal = 0;
+    for (int i = 0; i < index; i++) {
+        ordinal += facts->phdr[i].p_type == facts->phdr[index].p_type;
+    }
+    return ordinal;
+}
+
+static int segment_find(facts_t *facts, uint32_t type, int ordinal) {
+    for (int i = 0; i < facts->phnum; i++) {
+        if (facts->phdr[i].p_type == type && ordinal-- == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 按(类型, 序号)对齐程序头
+ * align the program headers by (type, ordinal)
+ */
+static int diff_segments(diff_file_t *a, diff_file_t *b) {
+    char label[64];
+    int n = 0;
+
+    PRINT_INFO("segments\n");
+    for (int i = 0; i < a->facts.phnum; i++) {
+        Elf64_Phdr *x = &a->facts.phdr[i];
+        int ordinal = segment_ordinal(&a->facts, i);
+        int j = segment_find(&b->facts, x->p_type, ordinal);
+        segment_label(x, ordinal, label, sizeof(label));
+        if (j < 0) {
+            printf("    %-24s removed\n", label);
+            n++;
+            continue;
+        }
+        Elf64_Phdr *y = &b->facts.phdr[j];
+        uint64_t xv[] = {x->p_offset, x->p_vaddr, x->p_paddr, x->p_filesz, x->p_memsz, x->p_flags, x->p_align};
+        uint64_t yv[] = {y->p_offset, y->p_vaddr, y->p_paddr, y->p_filesz, y->p_memsz, y->p_flags, y->p_align};
+        static const char *fields[] = {"p_offset", "p_vaddr", "p_paddr", "p_filesz", "p_memsz", "p_flags", "p_align"};
+        bool first = true;
+        for (int k = 0; k < sizeof(xv) / sizeof(xv[0]); k++) {
+            if (xv[k] != yv[k]) {
+                add_change(&first, label, "%s 0x%lx -> 0x%lx", fields[k], xv[k], yv[k]);
+            }
+        }
+        if (!first) {
+            printf("\n");
+            n++;
+        }
+    }
+    for (int j = 0; j < b->facts.phnum; j++) {
+        int ordinal = segment_ordinal(&b->facts, j);
+        if (segment_find(&a->facts, b->facts.phdr[j].p_type, ordinal) < 0) {
+            segment_label(&b->facts.phdr[j], ordinal, label, sizeof(label));
+            printf("    %-24s added\n", label);
+            n++;
+        }
+    }
+    return n;
+}
+
+static const char *section_label(diff_file_t *f, int i) {
+    return *f->facts.shdr[i].name? f->facts.shdr[i].name: "[unnamed]";
+}
+
+static int pair_sections(void *arg, diff_key_t *x, diff_key_t *y) {
+    diff_file_t *files = arg;
+    if (x && y) {
+        files[0].sections[x->index].match = y->index;
+        files[1].sections[y->index].match = x->index;
+    }
+    return 0;
+}
+
+/**
+ * @brief 逐字节比较哈希不同的块，哈希相同的块用memcmp确认，打印不同的字节范围(相对节的起始)
+ * compare the bytes of the chunks whose hashes differ, chunks with equal
+ * hashes are confirmed with memcmp, print the differing byte ranges relative
+ * to the start of the section
+ */
+static void print_ranges(bool *first, const char *label, diff_file_t *a, int i, diff_file_t *b, int j) {
+    Elf64_Shdr *x = &a->facts.shdr[i].hdr, *y = &b->facts.shdr[j].hdr;
+    diff_section_t *dx = &a->sections[i], *dy = &b->sections[j];
+    uint8_t *p = a->elf.mem + x->sh_offset, *q = b->elf.mem + y->sh_offset;
+    uint64_t common = x->sh_size < y->sh_size? x->sh_size: y->sh_size;
+    uint64_t start[DIFF_MAX_RANGES], end[DIFF_MAX_RANGES];
+    uint64_t ranges = 0, bytes = 0, last = 0;
+
+    for (uint64_t off = 0; off < common; off += DIFF_CHUNK) {
+        uint32_t c = off / DIFF_CHUNK;
+        uint64_t lx = x->sh_size - off < DIFF_CHUNK? x->sh_size - off: DIFF_CHUNK;
+        uint64_t ly = y->sh_size - off < DIFF_CHUNK? y->sh_size - off: DIFF_CHUNK;
+        if (lx == ly && dx->chunks[c] == dy->chunks[c] && !memcmp(p + off, q + off, lx)) {
+            continue;
+        }
+        uint64_t stop = off + (lx < ly? lx: ly);
+        for (uint64_t k = off; k < stop; k++) {
+            if (p[k] == q[k]) {
+                continue;
+            }
+            bytes++;
+            if (ranges && last == k) {
+                if (ranges <= DIFF_MAX_RANGES) {
+                    end[ranges - 1] = k + 1;
+                }
+            } else {
+                if (ranges < DIFF_MAX_RANGES) {
+                    start[ranges] = k;
+                    end[ranges] = k + 1;
+                }
+                ranges++;
+            }
+            last = k + 1;
+        }
+    }
+    if (!ranges) {
+        return;
+    }
+    add_change(first, label, "content changed in %lu bytes, %lu ranges:", bytes, ranges);
+    for (uint64_t k = 0; k < ranges && k < DIFF_MAX_RANGES; k++) {
+        printf(" 0x%lx-0x%lx", start[k], end[k]);
+    }
+    if (ranges > DIFF_MAX_RANGES) {
+        printf(" ...");
+    }
+}
+
+/**
+ * @brief 按(名称, 类型)对齐节，未配对的节按大小和内容哈希识别改名，
+ * 再比较位置、大小、属性和内容
+ * align the sections by (name, type), detect renames among the unmatched
+ * sections by size and content hash, then compare placement, size, flags
+ * and content
+ */
+static int diff_sections(diff_file_t *files) {
+    diff_file_t *a = &files[0], *b = &files[1];
+    diff_key_t *ka = calloc(a->facts.shnum + 1, sizeof(diff_key_t));
+    diff_key_t *kb = calloc(b->facts.shnum + 1, sizeof(diff_key_t));
+    int identical = 0, changed = 0, added = 0, removed = 0;
+
+    if (!ka || !kb) {
+        free(ka);
+        free(kb);
+        return ERR_MEM;
+    }
+    for (int i = 1; i < a->facts.shnum; i++) {
+        ka[i - 1] = (diff_key_t){.name = a->facts.shdr[i].name, .type = a->facts.shdr[i].hdr.sh_type, .index = i};
+    }
+    for (int i = 1; i < b->facts.shnum; i++) {
+        kb[i - 1] = (diff_key_t){.name = b->facts.shdr[i].name, .type = b->facts.shdr[i].hdr.sh_type, .index = i};
+    }
+    size_t na = a->facts.shnum > 1? a->facts.shnum - 1: 0;
+    size_t nb = b->facts.shnum > 1? b->facts.shnum - 1: 0;
+    qsort(ka, na, sizeof(diff_key_t), key_name_cmp);
+    qsort(kb, nb, sizeof(diff_key_t), key_name_cmp);
+    merge_keys(ka, na, kb, nb, pair_sections, files);
+    free(ka);
+    free(kb);
+
+    /* a renamed section keeps its type, size and content */
+    for (int i = 1; i < a->facts.shnum; i++) {
+        if (a->sections[i].match >= 0 || !has_content(a, i)) {
+            continue;
+        }
+        for (int j = 1; j < b->facts.shnum; j++) {
+            Elf64_Shdr *x = &a->facts.shdr[i].hdr, *y = &b->facts.shdr[j].hdr;
+            if (b->sections[j].match < 0 && has_content(b, j) && x->sh_type == y->sh_type
+                && same_content(a, i, b, j)) {
+                a->sections[i].match = j;
+                b->sections[j].match = i;
+                break;
+            }
+        }
+    }
+
+    PRINT_INFO("sections\n");
+    for (int i = 1; i < a->facts.shnum; i++) {
+        const char *label = section_label(a, i);
+        Elf64_Shdr *x = &a->facts.shdr[i].hdr;
+        int j = a->sections[i].match;
+        bool first = true;
+        if (j < 0) {
+            printf("    %-24s removed, 0x%lx bytes\n", label, x->sh_size);
+            removed++;
+            continue;
+        }
+        Elf64_Shdr *y = &b->facts.shdr[j].hdr;
+        if (strcmp(a->facts.shdr[i].name, b->facts.shdr[j].name)) {
+            add_change(&first, label, "renamed to %s", section_label(b, j));
+        }
+        if (x->sh_offset != y->sh_offset) {
+            add_change(&first, label, "moved 0x%lx -> 0x%lx", x->sh_offset, y->sh_offset);
+        }
+        if (x->sh_addr != y->sh_addr) {
+            add_change(&first, label, "addr 0x%lx -> 0x%lx", x->sh_addr, y->sh_addr);
+        }
+        if (x->sh_size != y->sh_size) {
+            add_change(&first, label, "resized 0x%lx -> 0x%lx", x->sh_size, y->sh_size);
+        }
+        if (x->sh_flags != y->sh_flags) {
+            add_change(&first, label, "flags 0x%lx -> 0x%lx", x->sh_flags, y->sh_flags);
+        }
+        if (x->sh_link != y->sh_link || x->sh_info != y->sh_info) {
+            add_change(&first, label, "link/info %u/%u -> %u/%u", x->sh_link, x->sh_info, y->sh_link, y->sh_info);
+        }
+        if (x->sh_addralign != y->sh_addralign || x->sh_entsize != y->sh_entsize) {
+            add_change(&first, label, "align/entsize 0x%lx/0x%lx -> 0x%lx/0x%lx",
+                x->sh_addralign, x->sh_entsize, y->sh_addralign, y->sh_entsize);
+        }
+        if (has_content(a, i) && has_content(b, j) && !same_content(a, i, b, j)) {
+            print_ranges(&first, label, a, i, b, j);
+        }
+        if (first) {
+            identical++;
+        } else {
+            printf("\n");
+            changed++;
+        }
+    }
+    for (int j = 1; j < b->facts.shnum; j++) {
+        if (b->sections[j].match < 0) {
+            printf("    %-24s added, 0x%lx bytes\n", section_label(b, j), b->facts.shdr[j].hdr.sh_size);
+            added++;
+        }
+    }
+    printf("    %d identical, %d changed, %d added, %d removed\n", identical, changed, added, removed);
+    return changed + added + removed;
+}
+
+/* string value of DT_NEEDED, DT_SONAME, DT_RPATH and DT_RUNPATH */
+static const char *dyn_string(diff_file_t *f, Elf64_Dyn *dyn) {
+    switch (dyn->d_tag) {
+        case DT_NEEDED: case DT_SONAME: case DT_RPATH: case DT_RUNPATH: case DT_AUXILIARY: case DT_FILTER:
+            break;
+        default:
+            return NULL;
+    }
+    if (!f->has_reloc || !f->reloc.strtab || dyn->d_un.d_val >= f->reloc.strsz) {
+        return NULL;
+    }
+    return (char *)f->elf.mem + f->reloc.strtab + dyn->d_un.d_val;
+}
+
+static int dyn_find(facts_t *facts, int64_t tag, int ordinal) {
+    for (int i = 0; i < facts->dyn_count; i++) {
+        if (facts->dyn[i].d_tag == tag && ordinal-- == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void dyn_label(diff_file_t *f, int64_t tag, int ordinal, char *label, size_t size) {
+    const char *name = dyn_tag_name(f->ehdr.e_machine, tag);
+    if (name) {
+        snprintf(label, size, "%s#%d", name, ordinal);
+    } else {
+        snprintf(label, size, "0x%lx#%d", tag, ordinal);
+    }
+}
+
+/**
+ * @brief 按(标签, 序号)对齐动态段，字符串标签比较字符串内容
+ * align the dynamic tags by (tag, ordinal), string tags compare the strings
+ */
+static int diff_dynamic(diff_file_t *a, diff_file_t *b) {
+    char label[64];
+    int n = 0;
+
+    PRINT_INFO("dynamic\n");
+    for (int i = 0; i < a->facts.dyn_count; i++) {
+        Elf64_Dyn *x = &a->facts.dyn[i];
+        int ordinal = 0;
+        for (int k = 0; k < i; k++) {
+            ordinal += a->facts.dyn[k].d_tag == x->d_tag;
+        }
+        dyn_label(a, x->d_tag, ordinal, label, sizeof(label));
+        int j = dyn_find(&b->facts, x->d_tag, ordinal);
+        const char *sx = dyn_string(a, x);
+        if (j < 0) {
+            printf(sx? "    %-24s removed, %s\n": "    %-24s removed\n", label, sx);
+            n++;
+            continue;
+        }
+        Elf64_Dyn *y = &b->facts.dyn[j];
+        const char *sy = dyn_string(b, y);
+        if (sx && sy) {
+            if (strcmp(sx, sy)) {
+                printf("    %-24s %s -> %s\n", label, sx, sy);
+                n++;
+            }
+        } else if (x->d_un.d_val != y->d_un.d_val) {
+            printf("    %-24s 0x%lx -> 0x%lx\n", label, x->d_un.d_val, y->d_un.d_val);
+            n++;
+        }
+    }
+    for (int j = 0; j < b->facts.dyn_count; j++) {
+        Elf64_Dyn *y = &b->facts.dyn[j];
+        int ordinal = 0;
+        for (int k = 0; k < j; k++) {
+            ordinal += b->facts.dyn[k].d_tag == y->d_tag;
+        }
+        if (dyn_find(&a->facts, y->d_tag, ordinal) < 0) {
+            const char *sy = dyn_string(b, y);
+            dyn_label(b, y->d_tag, ordinal, label, sizeof(label));
+            printf(sy? "    %-24s added, %s\n": "    %-24s added\n", label, sy);
+            n++;
+        }
+    }
+    return n;
+}
+
+typedef struct DiffPair {
+    diff_file_t *a;
+    diff_file_t *b;
+    diff_rows_t rows;
+    int added;
+    int removed;
+    int changed;
+} diff_pair_t;
+
+static const char *shndx_name(diff_file_t *f, uint16_t shndx) {
+    switch (shndx) {
+        case SHN_UNDEF: return "UND";
+        case SHN_ABS: return "ABS";
+        case SHN_COMMON: return "COMMON";
+        default: return shndx < f->facts.shnum? section_label(f, shndx): "?";
+    }
+}
+
+static int pair_symbols(void *arg, diff_key_t *x, diff_key_t *y) {
+    diff_pair_t *p = arg;
+    bool first = true;
+
+    if (!x || !y) {
+        if (row_visible(&p->rows)) {
+            printf("    %-24s %s\n", x? x->name: y->name, x? "removed": "added");
+        }
+        x? p->removed++: p->added++;
+        return 1;
+    }
+    /* only the changed rows are counted against the limit */
+    Elf64_Sym *s = &x->sym, *t = &y->sym;
+    const char *sx = shndx_name(p->a, s->st_shndx), *sy = shndx_name(p->b, t->st_shndx);
+    bool section = strcmp(sx, sy);
+    if (s->st_value == t->st_value && s->st_size == t->st_size && s->st_info == t->st_info
+        && s->st_other == t->st_other && !section) {
+        return 0;
+    }
+    p->changed++;
+    if (!row_visible(&p->rows)) {
+        return 1;
+    }
+    if (s->st_value != t->st_value) {
+        add_change(&first, x->name, "value 0x%lx -> 0x%lx", s->st_value, t->st_value);
+    }
+    if (s->st_size != t->st_size) {
+        add_change(&first, x->name, "size %lu -> %lu", s->st_size, t->st_size);
+    }
+    if (ELF64_ST_TYPE(s->st_info) != ELF64_ST_TYPE(t->st_info)) {
+        add_change(&first, x->name, "type %d -> %d", ELF64_ST_TYPE(s->st_info), ELF64_ST_TYPE(t->st_info));
+    }
+    if (ELF64_ST_BIND(s->st_info) != ELF64_ST_BIND(t->st_info)) {
+        add_change(&first, x->name, "bind %d -> %d", ELF64_ST_BIND(s->st_info), ELF64_ST_BIND(t->st_info));
+    }
+    if (s->st_other != t->st_other) {
+        add_change(&first, x->name, "other 0x%x -> 0x%x", s->st_other, t->st_other);
+    }
+    if (section) {
+        add_change(&first, x->name, "section %s -> %s", sx, sy);
+    }
+    printf("\n");
+    return 1;
+}
+
+/* named symbols of the first table of the type, sorted by name */
+static diff_key_t *symbol_keys(diff_file_t *f, uint32_t sh_type, size_t *count) {
+    size_t entsize = f->elf.class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    diff_key_t *keys = NULL;
+    int table = -1;
+
+    *count = 0;
+    for (int i = 1; i < f->facts.shnum && table < 0; i++) {
+        if (f->facts.shdr[i].hdr.sh_type == sh_type) {
+            table = i;
+        }
+    }
+    if (table < 0) {
+        return NULL;
+    }
+    Elf64_Shdr *s = &f->facts.shdr[table].hdr;
+    if (s->sh_link >= f->facts.shnum || s->sh_offset + s->sh_size > f->elf.size) {
+        return NULL;
+    }
+    Elf64_Shdr *str = &f->facts.shdr[s->sh_link].hdr;
+    if (str->sh_offset + str->sh_size > f->elf.size) {
+        return NULL;
+    }
+    size_t nsyms = s->sh_size / entsize;
+    keys = calloc(nsyms + 1, sizeof(diff_key_t));
+    if (!keys) {
+        return NULL;
+    }
+    for (size_t i = 1; i < nsyms; i++) {
+        diff_key_t *k = &keys[*count];
+        get_sym_by_table(&f->elf, f->elf.mem + s->sh_offset, i, &k->sym);
+        if (!k->sym.st_name || k->sym.st_name >= str->sh_size || ELF64_ST_TYPE(k->sym.st_info) == STT_SECTION) {
+            continue;
+        }
+        k->name = (char *)f->elf.mem + str->sh_offset + k->sym.st_name;
+        k->index = i;
+        (*count)++;
+    }
+    qsort(keys, *count, sizeof(diff_key_t), key_name_cmp);
+    return keys;
+}
+
+/**
+ * @brief 按名称对齐符号，同名的局部符号按出现顺序配对
+ * align the symbols by name, local symbols with the same name are paired in order
+ */
+static int diff_symbols(diff_file_t *a, diff_file_t *b, uint32_t sh_type, uint32_t rows) {
+    diff_pair_t p = {a, b, {rows, 0, 0}, 0, 0, 0};
+    size_t na, nb;
+    diff_key_t *ka = symbol_keys(a, sh_type, &na);
+    diff_key_t *kb = symbol_keys(b, sh_type, &nb);
+
+    if (!na && !nb) {
+        free(ka);
+        free(kb);
+        return 0;
+    }
+    PRINT_INFO("symbols of %s\n", sh_type == SHT_SYMTAB? ".symtab": ".dynsym");
+    int n = merge_keys(ka, na, kb, nb, pair_symbols, &p);
+    rows_done(&p.rows);
+    printf("    %zu -> %zu symbols, %d changed, %d added, %d removed\n", na, nb, p.changed, p.added, p.removed);
+    free(ka);
+    free(kb);
+    return n;
+}
+
+typedef struct RelocKeys {
+    diff_key_t *keys;
+    size_t count;
+    size_t capacity;
+} reloc_keys_t;
+
+static int add_reloc(void *arg, reloc_t *rel) {
+    reloc_keys_t *r = arg;
+    if (r->count == r->capacity) {
+        size_t n = r->capacity? r->capacity * 2: 256;
+        diff_key_t *p = realloc(r->keys, n * sizeof(diff_key_t));
+        if (!p) {
+            return ERR_MEM;
+        }
+        r->keys = p;
+        r->capacity = n;
+    }
+    diff_key_t *k = &r->keys[r->count];
+    memset(k, 0, sizeof(diff_key_t));
+    k->name = rel->name? rel->name: "";
+    k->table = rel->table;
+    k->type = rel->type;
+    k->index = r->count++;
+    k->offset = rel->offset;
+    k->addend = rel->addend;
+    return NO_ERR;
+}
+
+static const char *reloc_label(diff_file_t *f, uint32_t type, char *buf, size_t size) {
+    const char *name = reloc_type_name(f->ehdr.e_machine, type);
+    if (!name) {
+        snprintf(buf, size, "0x%x", type);
+        name = buf;
+    }
+    return name;
+}
+
+static int pair_relocs(void *arg, diff_key_t *x, diff_key_t *y) {
+    static const char *tables[RELOC_TABLES] = {"JMPREL", "RELA", "REL", "RELR"};
+    diff_pair_t *p = arg;
+    char buf[16];
+    bool first = true;
+
+    /* relocations without a symbol are compared by count */
+    if ((x && !*x->name) || (y && !*y->name)) {
+        return 0;
+    }
+    if (!x || !y) {
+        diff_key_t *k = x? x: y;
+        if (row_visible(&p->rows)) {
+            printf("    %-24s %s %s in %s\n", k->name, x? "removed": "added",
+                reloc_label(x? p->a: p->b, k->type, buf, sizeof(buf)), tables[k->table]);
+        }
+        x? p->removed++: p->added++;
+        return 1;
+    }
+    if (x->offset == y->offset && x->addend == y->addend) {
+        return 0;
+    }
+    p->changed++;
+    if (!row_visible(&p->rows)) {
+        return 1;
+    }
+    if (x->offset != y->offset) {
+        add_change(&first, x->name, "%s offset 0x%lx -> 0x%lx", reloc_label(p->a, x->type, buf, sizeof(buf)),
+            x->offset, y->offset);
+    }
+    if (x->addend != y->addend) {
+        add_change(&first, x->name, "addend %ld -> %ld", x->addend, y->addend);
+    }
+    printf("\n");
+    return 1;
+}
+
+/* number of keys at the start of the sorted list with an empty name */
+static size_t unnamed_count(diff_key_t *keys, size_t count) {
+    size_t n = 0;
+    while (n < count && !*keys[n].name) {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief 比较动态重定位：带符号的按(符号, 表, 类型)配对，不带符号的按(表, 类型)比较数量
+ * compare the dynamic relocations: those with a symbol are paired by
+ * (symbol, table, type), the others are compared by count per (table, type)
+ */
+static int diff_relocs(diff_file_t *a, diff_file_t *b, uint32_t rows) {
+    diff_pair_t p = {a, b, {rows, 0, 0}, 0, 0, 0};
+    reloc_keys_t ra = {0}, rb = {0};
+    char buf[16];
+    int n = 0;
+
+    if (a->has_reloc) {
+        reloc_foreach(&a->elf, &a->reloc, add_reloc, &ra);
+    }
+    if (b->has_reloc) {
+        reloc_foreach(&b->elf, &b->reloc, add_reloc, &rb);
+    }
+    if (!ra.count && !rb.count) {
+        return 0;
+    }
+    qsort(ra.keys, ra.count, sizeof(diff_key_t), key_name_cmp);
+    qsort(rb.keys, rb.count, sizeof(diff_key_t), key_name_cmp);
+
+    PRINT_INFO("relocations\n");
+    size_t ua = unnamed_count(ra.keys, ra.count), ub = unnamed_count(rb.keys, rb.count);
+    size_t i = 0, j = 0;
+    while (i < ua || j < ub) {
+        diff_key_t *k = i == ua? &rb.keys[j]: j == ub? &ra.keys[i]: key_name_cmp(&ra.keys[i], &rb.keys[j]) <= 0?
+            &ra.keys[i]: &rb.keys[j];
+        uint32_t table = k->table, type = k->type;
+        size_t ca = 0, cb = 0;
+        while (i < ua && ra.keys[i].table == table && ra.keys[i].type == type) {
+            i++, ca++;
+        }
+        while (j < ub && rb.keys[j].table == table && rb.keys[j].type == type) {
+            j++, cb++;
+        }
+        if (ca != cb) {
+            printf("    %-24s %zu -> %zu without symbol\n", reloc_label(a, type, buf, sizeof(buf)), ca, cb);
+            n++;
+        }
+    }
+    n += merge_keys(ra.keys, ra.count, rb.keys, rb.count, pair_relocs, &p);
+    rows_done(&p.rows);
+    printf("    %zu -> %zu relocations, %d changed, %d added, %d removed\n", ra.count, rb.count, p.changed, p.added, p.removed);
+    free(ra.keys);
+    free(rb.keys);
+    return n;
+}
+
+/**
+ * @brief 结构化比较两个ELF文件：头、段、节、动态标签、符号和重定位，
+ * 节内容先比较哈希，哈希相同的节不再逐字节比较
+ * structural diff of two elf files: headers, segments, sections, dynamic
+ * tags, symbols and relocations. Section contents are compared by hash first,
+ * identical sections are skipped without a byte comparison
+ * @param old_name elf file name
+ * @param new_name elf file name
+ * @param workers worker threads to hash large sections, <= 0 means default
+ * @param rows symbol and relocation rows printed per table, 0 means DIFF_MAX_ROWS
+ * @return number of differences, or error code
+ */
+int elf_diff(char *old_name, char *new_name, int workers, uint32_t rows) {
+    diff_file_t files[2];
+    int n = 0;
+
+    int err = diff_open(old_name, &files[0]);
+    if (err != NO_ERR) {
+        return err;
+    }
+    err = diff_open(new_name, &files[1]);
+    if (err != NO_ERR) {
+        diff_close(&files[0]);
+        return err;
+    }
+    rows = rows? rows: DIFF_MAX_ROWS;
+    err = hash_sections(files, workers);
+    if (err != NO_ERR) {
+        goto out;
+    }
+
+    PRINT_INFO("%s -> %s\n", old_name, new_name);
+    n += diff_header(&files[0], &files[1]);
+    n += diff_segments(&files[0], &files[1]);
+    err = diff_sections(files);
+    if (err < 0) {
+        goto out;
+    }
+    n += err;
+    n += diff_dynamic(&files[0], &files[1]);
+    n += diff_symbols(&files[0], &files[1], SHT_DYNSYM, rows);
+    n += diff_symbols(&files[0], &files[1], SHT_SYMTAB, rows);
+    n += diff_relocs(&files[0], &files[1], rows);
+    PRINT_INFO("%d differences\n", n);
+    err = n;
+
+out:
+    diff_close(&files[0]);
+    diff_close(&files[1]);
+    return err;
+}
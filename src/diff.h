@@ -0,0 +1,48 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __DIFF_H
+#define __DIFF_H
+
+#define DIFF_CHUNK          0x10000     // bytes hashed by one task
+#define DIFF_PARALLEL_SIZE  0x400000    // hash in parallel from this many bytes
+#define DIFF_MAX_RANGES     8           // differing byte ranges printed per section
+#define DIFF_MAX_ROWS       50          // symbol and relocation rows printed per table
+
+/**
+ * @brief 结构化比较两个ELF文件：头、段、节、动态标签、符号和重定位，
+ * 节内容先比较哈希，哈希相同的节不再逐字节比较
+ * structural diff of two elf files: headers, segments, sections, dynamic
+ * tags, symbols and relocations. Section contents are compared by hash first,
+ * identical sections are skipped without a byte comparison
+ * @param old_name elf file name
+ * @param new_name elf file name
+ * @param workers worker threads to hash large sections, <= 0 means default
+ * @param rows symbol and relocation rows printed per table, 0 means DIFF_MAX_ROWS
+ * @return number of differences, or error code
+ */
+int elf_diff(char *old_name, char *new_name, int workers, uint32_t rows);
+
+#endif
@@ -0,0 +1,550 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "parse.h"
+#include "json.h"
+#include "export.h"
+#include "names.h"
+
+typedef struct Export {
+    Elf *elf;
+    json_t j;
+    int format;
+    parse_filter_t *filter;
+    uint16_t machine;
+    int shnum;
+    int phnum;
+} export_t;
+
+static const char *symbol_type(int type) {
+    static const char *names[] = {"NOTYPE", "OBJECT", "FUNC", "SECTION", "FILE", "COMMON", "TLS"};
+    if (type == STT_GNU_IFUNC) {
+        return "IFUNC";
+    }
+    return type < sizeof(names) / sizeof(names[0])? names[type]: NULL;
+}
+
+static const char *symbol_bind(int bind) {
+    static const char *names[] = {"LOCAL", "GLOBAL", "WEAK"};
+    if (bind == STB_GNU_UNIQUE) {
+        return "UNIQUE";
+    }
+    return bind < sizeof(names) / sizeof(names[0])? names[bind]: NULL;
+}
+
+/* a string of the file, NULL when it runs off the end */
+static const char *string_at(Elf *elf, uint64_t offset) {
+    if (offset >= elf->size || !memchr(elf->mem + offset, 0, elf->size - offset)) {
+        return NULL;
+    }
+    return (const char *)elf->mem + offset;
+}
+
+/* ndjson tags every record, json collects them in an array */
+static void table_begin(export_t *e, const char *name) {
+    if (e->format == EXPORT_JSON) {
+        json_key(&e->j, name);
+        json_array_begin(&e->j);
+    }
+}
+
+static void table_end(export_t *e) {
+    if (e->format == EXPORT_JSON) {
+        json_array_end(&e->j);
+    }
+}
+
+static void record_begin(export_t *e, const char *table) {
+    json_object_begin(&e->j);
+    if (e->format == EXPORT_NDJSON) {
+        JSON_KV_STRING(&e->j, "table", table);
+    }
+}
+
+static void record_end(export_t *e) {
+    json_object_end(&e->j);
+    if (e->format == EXPORT_NDJSON) {
+        json_newline(&e->j);
+    }
+}
+
+static void export_header(export_t *e) {
+    Elf64_Ehdr *ehdr = (Elf64_Ehdr *)e->elf->mem;
+    Elf64_Ehdr h;
+
+    /* the fields after e_entry move with the class */
+    memcpy(h.e_ident, ehdr->e_ident, EI_NIDENT);
+    h.e_type = ehdr->e_type;
+    h.e_machine = ehdr->e_machine;
+    h.e_version = ehdr->e_version;
+    if (e->elf->class == ELFCLASS32) {
+        Elf32_Ehdr *h32 = e->elf->data.elf32.ehdr;
+        h.e_entry = h32->e_entry; h.e_phoff = h32->e_phoff; h.e_shoff = h32->e_shoff; h.e_flags = h32->e_flags;
+        h.e_ehsize = h32->e_ehsize; h.e_phentsize = h32->e_phentsize; h.e_phnum = h32->e_phnum;
+        h.e_shentsize = h32->e_shentsize; h.e_shnum = h32->e_shnum; h.e_shstrndx = h32->e_shstrndx;
+    } else {
+        memcpy(&h, ehdr, sizeof(h));
+    }
+
+    if (e->format == EXPORT_JSON) {
+        json_key(&e->j, "header");
+    }
+    record_begin(e, "header");
+    JSON_KV_UINT(&e->j, "class", h.e_ident[EI_CLASS] == ELFCLASS32? 32: 64);
+    JSON_KV_STRING(&e->j, "data", h.e_ident[EI_DATA] == ELFDATA2MSB? "big": "little");
+    JSON_KV_UINT(&e->j, "osabi", h.e_ident[EI_OSABI]);
+    JSON_KV_UINT(&e->j, "abiversion", h.e_ident[EI_ABIVERSION]);
+    JSON_KV_UINT(&e->j, "type", h.e_type);
+    JSON_KV_UINT(&e->j, "machine", h.e_machine);
+    if (machine_name(h.e_machine)) {
+        JSON_KV_STRING(&e->j, "machine_name", machine_name(h.e_machine));
+    }
+    JSON_KV_UINT(&e->j, "version", h.e_version);
+    JSON_KV_HEX(&e->j, "entry", h.e_entry);
+    JSON_KV_HEX(&e->j, "phoff", h.e_phoff);
+    JSON_KV_HEX(&e->j, "shoff", h.e_shoff);
+    JSON_KV_HEX(&e->j, "flags", h.e_flags);
+    JSON_KV_UINT(&e->j, "ehsize", h.e_ehsize);
+    JSON_KV_UINT(&e->j, "phentsize", h.e_phentsize);
+    JSON_KV_UINT(&e->j, "phnum", h.e_phnum);
+    JSON_KV_UINT(&e->j, "shentsize", h.e_shentsize);
+    JSON_KV_UINT(&e->j, "shnum", h.e_shnum);
+    JSON_KV_UINT(&e->j, "shstrndx", h.e_shstrndx);
+    record_end(e);
+}
+
+static void export_sections(export_t *e) {
+    table_begin(e, "sections");
+    for (int i = 0; i < e->shnum; i++) {
+        Elf64_Shdr shdr;
+        get_section_by_index(e->elf, i, &shdr);
+        record_begin(e, "section");
+        JSON_KV_UINT(&e->j, "index", i);
+        JSON_KV_STRING(&e->j, "name", get_section_name(e->elf, i));
+        JSON_KV_UINT(&e->j, "type", shdr.sh_type);
+        JSON_KV_STRING(&e->j, "type_name", section_type_name(shdr.sh_type));
+        JSON_KV_HEX(&e->j, "flags", shdr.sh_flags);
+        JSON_KV_HEX(&e->j, "addr", shdr.sh_addr);
+        JSON_KV_HEX(&e->j, "offset", shdr.sh_offset);
+        JSON_KV_UINT(&e->j, "size", shdr.sh_size);
+        JSON_KV_UINT(&e->j, "link", shdr.sh_link);
+        JSON_KV_UINT(&e->j, "info", shdr.sh_info);
+        JSON_KV_UINT(&e->j, "addralign", shdr.sh_addralign);
+        JSON_KV_UINT(&e->j, "entsize", shdr.sh_entsize);
+        record_end(e);
+    }
+    table_end(e);
+}
+
+static void export_segments(export_t *e) {
+    table_begin(e, "segments");
+    for (int i = 0; i < e->phnum; i++) {
+        Elf64_Phdr phdr;
+        get_segment_by_index(e->elf, i, &phdr);
+        record_begin(e, "segment");
+        JSON_KV_UINT(&e->j, "index", i);
+        JSON_KV_UINT(&e->j, "type", phdr.p_type);
+        JSON_KV_STRING(&e->j, "type_name", segment_type_name(phdr.p_type));
+        JSON_KV_HEX(&e->j, "offset", phdr.p_offset);
+        JSON_KV_HEX(&e->j, "vaddr", phdr.p_vaddr);
+        JSON_KV_HEX(&e->j, "paddr", phdr.p_paddr);
+        JSON_KV_UINT(&e->j, "filesz", phdr.p_filesz);
+        JSON_KV_UINT(&e->j, "memsz", phdr.p_memsz);
+        JSON_KV_UINT(&e->j, "flags", phdr.p_flags);
+        JSON_KV_UINT(&e->j, "align", phdr.p_align);
+        record_end(e);
+    }
+    table_end(e);
+}
+
+static void export_symbols(export_t *e, uint32_t type, const char *key) {
+    size_t symsize = e->elf->class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+
+    table_begin(e, key);
+    for (int i = 0; i < e->shnum; i++) {
+        Elf64_Shdr shdr, strtab;
+        get_section_by_index(e->elf, i, &shdr);
+        if (shdr.sh_type != type || shdr.sh_offset + shdr.sh_size > e->elf->size || shdr.sh_link >= e->shnum) {
+            continue;
+        }
+        get_section_by_index(e->elf, shdr.sh_link, &strtab);
+        const char *section = get_section_name(e->elf, i);
+        for (size_t k = 0; k < shdr.sh_size / symsize; k++) {
+            Elf64_Sym sym;
+            get_sym_by_table(e->elf, e->elf->mem + shdr.sh_offset, k, &sym);
+            const char *name = string_at(e->elf, strtab.sh_offset + sym.st_name);
+            if (!filter_sym(e->filter, k, name, &sym)) {
+                continue;
+            }
+            record_begin(e, "symbol");
+            JSON_KV_STRING(&e->j, "section", section);
+            JSON_KV_UINT(&e->j, "index", k);
+            JSON_KV_STRING(&e->j, "name", name);
+            JSON_KV_HEX(&e->j, "value", sym.st_value);
+            JSON_KV_UINT(&e->j, "size", sym.st_size);
+            JSON_KV_STRING(&e->j, "type", symbol_type(ELF64_ST_TYPE(sym.st_info)));
+            JSON_KV_STRING(&e->j, "bind", symbol_bind(ELF64_ST_BIND(sym.st_info)));
+            JSON_KV_UINT(&e->j, "visibility", ELF64_ST_VISIBILITY(sym.st_other));
+            JSON_KV_UINT(&e->j, "shndx", sym.st_shndx);
+            record_end(e);
+        }
+    }
+    table_end(e);
+}
+
+static void export_dynamic(export_t *e) {
+    int count = e->elf->class == ELFCLASS32? e->elf->data.elf32.dyn_count: e->elf->data.elf64.dyn_count;
+    uint64_t strtab = 0;
+
+    /* DT_STRTAB is an address, .dynstr is the fallback for a broken one */
+    for (int i = 0; i < count; i++) {
+        Elf64_Dyn dyn;
+        get_dyn_by_index(e->elf, i, &dyn);
+        if (dyn.d_tag == DT_STRTAB && vaddr_to_offset(e->elf, dyn.d_un.d_ptr, &strtab) != NO_ERR) {
+            strtab = 0;
+        }
+    }
+    if (!strtab) {
+        int index = get_section_index_by_name(e->elf, ".dynstr");
+        Elf64_Shdr shdr;
+        if (index > 0 && get_section_by_index(e->elf, index, &shdr) == NO_ERR) {
+            strtab = shdr.sh_offset;
+        }
+    }
+
+    table_begin(e, "dynamic");
+    for (int i = 0; i < count; i++) {
+        Elf64_Dyn dyn;
+        get_dyn_by_index(e->elf, i, &dyn);
+        record_begin(e, "dynamic");
+        JSON_KV_UINT(&e->j, "index", i);
+        JSON_KV_HEX(&e->j, "tag", dyn.d_tag);
+        if (dyn_tag_name(e->machine, dyn.d_tag)) {
+            JSON_KV_STRING(&e->j, "tag_name", dyn_tag_name(e->machine, dyn.d_tag));
+        }
+        JSON_KV_HEX(&e->j, "value", dyn.d_un.d_val);
+        if (strtab && (dyn.d_tag == DT_NEEDED || dyn.d_tag == DT_SONAME || dyn.d_tag == DT_RPATH || dyn.d_tag == DT_RUNPATH)) {
+            JSON_KV_STRING(&e->j, "string", string_at(e->elf, strtab + dyn.d_un.d_val));
+        }
+        record_end(e);
+        if (dyn.d_tag == DT_NULL) {
+            break;
+        }
+    }
+    table_end(e);
+}
+
+static void export_relocations(export_t *e) {
+    size_t word = e->elf->class == ELFCLASS32? 4: 8;
+
+    table_begin(e, "relocations");
+    for (int i = 0; i < e->shnum; i++) {
+        Elf64_Shdr shdr, symtab, strtab;
+        get_section_by_index(e->elf, i, &shdr);
+        if ((shdr.sh_type != SHT_REL && shdr.sh_type != SHT_RELA) || shdr.sh_offset + shdr.sh_size > e->elf->size) {
+            continue;
+        }
+        size_t entsize = shdr.sh_type == SHT_RELA? word * 3: word * 2;
+        const char *section = get_section_name(e->elf, i);
+        bool has_symtab = shdr.sh_link && shdr.sh_link < e->shnum;
+        if (has_symtab) {
+            get_section_by_index(e->elf, shdr.sh_link, &symtab);
+            get_section_by_index(e->elf, symtab.sh_link < e->shnum? symtab.sh_link: 0, &strtab);
+        }
+
+        for (size_t k = 0; k < shdr.sh_size / entsize; k++) {
+            uint8_t *p = e->elf->mem + shdr.sh_offset + k * entsize;
+            uint64_t offset, info, sym, type;
+            int64_t addend = 0;
+            if (word == 4) {
+                offset = ((uint32_t *)p)[0];
+                info = ((uint32_t *)p)[1];
+                sym = ELF32_R_SYM(info);
+                type = ELF32_R_TYPE(info);
+                addend = shdr.sh_type == SHT_RELA? ((int32_t *)p)[2]: 0;
+            } else {
+                offset = ((uint64_t *)p)[0];
+                info = ((uint64_t *)p)[1];
+                sym = ELF64_R_SYM(info);
+                type = ELF64_R_TYPE(info);
+                addend = shdr.sh_type == SHT_RELA? ((int64_t *)p)[2]: 0;
+            }
+
+            const char *name = NULL;
+            if (sym && has_symtab && symtab.sh_entsize && sym < symtab.sh_size / symtab.sh_entsize) {
+                Elf64_Sym s;
+                get_sym_by_table(e->elf, e->elf->mem + symtab.sh_offset, sym, &s);
+                name = string_at(e->elf, strtab.sh_offset + s.st_name);
+            }
+            const char *type_name = reloc_type_name(e->machine, type);
+            if (!filter_rel(e->filter, k, offset, type, type_name, name)) {
+                continue;
+            }
+
+            record_begin(e, "relocation");
+            JSON_KV_STRING(&e->j, "section", section);
+            JSON_KV_UINT(&e->j, "index", k);
+            JSON_KV_HEX(&e->j, "offset", offset);
+            JSON_KV_UINT(&e->j, "type", type);
+            if (type_name) {
+                JSON_KV_STRING(&e->j, "type_name", type_name);
+            }
+            JSON_KV_UINT(&e->j, "symbol_index", sym);
+            if (name) {
+                JSON_KV_STRING(&e->j, "symbol", name);
+            }
+            if (shdr.sh_type == SHT_RELA) {
+                JSON_KV_INT(&e->j, "addend", addend);
+            }
+            record_end(e);
+        }
+    }
+    table_end(e);
+}
+
+/* a defined symbol, sorted by address and then by the order of the old linear scan */
+typedef struct SymAddr {
+    uint64_t addr;
+    size_t rank;
+    const char *name;
+} sym_addr_t;
+
+static int sym_addr_cmp(const void *a, const void *b) {
+    const sym_addr_t *x = a, *y = b;
+    if (x->addr != y->addr) {
+        return x->addr < y->addr? -1: 1;
+    }
+    return x->rank < y->rank? -1: x->rank > y->rank;
+}
+
+/**
+ * @brief 建立按地址排序的已定义符号索引，.symtab优先
+ * index the defined symbols by address, .symtab first
+ * @param elf elf
+ * @param count output, number of entries
+ * @return sorted index, NULL if there are none
+ */
+static sym_addr_t *symbol_index(Elf *elf, size_t *count) {
+    uint32_t types[] = {SHT_SYMTAB, SHT_DYNSYM};
+    int shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    sym_addr_t *index = NULL;
+    size_t n = 0, capacity = 0;
+
+    for (int t = 0; t < 2; t++) {
+        for (int i = 0; i < shnum; i++) {
+            Elf64_Shdr shdr, strtab;
+            get_section_by_index(elf, i, &shdr);
+            if (shdr.sh_type != types[t] || !shdr.sh_entsize || shdr.sh_link >= shnum ||
+                shdr.sh_offset + shdr.sh_size > elf->size) {
+                continue;
+            }
+            get_section_by_index(elf, shdr.sh_link, &strtab);
+            size_t entries = shdr.sh_size / shdr.sh_entsize;
+            if (n + entries > capacity) {
+                capacity = n + entries;
+                sym_addr_t *tmp = realloc(index, capacity * sizeof(sym_addr_t));
+                if (!tmp) {
+                    free(index);
+                    *count = 0;
+                    return NULL;
+                }
+                index = tmp;
+            }
+            for (size_t k = 1; k < entries; k++) {
+                Elf64_Sym sym;
+                get_sym_by_table(elf, elf->mem + shdr.sh_offset, k, &sym);
+                if (sym.st_shndx != SHN_UNDEF && sym.st_name) {
+                    index[n].addr = sym.st_value;
+                    index[n].rank = n;
+                    index[n++].name = string_at(elf, strtab.sh_offset + sym.st_name);
+                }
+            }
+        }
+    }
+    qsort(index, n, sizeof(sym_addr_t), sym_addr_cmp);
+    *count = n;
+    return index;
+}
+
+/* the name of a defined symbol at addr, the first one the index recorded */
+static const char *symbol_at(const sym_addr_t *index, size_t count, uint64_t addr) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index[mid].addr < addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < count && index[lo].addr == addr? index[lo].name: NULL;
+}
+
+static void export_pointers(export_t *e) {
+    const char *names[] = {".init_array", ".fini_array", ".preinit_array", ".ctors", ".dtors"};
+    size_t word = e->elf->class == ELFCLASS32? 4: 8;
+    sym_addr_t *symbols = NULL;
+    size_t count = 0;
+    bool indexed = false;
+
+    table_begin(e, "pointers");
+    for (int n = 0; n < sizeof(names) / sizeof(names[0]); n++) {
+        int index = get_section_index_by_name(e->elf, (char *)names[n]);
+        Elf64_Shdr shdr;
+        if (index <= 0 || get_section_by_index(e->elf, index, &shdr) != NO_ERR ||
+            shdr.sh_type == SHT_NOBITS || shdr.sh_offset + shdr.sh_size > e->elf->size) {
+            continue;
+        }
+        for (size_t k = 0; k < shdr.sh_size / word; k++) {
+            uint8_t *p = e->elf->mem + shdr.sh_offset + k * word;
+            uint64_t value = word == 4? *(uint32_t *)p: *(uint64_t *)p;
+            record_begin(e, "pointer");
+            JSON_KV_STRING(&e->j, "section", names[n]);
+            JSON_KV_UINT(&e->j, "index", k);
+            JSON_KV_HEX(&e->j, "addr", shdr.sh_addr + k * word);
+            JSON_KV_HEX(&e->j, "value", value);
+            if (value && !indexed) {
+                symbols = symbol_index(e->elf, &count);
+                indexed = true;
+            }
+            JSON_KV_STRING(&e->j, "symbol", value? symbol_at(symbols, count, value): NULL);
+            record_end(e);
+        }
+    }
+    free(symbols);
+    table_end(e);
+}
+
+static void export_hash(export_t *e) {
+    size_t word = e->elf->class == ELFCLASS32? 4: 8;
+    int index = -1, dynsym = get_section_index_by_name(e->elf, ".dynsym");
+    Elf64_Shdr shdr, symtab;
+
+    for (int i = 0; i < e->shnum; i++) {
+        get_section_by_index(e->elf, i, &shdr);
+        if (shdr.sh_type == SHT_GNU_HASH) {
+            index = i;
+            break;
+        }
+    }
+    if (e->format == EXPORT_JSON) {
+        json_key(&e->j, "gnu_hash");
+    }
+    gnuhash_t *hash = (gnuhash_t *)(e->elf->mem + shdr.sh_offset);
+    uint64_t end = shdr.sh_offset + shdr.sh_size, nsyms = 0;
+    if (index < 0 || shdr.sh_size < 16 || end > e->elf->size ||
+        16 + (uint64_t)hash->maskbits * word + (uint64_t)hash->nbuckets * 4 > shdr.sh_size) {
+        if (e->format == EXPORT_JSON) {
+            json_null(&e->j);
+        }
+        return;
+    }
+
+    uint8_t *bloom = (uint8_t *)hash->buckets;
+    uint32_t *buckets = (uint32_t *)(bloom + (uint64_t)hash->maskbits * word);
+    uint32_t *chain = buckets + hash->nbuckets;
+    if (dynsym > 0 && get_section_by_index(e->elf, dynsym, &symtab) == NO_ERR && symtab.sh_entsize) {
+        nsyms = symtab.sh_size / symtab.sh_entsize;
+    }
+
+    record_begin(e, "gnu_hash");
+    JSON_KV_HEX(&e->j, "offset", shdr.sh_offset);
+    JSON_KV_UINT(&e->j, "nbuckets", hash->nbuckets);
+    JSON_KV_UINT(&e->j, "symndx", hash->symndx);
+    JSON_KV_UINT(&e->j, "maskbits", hash->maskbits);
+    JSON_KV_UINT(&e->j, "shift", hash->shift);
+    json_key(&e->j, "bloom");
+    json_array_begin(&e->j);
+    for (uint32_t i = 0; i < hash->maskbits; i++) {
+        json_hex(&e->j, word == 4? ((uint32_t *)bloom)[i]: ((uint64_t *)bloom)[i]);
+    }
+    json_array_end(&e->j);
+    json_key(&e->j, "buckets");
+    json_array_begin(&e->j);
+    for (uint32_t i = 0; i < hash->nbuckets; i++) {
+        json_uint(&e->j, buckets[i]);
+    }
+    json_array_end(&e->j);
+    json_key(&e->j, "chain");
+    json_array_begin(&e->j);
+    for (uint64_t i = hash->symndx; i < nsyms && (uint8_t *)&chain[i - hash->symndx + 1] - e->elf->mem <= end; i++) {
+        json_hex(&e->j, chain[i - hash->symndx]);
+    }
+    json_array_end(&e->j);
+    record_end(e);
+}
+
+int parse_export(Elf *elf, parser_opt_t *po, int format) {
+    export_t e;
+    memset(&e, 0, sizeof(e));
+    e.elf = elf;
+    e.format = format;
+    e.filter = &po->filter;
+    e.machine = ((Elf64_Ehdr *)elf->mem)->e_machine;
+    e.shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    e.phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    if (elf->class != ELFCLASS32 && elf->class != ELFCLASS64) {
+        return ERR_ELF_CLASS;
+    }
+    if ((uint64_t)(elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shoff: elf->data.elf64.ehdr->e_shoff) +
+        (uint64_t)e.shnum * (elf->class == ELFCLASS32? sizeof(Elf32_Shdr): sizeof(Elf64_Shdr)) > elf->size) {
+        e.shnum = 0;
+    }
+
+    json_init(&e.j, stdout);
+    /* a json document may be flushed in pieces, ndjson records are written whole */
+    e.j.stream = format == EXPORT_JSON;
+    if (format == EXPORT_JSON) {
+        json_object_begin(&e.j);
+    }
+    if (!get_option(po, HEADERS) || !get_option(po, ALL))
+        export_header(&e);
+    if (!get_option(po, SECTIONS) || !get_option(po, ALL))
+        export_sections(&e);
+    if (!get_option(po, SEGMENTS) || !get_option(po, ALL))
+        export_segments(&e);
+    if (!get_option(po, DYNSYM) || !get_option(po, ALL))
+        export_symbols(&e, SHT_DYNSYM, "dynsym");
+    if (!get_option(po, SYMTAB) || !get_option(po, ALL))
+        export_symbols(&e, SHT_SYMTAB, "symtab");
+    if (!get_option(po, LINK) || !get_option(po, ALL))
+        export_dynamic(&e);
+    if (!get_option(po, RELA) || !get_option(po, ALL))
+        export_relocations(&e);
+    if (!get_option(po, POINTER) || !get_option(po, ALL))
+        export_pointers(&e);
+    if (!get_option(po, GNUHASH) || !get_option(po, ALL))
+        export_hash(&e);
+    if (format == EXPORT_JSON) {
+        json_object_end(&e.j);
+        json_newline(&e.j);
+    }
+    json_fini(&e.j);
+    return NO_ERR;
+}
@@ -0,0 +1,44 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef __EXPORT_H
+#define __EXPORT_H
+
+enum EXPORT_FORMAT {
+    EXPORT_JSON,            // one document, each table is an array
+    EXPORT_NDJSON,          // one record per line, tagged with "table"
+};
+
+/**
+ * @brief 以JSON或NDJSON输出parse的各个表，记录通过缓冲写入器流式输出，内存占用与表的大小无关
+ * write the parse tables as JSON or NDJSON. Records are streamed through the
+ * buffered writer, so memory does not grow with the size of the tables
+ * @param elf elf file custom structure
+ * @param po parser options, the same tables as the text output
+ * @param format enum EXPORT_FORMAT
+ * @return error code
+ */
+int parse_export(Elf *elf, parser_opt_t *po, int format);
+
+#endif
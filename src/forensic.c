@@ -7,82 +7,11 @@
 #include <sys/mman.h>
 #include <elf.h>
 #include <stdbool.h>
+#include <pthread.h>
 #include "lib/elfutil.h"
 #include "lib/util.h"
-
-enum ELF_TYPE {
-    ELF_STATIC,
-    ELF_EXE_NOW,
-    ELF_EXE_LAZY,
-    ELF_SHARED
-};
-
-/**
- * @brief elf类型
- * get elf type
- * @param h32 elf file handle struct
- * @param h64 elf file handle struct
- * @return int error code {-1:error,elf type}
- */
-int get_elf_type(Elf *elf) {
-    int has_dynamic = 0;
-    if (elf->class == ELFCLASS32) {
-        Elf32_Dyn *dyn = NULL;
-        uint32_t dyn_c;
-        for (int i = 0; i < elf->data.elf32.ehdr->e_phnum; i++) {
-            if (elf->data.elf32.phdr[i].p_type == PT_DYNAMIC) {
-                has_dynamic = 1;
-                dyn = (Elf32_Dyn *)(elf->mem + elf->data.elf32.phdr[i].p_offset);
-                dyn_c = elf->data.elf32.phdr[i].p_filesz / sizeof(Elf32_Dyn);
-                break;
-            }
-        }
-        if (!has_dynamic && elf->data.elf32.ehdr->e_type == ET_EXEC) {
-            return ELF_STATIC;
-        }
-        else if (has_dynamic && elf->data.elf32.ehdr->e_type == ET_DYN) {
-            for (int i = 0; i < dyn_c; i++) {
-                if (dyn[i].d_tag == DT_FLAGS_1) {
-                    if (has_flag(dyn[i].d_un.d_val, DF_1_NOW))
-                        return ELF_EXE_NOW;
-                    else
-                        return ELF_EXE_LAZY;
-                    break;
-                }
-            }
-            return ELF_SHARED;
-        }
-    }
-    if (elf->class == ELFCLASS64) {
-        Elf64_Dyn *dyn = NULL;
-        uint64_t dyn_c;
-        for (int i = 0; i < elf->data.elf64.ehdr->e_phnum; i++) {
-            if (elf->data.elf64.phdr[i].p_type == PT_DYNAMIC) {
-                has_dynamic = 1;
-                dyn = (Elf64_Dyn *)(elf->mem + elf->data.elf64.phdr[i].p_offset);
-                dyn_c = elf->data.elf64.phdr[i].p_filesz / sizeof(Elf64_Dyn);
-                break;
-            }
-        }
-        if (!has_dynamic && elf->data.elf64.ehdr->e_type == ET_EXEC) {
-            return ELF_STATIC;
-        }
-        else if (has_dynamic && elf->data.elf64.ehdr->e_type == ET_DYN) {
-            for (int i = 0; i < dyn_c; i++) {
-                if (dyn[i].d_tag == DT_FLAGS_1) {
-                    if (has_flag(dyn[i].d_un.d_val, DF_1_NOW))
-                        return ELF_EXE_NOW;
-                    else
-                        return ELF_EXE_LAZY;
-                    break;
-                }
-            }
-            return ELF_SHARED;
-        }
-    } else {
-        return ERR_ELF_CLASS;
-    }
-}
+#include "forensic.h"
+#include "rule.h"
 
 /**
  * @brief 检查hook外部函数
@@ -453,6 +382,23 @@ int check_interpreter(Elf *elf) {
     return ret;
 }
 
+static void print_rule(void *arg, const rule_t *rule, rule_result_t *result) {
+    switch (result->severity) {
+        case RULE_PASS:
+            CHECK_COMMON("|%-20s|%1s| %-50s|\n", rule->name, "✓", result->evidence);
+            break;
+        case RULE_WARN:
+            CHECK_WARNING("|%-20s|%1s| %-50s|\n", rule->name, "!", result->evidence);
+            break;
+        case RULE_FAIL:
+            CHECK_ERROR("|%-20s|%1s| %-50s|\n", rule->name, "✗", result->evidence);
+            break;
+        default:
+            CHECK_COMMON("|%-20s|%1s| %-50s|\n", rule->name, "-", result->evidence);
+            break;
+    }
+}
+
 /**
  * @brief 检查elf文件是否合法
  * check if the elf file is legal
@@ -462,9 +408,13 @@ int check_interpreter(Elf *elf) {
 int checksec_t0(Elf *elf) {
     char *mode, *tmp, *bind;
     char elf_info[1000];
+    facts_t facts;
     int err;
-    enum ELF_TYPE type;
-    type = get_elf_type(elf);
+
+    err = facts_collect(elf, &facts);
+    if (err != NO_ERR) {
+        return err;
+    }
     if (elf->class == ELFCLASS32) {
         mode = "32-bit";
     } else if (elf->class == ELFCLASS64) {
@@ -472,230 +422,366 @@ int checksec_t0(Elf *elf) {
     } else {
         mode = "Known";
     }
-    if (type == ELF_EXE_LAZY) {
+    if (facts.type == ELF_EXE_LAZY) {
         bind = "bind lazy";
-        tmp = "pie executable";
-    } else if (type == ELF_EXE_NOW) {
+        tmp = facts.e_type == ET_DYN? "pie executable": "executable";
+    } else if (facts.type == ELF_EXE_NOW) {
         bind = "bind now";
-        tmp = "pie executable";
-    } else if (type == ELF_SHARED) {
+        tmp = facts.e_type == ET_DYN? "pie executable": "executable";
+    } else if (facts.type == ELF_SHARED) {
         bind = "dynamically linked";
         tmp = "shared object";
-    } else if (type == ELF_STATIC) {
+    } else {
         bind = "statically linked";
         tmp = "executable";
     }
     snprintf(elf_info, 1000, "ELF %s %s, %s", mode, tmp, bind);
     printf("%s\n", elf_info);
 
-    char TAG[50];
     printf("|--------------------------------------------------------------------------|\n");
     printf("|%-20s|%1s| %-50s|\n", "checkpoint", "s", "description");
     printf("|--------------------------------------------------------------------------|\n");
-    /* check entry */
-    strcpy(TAG, "entry point");
-    uint64_t entry = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_entry:elf->data.elf64.ehdr->e_entry;
-    uint64_t addr = get_section_addr_by_name(elf, ".text");
-    size_t size = get_section_size_by_name(elf, ".text");
-    if (type == ELF_SHARED && entry == 0) {
-        CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(shared library)");
-    }
-    else if (entry == addr) {
-        CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-    } else if (entry > addr && entry < addr + size) {
-        CHECK_WARNING("|%-20s|%1s| %-50s|\n", TAG, "!", "is NOT at the start of the .TEXT section");
-    } else {
-        CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "is NOT inside the .TEXT section");
-    }
+    rule_run(&facts, print_rule, NULL);
+    printf("|--------------------------------------------------------------------------|\n");
+    facts_fini(&facts);
+    return 0;
+}
 
-    /* check plt/got hook (lazy bind) */
-    strcpy(TAG, "hook in .got.plt");
-    if (type == ELF_SHARED) {
-        CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(shared library)");
-    } else if (type == ELF_STATIC) {
-        CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(statically linked)");
-    } else {
-        addr = get_section_addr_by_name(elf, ".plt");
-        size = get_section_size_by_name(elf, ".plt");
-        err = check_hook(elf, addr, size);
-        switch (err)
-        {
-            case true:
-                CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-                break;
+#ifndef PT_GNU_PROPERTY
+#define PT_GNU_PROPERTY 0x6474e553
+#endif
+#ifndef NT_GNU_PROPERTY_TYPE_0
+#define NT_GNU_PROPERTY_TYPE_0 5
+#endif
+#ifndef DF_1_PIE
+#define DF_1_PIE 0x08000000
+#endif
+#define GNU_PROPERTY_X86_FEATURE_1 0xc0000002
+#define GNU_PROPERTY_AARCH64_FEATURE_1 0xc0000000
+
+/* functions which have a fortified __*_chk variant in glibc */
+static const char *fortify_names[] = {
+    "memcpy", "memmove", "mempcpy", "memset", "stpcpy", "stpncpy", "strcat", "strcpy",
+    "strncat", "strncpy", "strlcpy", "strlcat", "sprintf", "vsprintf", "snprintf", "vsnprintf",
+    "printf", "vprintf", "fprintf", "vfprintf", "dprintf", "vdprintf", "asprintf", "vasprintf",
+    "obstack_printf", "obstack_vprintf", "syslog", "vsyslog", "fgets", "fgets_unlocked",
+    "fread", "fread_unlocked", "gets", "read", "pread", "pread64", "recv", "recvfrom",
+    "readlink", "readlinkat", "getcwd", "getwd", "realpath", "confstr", "getgroups",
+    "ttyname_r", "getlogin_r", "gethostname", "getdomainname", "ptsname_r", "wctomb",
+    "wcscpy", "wcpcpy", "wcsncpy", "wcpncpy", "wcscat", "wcsncat", "wcslcpy", "wcslcat",
+    "wmemcpy", "wmemmove", "wmempcpy", "wmemset", "swprintf", "vswprintf", "wprintf",
+    "fwprintf", "vwprintf", "vfwprintf", "fgetws", "fgetws_unlocked", "wcrtomb",
+    "mbsrtowcs", "mbsnrtowcs", "wcsrtombs", "wcsnrtombs", "mbstowcs", "wcstombs",
+    "poll", "ppoll", "explicit_bzero", "longjmp", "fdelt",
+};
 
-            case false:
-                CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", ".got.plt hook is detected");
-                break;
+#define FORTIFY_BUCKETS 256
+static const char *fortify_set[FORTIFY_BUCKETS];
+static pthread_once_t fortify_once = PTHREAD_ONCE_INIT;
 
-            default:
-                CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(bind now)");
-                break;
-        }
+/* same function as dl_new_hash, on a string of known length */
+static uint32_t name_hash(const char *s, size_t n) {
+    uint32_t h = 5381;
+    for (size_t i = 0; i < n; i++) {
+        h = (h << 5) + h + (unsigned char)s[i];
     }
-    
-
-    /* check load segment permission */
-    strcpy(TAG, "segment flags");
-    err = check_load_flags(elf);
-    switch (err)
-    {
-        case true:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-
-        case false:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "more than one executable segment");
-            break;
+    return h;
+}
 
-        default:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(no executable elf file)");
-            break;
+static void fortify_init() {
+    for (size_t i = 0; i < sizeof(fortify_names) / sizeof(fortify_names[0]); i++) {
+        uint32_t h = name_hash(fortify_names[i], strlen(fortify_names[i])) & (FORTIFY_BUCKETS - 1);
+        while (fortify_set[h]) {
+            h = (h + 1) & (FORTIFY_BUCKETS - 1);
+        }
+        fortify_set[h] = fortify_names[i];
     }
+}
 
-    /* check segment continuity */
-    strcpy(TAG, "segment continuity");
-    err = check_load_continuity(elf);
-    switch (err)
-    {
-        case true:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-
-        case false:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "load segments are NOT continuous");
-            break;
-
-        default:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na");
-            break;
+static bool is_fortify_name(const char *s, size_t n) {
+    uint32_t h = name_hash(s, n) & (FORTIFY_BUCKETS - 1);
+    while (fortify_set[h]) {
+        if (!strncmp(fortify_set[h], s, n) && fortify_set[h][n] == '\0') {
+            return true;
+        }
+        h = (h + 1) & (FORTIFY_BUCKETS - 1);
     }
+    return false;
+}
 
-    /* check DLL injection */
-    strcpy(TAG, "DLL injection");
-    err = check_needed_continuity(elf);
-    switch (err)
-    {
-        case true:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-
-        case false:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "DT_NEEDED libraries are NOT continuous");
-            break;
-
-        default:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(statically linked)");
-            break;
+/* check one symbol name for stack protector and fortify functions */
+static void classify_symbol(secinfo_t *info, const char *name) {
+    size_t n = strlen(name);
+    if (n < 3) {
+        return;
+    }
+    if (!strcmp(name, "__stack_chk_fail") || !strcmp(name, "__stack_chk_guard") ||
+        !strcmp(name, "__intel_security_cookie")) {
+        info->canary = true;
+    } else if (n > 6 && name[0] == '_' && name[1] == '_' && !strcmp(name + n - 4, "_chk")) {
+        if (is_fortify_name(name + 2, n - 6)) {
+            info->fortified++;
+        }
+    } else if (is_fortify_name(name, n)) {
+        info->fortifiable++;
     }
+}
 
-    /* check section header table */
-    strcpy(TAG, "section header table");
-    err = check_shdr(elf);
-    switch (err)
-    {
-        case 0:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-        
-        case 1:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "NO section header table");
-            break;
+/* walk the notes of [offset, offset + size) for GNU properties */
+static void parse_properties(Elf *elf, secinfo_t *info, uint16_t machine, uint64_t offset, uint64_t size) {
+    size_t align = elf->class == ELFCLASS64? 8: 4;
+    uint64_t end = offset + size;
 
-        case 2:
-            CHECK_WARNING("|%-20s|%1s| %-50s|\n", TAG, "!", "is NOT at the end of the file");
-            break;
-        
-        default:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na");
-            break;
+    if (end > elf->size || end < offset) {
+        return;
     }
-
-    /* check .dynstr */
-    strcpy(TAG, "symbol injection");
-    err = check_dynstr(elf);
-    switch (err)
-    {
-        case true:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-        
-        case false:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "modified symbol is detected");
-            break;
-        
-        default:
-            CHECK_WARNING("|%-20s|%1s| %-50s|\n", TAG, "-", "na(no .dynstr section)");
-            break;
+    while (offset + 12 <= end) {
+        uint32_t *note = (uint32_t *)(elf->mem + offset);
+        uint32_t namesz = note[0], descsz = note[1], type = note[2];
+        uint64_t name = offset + 12;
+        uint64_t desc = name + ((namesz + 3) & ~3ULL);
+        uint64_t next = desc + ((descsz + align - 1) & ~(uint64_t)(align - 1));
+        if (desc + descsz > end || next <= offset) {
+            return;
+        }
+        if (type == NT_GNU_PROPERTY_TYPE_0 && namesz == 4 && !memcmp(elf->mem + name, "GNU", 4)) {
+            uint64_t p = desc;
+            while (p + 8 <= desc + descsz) {
+                uint32_t pr_type = *(uint32_t *)(elf->mem + p);
+                uint32_t pr_size = *(uint32_t *)(elf->mem + p + 4);
+                if (p + 8 + pr_size > desc + descsz) {
+                    break;
+                }
+                if (pr_size >= 4) {
+                    uint32_t bits = *(uint32_t *)(elf->mem + p + 8);
+                    if ((machine == EM_X86_64 || machine == EM_386) && pr_type == GNU_PROPERTY_X86_FEATURE_1) {
+                        if (bits & 1) info->cet |= SEC_CET_IBT;
+                        if (bits & 2) info->cet |= SEC_CET_SHSTK;
+                    } else if (machine == EM_AARCH64 && pr_type == GNU_PROPERTY_AARCH64_FEATURE_1) {
+                        if (bits & 1) info->cet |= SEC_ARM_BTI;
+                        if (bits & 2) info->cet |= SEC_ARM_PAC;
+                    }
+                }
+                p += 8 + ((pr_size + align - 1) & ~(uint64_t)(align - 1));
+            }
+        }
+        offset = next;
     }
+}
 
-    /* check .interp */
-    strcpy(TAG, "interp injection");
-    err = check_interpreter(elf);
-    switch (err)
-    {
-        case true:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "✓", "normal");
-            break;
-        
-        case false:
-            CHECK_ERROR("|%-20s|%1s| %-50s|\n", TAG, "✗", "modified interpreter is detected");
-            break;
-        
-        default:
-            CHECK_COMMON("|%-20s|%1s| %-50s|\n", TAG, "-", "na(no .interp section)");
-            break;
+int checksec_collect(Elf *elf, secinfo_t *info) {
+    Elf64_Phdr phdr;
+    Elf64_Shdr shdr;
+    Elf64_Dyn dyn;
+    Elf64_Sym sym;
+    bool interp = false, dynamic = false, bind_now = false, pie_flag = false;
+    bool property = false;
+    uint64_t dyn_off = 0, dyn_size = 0;
+    uint16_t type, machine;
+    int phnum, shnum;
+
+    pthread_once(&fortify_once, fortify_init);
+    memset(info, 0, sizeof(secinfo_t));
+    info->class = elf->class;
+    if (elf->class == ELFCLASS32) {
+        type = elf->data.elf32.ehdr->e_type;
+        machine = elf->data.elf32.ehdr->e_machine;
+        phnum = elf->data.elf32.ehdr->e_phnum;
+        shnum = elf->data.elf32.ehdr->e_shnum;
+    } else if (elf->class == ELFCLASS64) {
+        type = elf->data.elf64.ehdr->e_type;
+        machine = elf->data.elf64.ehdr->e_machine;
+        phnum = elf->data.elf64.ehdr->e_phnum;
+        shnum = elf->data.elf64.ehdr->e_shnum;
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    size_t dynent = elf->class == ELFCLASS32? sizeof(Elf32_Dyn): sizeof(Elf64_Dyn);
+
+    /* program headers; no PT_GNU_STACK means an executable stack */
+    for (int i = 0; i < phnum; i++) {
+        get_segment_by_index(elf, i, &phdr);
+        switch (phdr.p_type) {
+            case PT_INTERP: interp = true; break;
+            case PT_DYNAMIC:
+                dynamic = true;
+                dyn_off = phdr.p_offset;
+                dyn_size = phdr.p_filesz;
+                break;
+            case PT_GNU_STACK: info->nx = !(phdr.p_flags & PF_X); break;
+            case PT_GNU_RELRO: info->relro = 1; break;
+            case PT_GNU_PROPERTY:
+                property = true;
+                parse_properties(elf, info, machine, phdr.p_offset, phdr.p_filesz);
+                break;
+            default: break;
+        }
+    }
+    /* older linkers only emit the property note inside PT_NOTE */
+    for (int i = 0; i < phnum && !property; i++) {
+        get_segment_by_index(elf, i, &phdr);
+        if (phdr.p_type == PT_NOTE) {
+            parse_properties(elf, info, machine, phdr.p_offset, phdr.p_filesz);
+        }
     }
 
-    printf("|--------------------------------------------------------------------------|\n");
-    return 0;
-}
+    /* .dynamic */
+    if (dynamic && dyn_off + dyn_size <= elf->size) {
+        int count = dyn_size / dynent;
+        for (int i = 0; i < count; i++) {
+            get_dyn_by_index(elf, i, &dyn);
+            switch (dyn.d_tag) {
+                case DT_NULL: i = count; break;
+                case DT_BIND_NOW: bind_now = true; break;
+                case DT_FLAGS: if (dyn.d_un.d_val & DF_BIND_NOW) bind_now = true; break;
+                case DT_FLAGS_1:
+                    if (dyn.d_un.d_val & DF_1_NOW) bind_now = true;
+                    if (dyn.d_un.d_val & DF_1_PIE) pie_flag = true;
+                    break;
+                case DT_RPATH: info->rpath = true; break;
+                case DT_RUNPATH: info->runpath = true; break;
+                default: break;
+            }
+        }
+    }
 
-int checksec_t1(Elf *elf) {
-    int err = 0;
-    bool flag = false;
-    err = check_pie(elf, &flag);
-    if (err == NO_ERR) {
-        if (flag)
-            CHECK_INFO("%-15s%-10s\n", "PIE", "Enabled");
-        else
-            CHECK_ERROR("%-15s%-10s\n", "PIE", "No");
+    /* symbol tables, undefined dynamic symbols are imports */
+    for (int i = 0; i < shnum; i++) {
+        get_section_by_index(elf, i, &shdr);
+        if (shdr.sh_type != SHT_SYMTAB && shdr.sh_type != SHT_DYNSYM) {
+            continue;
+        }
+        size_t entsize = elf->class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+        Elf64_Shdr strtab;
+        if (shdr.sh_offset + shdr.sh_size > elf->size ||
+            get_section_by_index(elf, shdr.sh_link, &strtab) != NO_ERR ||
+            strtab.sh_offset + strtab.sh_size > elf->size) {
+            continue;
+        }
+        uint32_t count = shdr.sh_size / entsize;
+        if (shdr.sh_type == SHT_SYMTAB) {
+            info->symtab_count += count;
+        } else {
+            info->dynsym_count += count;
+        }
+        /* .symtab is only needed when there are no imports, e.g. static binaries */
+        if (shdr.sh_type == SHT_SYMTAB && dynamic) {
+            continue;
+        }
+        for (uint32_t j = 1; j < count; j++) {
+            get_sym_by_table(elf, elf->mem + shdr.sh_offset, j, &sym);
+            if (sym.st_name >= strtab.sh_size) {
+                continue;
+            }
+            char *name = (char *)elf->mem + strtab.sh_offset + sym.st_name;
+            /* libc defines the stack protector itself */
+            if (shdr.sh_type == SHT_DYNSYM && sym.st_shndx != SHN_UNDEF) {
+                if (!strcmp(name, "__stack_chk_fail")) {
+                    info->canary = true;
+                }
+                continue;
+            }
+            classify_symbol(info, name);
+        }
+    }
+    info->stripped = info->symtab_count == 0;
+    info->fortify = info->fortified > 0;
+
+    /* elf type, an ET_DYN is an executable only with an interpreter or DF_1_PIE */
+    if (type == ET_EXEC) {
+        info->pie = false;
+    } else if (type == ET_DYN && (interp || pie_flag)) {
+        info->pie = true;
     } else {
-        CHECK_WARNING("parse PIE error\n");
+        info->pie = ERR_ELF_TYPE;
     }
-    
-    err = check_nx(elf, &flag);
-    if (err == NO_ERR) {
-        if (flag)
-            CHECK_INFO("%-15s%-10s\n", "NX", "Enabled");
-        else
-            CHECK_ERROR("%-15s%-10s\n", "NX", "No");
+    if (!dynamic && type == ET_EXEC) {
+        info->type = ELF_STATIC;
+    } else if (type == ET_DYN && !interp && !pie_flag) {
+        info->type = ELF_SHARED;
     } else {
-        CHECK_WARNING("parse NX error");
+        info->type = bind_now? ELF_EXE_NOW: ELF_EXE_LAZY;
+    }
+    if (info->relro && bind_now) {
+        info->relro = 2;
     }
 
-    err = check_cookie(elf, &flag);
-    if (err == NO_ERR) {
-        if (flag)
-            CHECK_INFO("%-15s%-10s\n", "STACK CANARY", "Enabled");
-        else
-            CHECK_ERROR("%-15s%-10s\n", "STACK CANARY", "No");
-    } else {
-        CHECK_WARNING("parse Cookie error\n");
+    /* .got.plt hook only makes sense for lazy binding */
+    info->hook = ERR_SEC_NOTFOUND;
+    if ((info->type == ELF_EXE_LAZY || info->type == ELF_EXE_NOW) &&
+        get_section_index_by_name(elf, ".got.plt") >= 0 &&
+        get_section_index_by_name(elf, elf->class == ELFCLASS32? ".rel.plt": ".rela.plt") >= 0) {
+        info->hook = check_hook(elf, get_section_addr_by_name(elf, ".plt"), get_section_size_by_name(elf, ".plt"));
     }
+    return NO_ERR;
+}
 
-    int result = 0;
-    err = check_relro(elf, &result);
-    if (err == NO_ERR) {
-        if (result == 2)
-            CHECK_INFO("%-15s%-10s\n", "RelRO", "Enabled");
-        else if (result == 1)
-            CHECK_WARNING("%-15s%-10s\n", "RelRO", "Partial Enabled");
-        else
-            CHECK_ERROR("%-15s%-10s\n", "RelRO", "No");
+int checksec_t1(Elf *elf) {
+    secinfo_t info;
+    int err = checksec_collect(elf, &info);
+    if (err != NO_ERR) {
+        CHECK_WARNING("parse error\n");
+        return err;
+    }
+
+    if (info.pie == true)
+        CHECK_INFO("%-15s%-10s\n", "PIE", "Enabled");
+    else if (info.pie == false)
+        CHECK_ERROR("%-15s%-10s\n", "PIE", "No");
+    else
+        CHECK_COMMON("%-15s%-10s\n", "PIE", "N/A");
+
+    if (info.nx)
+        CHECK_INFO("%-15s%-10s\n", "NX", "Enabled");
+    else
+        CHECK_ERROR("%-15s%-10s\n", "NX", "No");
+
+    if (info.canary)
+        CHECK_INFO("%-15s%-10s\n", "STACK CANARY", "Enabled");
+    else
+        CHECK_ERROR("%-15s%-10s\n", "STACK CANARY", "No");
+
+    if (info.relro == 2)
+        CHECK_INFO("%-15s%-10s\n", "RelRO", "Enabled");
+    else if (info.relro == 1)
+        CHECK_WARNING("%-15s%-10s\n", "RelRO", "Partial Enabled");
+    else
+        CHECK_ERROR("%-15s%-10s\n", "RelRO", "No");
+
+    if (info.fortify)
+        CHECK_INFO("%-15s%-10s(%u fortified, %u fortifiable)\n", "FORTIFY", "Enabled", info.fortified, info.fortifiable);
+    else
+        CHECK_ERROR("%-15s%-10s(%u fortifiable)\n", "FORTIFY", "No", info.fortifiable);
+
+    if (info.cet & (SEC_ARM_BTI | SEC_ARM_PAC)) {
+        CHECK_COMMON("%-15s%-10s\n", "BTI", info.cet & SEC_ARM_BTI? "Enabled": "No");
+        CHECK_COMMON("%-15s%-10s\n", "PAC", info.cet & SEC_ARM_PAC? "Enabled": "No");
     } else {
-        CHECK_WARNING("parse RelRO error\n");
+        if (info.cet & SEC_CET_IBT)
+            CHECK_INFO("%-15s%-10s\n", "CET IBT", "Enabled");
+        else
+            CHECK_ERROR("%-15s%-10s\n", "CET IBT", "No");
+        if (info.cet & SEC_CET_SHSTK)
+            CHECK_INFO("%-15s%-10s\n", "CET SHSTK", "Enabled");
+        else
+            CHECK_ERROR("%-15s%-10s\n", "CET SHSTK", "No");
     }
 
-    return err;
-}
\ No newline at end of file
+    if (info.rpath)
+        CHECK_WARNING("%-15s%-10s\n", "RPATH", "Yes");
+    else
+        CHECK_INFO("%-15s%-10s\n", "RPATH", "No");
+
+    if (info.runpath)
+        CHECK_WARNING("%-15s%-10s\n", "RUNPATH", "Yes");
+    else
+        CHECK_INFO("%-15s%-10s\n", "RUNPATH", "No");
+
+    if (info.stripped)
+        CHECK_COMMON("%-15s%-10s\n", "Stripped", "Yes");
+    else
+        CHECK_COMMON("%-15s%-10s\n", "Stripped", "No");
+    CHECK_COMMON("%-15s%u symbols, %u dynamic symbols\n", "Symbols", info.symtab_count, info.dynsym_count);
+
+    return NO_ERR;
+}
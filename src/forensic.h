@@ -1,3 +1,46 @@
+enum ELF_TYPE {
+    ELF_STATIC,
+    ELF_EXE_NOW,
+    ELF_EXE_LAZY,
+    ELF_SHARED
+};
+
+/* CET and BTI/PAC bits of .note.gnu.property */
+#define SEC_CET_IBT     0x1
+#define SEC_CET_SHSTK   0x2
+#define SEC_ARM_BTI     0x4
+#define SEC_ARM_PAC     0x8
+
+/* security properties of one elf file */
+typedef struct SecInfo {
+    int class;              // ELFCLASS32 or ELFCLASS64
+    int type;               // enum ELF_TYPE
+    int pie;                // true:pie, false:fixed address, other:na (shared library)
+    bool nx;
+    bool canary;
+    int relro;              // 0:none, 1:partial, 2:full
+    int hook;               // true:normal, false:.got.plt hook detected, other:na
+    bool fortify;
+    uint32_t fortified;     // imported __*_chk functions
+    uint32_t fortifiable;   // imported functions which have a __*_chk variant
+    uint32_t cet;           // SEC_CET_* and SEC_ARM_* bits
+    bool rpath;
+    bool runpath;
+    bool stripped;          // no .symtab
+    uint32_t symtab_count;
+    uint32_t dynsym_count;
+} secinfo_t;
+
+/**
+ * @brief 收集elf文件的安全属性，只遍历一次程序头、.dynamic、符号表和note
+ * collect the security properties of the elf file in one pass over
+ * the program headers, .dynamic, the symbol tables and the notes
+ * @param elf elf file custom structure
+ * @param info output security properties
+ * @return error code
+ */
+int checksec_collect(Elf *elf, secinfo_t *info);
+
 /**
  * @brief 检查elf文件是否合法
  * check if the elf file is legal
@@ -5,4 +48,4 @@
  * @return error code
  */
 int checksec_t0(Elf *elf);
-int checksec_t1(Elf *elf);
\ No newline at end of file
+int checksec_t1(Elf *elf);
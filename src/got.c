@@ -0,0 +1,296 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "forensic.h"
+#include "rule.h"
+#include "got.h"
+
+/* allocated section, sorted by address */
+typedef struct AddrRange {
+    uint64_t start;
+    uint64_t end;
+    int index;
+} addr_range_t;
+
+typedef struct AddrIndex {
+    addr_range_t *ranges;
+    int count;
+} addr_index_t;
+
+/* a relocation table located through .dynamic */
+typedef struct RelTable {
+    uint64_t offset;
+    uint64_t size;
+    bool rela;
+} rel_table_t;
+
+static const char *class_names[] = {
+    "zero", "plt stub", "resolver", "local", "image", "segment", "out",
+};
+
+static int range_cmp(const void *a, const void *b) {
+    const addr_range_t *x = a, *y = b;
+    return x->start < y->start? -1: x->start > y->start;
+}
+
+static int index_build(facts_t *facts, addr_index_t *idx) {
+    idx->count = 0;
+    idx->ranges = malloc(sizeof(addr_range_t) * (facts->shnum + 1));
+    if (!idx->ranges) {
+        return ERR_MEM;
+    }
+    for (int i = 0; i < facts->shnum; i++) {
+        Elf64_Shdr *s = &facts->shdr[i].hdr;
+        /* .tbss overlaps the following sections */
+        if (!(s->sh_flags & SHF_ALLOC) || !s->sh_size || (s->sh_flags & SHF_TLS && s->sh_type == SHT_NOBITS)) {
+            continue;
+        }
+        idx->ranges[idx->count].start = s->sh_addr;
+        idx->ranges[idx->count].end = s->sh_addr + s->sh_size;
+        idx->ranges[idx->count].index = i;
+        idx->count++;
+    }
+    qsort(idx->ranges, idx->count, sizeof(addr_range_t), range_cmp);
+    return NO_ERR;
+}
+
+/* index of the section that holds addr, -1 if none */
+static int index_find(addr_index_t *idx, uint64_t addr) {
+    int lo = 0, hi = idx->count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (idx->ranges[mid].start <= addr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (found >= 0 && addr < idx->ranges[found].end) {
+        return idx->ranges[found].index;
+    }
+    return -1;
+}
+
+/* flags: required p_flags bits, 0 for any loaded segment */
+static bool in_load_segment(facts_t *facts, uint64_t addr, uint32_t flags) {
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *p = &facts->phdr[i];
+        if (p->p_type == PT_LOAD && (p->p_flags & flags) == flags && addr >= p->p_vaddr &&
+            addr < p->p_vaddr + p->p_memsz) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool got_types(uint16_t machine, uint32_t *glob_dat, uint32_t *jump_slot) {
+    switch (machine) {
+        case EM_386: *glob_dat = 6; *jump_slot = 7; return true;           // R_386_GLOB_DAT, R_386_JMP_SLOT
+        case EM_X86_64: *glob_dat = 6; *jump_slot = 7; return true;        // R_X86_64_GLOB_DAT, R_X86_64_JUMP_SLOT
+        case EM_AARCH64: *glob_dat = 1025; *jump_slot = 1026; return true; // R_AARCH64_GLOB_DAT, R_AARCH64_JUMP_SLOT
+        default: return false;
+    }
+}
+
+static void classify(facts_t *facts, addr_index_t *idx, got_slot_t *slot, Elf64_Sym *sym) {
+    int sec = slot->value? index_find(idx, slot->value): -1;
+
+    slot->section = sec >= 0? facts->shdr[sec].name: NULL;
+    slot->anomalous = false;
+    if (!slot->value) {
+        slot->klass = GOT_ZERO;
+    } else if (sec >= 0 && !strncmp(facts->shdr[sec].name, ".plt", 4)) {
+        /* aarch64 fills the lazy slots with PLT0 */
+        slot->klass = slot->value == facts->shdr[sec].hdr.sh_addr? GOT_RESOLVER: GOT_PLT_STUB;
+    } else if (!facts->shnum && slot->plt && in_load_segment(facts, slot->value, PF_X)) {
+        /* section headers stripped, the lazy slot points into the code segment that holds the PLT */
+        slot->klass = GOT_PLT_STUB;
+    } else if (sym && sym->st_shndx != SHN_UNDEF && slot->value == sym->st_value) {
+        slot->klass = GOT_LOCAL;
+    } else if (sec >= 0) {
+        slot->klass = GOT_IMAGE;
+        slot->anomalous = true;
+    } else if (in_load_segment(facts, slot->value, 0)) {
+        slot->klass = GOT_SEGMENT;
+        slot->anomalous = true;
+    } else {
+        slot->klass = GOT_OUT;
+        slot->anomalous = true;
+    }
+}
+
+int got_verify(facts_t *facts, got_report_t report, void *arg) {
+    Elf *elf = facts->elf;
+    uint32_t glob_dat, jump_slot;
+    uint64_t symtab = 0, strtab = 0, strsz = 0;
+    uint64_t rela = 0, relasz = 0, rel = 0, relsz = 0, jmprel = 0, pltrelsz = 0, pltrel = DT_RELA;
+    rel_table_t tables[3];
+    int ntables = 0, anomalies = 0;
+    bool has_jmprel = false;
+    addr_index_t idx;
+
+    if (!got_types(facts->machine, &glob_dat, &jump_slot)) {
+        return ERR_ELF_TYPE;
+    }
+    for (int i = 0; i < facts->dyn_count; i++) {
+        uint64_t v = facts->dyn[i].d_un.d_val;
+        switch (facts->dyn[i].d_tag) {
+            case DT_SYMTAB: symtab = v; break;
+            case DT_STRTAB: strtab = v; break;
+            case DT_STRSZ: strsz = v; break;
+            case DT_RELA: rela = v; break;
+            case DT_RELASZ: relasz = v; break;
+            case DT_REL: rel = v; break;
+            case DT_RELSZ: relsz = v; break;
+            case DT_JMPREL: jmprel = v; break;
+            case DT_PLTRELSZ: pltrelsz = v; break;
+            case DT_PLTREL: pltrel = v; break;
+            default: break;
+        }
+    }
+    if (vaddr_to_offset(elf, symtab, &symtab) != NO_ERR || vaddr_to_offset(elf, strtab, &strtab) != NO_ERR ||
+        strtab + strsz > elf->size) {
+        symtab = strtab = strsz = 0;
+    }
+
+    /* DT_JMPREL first, DT_RELA may cover it on some linkers */
+    if (jmprel && vaddr_to_offset(elf, jmprel, &tables[ntables].offset) == NO_ERR) {
+        tables[ntables].size = pltrelsz;
+        tables[ntables++].rela = pltrel == DT_RELA;
+        has_jmprel = true;
+    }
+    if (rela && vaddr_to_offset(elf, rela, &tables[ntables].offset) == NO_ERR) {
+        tables[ntables].size = relasz;
+        tables[ntables++].rela = true;
+    }
+    if (rel && vaddr_to_offset(elf, rel, &tables[ntables].offset) == NO_ERR) {
+        tables[ntables].size = relsz;
+        tables[ntables++].rela = false;
+    }
+    if (!ntables) {
+        return 0;
+    }
+    if (index_build(facts, &idx) != NO_ERR) {
+        return ERR_MEM;
+    }
+
+    size_t word = facts->class == ELFCLASS32? 4: 8;
+    size_t symsize = facts->class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    for (int t = 0; t < ntables; t++) {
+        size_t entsize = tables[t].rela? word * 3: word * 2;
+        uint64_t end = tables[t].offset + tables[t].size;
+        if (end > elf->size) {
+            end = elf->size;
+        }
+        for (uint64_t off = tables[t].offset; off + entsize <= end; off += entsize) {
+            if (t > 0 && has_jmprel && off >= tables[0].offset && off < tables[0].offset + tables[0].size) {
+                continue;
+            }
+            uint64_t r_offset, r_info, type, symi, slot_off;
+            got_slot_t slot;
+            Elf64_Sym sym, *psym = NULL;
+            if (word == 4) {
+                r_offset = *(uint32_t *)(elf->mem + off);
+                r_info = *(uint32_t *)(elf->mem + off + 4);
+                type = ELF32_R_TYPE(r_info);
+                symi = ELF32_R_SYM(r_info);
+            } else {
+                r_offset = *(uint64_t *)(elf->mem + off);
+                r_info = *(uint64_t *)(elf->mem + off + 8);
+                type = ELF64_R_TYPE(r_info);
+                symi = ELF64_R_SYM(r_info);
+            }
+            if (type != glob_dat && type != jump_slot) {
+                continue;
+            }
+            if (vaddr_to_offset(elf, r_offset, &slot_off) != NO_ERR || slot_off + word > elf->size) {
+                continue;
+            }
+
+            memset(&slot, 0, sizeof(slot));
+            slot.addr = r_offset;
+            slot.value = word == 4? *(uint32_t *)(elf->mem + slot_off): *(uint64_t *)(elf->mem + slot_off);
+            slot.type = type;
+            slot.plt = type == jump_slot;
+            slot.symbol = "";
+            if (symtab && symi && symtab + (symi + 1) * symsize <= elf->size) {
+                get_sym_by_table(elf, elf->mem + symtab, symi, &sym);
+                psym = &sym;
+                if (sym.st_name < strsz && memchr(elf->mem + strtab + sym.st_name, '\0', strsz - sym.st_name)) {
+                    slot.symbol = (const char *)elf->mem + strtab + sym.st_name;
+                }
+            }
+            classify(facts, &idx, &slot, psym);
+            if (slot.anomalous) {
+                anomalies++;
+            }
+            if (report) {
+                report(arg, &slot);
+            }
+        }
+    }
+    free(idx.ranges);
+    return anomalies;
+}
+
+static void print_slot(void *arg, got_slot_t *slot) {
+    int *nr = (int *)arg;
+    char where[64];
+    snprintf(where, sizeof(where), "%s", slot->section? slot->section: "-");
+    if (slot->anomalous) {
+        CHECK_ERROR("    [%2d] %016lx %016lx %-9s %-9s %-12s %s\n", (*nr)++, slot->addr, slot->value,
+            slot->plt? "JUMP_SLOT": "GLOB_DAT", class_names[slot->klass], where, slot->symbol);
+    } else {
+        CHECK_COMMON("    [%2d] %016lx %016lx %-9s %-9s %-12s %s\n", (*nr)++, slot->addr, slot->value,
+            slot->plt? "JUMP_SLOT": "GLOB_DAT", class_names[slot->klass], where, slot->symbol);
+    }
+}
+
+int got_report(Elf *elf) {
+    facts_t facts;
+    int nr = 0;
+    int err = facts_collect(elf, &facts);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    PRINT_INFO("GOT slots\n");
+    printf("    [%2s] %-16s %-16s %-9s %-9s %-12s %s\n", "Nr", "Slot", "Value", "Type", "Class", "Section", "Symbol");
+    err = got_verify(&facts, print_slot, &nr);
+    if (err > 0) {
+        PRINT_WARNING("%d of %d slots are redirected\n", err, nr);
+    } else if (err == 0) {
+        PRINT_INFO("%d slots verified\n", nr);
+    }
+    facts_fini(&facts);
+    return err;
+}
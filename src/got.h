@@ -0,0 +1,74 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef __GOT_H
+#define __GOT_H
+
+/* where a GOT slot points to */
+enum GOT_CLASS {
+    GOT_ZERO,               // filled in by the dynamic loader
+    GOT_PLT_STUB,           // own PLT stub, lazy binding
+    GOT_RESOLVER,           // PLT0, the lazy resolver trampoline
+    GOT_LOCAL,              // own definition of the symbol
+    GOT_IMAGE,              // another place inside a section of the image
+    GOT_SEGMENT,            // a loaded segment which no section describes
+    GOT_OUT,                // outside of the image
+};
+
+/* one GLOB_DAT or JUMP_SLOT relocation */
+typedef struct GotSlot {
+    uint64_t addr;          // r_offset
+    uint64_t value;         // content of the slot in the file
+    uint32_t type;          // relocation type
+    bool plt;               // JUMP_SLOT
+    const char *symbol;
+    const char *section;    // section that the value points into, NULL if none
+    int klass;              // enum GOT_CLASS
+    bool anomalous;
+} got_slot_t;
+
+typedef void (*got_report_t)(void *arg, got_slot_t *slot);
+
+/**
+ * @brief 校验.rel[a].dyn和.rel[a].plt中GLOB_DAT与JUMP_SLOT对应的GOT表项
+ * verify the GOT slots of the GLOB_DAT and JUMP_SLOT relocations, found
+ * through DT_REL[A] and DT_JMPREL
+ * @param facts facts of the elf file
+ * @param report callback for each slot, may be NULL
+ * @param arg callback argument
+ * @return number of anomalous slots, or error code
+ */
+int got_verify(facts_t *facts, got_report_t report, void *arg);
+
+/**
+ * @brief 打印GOT表项的校验结果
+ * print the verification result of every GOT slot
+ * @param elf elf file custom structure
+ * @return number of anomalous slots, or error code
+ */
+int got_report(Elf *elf);
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "json.h"
+
+void json_init(json_t *j, FILE *out) {
+    memset(j, 0, sizeof(json_t));
+    j->out = out;
+}
+
+void json_flush(json_t *j) {
+    if (j->len && j->out) {
+        fwrite(j->buf, 1, j->len, j->out);
+    }
+    j->len = 0;
+}
+
+void json_fini(json_t *j) {
+    json_flush(j);
+    free(j->buf);
+    memset(j, 0, sizeof(json_t));
+}
+
+static void json_reserve(json_t *j, size_t n) {
+    if (j->len + n <= j->cap) {
+        return;
+    }
+    /* stream large documents instead of holding them, records stay whole */
+    if (j->stream && j->out && j->len >= JSON_FLUSH_SIZE) {
+        json_flush(j);
+        if (n <= j->cap) {
+            return;
+        }
+    }
+    size_t cap = j->cap? j->cap: 4096;
+    while (cap < j->len + n) {
+        cap *= 2;
+    }
+    char *buf = realloc(j->buf, cap);
+    if (!buf) {
+        /* keep what we have, the output is truncated */
+        json_flush(j);
+        return;
+    }
+    j->buf = buf;
+    j->cap = cap;
+}
+
+static void json_raw(json_t *j, const char *s, size_t n) {
+    json_reserve(j, n);
+    if (j->len + n > j->cap) {
+        return;
+    }
+    memcpy(j->buf + j->len, s, n);
+    j->len += n;
+}
+
+static void json_char(json_t *j, char c) {
+    json_raw(j, &c, 1);
+}
+
+/* separator before a value or a key */
+static void json_prefix(json_t *j) {
+    if (j->key) {
+        j->key = false;
+        return;
+    }
+    if (j->comma[j->depth]) {
+        json_char(j, ',');
+    }
+    j->comma[j->depth] = true;
+}
+
+/* length of the well-formed utf-8 sequence at s, 0 if it is not one */
+static int utf8_length(const unsigned char *s) {
+    if (s[0] >= 0xc2 && s[0] <= 0xdf) {
+        return (s[1] & 0xc0) == 0x80? 2: 0;
+    }
+    if (s[0] >= 0xe0 && s[0] <= 0xef) {
+        /* no overlong forms, no surrogates */
+        if ((s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80 || (s[0] == 0xe0 && s[1] < 0xa0) ||
+            (s[0] == 0xed && s[1] > 0x9f)) {
+            return 0;
+        }
+        return 3;
+    }
+    if (s[0] >= 0xf0 && s[0] <= 0xf4) {
+        /* up to U+10FFFF */
+        if ((s[1] & 0xc0) != 0x80 || (s[2] & 0xc0) != 0x80 || (s[3] & 0xc0) != 0x80 ||
+            (s[0] == 0xf0 && s[1] < 0x90) || (s[0] == 0xf4 && s[1] > 0x8f)) {
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+/* names come from the file: an invalid utf-8 byte is written as \u00XX, the code point of the same value */
+static void json_escaped(json_t *j, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    const char *start = s;
+    json_char(j, '"');
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x80) {
+            int n = utf8_length((const unsigned char *)s);
+            if (n) {
+                s += n - 1;
+                continue;
+            }
+        } else if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        json_raw(j, start, s - start);
+        start = s + 1;
+        switch (c) {
+            case '"': json_raw(j, "\\\"", 2); break;
+            case '\\': json_raw(j, "\\\\", 2); break;
+            case '\n': json_raw(j, "\\n", 2); break;
+            case '\r': json_raw(j, "\\r", 2); break;
+            case '\t': json_raw(j, "\\t", 2); break;
+            default: {
+                char u[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+                json_raw(j, u, 6);
+            }
+        }
+    }
+    json_raw(j, start, s - start);
+    json_char(j, '"');
+}
+
+void json_object_begin(json_t *j) {
+    json_prefix(j);
+    json_char(j, '{');
+    if (j->depth + 1 < JSON_MAX_DEPTH) {
+        j->depth++;
+    }
+    j->comma[j->depth] = false;
+}
+
+void json_object_end(json_t *j) {
+    if (j->depth > 0) {
+        j->depth--;
+    }
+    json_char(j, '}');
+}
+
+void json_array_begin(json_t *j) {
+    json_prefix(j);
+    json_char(j, '[');
+    if (j->depth + 1 < JSON_MAX_DEPTH) {
+        j->depth++;
+    }
+    j->comma[j->depth] = false;
+}
+
+void json_array_end(json_t *j) {
+    if (j->depth > 0) {
+        j->depth--;
+    }
+    json_char(j, ']');
+}
+
+void json_key(json_t *j, const char *key) {
+    json_prefix(j);
+    json_escaped(j, key);
+    json_char(j, ':');
+    j->key = true;
+}
+
+void json_string(json_t *j, const char *value) {
+    json_prefix(j);
+    if (value) {
+        json_escaped(j, value);
+    } else {
+        json_raw(j, "null", 4);
+    }
+}
+
+void json_uint(json_t *j, uint64_t value) {
+    char tmp[24];
+    int n = sizeof(tmp);
+    json_prefix(j);
+    do {
+        tmp[--n] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    json_raw(j, tmp + n, sizeof(tmp) - n);
+}
+
+void json_int(json_t *j, int64_t value) {
+    if (value < 0) {
+        char tmp[24];
+        uint64_t v = -(uint64_t)value;
+        int n = sizeof(tmp);
+        json_prefix(j);
+        do {
+            tmp[--n] = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        tmp[--n] = '-';
+        json_raw(j, tmp + n, sizeof(tmp) - n);
+    } else {
+        json_uint(j, value);
+    }
+}
+
+/* addresses are written as "0x..." strings, json numbers lose precision above 2^53 */
+void json_hex(json_t *j, uint64_t value) {
+    static const char hex[] = "0123456789abcdef";
+    char tmp[24];
+    int n = sizeof(tmp);
+    json_prefix(j);
+    tmp[--n] = '"';
+    do {
+        tmp[--n] = hex[value & 0xf];
+        value >>= 4;
+    } while (value);
+    tmp[--n] = 'x';
+    tmp[--n] = '0';
+    tmp[--n] = '"';
+    json_raw(j, tmp + n, sizeof(tmp) - n);
+}
+
+void json_bool(json_t *j, bool value) {
+    json_prefix(j);
+    if (value) {
+        json_raw(j, "true", 4);
+    } else {
+        json_raw(j, "false", 5);
+    }
+}
+
+void json_null(json_t *j) {
+    json_prefix(j);
+    json_raw(j, "null", 4);
+}
+
+void json_newline(json_t *j) {
+    json_char(j, '\n');
+    j->comma[0] = false;
+    json_flush(j);
+}
@@ -0,0 +1,95 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef __JSON_H
+#define __JSON_H
+
+#define JSON_MAX_DEPTH 32
+#define JSON_FLUSH_SIZE 65536
+
+/* streaming json writer, output is buffered and written in large blocks */
+typedef struct JsonWriter {
+    FILE *out;
+    char *buf;
+    size_t len;
+    size_t cap;
+    int depth;
+    bool comma[JSON_MAX_DEPTH];     // a value was written at this level
+    bool key;                       // a key is waiting for its value
+    bool stream;                    // one large document, flushed before JSON_FLUSH_SIZE; otherwise only
+                                    // json_flush and json_newline write, one fwrite per record
+} json_t;
+
+/**
+ * @brief 初始化json写入器
+ * initialize the json writer
+ * @param j json writer
+ * @param out output stream, written on flush
+ */
+void json_init(json_t *j, FILE *out);
+
+/**
+ * @brief 输出缓冲区中的内容，释放写入器
+ * flush the buffer and release the writer
+ * @param j json writer
+ */
+void json_fini(json_t *j);
+
+/**
+ * @brief 使用一次fwrite写出缓冲区，多线程写同一个流时每条记录保持完整
+ * write the buffer with a single fwrite, so records stay whole when threads share a stream
+ * @param j json writer
+ */
+void json_flush(json_t *j);
+
+void json_object_begin(json_t *j);
+void json_object_end(json_t *j);
+void json_array_begin(json_t *j);
+void json_array_end(json_t *j);
+void json_key(json_t *j, const char *key);
+void json_string(json_t *j, const char *value);
+void json_int(json_t *j, int64_t value);
+void json_uint(json_t *j, uint64_t value);
+void json_hex(json_t *j, uint64_t value);
+void json_bool(json_t *j, bool value);
+void json_null(json_t *j);
+
+/**
+ * @brief 结束一条NDJSON记录并输出
+ * terminate one NDJSON record and flush it
+ * @param j json writer
+ */
+void json_newline(json_t *j);
+
+/* key and value in one call */
+#define JSON_KV_STRING(j, k, v) do { json_key(j, k); json_string(j, v); } while (0)
+#define JSON_KV_INT(j, k, v) do { json_key(j, k); json_int(j, v); } while (0)
+#define JSON_KV_UINT(j, k, v) do { json_key(j, k); json_uint(j, v); } while (0)
+#define JSON_KV_HEX(j, k, v) do { json_key(j, k); json_hex(j, v); } while (0)
+#define JSON_KV_BOOL(j, k, v) do { json_key(j, k); json_bool(j, v); } while (0)
+
+#endif
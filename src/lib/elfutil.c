@@ -76,6 +76,56 @@ void print_error(enum ErrorCode code) {
     }
 }
 
+/**
+ * @brief 只读取ELF头，检查魔数以及头表是否越界，避免映射非ELF或损坏的文件
+ * read the elf header only and check the magic and the bounds of the header tables,
+ * so that non-elf or corrupted files are never mapped
+ * @param fd file descriptor
+ * @param size file size
+ * @param class output elf class
+ * @param machine output elf machine
+ * @return error code
+ */
+int probe_elf(int fd, size_t size, int *class, uint16_t *machine) {
+    Elf64_Ehdr ehdr;
+    uint64_t phend, shend;
+
+    if (size < sizeof(Elf32_Ehdr) || pread(fd, &ehdr, sizeof(ehdr), 0) < (ssize_t)sizeof(Elf32_Ehdr)) {
+        return ERR_ELF_TYPE;
+    }
+    if (memcmp(ehdr.e_ident, ELFMAG, SELFMAG)) {
+        return ERR_ELF_TYPE;
+    }
+
+    *class = ehdr.e_ident[EI_CLASS];
+    if (*class == ELFCLASS32) {
+        Elf32_Ehdr *e = (Elf32_Ehdr *)&ehdr;
+        *machine = e->e_machine;
+        phend = (uint64_t)e->e_phoff + (uint64_t)e->e_phnum * sizeof(Elf32_Phdr);
+        shend = (uint64_t)e->e_shoff + (uint64_t)e->e_shnum * sizeof(Elf32_Shdr);
+        if (e->e_shnum && e->e_shstrndx >= e->e_shnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+    } else if (*class == ELFCLASS64) {
+        if (size < sizeof(Elf64_Ehdr)) {
+            return ERR_ELF_TYPE;
+        }
+        *machine = ehdr.e_machine;
+        phend = ehdr.e_phoff + (uint64_t)ehdr.e_phnum * sizeof(Elf64_Phdr);
+        shend = ehdr.e_shoff + (uint64_t)ehdr.e_shnum * sizeof(Elf64_Shdr);
+        if (ehdr.e_shnum && ehdr.e_shstrndx >= ehdr.e_shnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+    } else {
+        return ERR_ELF_CLASS;
+    }
+
+    if (phend > size || shend > size) {
+        return ERR_OUT_OF_BOUNDS;
+    }
+    return NO_ERR;
+}
+
 /**
  * @brief 初始化elf文件，将elf文件转化为elf结构体
  * initialize the elf file and convert it into an elf structure
@@ -85,14 +135,25 @@ void print_error(enum ErrorCode code) {
  * @return error code
  */
 int init(char *elf_name, Elf *elf, bool ro) {
-    int fd = -1;
-    struct stat st;
-    uint8_t *elf_map = NULL;
-
-    fd = ro?open(elf_name, O_RDONLY): open(elf_name, O_RDWR);
+    int fd = ro?open(elf_name, O_RDONLY): open(elf_name, O_RDWR);
     if (fd < 0) {
         return ERR_FILE_OPEN;
     }
+    return init_fd(fd, elf, ro);
+}
+
+/**
+ * @brief 使用已打开的文件描述符初始化elf结构体，失败时关闭fd
+ * initialize the elf structure from an open file descriptor, the
+ * descriptor is closed on failure and by finit
+ * @param fd file descriptor, opened O_RDWR unless ro
+ * @param elf elf file custom structure
+ * @param ro if modify elf
+ * @return error code
+ */
+int init_fd(int fd, Elf *elf, bool ro) {
+    struct stat st;
+    uint8_t *elf_map = NULL;
 
     if (fstat(fd, &st) < 0) {
         close(fd);
@@ -1086,6 +1147,155 @@ int set_segment_vaddr_by_index(Elf *elf, int index, uint64_t vaddr) {
     }
 }
 
+/**
+ * @brief 根据段的下标，获取段头(统一转换为64位结构)
+ * Get the program header based on its index, widened to the 64-bit layout.
+ * @param elf Elf custom structure
+ * @param index Elf segment index
+ * @param phdr output program header
+ * @return error code
+ */
+int get_segment_by_index(Elf *elf, int index, Elf64_Phdr *phdr) {
+    if (elf->class == ELFCLASS32) {
+        if (index < 0 || index >= elf->data.elf32.ehdr->e_phnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        Elf32_Phdr *p = &elf->data.elf32.phdr[index];
+        phdr->p_type = p->p_type;
+        phdr->p_flags = p->p_flags;
+        phdr->p_offset = p->p_offset;
+        phdr->p_vaddr = p->p_vaddr;
+        phdr->p_paddr = p->p_paddr;
+        phdr->p_filesz = p->p_filesz;
+        phdr->p_memsz = p->p_memsz;
+        phdr->p_align = p->p_align;
+    } else if (elf->class == ELFCLASS64) {
+        if (index < 0 || index >= elf->data.elf64.ehdr->e_phnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        *phdr = elf->data.elf64.phdr[index];
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    return NO_ERR;
+}
+
+/**
+ * @brief 根据节的下标，获取节头(统一转换为64位结构)
+ * Get the section header based on its index, widened to the 64-bit layout.
+ * @param elf Elf custom structure
+ * @param index Elf section index
+ * @param shdr output section header
+ * @return error code
+ */
+int get_section_by_index(Elf *elf, int index, Elf64_Shdr *shdr) {
+    if (elf->class == ELFCLASS32) {
+        if (index < 0 || index >= elf->data.elf32.ehdr->e_shnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        Elf32_Shdr *s = &elf->data.elf32.shdr[index];
+        shdr->sh_name = s->sh_name;
+        shdr->sh_type = s->sh_type;
+        shdr->sh_flags = s->sh_flags;
+        shdr->sh_addr = s->sh_addr;
+        shdr->sh_offset = s->sh_offset;
+        shdr->sh_size = s->sh_size;
+        shdr->sh_link = s->sh_link;
+        shdr->sh_info = s->sh_info;
+        shdr->sh_addralign = s->sh_addralign;
+        shdr->sh_entsize = s->sh_entsize;
+    } else if (elf->class == ELFCLASS64) {
+        if (index < 0 || index >= elf->data.elf64.ehdr->e_shnum) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        *shdr = elf->data.elf64.shdr[index];
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    return NO_ERR;
+}
+
+/**
+ * @brief 根据下标，获取dynamic段条目(统一转换为64位结构)
+ * Get the dynamic entry based on its index, widened to the 64-bit layout.
+ * @param elf Elf custom structure
+ * @param index dynamic entry index
+ * @param dyn output dynamic entry
+ * @return error code
+ */
+int get_dyn_by_index(Elf *elf, int index, Elf64_Dyn *dyn) {
+    if (elf->class == ELFCLASS32) {
+        if (index < 0 || index >= elf->data.elf32.dyn_count) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        dyn->d_tag = elf->data.elf32.dyn[index].d_tag;
+        dyn->d_un.d_val = elf->data.elf32.dyn[index].d_un.d_val;
+    } else if (elf->class == ELFCLASS64) {
+        if (index < 0 || index >= elf->data.elf64.dyn_count) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        *dyn = elf->data.elf64.dyn[index];
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    return NO_ERR;
+}
+
+/**
+ * @brief 从任意符号表中读取一个符号(统一转换为64位结构)
+ * Read a symbol from an arbitrary symbol table, widened to the 64-bit layout.
+ * @param elf Elf custom structure
+ * @param table start of the symbol table in memory
+ * @param index symbol index
+ * @param sym output symbol
+ * @return error code
+ */
+int get_sym_by_table(Elf *elf, void *table, size_t index, Elf64_Sym *sym) {
+    if (elf->class == ELFCLASS32) {
+        Elf32_Sym *s = &((Elf32_Sym *)table)[index];
+        sym->st_name = s->st_name;
+        sym->st_info = s->st_info;
+        sym->st_other = s->st_other;
+        sym->st_shndx = s->st_shndx;
+        sym->st_value = s->st_value;
+        sym->st_size = s->st_size;
+    } else if (elf->class == ELFCLASS64) {
+        *sym = ((Elf64_Sym *)table)[index];
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    return NO_ERR;
+}
+
+/**
+ * @brief 将虚拟地址转换为文件偏移
+ * Convert a virtual address to a file offset through the PT_LOAD segments.
+ * @param elf Elf custom structure
+ * @param vaddr virtual address
+ * @param offset output file offset
+ * @return error code
+ */
+int vaddr_to_offset(Elf *elf, uint64_t vaddr, uint64_t *offset) {
+    Elf64_Phdr phdr;
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        if (get_segment_by_index(elf, i, &phdr) != NO_ERR) {
+            return ERR_ELF_CLASS;
+        }
+        if (phdr.p_type != PT_LOAD) {
+            continue;
+        }
+        if (vaddr >= phdr.p_vaddr && vaddr < phdr.p_vaddr + phdr.p_filesz) {
+            if (vaddr - phdr.p_vaddr + phdr.p_offset >= elf->size) {
+                return ERR_OUT_OF_BOUNDS;
+            }
+            *offset = vaddr - phdr.p_vaddr + phdr.p_offset;
+            return NO_ERR;
+        }
+    }
+    return ERR_SEG_NOTFOUND;
+}
+
 /**
  * @brief 根据节的名字，获取该节对应的段的下标.请注意，一个节可能属于多个段！
  * Obtain the subscript of the segment corresponding to the section based on its name.
@@ -1996,6 +2206,98 @@ int set_runpath(Elf *elf, char *runpath) {
     return add_dynseg_auto(elf, DT_RUNPATH, path_offset);
 }
 
+/**
+ * @brief 定位.dynamic中字符串的文件偏移，检查其位于DT_STRSZ范围内且以'\0'结尾
+ * locate the string of a dynamic entry, checked against DT_STRSZ and for a
+ * terminating '\0'
+ * @param elf Elf custom structure
+ * @param d_val string table index
+ * @param str_offset output, file offset of the string
+ * @return error code
+ */
+int get_dyn_string_offset(Elf *elf, uint64_t d_val, uint64_t *str_offset) {
+    Elf64_Dyn dyn;
+    uint64_t strtab = 0, strsz = 0, offset = 0;
+    int count = elf->class == ELFCLASS32? elf->data.elf32.dyn_count: elf->data.elf64.dyn_count;
+
+    for (int i = 0; i < count; i++) {
+        get_dyn_by_index(elf, i, &dyn);
+        if (dyn.d_tag == DT_STRTAB) {
+            strtab = dyn.d_un.d_ptr;
+        } else if (dyn.d_tag == DT_STRSZ) {
+            strsz = dyn.d_un.d_val;
+        }
+    }
+    if (vaddr_to_offset(elf, strtab, &offset) != NO_ERR) {
+        return ERR_DYN_NOTFOUND;
+    }
+    if (offset > elf->size || strsz > elf->size - offset || d_val >= strsz ||
+        !memchr(elf->mem + offset + d_val, '\0', strsz - d_val)) {
+        return ERR_OUT_OF_BOUNDS;
+    }
+    *str_offset = offset + d_val;
+    return NO_ERR;
+}
+
+/**
+ * @brief 原地替换.dynamic中一个字符串，新字符串不能更长。新字符串与原字符串尾部对齐，
+ * 原来的字节保留，.dynstr中不会出现空洞
+ * replace the string of a dynamic entry in place with one that is not longer.
+ * The new string ends where the old one ended and d_val points to it, the
+ * old bytes before it stay, so .dynstr gets no run of empty strings
+ * @param elf Elf custom structure
+ * @param tag dynamic tag, the first entry with this tag is changed
+ * @param value new string
+ * @return error code
+ */
+int replace_dyn_string(Elf *elf, int tag, const char *value) {
+    Elf64_Dyn dyn;
+    uint64_t offset = 0;
+    int index = get_dynseg_index_by_tag(elf, tag);
+    if (index < 0) {
+        return ERR_DYN_NOTFOUND;
+    }
+    get_dyn_by_index(elf, index, &dyn);
+    int err = get_dyn_string_offset(elf, dyn.d_un.d_val, &offset);
+    if (err != NO_ERR) {
+        return err;
+    }
+    size_t old_len = strlen((char *)elf->mem + offset);
+    size_t new_len = strlen(value);
+    if (new_len > old_len) {
+        return ERR_ARGS;
+    }
+    memcpy(elf->mem + offset + old_len - new_len, value, new_len);
+    return set_dynseg_value_by_tag(elf, tag, dyn.d_un.d_val + old_len - new_len);
+}
+
+/**
+ * @brief 根据名字删除DT_NEEDED条目，并压缩.dynamic
+ * delete the DT_NEEDED entry by library name and compact .dynamic
+ * @param elf Elf custom structure
+ * @param name library name
+ * @return error code
+ */
+int delete_needed(Elf *elf, char *name) {
+    Elf64_Dyn dyn;
+    uint64_t offset = 0;
+    int count = elf->class == ELFCLASS32? elf->data.elf32.dyn_count: elf->data.elf64.dyn_count;
+
+    for (int i = 0; i < count; i++) {
+        get_dyn_by_index(elf, i, &dyn);
+        if (dyn.d_tag == DT_NULL) {
+            break;
+        }
+        if (dyn.d_tag != DT_NEEDED || get_dyn_string_offset(elf, dyn.d_un.d_val, &offset) != NO_ERR) {
+            continue;
+        }
+        if (!strcmp((char *)elf->mem + offset, name)) {
+            return delete_dynseg_by_index(elf, i);
+        }
+    }
+    return ERR_DYN_NOTFOUND;
+}
+
 static int mov_last_sections(Elf *elf, uint64_t expand_offset, size_t size) {
     if (elf->class == ELFCLASS32) {
         // mov section header table
@@ -3161,6 +3463,34 @@ int add_dynseg_auto(Elf *elf, int type, uint64_t value) {
     return NO_ERR;
 }
 
+/**
+ * @brief 删除一个dynamic条目，后续条目前移，末尾补DT_NULL
+ * Delete a dynamic entry, move the following entries forward and pad with DT_NULL
+ * @param elf Elf custom structure
+ * @param index dynamic entry index
+ * @return error code
+ */
+int delete_dynseg_by_index(Elf *elf, int index) {
+    if (elf->class == ELFCLASS32) {
+        if (index < 0 || index >= elf->data.elf32.dyn_count) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        Elf32_Dyn *dyn = elf->data.elf32.dyn;
+        memmove(&dyn[index], &dyn[index + 1], (elf->data.elf32.dyn_count - index - 1) * sizeof(Elf32_Dyn));
+        memset(&dyn[elf->data.elf32.dyn_count - 1], 0, sizeof(Elf32_Dyn));
+    } else if (elf->class == ELFCLASS64) {
+        if (index < 0 || index >= elf->data.elf64.dyn_count) {
+            return ERR_OUT_OF_BOUNDS;
+        }
+        Elf64_Dyn *dyn = elf->data.elf64.dyn;
+        memmove(&dyn[index], &dyn[index + 1], (elf->data.elf64.dyn_count - index - 1) * sizeof(Elf64_Dyn));
+        memset(&dyn[elf->data.elf64.dyn_count - 1], 0, sizeof(Elf64_Dyn));
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    return NO_ERR;
+}
+
 /**
  * @brief 增加一个节表项
  * Add a section entry
@@ -3334,8 +3664,13 @@ int add_dynsym_entry(Elf *elf, char *name, uint64_t value, size_t code_size) {
     return err;
 }
 
-// compute symbol hash
-static uint32_t dl_new_hash(const char* name) {
+/**
+ * @brief 计算符号的gnu hash值
+ * compute the GNU hash value of a symbol name
+ * @param name symbol name
+ * @return hash value
+ */
+uint32_t dl_new_hash(const char* name) {
     uint32_t h = 5381;
 
     for (unsigned char c = *name; c != '\0'; c = *++name) {
@@ -92,6 +92,18 @@ typedef struct GnuHash {
  */
 void print_error(enum ErrorCode code);
 
+/**
+ * @brief 只读取ELF头，检查魔数以及头表是否越界，避免映射非ELF或损坏的文件
+ * read the elf header only and check the magic and the bounds of the header tables,
+ * so that non-elf or corrupted files are never mapped
+ * @param fd file descriptor
+ * @param size file size
+ * @param class output elf class
+ * @param machine output elf machine
+ * @return error code
+ */
+int probe_elf(int fd, size_t size, int *class, uint16_t *machine);
+
 /**
  * @brief 初始化elf文件，将elf文件转化为elf结构体
  * initialize the elf file and convert it into an elf structure
@@ -101,6 +113,17 @@ void print_error(enum ErrorCode code);
  * @return error code
  */
 int init(char *elf_name, Elf *elf, bool ro);
+
+/**
+ * @brief 使用已打开的文件描述符初始化elf结构体，失败时关闭fd
+ * initialize the elf structure from an open file descriptor, the
+ * descriptor is closed on failure and by finit
+ * @param fd file descriptor, opened O_RDWR unless ro
+ * @param elf elf file custom structure
+ * @param ro if modify elf
+ * @return error code
+ */
+int init_fd(int fd, Elf *elf, bool ro);
 int finit(Elf *elf);
 void reinit(Elf *elf);
 
@@ -183,6 +206,29 @@ int get_segment_paddr_by_index(Elf *elf, int index);
 int get_segment_type_by_index(Elf *elf, int index);
 int get_segment_vaddr_by_index(Elf *elf, int index);
 
+/**
+ * @brief 根据下标获取段头、节头、dynamic条目和符号，统一转换为64位结构
+ * Get program header, section header, dynamic entry and symbol by index,
+ * widened to the 64-bit layout so callers do not need to branch on class.
+ * @param elf Elf custom structure
+ * @param index object index
+ * @return error code
+ */
+int get_segment_by_index(Elf *elf, int index, Elf64_Phdr *phdr);
+int get_section_by_index(Elf *elf, int index, Elf64_Shdr *shdr);
+int get_dyn_by_index(Elf *elf, int index, Elf64_Dyn *dyn);
+int get_sym_by_table(Elf *elf, void *table, size_t index, Elf64_Sym *sym);
+
+/**
+ * @brief 将虚拟地址转换为文件偏移
+ * Convert a virtual address to a file offset through the PT_LOAD segments.
+ * @param elf Elf custom structure
+ * @param vaddr virtual address
+ * @param offset output file offset
+ * @return error code
+ */
+int vaddr_to_offset(Elf *elf, uint64_t vaddr, uint64_t *offset);
+
 /**
  * @brief 根据段的下标,设置段的对齐方式
  * Set the segment alignment based on its index.
@@ -416,6 +462,15 @@ int add_section_auto(Elf *elf, size_t size, const char *name, uint64_t *added_in
  */
 int add_dynseg_auto(Elf *elf, int type, uint64_t value);
 
+/**
+ * @brief 删除一个dynamic条目，后续条目前移，末尾补DT_NULL
+ * Delete a dynamic entry, move the following entries forward and pad with DT_NULL
+ * @param elf Elf custom structure
+ * @param index dynamic entry index
+ * @return error code
+ */
+int delete_dynseg_by_index(Elf *elf, int index);
+
 /**
  * @brief 增加一个段
  * Add a dynamic segment
@@ -437,6 +492,14 @@ int add_dynseg_difficult(Elf *elf, int type, uint64_t value);
  */
 int add_dynsym_entry(Elf *elf, char *name, uint64_t value, size_t code_size);
 
+/**
+ * @brief 计算符号的gnu hash值
+ * compute the GNU hash value of a symbol name
+ * @param name symbol name
+ * @return hash value
+ */
+uint32_t dl_new_hash(const char* name);
+
 /**
  * @brief 刷新ELF文件的.gnu.hash节
  * Refresh the .gnu.hash section of ELF file
@@ -518,6 +581,36 @@ int set_rpath(Elf *elf, char *rpath);
  */
 int set_runpath(Elf *elf, char *runpath);
 
+/**
+ * @brief 定位.dynamic中字符串的文件偏移，检查其位于DT_STRSZ范围内且以'\0'结尾
+ * locate the string of a dynamic entry, checked against DT_STRSZ and for a
+ * terminating '\0'
+ * @param elf Elf custom structure
+ * @param d_val string table index
+ * @param str_offset output, file offset of the string
+ * @return error code
+ */
+int get_dyn_string_offset(Elf *elf, uint64_t d_val, uint64_t *str_offset);
+
+/**
+ * @brief 原地替换.dynamic中一个字符串，新字符串不能更长
+ * replace the string of a dynamic entry in place with one that is not longer
+ * @param elf Elf custom structure
+ * @param tag dynamic tag, the first entry with this tag is changed
+ * @param value new string
+ * @return error code
+ */
+int replace_dyn_string(Elf *elf, int tag, const char *value);
+
+/**
+ * @brief 根据名字删除DT_NEEDED条目，并压缩.dynamic
+ * delete the DT_NEEDED entry by library name and compact .dynamic
+ * @param elf Elf custom structure
+ * @param name library name
+ * @return error code
+ */
+int delete_needed(Elf *elf, char *name);
+
 /**
  * @brief hook外部函数
  * hook function by .got.plt
@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include "output.h"
+
+output_t g_stdout;
+static char stdout_line[OUTPUT_LINE_SIZE];
+
+static int color_enabled = -1;
+
+const char *out_color(const char *color) {
+    if (color_enabled < 0) {
+        color_enabled = isatty(STDOUT_FILENO) && !getenv("NO_COLOR");
+    }
+    return color_enabled? color: "";
+}
+
+void out_init() {
+    if (!isatty(STDOUT_FILENO)) {
+        setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+    }
+}
+
+void out_memory(output_t *o) {
+    memset(o, 0, sizeof(output_t));
+}
+
+static FILE *out_stream(output_t *o) {
+    return o == &g_stdout? stdout: o->fp;
+}
+
+void out_flush(output_t *o) {
+    FILE *fp = out_stream(o);
+    if (fp && o->len) {
+        fwrite_unlocked(o->buf, 1, o->len, fp);
+        o->len = 0;
+    }
+}
+
+void out_drain(output_t *o, output_t *to) {
+    out_write(to, o->buf, o->len);
+    free(o->buf);
+    memset(o, 0, sizeof(output_t));
+}
+
+void out_write(output_t *o, const char *s, size_t n) {
+    FILE *fp = out_stream(o);
+    if (fp) {
+        /* a stream is staged and handed to stdio once per line */
+        if (!o->buf) {
+            o->buf = o == &g_stdout? stdout_line: malloc(OUTPUT_LINE_SIZE);
+            o->cap = o->buf? OUTPUT_LINE_SIZE: 0;
+        }
+        if (o->len + n > o->cap) {
+            out_flush(o);
+            if (n > o->cap) {
+                fwrite_unlocked(s, 1, n, fp);
+                return;
+            }
+        }
+    } else if (o->len + n > o->cap) {
+        size_t cap = o->cap? o->cap: 4096;
+        while (cap < o->len + n) {
+            cap *= 2;
+        }
+        char *buf = realloc(o->buf, cap);
+        if (!buf) {
+            return;
+        }
+        o->buf = buf;
+        o->cap = cap;
+    }
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+}
+
+void out_char(output_t *o, char c) {
+    if (o->len < o->cap) {
+        o->buf[o->len++] = c;
+    } else {
+        out_write(o, &c, 1);
+    }
+    if (c == '\n') {
+        out_flush(o);
+    }
+}
+
+static void out_fill(output_t *o, char c, int n) {
+    static const char spaces[] = "                                ";
+    static const char zeros[] = "00000000000000000000000000000000";
+    while (n > 0) {
+        int k = n < 32? n: 32;
+        out_write(o, c == '0'? zeros: spaces, k);
+        n -= k;
+    }
+}
+
+/* digits are already formatted, add the padding */
+static void out_field(output_t *o, const char *s, int n, int width, char pad) {
+    if (width > n) {
+        out_fill(o, pad, width - n);
+    }
+    out_write(o, s, n);
+    if (-width > n) {
+        out_fill(o, ' ', -width - n);
+    }
+}
+
+void out_str(output_t *o, const char *s, int width) {
+    out_field(o, s, strlen(s), width, ' ');
+}
+
+void out_dec(output_t *o, int64_t value, int width) {
+    char tmp[24];
+    int n = sizeof(tmp);
+    uint64_t v = value < 0? -(uint64_t)value: value;
+    do {
+        tmp[--n] = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    if (value < 0) {
+        tmp[--n] = '-';
+    }
+    out_field(o, tmp + n, sizeof(tmp) - n, width, ' ');
+}
+
+void out_hex(output_t *o, uint64_t value, int width) {
+    static const char hex[] = "0123456789abcdef";
+    char tmp[24];
+    int n = sizeof(tmp);
+    do {
+        tmp[--n] = hex[value & 0xf];
+        value >>= 4;
+    } while (value);
+    out_field(o, tmp + n, sizeof(tmp) - n, width, '0');
+}
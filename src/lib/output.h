@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef __OUTPUT_H
+#define __OUTPUT_H
+
+/* stdout is fully buffered with this size when it is not a terminal */
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+/* a stream output is staged up to this size, and at every '\n' */
+#define OUTPUT_LINE_SIZE 4096
+
+/* output target, a stream or a growing memory buffer when fp is NULL.
+ * A stream is handed to stdio at each '\n', so lines stay in order with printf */
+typedef struct Output {
+    FILE *fp;
+    char *buf;
+    size_t len;
+    size_t cap;
+} output_t;
+
+/* standard output, writes to the stdio buffer so it stays in order with printf */
+extern output_t g_stdout;
+
+/**
+ * @brief 获取颜色转义序列，标准输出不是终端或设置了NO_COLOR时返回空字符串
+ * get a color escape sequence, "" when stdout is not a terminal or NO_COLOR is set
+ * @param color escape sequence, e.g. GREEN
+ * @return color or ""
+ */
+const char *out_color(const char *color);
+
+/**
+ * @brief 标准输出不是终端时使用大缓冲区
+ * use a large buffer for stdout when it is not a terminal
+ */
+void out_init();
+
+/**
+ * @brief 初始化内存输出，用于并行格式化后按顺序写出
+ * initialize a memory output, for chunks which are formatted in parallel and written in order
+ * @param o output
+ */
+void out_memory(output_t *o);
+
+/**
+ * @brief 把内存输出写到另一个输出并释放
+ * write a memory output to another output and free it
+ * @param o memory output
+ * @param to destination
+ */
+void out_drain(output_t *o, output_t *to);
+
+/**
+ * @brief 把暂存的不完整行交给stdio
+ * hand a staged partial line to stdio
+ * @param o stream output
+ */
+void out_flush(output_t *o);
+
+void out_write(output_t *o, const char *s, size_t n);
+void out_char(output_t *o, char c);
+
+/**
+ * @brief 不经过printf格式化，width与printf相同：正数右对齐，负数左对齐
+ * formatting without printf, width as in printf: positive right aligned, negative left aligned
+ */
+void out_str(output_t *o, const char *s, int width);
+void out_dec(output_t *o, int64_t value, int width);
+/* positive width is zero padded like %08x */
+void out_hex(output_t *o, uint64_t value, int width);
+
+#endif
@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "elfutil.h"
+#include "pool.h"
+
+typedef struct PoolWorker {
+    pool_t *pool;
+    int id;
+} pool_worker_t;
+
+int pool_default_workers() {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0? (int)n: 1;
+}
+
+/* take the next index of our own slice */
+static int pool_take(pool_range_t *range, size_t *index) {
+    int ret = FALSE;
+    pthread_mutex_lock(&range->lock);
+    if (range->lo < range->hi) {
+        *index = range->lo++;
+        ret = TRUE;
+    }
+    pthread_mutex_unlock(&range->lock);
+    return ret;
+}
+
+/* move the upper half of the largest slice of another worker to ours */
+static int pool_steal(pool_t *pool, int id) {
+    while (1) {
+        int victim = -1;
+        size_t best = 0;
+        for (int i = 1; i < pool->workers; i++) {
+            int v = (id + i) % pool->workers;
+            /* racy read, only used to choose a victim */
+            size_t left = pool->ranges[v].hi - pool->ranges[v].lo;
+            if (pool->ranges[v].hi > pool->ranges[v].lo && left > best) {
+                best = left;
+                victim = v;
+            }
+        }
+        if (victim < 0) {
+            return FALSE;
+        }
+
+        pool_range_t *r = &pool->ranges[victim];
+        size_t lo = 0, hi = 0;
+        pthread_mutex_lock(&r->lock);
+        if (r->lo < r->hi) {
+            lo = r->lo + (r->hi - r->lo) / 2;
+            hi = r->hi;
+            r->hi = lo;
+        }
+        pthread_mutex_unlock(&r->lock);
+        if (lo < hi) {
+            pthread_mutex_lock(&pool->ranges[id].lock);
+            pool->ranges[id].lo = lo;
+            pool->ranges[id].hi = hi;
+            pthread_mutex_unlock(&pool->ranges[id].lock);
+            return TRUE;
+        }
+        /* the victim drained meanwhile, look again */
+    }
+}
+
+static void *pool_worker(void *arg) {
+    pool_worker_t *w = (pool_worker_t *)arg;
+    pool_t *pool = w->pool;
+    size_t index;
+
+    while (1) {
+        while (pool_take(&pool->ranges[w->id], &index) == TRUE) {
+            pool->task(pool->arg, index);
+        }
+        if (pool_steal(pool, w->id) != TRUE) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+int pool_run(int workers, size_t count, pool_task_t task, void *arg) {
+    pool_t pool;
+    pthread_t *threads = NULL;
+    pool_worker_t *args = NULL;
+    int started = 0;
+
+    if (workers <= 0) {
+        workers = pool_default_workers();
+    }
+    if ((size_t)workers > count) {
+        workers = count? count: 1;
+    }
+
+    /* no thread for a single worker */
+    if (workers == 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(arg, i);
+        }
+        return NO_ERR;
+    }
+
+    pool.workers = workers;
+    pool.task = task;
+    pool.arg = arg;
+    pool.ranges = calloc(workers, sizeof(pool_range_t));
+    threads = calloc(workers, sizeof(pthread_t));
+    args = calloc(workers, sizeof(pool_worker_t));
+    if (!pool.ranges || !threads || !args) {
+        free(pool.ranges);
+        free(threads);
+        free(args);
+        return ERR_MEM;
+    }
+
+    for (int i = 0; i < workers; i++) {
+        pthread_mutex_init(&pool.ranges[i].lock, NULL);
+        pool.ranges[i].lo = count * i / workers;
+        pool.ranges[i].hi = count * (i + 1) / workers;
+        args[i].pool = &pool;
+        args[i].id = i;
+    }
+
+    /* worker 0 is the calling thread */
+    for (int i = 1; i < workers; i++) {
+        if (pthread_create(&threads[i], NULL, pool_worker, &args[i]) == 0) {
+            started = i;
+        } else {
+            break;
+        }
+    }
+    pool_worker(&args[0]);
+    for (int i = 1; i <= started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    /* slices of workers which failed to start are stolen by worker 0, drain anything left */
+    for (int i = 0; i < workers; i++) {
+        size_t index;
+        while (pool_take(&pool.ranges[i], &index) == TRUE) {
+            task(arg, index);
+        }
+        pthread_mutex_destroy(&pool.ranges[i].lock);
+    }
+
+    free(pool.ranges);
+    free(threads);
+    free(args);
+    return NO_ERR;
+}
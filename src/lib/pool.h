@@ -0,0 +1,44 @@
+#include <stddef.h>
+#include <pthread.h>
+
+#ifndef __POOL_H
+#define __POOL_H
+
+/* task callback, index is in [0, count) */
+typedef void (*pool_task_t)(void *arg, size_t index);
+
+/* range of task indexes owned by one worker, others steal from its tail */
+typedef struct PoolRange {
+    pthread_mutex_t lock;
+    size_t lo;
+    size_t hi;
+} pool_range_t;
+
+typedef struct Pool {
+    int workers;
+    pool_range_t *ranges;
+    pool_task_t task;
+    void *arg;
+} pool_t;
+
+/**
+ * @brief 获取默认的工作线程数量(在线CPU数量)
+ * get the default number of workers (online CPUs)
+ * @return worker count
+ */
+int pool_default_workers();
+
+/**
+ * @brief 使用工作窃取线程池执行count个任务，所有任务完成后返回
+ * run count tasks on a work-stealing thread pool, return after all tasks finished.
+ * every worker owns a contiguous slice of indexes and takes from its head,
+ * an idle worker steals the upper half of the largest remaining slice.
+ * @param workers worker count, <= 0 means default
+ * @param count task count
+ * @param task task callback
+ * @param arg task argument
+ * @return error code
+ */
+int pool_run(int workers, size_t count, pool_task_t task, void *arg);
+
+#endif
@@ -246,4 +246,165 @@ int copy_data(void *src, void *dst, size_t size) {
     memcpy(dst, m, size);
     free(m);
     return NO_ERR;
-}
\ No newline at end of file
+}
+/**
+ * @brief 计算内存块的64位哈希值(MurmurHash64A)
+ * 64-bit hash of a memory block (MurmurHash64A)
+ * @param data input data
+ * @param len data size
+ * @param seed hash seed
+ * @return uint64_t hash value
+ */
+uint64_t hash64(const void *data, size_t len, uint64_t seed) {
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    const uint8_t *p = (const uint8_t *)data;
+    const uint8_t *end = p + (len & ~(size_t)7);
+    uint64_t h = seed ^ (len * m);
+
+    for (; p != end; p += 8) {
+        uint64_t k;
+        memcpy(&k, p, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    switch (len & 7) {
+        case 7: h ^= (uint64_t)p[6] << 48;
+        case 6: h ^= (uint64_t)p[5] << 40;
+        case 5: h ^= (uint64_t)p[4] << 32;
+        case 4: h ^= (uint64_t)p[3] << 24;
+        case 3: h ^= (uint64_t)p[2] << 16;
+        case 2: h ^= (uint64_t)p[1] << 8;
+        case 1: h ^= (uint64_t)p[0];
+                h *= m;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_block(uint32_t *state, const uint8_t *p) {
+    uint32_t w[64], a, b, c, d, e, f, g, h;
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)p[i * 4] << 24 | (uint32_t)p[i * 4 + 1] << 16 | (uint32_t)p[i * 4 + 2] << 8 | p[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        uint32_t t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+/**
+ * @brief 初始化SHA-256上下文
+ * initialize a SHA-256 context
+ * @param ctx context
+ */
+void sha256_init(sha256_t *ctx) {
+    static const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->length = 0;
+    ctx->used = 0;
+}
+
+/**
+ * @brief 向SHA-256上下文追加数据
+ * feed data into a SHA-256 context
+ * @param ctx context
+ * @param data input data
+ * @param len data size
+ */
+void sha256_update(sha256_t *ctx, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+
+    ctx->length += len;
+    if (ctx->used) {
+        size_t n = 64 - ctx->used < len? 64 - ctx->used: len;
+        memcpy(ctx->block + ctx->used, p, n);
+        ctx->used += n;
+        p += n;
+        len -= n;
+        if (ctx->used < 64) {
+            return;
+        }
+        sha256_block(ctx->state, ctx->block);
+        ctx->used = 0;
+    }
+    for (; len >= 64; p += 64, len -= 64) {
+        sha256_block(ctx->state, p);
+    }
+    memcpy(ctx->block, p, len);
+    ctx->used = len;
+}
+
+/**
+ * @brief 结束SHA-256计算并输出摘要
+ * finish a SHA-256 context and write the digest
+ * @param ctx context
+ * @param digest output, SHA256_SIZE bytes
+ */
+void sha256_final(sha256_t *ctx, uint8_t *digest) {
+    uint64_t bits = ctx->length * 8;
+
+    ctx->block[ctx->used++] = 0x80;
+    if (ctx->used > 56) {
+        memset(ctx->block + ctx->used, 0, 64 - ctx->used);
+        sha256_block(ctx->state, ctx->block);
+        ctx->used = 0;
+    }
+    memset(ctx->block + ctx->used, 0, 56 - ctx->used);
+    for (int i = 0; i < 8; i++) {
+        ctx->block[56 + i] = bits >> (56 - i * 8);
+    }
+    sha256_block(ctx->state, ctx->block);
+    for (int i = 0; i < 8; i++) {
+        digest[i * 4] = ctx->state[i] >> 24;
+        digest[i * 4 + 1] = ctx->state[i] >> 16;
+        digest[i * 4 + 2] = ctx->state[i] >> 8;
+        digest[i * 4 + 3] = ctx->state[i];
+    }
+}
+
+/**
+ * @brief 计算内存块的SHA-256摘要
+ * SHA-256 digest of a memory block
+ * @param data input data
+ * @param len data size
+ * @param digest output, SHA256_SIZE bytes
+ */
+void sha256(const void *data, size_t len, uint8_t *digest) {
+    sha256_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, digest);
+}
@@ -2,6 +2,8 @@
 #define MAX_LINE_LEN 256  // 每行最大字符数
 #define READ_CHUNK 128    // 每次读取128字节(对应256字符)
 
+#include "output.h"
+
 #define NONE         "\033[m"
 #define RED          "\033[0;32;31m"
 #define LIGHT_RED    "\033[1;31m"
@@ -19,21 +21,24 @@
 #define LIGHT_GRAY   "\033[0;37m"
 #define WHITE        "\033[1;37m"
 
-#define PRINT_WARNING(format, ...) printf (""YELLOW"[!] "format""NONE"", ##__VA_ARGS__)
+/* one printf per message, the colors are "" when stdout is not a terminal */
+#define PRINT_WARNING(format, ...) printf ("%s[!] "format"%s", out_color(YELLOW), ##__VA_ARGS__, out_color(NONE))
 // #define PRINT_ERROR(format, ...) printf (""RED"[-] "format""NONE"", ##__VA_ARGS__)
-#define PRINT_INFO(format, ...) printf (""GREEN"[+] "format""NONE"", ##__VA_ARGS__)
-#define PRINT_VERBOSE(format, ...) printf (""NONE"[*] "format""NONE"", ##__VA_ARGS__)
-#define PRINT_ERROR(...)  do{printf(RED "[-] %s#%d: " NONE, __FILE__,__LINE__); printf(RED __VA_ARGS__);printf(NONE);}while(0)
+#define PRINT_INFO(format, ...) printf ("%s[+] "format"%s", out_color(GREEN), ##__VA_ARGS__, out_color(NONE))
+#define PRINT_VERBOSE(format, ...) printf ("%s[*] "format"%s", out_color(NONE), ##__VA_ARGS__, out_color(NONE))
+#define PRINT_ERROR(format, ...) printf ("%s[-] %s#%d: %s%s"format"%s", out_color(RED), __FILE__, __LINE__, \
+    out_color(NONE), out_color(RED), ##__VA_ARGS__, out_color(NONE))
 
 #ifdef debug
-    #define PRINT_DEBUG(...)  do{printf(YELLOW "[D] %s#%d: " NONE, __FILE__,__LINE__); printf(YELLOW __VA_ARGS__);printf(NONE);}while(0)
+    #define PRINT_DEBUG(format, ...) printf ("%s[D] %s#%d: %s%s"format"%s", out_color(YELLOW), __FILE__, __LINE__, \
+        out_color(NONE), out_color(YELLOW), ##__VA_ARGS__, out_color(NONE))
 #else
     #define PRINT_DEBUG(format, ...)
 #endif
 
-#define CHECK_WARNING(format, ...) printf (""YELLOW""format""NONE"", ##__VA_ARGS__)
-#define CHECK_ERROR(format, ...) printf (""RED""format""NONE"", ##__VA_ARGS__)
-#define CHECK_INFO(format, ...) printf (""GREEN""format""NONE"", ##__VA_ARGS__)
+#define CHECK_WARNING(format, ...) printf ("%s"format"%s", out_color(YELLOW), ##__VA_ARGS__, out_color(NONE))
+#define CHECK_ERROR(format, ...) printf ("%s"format"%s", out_color(RED), ##__VA_ARGS__, out_color(NONE))
+#define CHECK_INFO(format, ...) printf ("%s"format"%s", out_color(GREEN), ##__VA_ARGS__, out_color(NONE))
 #define CHECK_COMMON(format, ...) printf (""format"", ##__VA_ARGS__)
 
 #define ONE_PAGE 4096 // 4K的大小
@@ -166,3 +171,56 @@ int has_flag(int num, int flag);
  * @return error code
  */
 int copy_data(void *src, void *dst, size_t size);
+
+/**
+ * @brief 计算内存块的64位哈希值(MurmurHash64A)
+ * 64-bit hash of a memory block (MurmurHash64A)
+ * @param data input data
+ * @param len data size
+ * @param seed hash seed
+ * @return uint64_t hash value
+ */
+uint64_t hash64(const void *data, size_t len, uint64_t seed);
+
+#define SHA256_SIZE 32
+
+/* incremental SHA-256 state */
+typedef struct Sha256 {
+    uint32_t state[8];
+    uint64_t length;        // bytes hashed so far
+    uint8_t block[64];
+    size_t used;            // bytes in block
+} sha256_t;
+
+/**
+ * @brief 初始化SHA-256上下文
+ * initialize a SHA-256 context
+ * @param ctx context
+ */
+void sha256_init(sha256_t *ctx);
+
+/**
+ * @brief 向SHA-256上下文追加数据
+ * feed data into a SHA-256 context
+ * @param ctx context
+ * @param data input data
+ * @param len data size
+ */
+void sha256_update(sha256_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief 结束SHA-256计算并输出摘要
+ * finish a SHA-256 context and write the digest
+ * @param ctx context
+ * @param digest output, SHA256_SIZE bytes
+ */
+void sha256_final(sha256_t *ctx, uint8_t *digest);
+
+/**
+ * @brief 计算内存块的SHA-256摘要
+ * SHA-256 digest of a memory block
+ * @param data input data
+ * @param len data size
+ * @param digest output, SHA256_SIZE bytes
+ */
+void sha256(const void *data, size_t len, uint8_t *digest);
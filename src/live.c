@@ -0,0 +1,975 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <elf.h>
+#include <stdbool.h>
+#include <sys/stat.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "reloc.h"
+#include "live.h"
+
+/* /proc/pid/pagemap */
+#define PM_PRESENT  (1ULL << 63)
+#define PM_SWAP     (1ULL << 62)
+#define PM_FILE     (1ULL << 61)
+
+/* locale archives and other data files are mapped too */
+static const char *not_elf = "not an elf file";
+
+/* what the loader is expected to write into a word */
+enum LIVE_FIXUP {
+    FIX_VALUE,              // exactly value
+    FIX_ALT,                // the file content, or value
+    FIX_SLOT,               // address of a symbol, checked against the target object
+    FIX_IRELATIVE,          // any address inside the object itself
+    FIX_MASK,               // unpredictable, thread pointer offsets and the like
+};
+
+typedef struct LiveFixup {
+    uint64_t addr;          // link-time address
+    uint64_t value;         // FIX_VALUE and FIX_ALT value, FIX_SLOT addend
+    uint64_t file;          // content of the word in the file
+    const char *symbol;
+    uint8_t kind;
+    bool plt;
+    bool got;               // GLOB_DAT, JUMP_SLOT or IRELATIVE, the others may live in writable data
+} live_fixup_t;
+
+typedef struct LiveSym {
+    uint64_t addr;          // runtime address
+    uint64_t hash;          // hash64 of the name
+    const char *name;
+    uint8_t type;
+} live_sym_t;
+
+typedef struct LiveMap {
+    uint64_t start;
+    uint64_t end;
+    uint64_t offset;
+    uint64_t inode;
+    char *name;             // "" for anonymous memory
+} live_map_t;
+
+typedef struct LiveObject {
+    char *path;
+    uint64_t inode;
+    uint64_t map_start;     // mapping with the lowest file offset
+    uint64_t map_offset;
+    Elf elf;
+    bool loaded;
+    const char *skipped;    // reason why the object is not compared
+    uint16_t machine;
+    bool loader;            // the dynamic loader writes its own RELRO data before protecting it
+    uint64_t bias;
+    uint64_t start;         // runtime extent of the PT_LOAD segments
+    uint64_t end;
+    live_sym_t *syms;       // sorted by address
+    live_sym_t **by_hash;   // sorted by name hash
+    int nsyms;
+    bool has_dynsym;        // false when the symbols cannot be verified
+    live_finding_t *findings;
+    int nfindings;
+    int capacity;
+    size_t pages;
+    size_t compared;
+    size_t modified;
+    size_t slots;
+    size_t redirected;
+} live_object_t;
+
+typedef struct Live {
+    pid_t pid;
+    int mem;
+    int pagemap;
+    size_t page;
+    live_map_t *maps;
+    int nmaps;
+    live_object_t *objects;
+    int nobjects;
+    live_object_t **by_start;
+} live_t;
+
+static int finding_add(live_object_t *obj, int kind, uint64_t addr, uint64_t size, uint64_t value, const char *symbol) {
+    if (obj->nfindings == obj->capacity) {
+        int cap = obj->capacity? obj->capacity * 2: 16;
+        live_finding_t *tmp = realloc(obj->findings, cap * sizeof(live_finding_t));
+        if (!tmp) {
+            return ERR_MEM;
+        }
+        obj->findings = tmp;
+        obj->capacity = cap;
+    }
+    live_finding_t *f = &obj->findings[obj->nfindings++];
+    f->kind = kind;
+    f->addr = addr;
+    f->size = size;
+    f->value = value;
+    f->symbol = symbol;
+    return NO_ERR;
+}
+
+/* read /proc/pid/maps, one object per mapped file */
+static int read_maps(live_t *lp) {
+    char path[64], line[MAX_PATH_LEN + 128];
+    int cap = 0;
+
+    snprintf(path, sizeof(path), "/proc/%d/maps", lp->pid);
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return ERR_FILE_OPEN;
+    }
+    while (fgets(line, sizeof(line), fp)) {
+        unsigned long start, end, offset, inode;
+        char perms[8], dev[16];
+        int pos = 0;
+        if (sscanf(line, "%lx-%lx %7s %lx %15s %lu %n", &start, &end, perms, &offset, dev, &inode, &pos) < 6) {
+            continue;
+        }
+        line[strcspn(line, "\n")] = '\0';
+        if (lp->nmaps == cap) {
+            cap = cap? cap * 2: 256;
+            live_map_t *tmp = realloc(lp->maps, cap * sizeof(live_map_t));
+            if (!tmp) {
+                fclose(fp);
+                return ERR_MEM;
+            }
+            lp->maps = tmp;
+        }
+        live_map_t *m = &lp->maps[lp->nmaps++];
+        m->start = start;
+        m->end = end;
+        m->offset = offset;
+        m->inode = inode;
+        m->name = strdup(pos? line + pos: "");
+        if (!m->name) {
+            fclose(fp);
+            return ERR_MEM;
+        }
+    }
+    fclose(fp);
+
+    lp->objects = calloc(lp->nmaps? lp->nmaps: 1, sizeof(live_object_t));
+    if (!lp->objects) {
+        return ERR_MEM;
+    }
+    for (int i = 0; i < lp->nmaps; i++) {
+        live_map_t *m = &lp->maps[i];
+        live_object_t *obj = NULL;
+        if (!m->inode || m->name[0] != '/') {
+            continue;
+        }
+        for (int j = lp->nobjects - 1; j >= 0; j--) {
+            if (lp->objects[j].inode == m->inode && !strcmp(lp->objects[j].path, m->name)) {
+                obj = &lp->objects[j];
+                break;
+            }
+        }
+        if (!obj) {
+            obj = &lp->objects[lp->nobjects++];
+            obj->path = m->name;
+            obj->inode = m->inode;
+            obj->map_start = m->start;
+            obj->map_offset = m->offset;
+        } else if (m->offset < obj->map_offset) {
+            obj->map_start = m->start;
+            obj->map_offset = m->offset;
+        }
+    }
+    return NO_ERR;
+}
+
+static int sym_addr_cmp(const void *a, const void *b) {
+    const live_sym_t *x = a, *y = b;
+    return x->addr < y->addr? -1: x->addr > y->addr;
+}
+
+static int sym_hash_cmp(const void *a, const void *b) {
+    const live_sym_t *x = *(live_sym_t **)a, *y = *(live_sym_t **)b;
+    return x->hash < y->hash? -1: x->hash > y->hash;
+}
+
+/* exported symbols, and the canonical PLT entries of an executable */
+static int load_symbols(live_object_t *obj) {
+    Elf *elf = &obj->elf;
+    int shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    Elf64_Shdr dynsym, strtab;
+    int found = -1;
+
+    if (elf->size < (elf->class == ELFCLASS32? sizeof(Elf32_Ehdr): sizeof(Elf64_Ehdr))) {
+        return NO_ERR;
+    }
+    for (int i = 0; i < shnum; i++) {
+        if (get_section_by_index(elf, i, &dynsym) == NO_ERR && dynsym.sh_type == SHT_DYNSYM) {
+            found = i;
+            break;
+        }
+    }
+    if (found < 0 || get_section_by_index(elf, dynsym.sh_link, &strtab) != NO_ERR ||
+        dynsym.sh_offset + dynsym.sh_size > elf->size || strtab.sh_offset + strtab.sh_size > elf->size) {
+        return NO_ERR;
+    }
+
+    size_t symsize = elf->class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    size_t count = dynsym.sh_size / symsize;
+    obj->has_dynsym = true;
+    obj->syms = malloc(count * sizeof(live_sym_t) + 1);
+    obj->by_hash = malloc(count * sizeof(live_sym_t *) + 1);
+    if (!obj->syms || !obj->by_hash) {
+        return ERR_MEM;
+    }
+    for (size_t i = 1; i < count; i++) {
+        Elf64_Sym sym;
+        get_sym_by_table(elf, elf->mem + dynsym.sh_offset, i, &sym);
+        if (!sym.st_value || ELF64_ST_TYPE(sym.st_info) == STT_TLS || sym.st_name >= strtab.sh_size) {
+            continue;
+        }
+        const char *name = (const char *)elf->mem + strtab.sh_offset + sym.st_name;
+        size_t len = strnlen(name, strtab.sh_size - sym.st_name);
+        live_sym_t *s = &obj->syms[obj->nsyms++];
+        s->addr = sym.st_shndx == SHN_ABS? sym.st_value: sym.st_value + obj->bias;
+        s->hash = hash64(name, len, 0);
+        s->name = name;
+        s->type = ELF64_ST_TYPE(sym.st_info);
+    }
+    qsort(obj->syms, obj->nsyms, sizeof(live_sym_t), sym_addr_cmp);
+    for (int i = 0; i < obj->nsyms; i++) {
+        obj->by_hash[i] = &obj->syms[i];
+    }
+    qsort(obj->by_hash, obj->nsyms, sizeof(live_sym_t *), sym_hash_cmp);
+    return NO_ERR;
+}
+
+/* open the file as the process sees it, and make sure it is the mapped one */
+static void load_task(void *arg, size_t index) {
+    live_t *lp = (live_t *)arg;
+    live_object_t *obj = &lp->objects[index];
+    char path[MAX_PATH_LEN + 32];
+    struct stat st;
+    int class, phnum;
+    uint64_t low_vaddr = UINT64_MAX, low_offset = 0, high = 0;
+
+    snprintf(path, sizeof(path), "/proc/%d/root%s", lp->pid, obj->path);
+    if (stat(path, &st) < 0 && stat(strcpy(path, obj->path), &st) < 0) {
+        obj->skipped = "file not found";
+        return;
+    }
+    if (st.st_ino != obj->inode) {
+        obj->skipped = "file replaced on disk";
+        return;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        obj->skipped = "file open error";
+        return;
+    }
+    int err = probe_elf(fd, st.st_size, &class, &obj->machine);
+    close(fd);
+    if (err != NO_ERR) {
+        obj->skipped = not_elf;
+        return;
+    }
+    if (init(path, &obj->elf, true) != NO_ERR) {
+        obj->skipped = "file open error";
+        return;
+    }
+    obj->loaded = true;
+
+    phnum = class == ELFCLASS32? obj->elf.data.elf32.ehdr->e_phnum: obj->elf.data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(&obj->elf, i, &phdr) != NO_ERR || phdr.p_type != PT_LOAD) {
+            continue;
+        }
+        if (phdr.p_vaddr < low_vaddr) {
+            low_vaddr = phdr.p_vaddr;
+            low_offset = phdr.p_offset;
+        }
+        if (phdr.p_vaddr + phdr.p_memsz > high) {
+            high = phdr.p_vaddr + phdr.p_memsz;
+        }
+    }
+    if (low_vaddr == UINT64_MAX) {
+        obj->skipped = "no PT_LOAD segment";
+        return;
+    }
+    /* the mapping at map_offset holds the address low_vaddr - low_offset + map_offset */
+    obj->bias = obj->map_start - (low_vaddr - low_offset + obj->map_offset);
+    obj->start = obj->bias + (low_vaddr & ~(uint64_t)(lp->page - 1));
+    obj->end = obj->bias + high;
+    if (load_symbols(obj) != NO_ERR) {
+        obj->skipped = "out of memory";
+    }
+}
+
+/* the object named by PT_INTERP of the main program */
+static void find_loader(live_t *lp) {
+    char path[MAX_PATH_LEN + 32];
+    struct stat st;
+    live_object_t *exe = lp->nobjects? &lp->objects[0]: NULL;
+    int phnum;
+
+    if (!exe || !exe->loaded) {
+        return;
+    }
+    phnum = exe->elf.class == ELFCLASS32? exe->elf.data.elf32.ehdr->e_phnum: exe->elf.data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(&exe->elf, i, &phdr) != NO_ERR || phdr.p_type != PT_INTERP ||
+            phdr.p_offset + phdr.p_filesz > exe->elf.size || !phdr.p_filesz) {
+            continue;
+        }
+        snprintf(path, sizeof(path), "/proc/%d/root%.*s", lp->pid, (int)phdr.p_filesz, exe->elf.mem + phdr.p_offset);
+        if (stat(path, &st) < 0) {
+            return;
+        }
+        for (int j = 0; j < lp->nobjects; j++) {
+            if (lp->objects[j].inode == st.st_ino) {
+                lp->objects[j].loader = true;
+            }
+        }
+    }
+}
+
+static int object_start_cmp(const void *a, const void *b) {
+    const live_object_t *x = *(live_object_t **)a, *y = *(live_object_t **)b;
+    return x->start < y->start? -1: x->start > y->start;
+}
+
+/* object whose image holds addr, NULL if none */
+static live_object_t *find_object(live_t *lp, uint64_t addr) {
+    int lo = 0, hi = lp->nobjects - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (lp->by_start[mid]->start <= addr) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    /* a later object may be mapped inside the gap of an earlier one */
+    for (int i = found; i >= 0 && found - i < 4; i--) {
+        if (addr < lp->by_start[i]->end) {
+            return lp->by_start[i];
+        }
+    }
+    return NULL;
+}
+
+static live_map_t *find_map(live_t *lp, uint64_t addr) {
+    int lo = 0, hi = lp->nmaps - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (addr < lp->maps[mid].start) {
+            hi = mid - 1;
+        } else if (addr >= lp->maps[mid].end) {
+            lo = mid + 1;
+        } else {
+            return &lp->maps[mid];
+        }
+    }
+    return NULL;
+}
+
+static bool defines_at(live_object_t *obj, const char *name, uint64_t addr) {
+    int lo = 0, hi = obj->nsyms;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (obj->syms[mid].addr < addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (int i = lo; i < obj->nsyms && obj->syms[i].addr == addr; i++) {
+        if (!strcmp(obj->syms[i].name, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* an ifunc symbol resolves to any implementation inside its object */
+static bool defines_ifunc(live_object_t *obj, const char *name) {
+    uint64_t hash = hash64(name, strlen(name), 0);
+    int lo = 0, hi = obj->nsyms;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (obj->by_hash[mid]->hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (int i = lo; i < obj->nsyms && obj->by_hash[i]->hash == hash; i++) {
+        if (obj->by_hash[i]->type == STT_GNU_IFUNC && !strcmp(obj->by_hash[i]->name, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool slot_ok(live_t *lp, live_object_t *obj, live_fixup_t *f, uint64_t value) {
+    if (!value) {
+        return true;
+    }
+    if (f->kind == FIX_IRELATIVE) {
+        return value >= obj->start && value < obj->end;
+    }
+    /* lazy binding, still pointing to the own PLT */
+    if (f->plt && value == f->file + obj->bias) {
+        return true;
+    }
+    live_object_t *target = find_object(lp, value - f->value);
+    if (!target) {
+        /* glibc resolves time and gettimeofday to the vDSO through an ifunc */
+        live_map_t *map = find_map(lp, value);
+        if (map && !strcmp(map->name, "[vdso]")) {
+            for (int i = 0; i < lp->nobjects; i++) {
+                if (lp->objects[i].nsyms && defines_ifunc(&lp->objects[i], f->symbol)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    if (!target->has_dynsym) {
+        return true;
+    }
+    return defines_at(target, f->symbol, value - f->value) || defines_ifunc(target, f->symbol);
+}
+
+static int fixup_cmp(const void *a, const void *b) {
+    const live_fixup_t *x = a, *y = b;
+    return x->addr < y->addr? -1: x->addr > y->addr;
+}
+
+typedef struct FixupList {
+    live_fixup_t *items;
+    size_t count;
+    size_t capacity;
+    uint64_t bias;
+} fixup_list_t;
+
+static live_fixup_t *fixup_add(fixup_list_t *list, uint64_t addr, int kind) {
+    if (list->count == list->capacity) {
+        size_t cap = list->capacity? list->capacity * 2: 256;
+        live_fixup_t *tmp = realloc(list->items, cap * sizeof(live_fixup_t));
+        if (!tmp) {
+            return NULL;
+        }
+        list->items = tmp;
+        list->capacity = cap;
+    }
+    live_fixup_t *f = &list->items[list->count++];
+    memset(f, 0, sizeof(live_fixup_t));
+    f->addr = addr;
+    f->kind = kind;
+    return f;
+}
+
+/* what the loader writes for one relocation */
+static int add_reloc(void *arg, reloc_t *rel) {
+    fixup_list_t *list = (fixup_list_t *)arg;
+    live_fixup_t *f;
+
+    switch (rel->klass) {
+        case RELOC_RELATIVE:
+            f = fixup_add(list, rel->offset, FIX_VALUE);
+            if (f) {
+                f->value = rel->addend + list->bias;
+            }
+            break;
+        case RELOC_IRELATIVE:
+            f = fixup_add(list, rel->offset, FIX_IRELATIVE);
+            if (f) {
+                f->got = true;
+            }
+            break;
+        case RELOC_GLOB_DAT:
+        case RELOC_JUMP_SLOT:
+        case RELOC_ABS:
+            if (!rel->sym) {
+                f = fixup_add(list, rel->offset, FIX_VALUE);
+                if (f) {
+                    f->value = rel->addend;
+                }
+                break;
+            }
+            f = fixup_add(list, rel->offset, rel->name && *rel->name? FIX_SLOT: FIX_MASK);
+            if (f) {
+                f->value = rel->addend;
+                f->symbol = rel->name;
+                f->plt = rel->klass == RELOC_JUMP_SLOT;
+                f->got = rel->klass != RELOC_ABS;
+            }
+            break;
+        default:
+            f = fixup_add(list, rel->offset, FIX_MASK);
+            break;
+    }
+    if (!f) {
+        return ERR_MEM;
+    }
+    f->file = rel->value;
+    return NO_ERR;
+}
+
+/* everything that the loader writes, from .dynamic and the relocation tables */
+static int collect_fixups(live_object_t *obj, fixup_list_t *list) {
+    Elf *elf = &obj->elf;
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    Elf64_Phdr dynamic = {0};
+    reloc_info_t info;
+
+    if (reloc_info(elf, &info) != NO_ERR) {
+        return NO_ERR;
+    }
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(elf, i, &phdr) == NO_ERR && phdr.p_type == PT_DYNAMIC) {
+            dynamic = phdr;
+        }
+    }
+
+    /* glibc rebases the pointers in .dynamic, and DT_DEBUG is filled in */
+    size_t word = info.word;
+    for (uint64_t off = 0; off + word * 2 <= dynamic.p_filesz; off += word * 2) {
+        uint8_t *p = elf->mem + dynamic.p_offset + off;
+        int64_t tag = word == 4? *(int32_t *)p: *(int64_t *)p;
+        uint64_t val = word == 4? *(uint32_t *)(p + 4): *(uint64_t *)(p + 8);
+        live_fixup_t *f = fixup_add(list, dynamic.p_vaddr + off + word, tag == DT_DEBUG? FIX_MASK: FIX_ALT);
+        if (!f) {
+            return ERR_MEM;
+        }
+        f->value = val + obj->bias;
+        if (tag == DT_NULL) {
+            break;
+        }
+    }
+    /* GOT[1] and GOT[2] hold the link map and the lazy resolver */
+    if (info.pltgot) {
+        if (!fixup_add(list, info.pltgot + word, FIX_MASK) || !fixup_add(list, info.pltgot + word * 2, FIX_MASK)) {
+            return ERR_MEM;
+        }
+    }
+
+    list->bias = obj->bias;
+    int err = reloc_foreach(elf, &info, add_reloc, list);
+    if (err != NO_ERR) {
+        return err;
+    }
+    qsort(list->items, list->count, sizeof(live_fixup_t), fixup_cmp);
+    return NO_ERR;
+}
+
+/* first fixup at or after addr */
+static size_t fixup_lower(fixup_list_t *list, uint64_t addr) {
+    size_t lo = 0, hi = list->count;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (list->items[mid].addr < addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void put_word(uint8_t *p, uint64_t value, size_t word) {
+    if (word == 4) {
+        *(uint32_t *)p = value;
+    } else {
+        *(uint64_t *)p = value;
+    }
+}
+
+static uint64_t get_word(uint8_t *p, size_t word) {
+    return word == 4? *(uint32_t *)p: *(uint64_t *)p;
+}
+
+/* compare [start, end) of the link-time image, file bytes at offset */
+static int compare_run(live_t *lp, live_object_t *obj, fixup_list_t *list, uint64_t start, uint64_t end,
+                       uint64_t offset, uint8_t *mem, uint8_t *expect) {
+    size_t word = obj->elf.class == ELFCLASS32? 4: 8;
+    size_t len = end - start;
+
+    if (pread(lp->mem, mem, len, obj->bias + start) != len) {
+        return NO_ERR;
+    }
+    memcpy(expect, obj->elf.mem + offset, len);
+    for (size_t i = fixup_lower(list, start); i < list->count && list->items[i].addr + word <= end; i++) {
+        live_fixup_t *f = &list->items[i];
+        uint8_t *e = expect + (f->addr - start);
+        uint8_t *m = mem + (f->addr - start);
+        switch (f->kind) {
+            case FIX_VALUE:
+                put_word(e, f->value, word);
+                break;
+            case FIX_ALT:
+                if (get_word(m, word) == (f->value & (word == 4? 0xffffffffULL: ~0ULL))) {
+                    memcpy(e, m, word);
+                }
+                break;
+            default:
+                /* symbol slots are checked on their own */
+                memcpy(e, m, word);
+                break;
+        }
+    }
+
+    for (uint64_t page = start; page < end; ) {
+        uint64_t page_end = (page | (lp->page - 1)) + 1;
+        size_t n = (page_end > end? end: page_end) - page;
+        uint8_t *m = mem + (page - start), *e = expect + (page - start);
+        obj->compared++;
+        if (memcmp(m, e, n)) {
+            size_t first = n, diff = 0;
+            for (size_t i = 0; i < n; i++) {
+                if (m[i] != e[i]) {
+                    first = first < i? first: i;
+                    diff++;
+                }
+            }
+            obj->modified++;
+            if (finding_add(obj, LIVE_MODIFIED, obj->bias + page + first, diff, 0, NULL) != NO_ERR) {
+                return ERR_MEM;
+            }
+        }
+        page = page_end;
+    }
+    return NO_ERR;
+}
+
+/* only copy-on-write pages can differ from the page cache */
+static int compare_region(live_t *lp, live_object_t *obj, fixup_list_t *list, uint64_t start, uint64_t end,
+                          uint64_t offset, uint8_t *mem, uint8_t *expect) {
+    uint64_t mask = lp->page - 1;
+    uint64_t first = (obj->bias + start) & ~mask, last = (obj->bias + end + mask) & ~mask;
+    size_t npages = (last - first) / lp->page;
+    uint64_t *pm = NULL;
+
+    if (start >= end) {
+        return NO_ERR;
+    }
+    obj->pages += npages;
+    if (lp->pagemap >= 0) {
+        pm = malloc(npages * sizeof(uint64_t));
+        if (pm && pread(lp->pagemap, pm, npages * sizeof(uint64_t), first / lp->page * sizeof(uint64_t)) !=
+            npages * sizeof(uint64_t)) {
+            free(pm);
+            pm = NULL;
+        }
+    }
+
+    for (size_t i = 0; i < npages; ) {
+        /* a run of pages that need to be read, no longer than LIVE_READ_MAX */
+        if (pm && !(pm[i] & PM_SWAP) && (!(pm[i] & PM_PRESENT) || (pm[i] & PM_FILE))) {
+            i++;
+            continue;
+        }
+        size_t j = i + 1;
+        while (j < npages && (j - i) * lp->page < LIVE_READ_MAX &&
+               (!pm || (pm[j] & PM_SWAP) || ((pm[j] & PM_PRESENT) && !(pm[j] & PM_FILE)))) {
+            j++;
+        }
+        uint64_t s = first + i * lp->page - obj->bias, e = first + j * lp->page - obj->bias;
+        s = s < start? start: s;
+        e = e > end? end: e;
+        int err = compare_run(lp, obj, list, s, e, offset + (s - start), mem, expect);
+        if (err != NO_ERR) {
+            free(pm);
+            return err;
+        }
+        i = j;
+    }
+    free(pm);
+    return NO_ERR;
+}
+
+/* GOT slots, and pointers which can not be written after RELRO is protected */
+static bool is_slot(live_fixup_t *f, Elf64_Phdr *relro) {
+    if (f->kind != FIX_SLOT && f->kind != FIX_IRELATIVE) {
+        return false;
+    }
+    return f->got || (f->addr >= relro->p_vaddr && f->addr < relro->p_vaddr + relro->p_memsz);
+}
+
+/* read the symbol slots in clusters and check where they point */
+static int check_slots(live_t *lp, live_object_t *obj, fixup_list_t *list, Elf64_Phdr *relro, uint8_t *mem) {
+    size_t word = obj->elf.class == ELFCLASS32? 4: 8;
+
+    for (size_t i = 0; i < list->count; ) {
+        if (!is_slot(&list->items[i], relro)) {
+            i++;
+            continue;
+        }
+        uint64_t start = list->items[i].addr;
+        size_t j = i + 1, last = i;
+        for (; j < list->count; j++) {
+            live_fixup_t *f = &list->items[j];
+            if (f->addr + word - start > LIVE_READ_MAX || f->addr - list->items[last].addr > lp->page) {
+                break;
+            }
+            if (is_slot(f, relro)) {
+                last = j;
+            }
+        }
+        size_t len = list->items[last].addr + word - start;
+        if (pread(lp->mem, mem, len, obj->bias + start) == len) {
+            for (size_t k = i; k <= last; k++) {
+                live_fixup_t *f = &list->items[k];
+                if (!is_slot(f, relro)) {
+                    continue;
+                }
+                uint64_t value = get_word(mem + (f->addr - start), word);
+                obj->slots++;
+                if (!slot_ok(lp, obj, f, value)) {
+                    obj->redirected++;
+                    if (finding_add(obj, LIVE_REDIRECTED, obj->bias + f->addr, word, value,
+                                    f->symbol? f->symbol: "<irelative>") != NO_ERR) {
+                        return ERR_MEM;
+                    }
+                }
+            }
+        }
+        i = last + 1;
+    }
+    return NO_ERR;
+}
+
+static void compare_task(void *arg, size_t index) {
+    live_t *lp = (live_t *)arg;
+    live_object_t *obj = &lp->objects[index];
+    Elf *elf = &obj->elf;
+    fixup_list_t list = {0};
+    Elf64_Phdr relro = {0};
+    int phnum;
+    uint8_t *mem = malloc(LIVE_READ_MAX + 16), *expect = malloc(LIVE_READ_MAX + 16);
+
+    if (!obj->loaded || obj->skipped) {
+        goto out;
+    }
+    if (!mem || !expect || collect_fixups(obj, &list) != NO_ERR) {
+        obj->skipped = "out of memory";
+        goto out;
+    }
+    phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(elf, i, &phdr) == NO_ERR && phdr.p_type == PT_GNU_RELRO) {
+            relro = phdr;
+        }
+    }
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        uint64_t start, end;
+        if (get_segment_by_index(elf, i, &phdr) != NO_ERR || phdr.p_type != PT_LOAD ||
+            phdr.p_offset + phdr.p_filesz > elf->size) {
+            continue;
+        }
+        start = phdr.p_vaddr;
+        end = phdr.p_vaddr + phdr.p_filesz;
+        if (phdr.p_flags & PF_W) {
+            /* only RELRO is read-only after loading */
+            if (obj->loader) {
+                continue;
+            }
+            start = start > relro.p_vaddr? start: relro.p_vaddr;
+            end = end < relro.p_vaddr + relro.p_memsz? end: relro.p_vaddr + relro.p_memsz;
+            if (!relro.p_memsz || start >= end) {
+                continue;
+            }
+        }
+        if (compare_region(lp, obj, &list, start, end, phdr.p_offset + (start - phdr.p_vaddr), mem, expect) != NO_ERR) {
+            obj->skipped = "out of memory";
+            goto out;
+        }
+    }
+    if (check_slots(lp, obj, &list, &relro, mem) != NO_ERR) {
+        obj->skipped = "out of memory";
+    }
+
+out:
+    free(list.items);
+    free(mem);
+    free(expect);
+}
+
+/* .text+0x10, or the segment offset when no section covers addr */
+static void describe(live_object_t *obj, uint64_t vaddr, char *buf, size_t size) {
+    Elf *elf = &obj->elf;
+    int shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    int shstrndx = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shstrndx: elf->data.elf64.ehdr->e_shstrndx;
+    Elf64_Shdr shdr, strtab;
+
+    if (get_section_by_index(elf, shstrndx, &strtab) == NO_ERR && strtab.sh_offset + strtab.sh_size <= elf->size) {
+        for (int i = 0; i < shnum; i++) {
+            if (get_section_by_index(elf, i, &shdr) != NO_ERR || !(shdr.sh_flags & SHF_ALLOC) ||
+                shdr.sh_type == SHT_NOBITS || vaddr < shdr.sh_addr || vaddr >= shdr.sh_addr + shdr.sh_size ||
+                shdr.sh_name >= strtab.sh_size) {
+                continue;
+            }
+            snprintf(buf, size, "%s+0x%lx", elf->mem + strtab.sh_offset + shdr.sh_name, vaddr - shdr.sh_addr);
+            return;
+        }
+    }
+    snprintf(buf, size, "0x%lx", vaddr);
+}
+
+/* where a redirected slot points to */
+static void describe_target(live_t *lp, uint64_t value, char *buf, size_t size) {
+    live_object_t *target = find_object(lp, value);
+    live_map_t *map;
+    if (target) {
+        char where[64];
+        describe(target, value - target->bias, where, sizeof(where));
+        snprintf(buf, size, "%s %s", basename(target->path), where);
+    } else if ((map = find_map(lp, value))) {
+        snprintf(buf, size, "%s", map->name[0]? map->name: "[anonymous]");
+    } else {
+        snprintf(buf, size, "[unmapped]");
+    }
+}
+
+static int finding_cmp(const void *a, const void *b) {
+    const live_finding_t *x = a, *y = b;
+    return x->addr < y->addr? -1: x->addr > y->addr;
+}
+
+static void live_print(live_t *lp) {
+    size_t pages = 0, compared = 0, modified = 0, slots = 0, redirected = 0;
+    int compared_objects = 0;
+    char where[96], target[MAX_PATH_LEN + 96];
+
+    PRINT_INFO("pid %d: %d mapped objects\n", lp->pid, lp->nobjects);
+    printf("    %-10s %-16s %-24s %-28s %s\n", "Kind", "Address", "Object", "Location", "Detail");
+    for (int i = 0; i < lp->nobjects; i++) {
+        live_object_t *obj = &lp->objects[i];
+        if (obj->skipped == not_elf) {
+            continue;
+        }
+        if (obj->skipped) {
+            CHECK_WARNING("    %-10s %-16s %-24s %-28s %s\n", "skipped", "-", basename(obj->path), "-", obj->skipped);
+            continue;
+        }
+        compared_objects++;
+        pages += obj->pages;
+        compared += obj->compared;
+        modified += obj->modified;
+        slots += obj->slots;
+        redirected += obj->redirected;
+        qsort(obj->findings, obj->nfindings, sizeof(live_finding_t), finding_cmp);
+        for (int j = 0; j < obj->nfindings; j++) {
+            live_finding_t *f = &obj->findings[j];
+            describe(obj, f->addr - obj->bias, where, sizeof(where));
+            if (f->kind == LIVE_MODIFIED) {
+                CHECK_ERROR("    %-10s %016lx %-24s %-28s %lu bytes differ\n", "modified", f->addr,
+                    basename(obj->path), where, f->size);
+            } else {
+                describe_target(lp, f->value, target, sizeof(target));
+                CHECK_ERROR("    %-10s %016lx %-24s %-28s %s -> %016lx %s\n", "redirected", f->addr,
+                    basename(obj->path), where, f->symbol, f->value, target);
+            }
+        }
+    }
+    PRINT_INFO("%d objects compared, %lu of %lu read-only pages were copied on write, %lu symbol slots checked\n",
+        compared_objects, compared, pages, slots);
+    if (modified || redirected) {
+        PRINT_WARNING("%lu modified pages, %lu redirected slots\n", modified, redirected);
+    }
+}
+
+int live_compare(pid_t pid, int workers) {
+    live_t lp = {0};
+    char path[64];
+    int err, findings = 0;
+
+    lp.pid = pid;
+    lp.page = sysconf(_SC_PAGESIZE);
+    lp.pagemap = -1;
+    snprintf(path, sizeof(path), "/proc/%d/mem", pid);
+    lp.mem = open(path, O_RDONLY);
+    if (lp.mem < 0) {
+        return ERR_FILE_OPEN;
+    }
+    /* without pagemap every page is compared */
+    snprintf(path, sizeof(path), "/proc/%d/pagemap", pid);
+    lp.pagemap = open(path, O_RDONLY);
+
+    err = read_maps(&lp);
+    if (err != NO_ERR) {
+        goto out;
+    }
+    pool_run(workers, lp.nobjects, load_task, &lp);
+    find_loader(&lp);
+    lp.by_start = malloc((lp.nobjects + 1) * sizeof(live_object_t *));
+    if (!lp.by_start) {
+        err = ERR_MEM;
+        goto out;
+    }
+    for (int i = 0; i < lp.nobjects; i++) {
+        lp.by_start[i] = &lp.objects[i];
+    }
+    qsort(lp.by_start, lp.nobjects, sizeof(live_object_t *), object_start_cmp);
+    pool_run(workers, lp.nobjects, compare_task, &lp);
+
+    live_print(&lp);
+    for (int i = 0; i < lp.nobjects; i++) {
+        findings += lp.objects[i].nfindings;
+    }
+    err = findings;
+
+out:
+    for (int i = 0; i < lp.nobjects; i++) {
+        live_object_t *obj = &lp.objects[i];
+        if (obj->loaded) {
+            finit(&obj->elf);
+        }
+        free(obj->syms);
+        free(obj->by_hash);
+        free(obj->findings);
+    }
+    for (int i = 0; i < lp.nmaps; i++) {
+        free(lp.maps[i].name);
+    }
+    free(lp.maps);
+    free(lp.objects);
+    free(lp.by_start);
+    close(lp.mem);
+    if (lp.pagemap >= 0) {
+        close(lp.pagemap);
+    }
+    return err;
+}
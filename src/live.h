@@ -0,0 +1,62 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#ifndef __LIVE_H
+#define __LIVE_H
+
+/* the largest single read from /proc/pid/mem */
+#define LIVE_READ_MAX       (1 << 20)
+
+/* what was found in the loaded image */
+enum LIVE_KIND {
+    LIVE_MODIFIED,          // a read-only or RELRO page differs from the file
+    LIVE_REDIRECTED,        // a symbol slot does not point to its symbol
+};
+
+typedef struct LiveFinding {
+    int kind;               // enum LIVE_KIND
+    uint64_t addr;          // runtime address, first differing byte for pages
+    uint64_t size;          // number of differing bytes in the page
+    uint64_t value;         // content of a redirected slot
+    const char *symbol;     // symbol of a redirected slot
+} live_finding_t;
+
+/**
+ * @brief 将进程中加载的ELF对象与磁盘文件对比：按/proc/pid/pagemap只读取写时复制过的页，
+ * 对只读段和RELRO区域施加预期的重定位后逐字节比较，并检查每个符号槽是否指向其符号
+ * compare the elf objects loaded in a process with their files on disk. Only
+ * the copy-on-write pages of the read-only and RELRO regions can differ, they
+ * are read from /proc/pid/mem in batches and compared after the expected
+ * relocations are applied. Every symbol slot must point to its symbol in the
+ * object that it resolves into
+ * @param pid process id
+ * @param workers worker count, <= 0 means one per CPU
+ * @return number of findings, or error code
+ */
+int live_compare(pid_t pid, int workers);
+
+#endif
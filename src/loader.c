@@ -0,0 +1,675 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <elf.h>
+#include <stdbool.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "reloc.h"
+#include "resolve.h"
+#include "loader.h"
+
+#define PAGE_FLOOR(x) ((x) & ~(uint64_t)(ONE_PAGE - 1))
+#define PAGE_CEIL(x) (((x) + ONE_PAGE - 1) & ~(uint64_t)(ONE_PAGE - 1))
+
+enum LOADER_STAT {
+    ST_RELATIVE,            // RELATIVE and RELR
+    ST_LOCAL,               // symbol defined by the object itself
+    ST_BOUND,               // symbol defined by a dependency
+    ST_LAZY,                // JUMP_SLOT left to the lazy resolver
+    ST_WEAK,                // undefined weak symbol, 0
+    ST_UNRESOLVED,
+    ST_IFUNC,               // the resolver address was written, it can not be called
+    ST_COPY,
+    ST_SKIPPED,             // TLS and unknown types
+    ST_MAX,
+};
+
+static const char *stat_names[] = {
+    "relative", "local", "bound", "lazy", "weak", "unresolved", "ifunc", "copy", "skipped",
+};
+
+typedef struct Loader {
+    Elf *elf;
+    uint8_t *image;         // output bytes of address lo
+    uint64_t lo;            // page aligned link-time range of the PT_LOAD segments
+    uint64_t hi;
+    uint64_t bias;
+    size_t word;
+    uint8_t *touched;       // one flag per page of the image
+    size_t touched_count;
+    scope_t scope;          // load order, when a sysroot is given
+    bool bind;
+    uint64_t *bases;        // load bias of each object of the scope
+    size_t stat[ST_MAX];
+} loader_t;
+
+static void touch(loader_t *ld, uint64_t vaddr, uint64_t len) {
+    for (uint64_t p = PAGE_FLOOR(vaddr); p < vaddr + len; p += ONE_PAGE) {
+        size_t i = (p - ld->lo) / ONE_PAGE;
+        if (!ld->touched[i]) {
+            ld->touched[i] = 1;
+            ld->touched_count++;
+        }
+    }
+}
+
+static bool is_zero(const uint8_t *p, size_t n) {
+    return !n || (!p[0] && !memcmp(p, p + 1, n - 1));
+}
+
+/* map one PT_LOAD like ld.so, whole pages from the file, then zero the tail of the last page */
+static void map_segment(loader_t *ld, Elf64_Phdr *phdr) {
+    uint64_t start = PAGE_FLOOR(phdr->p_vaddr), end = phdr->p_vaddr + phdr->p_filesz;
+    uint64_t offset = phdr->p_offset - (phdr->p_vaddr - start);
+
+    for (uint64_t p = start; p < end; p += ONE_PAGE) {
+        uint64_t n = end - p < ONE_PAGE? end - p: ONE_PAGE;
+        uint64_t off = offset + (p - start);
+        if (off >= ld->elf->size) {
+            break;
+        }
+        n = off + n > ld->elf->size? ld->elf->size - off: n;
+        /* pages of zeros stay holes in the output */
+        if (is_zero(ld->elf->mem + off, n) && !ld->touched[(p - ld->lo) / ONE_PAGE]) {
+            continue;
+        }
+        memcpy(ld->image + (p - ld->lo), ld->elf->mem + off, n);
+        touch(ld, p, n);
+    }
+    if (phdr->p_memsz > phdr->p_filesz && ld->touched[(PAGE_FLOOR(end) - ld->lo) / ONE_PAGE]) {
+        memset(ld->image + (end - ld->lo), 0, PAGE_CEIL(end) - end);
+    }
+}
+
+static bool put_word(loader_t *ld, uint64_t vaddr, uint64_t value) {
+    if (vaddr < ld->lo || vaddr + ld->word > ld->hi) {
+        return false;
+    }
+    if (ld->word == 4) {
+        *(uint32_t *)(ld->image + (vaddr - ld->lo)) = value;
+    } else {
+        *(uint64_t *)(ld->image + (vaddr - ld->lo)) = value;
+    }
+    touch(ld, vaddr, ld->word);
+    return true;
+}
+
+/* lay the dependencies out after the image */
+static int place_scope(loader_t *ld) {
+    uint64_t next = ld->hi + ld->bias;
+
+    ld->bases = calloc(ld->scope.count, sizeof(uint64_t));
+    if (!ld->bases) {
+        return ERR_MEM;
+    }
+    ld->bases[0] = ld->bias;
+    for (uint32_t k = 1; k < ld->scope.count; k++) {
+        Elf *elf = &ld->scope.objs[k]->elf;
+        int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+        uint64_t lo = UINT64_MAX, hi = 0;
+        for (int i = 0; i < phnum; i++) {
+            Elf64_Phdr phdr;
+            if (get_segment_by_index(elf, i, &phdr) == NO_ERR && phdr.p_type == PT_LOAD) {
+                lo = phdr.p_vaddr < lo? phdr.p_vaddr: lo;
+                hi = phdr.p_vaddr + phdr.p_memsz > hi? phdr.p_vaddr + phdr.p_memsz: hi;
+            }
+        }
+        if (lo == UINT64_MAX) {
+            continue;
+        }
+        next = (next + LOADER_DSO_ALIGN - 1) & ~(uint64_t)(LOADER_DSO_ALIGN - 1);
+        ld->bases[k] = next - PAGE_FLOOR(lo);
+        next += PAGE_CEIL(hi) - PAGE_FLOOR(lo);
+    }
+    return NO_ERR;
+}
+
+/* runtime address of the symbol of a relocation, provider is the index in the scope */
+static bool resolve(loader_t *ld, reloc_t *rel, uint32_t first, uint64_t *addr, int *provider, Elf64_Sym *sym) {
+    if (!rel->name || !*rel->name) {
+        return false;
+    }
+    if (!ld->bind) {
+        if (rel->symbol.st_shndx == SHN_UNDEF || first > 0) {
+            return false;
+        }
+        *sym = rel->symbol;
+        *provider = 0;
+        *addr = (sym->st_shndx == SHN_ABS? 0: ld->bias) + sym->st_value;
+        return true;
+    }
+    char *version = dso_sym_version(ld->scope.objs[0], rel->sym);
+    uint32_t hash = dl_new_hash(rel->name);
+    for (uint32_t k = first; k < ld->scope.count; k++) {
+        bool mismatch = false;
+        int index = dso_lookup(ld->scope.objs[k], rel->name, hash, version, &mismatch);
+        if (index >= 0) {
+            dso_sym(ld->scope.objs[k], index, sym);
+            *provider = k;
+            *addr = (sym->st_shndx == SHN_ABS? 0: ld->bases[k]) + sym->st_value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* the initial data of a symbol, zeros past p_filesz */
+static bool copy_symbol(Elf *src, Elf64_Sym *sym, uint8_t *dest) {
+    int phnum = src->class == ELFCLASS32? src->data.elf32.ehdr->e_phnum: src->data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(src, i, &phdr) != NO_ERR || phdr.p_type != PT_LOAD ||
+            sym->st_value < phdr.p_vaddr || sym->st_value + sym->st_size > phdr.p_vaddr + phdr.p_memsz) {
+            continue;
+        }
+        uint64_t rel = sym->st_value - phdr.p_vaddr;
+        uint64_t n = rel >= phdr.p_filesz? 0: phdr.p_filesz - rel;
+        n = n > sym->st_size? sym->st_size: n;
+        if (n && phdr.p_offset + rel + n > src->size) {
+            return false;
+        }
+        if (n) {
+            memcpy(dest, src->mem + phdr.p_offset + rel, n);
+        }
+        memset(dest + n, 0, sym->st_size - n);
+        return true;
+    }
+    return false;
+}
+
+static int apply_reloc(void *arg, reloc_t *rel) {
+    loader_t *ld = (loader_t *)arg;
+    Elf64_Sym sym;
+    uint64_t addr;
+    int provider, st;
+
+    switch (rel->klass) {
+        case RELOC_RELATIVE:
+            st = put_word(ld, rel->offset, ld->bias + rel->addend)? ST_RELATIVE: ST_SKIPPED;
+            break;
+        case RELOC_IRELATIVE:
+            st = put_word(ld, rel->offset, ld->bias + rel->addend)? ST_IFUNC: ST_SKIPPED;
+            break;
+        case RELOC_GLOB_DAT:
+        case RELOC_JUMP_SLOT:
+        case RELOC_ABS:
+            if (!rel->sym) {
+                st = put_word(ld, rel->offset, rel->addend)? ST_RELATIVE: ST_SKIPPED;
+            } else if (ELF64_ST_TYPE(rel->symbol.st_info) == STT_TLS) {
+                st = ST_SKIPPED;
+            } else if (resolve(ld, rel, 0, &addr, &provider, &sym)) {
+                st = ELF64_ST_TYPE(sym.st_info) == STT_GNU_IFUNC? ST_IFUNC: provider? ST_BOUND: ST_LOCAL;
+                st = put_word(ld, rel->offset, addr + rel->addend)? st: ST_SKIPPED;
+            } else if (rel->klass == RELOC_JUMP_SLOT) {
+                /* what ld.so does for a lazy slot, rebase the PLT stub address */
+                st = put_word(ld, rel->offset, rel->value + ld->bias)? ST_LAZY: ST_SKIPPED;
+            } else if (ELF64_ST_BIND(rel->symbol.st_info) == STB_WEAK) {
+                st = put_word(ld, rel->offset, rel->addend)? ST_WEAK: ST_SKIPPED;
+            } else {
+                st = ST_UNRESOLVED;
+            }
+            break;
+        case RELOC_COPY:
+            /* the executable itself is not searched for the source of a copy */
+            st = ST_UNRESOLVED;
+            if (ld->bind && resolve(ld, rel, 1, &addr, &provider, &sym) &&
+                rel->offset >= ld->lo && rel->offset + sym.st_size <= ld->hi &&
+                copy_symbol(&ld->scope.objs[provider]->elf, &sym, ld->image + (rel->offset - ld->lo))) {
+                touch(ld, rel->offset, sym.st_size);
+                st = ST_COPY;
+            }
+            break;
+        default:
+            st = ST_SKIPPED;
+            break;
+    }
+    if (st == ST_UNRESOLVED && ld->bind) {
+        PRINT_VERBOSE("unresolved: %s\n", rel->name? rel->name: "");
+    }
+    ld->stat[st]++;
+    return NO_ERR;
+}
+
+static void put_ehdr(uint8_t *p, int class, Elf64_Ehdr *e) {
+    if (class == ELFCLASS64) {
+        memcpy(p, e, sizeof(Elf64_Ehdr));
+        return;
+    }
+    Elf32_Ehdr *h = (Elf32_Ehdr *)p;
+    memcpy(h->e_ident, e->e_ident, EI_NIDENT);
+    h->e_type = e->e_type;
+    h->e_machine = e->e_machine;
+    h->e_version = e->e_version;
+    h->e_entry = e->e_entry;
+    h->e_phoff = e->e_phoff;
+    h->e_shoff = e->e_shoff;
+    h->e_flags = e->e_flags;
+    h->e_ehsize = sizeof(Elf32_Ehdr);
+    h->e_phentsize = sizeof(Elf32_Phdr);
+    h->e_phnum = e->e_phnum;
+    h->e_shentsize = sizeof(Elf32_Shdr);
+    h->e_shnum = e->e_shnum;
+    h->e_shstrndx = e->e_shstrndx;
+}
+
+static void put_phdr(uint8_t *p, int class, Elf64_Phdr *ph) {
+    if (class == ELFCLASS64) {
+        memcpy(p, ph, sizeof(Elf64_Phdr));
+        return;
+    }
+    Elf32_Phdr *h = (Elf32_Phdr *)p;
+    h->p_type = ph->p_type;
+    h->p_offset = ph->p_offset;
+    h->p_vaddr = ph->p_vaddr;
+    h->p_paddr = ph->p_paddr;
+    h->p_filesz = ph->p_filesz;
+    h->p_memsz = ph->p_memsz;
+    h->p_flags = ph->p_flags;
+    h->p_align = ph->p_align;
+}
+
+static void put_shdr(uint8_t *p, int class, Elf64_Shdr *sh) {
+    if (class == ELFCLASS64) {
+        memcpy(p, sh, sizeof(Elf64_Shdr));
+        return;
+    }
+    Elf32_Shdr *h = (Elf32_Shdr *)p;
+    h->sh_name = sh->sh_name;
+    h->sh_type = sh->sh_type;
+    h->sh_flags = sh->sh_flags;
+    h->sh_addr = sh->sh_addr;
+    h->sh_offset = sh->sh_offset;
+    h->sh_size = sh->sh_size;
+    h->sh_link = sh->sh_link;
+    h->sh_info = sh->sh_info;
+    h->sh_addralign = sh->sh_addralign;
+    h->sh_entsize = sh->sh_entsize;
+}
+
+static void put_sym(uint8_t *p, int class, Elf64_Sym *s) {
+    if (class == ELFCLASS64) {
+        memcpy(p, s, sizeof(Elf64_Sym));
+        return;
+    }
+    Elf32_Sym *h = (Elf32_Sym *)p;
+    h->st_name = s->st_name;
+    h->st_value = s->st_value;
+    h->st_size = s->st_size;
+    h->st_info = s->st_info;
+    h->st_other = s->st_other;
+    h->st_shndx = s->st_shndx;
+}
+
+/* the relocations are applied, nothing should process them again */
+static bool is_dynamic_section(uint32_t type) {
+    switch (type) {
+        case SHT_DYNAMIC: case SHT_DYNSYM: case SHT_HASH: case SHT_GNU_HASH: case SHT_REL: case SHT_RELA:
+        case SHT_GNU_versym: case SHT_GNU_verdef: case SHT_GNU_verneed: case 19: // SHT_RELR
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool keep_segment(uint32_t type) {
+    return type == PT_LOAD || type == PT_TLS || type == PT_NOTE || type == PT_GNU_EH_FRAME ||
+           type == PT_GNU_STACK || type == PT_GNU_RELRO;
+}
+
+/* layout of the ET_EXEC output, [headers][image][symtab][strtab][shstrtab][shdr] */
+typedef struct ElfLayout {
+    uint64_t header;        // size of the header pages
+    int phnum;
+    int shnum;              // output sections, 0 when the input has none
+    int *newidx;            // input section index to output index, 0 if dropped
+    int symsec;             // input symbol table, -1 if none
+    int strsec;             // its string table
+    bool copy_str;          // the string table is not in the image
+    int shstrsec;
+    uint64_t sym_off;
+    uint64_t str_off;
+    uint64_t shstr_off;
+    uint64_t shoff;
+    uint64_t size;
+} elf_layout_t;
+
+static int elf_layout(loader_t *ld, elf_layout_t *lay) {
+    Elf *elf = ld->elf;
+    int class = elf->class;
+    int phnum = class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    int shnum = class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    size_t ehsize = class == ELFCLASS32? sizeof(Elf32_Ehdr): sizeof(Elf64_Ehdr);
+    size_t phsize = class == ELFCLASS32? sizeof(Elf32_Phdr): sizeof(Elf64_Phdr);
+    size_t shsize = class == ELFCLASS32? sizeof(Elf32_Shdr): sizeof(Elf64_Shdr);
+    Elf64_Shdr shdr;
+
+    memset(lay, 0, sizeof(elf_layout_t));
+    lay->symsec = lay->strsec = lay->shstrsec = -1;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(elf, i, &phdr) == NO_ERR && keep_segment(phdr.p_type)) {
+            lay->phnum++;
+        }
+    }
+    lay->header = PAGE_CEIL(ehsize + lay->phnum * phsize);
+    lay->size = lay->header + (ld->hi - ld->lo);
+
+    lay->shstrsec = class == ELFCLASS32? elf->data.elf32.ehdr->e_shstrndx: elf->data.elf64.ehdr->e_shstrndx;
+    if (!shnum || get_section_by_index(elf, lay->shstrsec, &shdr) != NO_ERR || shdr.sh_offset + shdr.sh_size > elf->size) {
+        return NO_ERR;
+    }
+    lay->newidx = calloc(shnum, sizeof(int));
+    if (!lay->newidx) {
+        return ERR_MEM;
+    }
+    lay->shnum = 1;
+    for (int i = 1; i < shnum; i++) {
+        if (get_section_by_index(elf, i, &shdr) != NO_ERR) {
+            continue;
+        }
+        if ((shdr.sh_flags & SHF_ALLOC) && shdr.sh_addr >= ld->lo && shdr.sh_addr + shdr.sh_size <= ld->hi) {
+            lay->newidx[i] = lay->shnum++;
+        }
+        if (shdr.sh_type == SHT_SYMTAB || (shdr.sh_type == SHT_DYNSYM && lay->symsec < 0)) {
+            lay->symsec = i;
+        }
+    }
+
+    /* the symbol table is copied out of the image and rebased */
+    lay->size = (lay->size + 7) & ~7ULL;
+    if (lay->symsec >= 0 && get_section_by_index(elf, lay->symsec, &shdr) == NO_ERR &&
+        shdr.sh_offset + shdr.sh_size <= elf->size) {
+        lay->sym_off = lay->size;
+        lay->size += shdr.sh_size;
+        lay->strsec = shdr.sh_link;
+        if (get_section_by_index(elf, lay->strsec, &shdr) == NO_ERR && shdr.sh_offset + shdr.sh_size <= elf->size) {
+            lay->copy_str = !lay->newidx[lay->strsec];
+            if (lay->copy_str) {
+                lay->str_off = lay->size;
+                lay->size += shdr.sh_size;
+            }
+        } else {
+            lay->strsec = -1;
+        }
+        lay->shnum += lay->copy_str? 2: 1;
+    } else {
+        lay->symsec = -1;
+    }
+    get_section_by_index(elf, lay->shstrsec, &shdr);
+    lay->shstr_off = lay->size;
+    lay->size = (lay->size + shdr.sh_size + 7) & ~7ULL;
+    lay->shnum++;
+    lay->shoff = lay->size;
+    lay->size += lay->shnum * shsize;
+    return NO_ERR;
+}
+
+static void elf_write(loader_t *ld, elf_layout_t *lay, uint8_t *out) {
+    Elf *elf = ld->elf;
+    int class = elf->class;
+    int phnum = class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    int shnum = class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    size_t ehsize = class == ELFCLASS32? sizeof(Elf32_Ehdr): sizeof(Elf64_Ehdr);
+    size_t phsize = class == ELFCLASS32? sizeof(Elf32_Phdr): sizeof(Elf64_Phdr);
+    size_t shsize = class == ELFCLASS32? sizeof(Elf32_Shdr): sizeof(Elf64_Shdr);
+    size_t symsize = class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    Elf64_Ehdr ehdr;
+    Elf64_Shdr shdr, out_shdr;
+    int nr = 0;
+
+    memset(&ehdr, 0, sizeof(ehdr));
+    memcpy(ehdr.e_ident, elf->mem, EI_NIDENT);
+    ehdr.e_type = ET_EXEC;
+    ehdr.e_machine = class == ELFCLASS32? elf->data.elf32.ehdr->e_machine: elf->data.elf64.ehdr->e_machine;
+    ehdr.e_version = EV_CURRENT;
+    ehdr.e_entry = (class == ELFCLASS32? elf->data.elf32.ehdr->e_entry: elf->data.elf64.ehdr->e_entry) + ld->bias;
+    ehdr.e_flags = class == ELFCLASS32? elf->data.elf32.ehdr->e_flags: elf->data.elf64.ehdr->e_flags;
+    ehdr.e_phoff = ehsize;
+    ehdr.e_ehsize = ehsize;
+    ehdr.e_phentsize = phsize;
+    ehdr.e_phnum = lay->phnum;
+    ehdr.e_shentsize = shsize;
+    ehdr.e_shoff = lay->shnum? lay->shoff: 0;
+    ehdr.e_shnum = lay->shnum;
+    ehdr.e_shstrndx = lay->shnum? lay->shnum - 1: 0;
+    put_ehdr(out, class, &ehdr);
+
+    /* every segment points into the image, bss is part of it */
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(elf, i, &phdr) != NO_ERR || !keep_segment(phdr.p_type)) {
+            continue;
+        }
+        if (phdr.p_type != PT_GNU_STACK) {
+            phdr.p_offset = lay->header + (phdr.p_vaddr - ld->lo);
+            phdr.p_vaddr += ld->bias;
+            phdr.p_paddr += ld->bias;
+            if (phdr.p_type != PT_TLS) {
+                phdr.p_filesz = phdr.p_memsz;
+            }
+            if (phdr.p_type == PT_LOAD) {
+                phdr.p_align = ONE_PAGE;
+            }
+        }
+        put_phdr(out + ehsize + phsize * nr++, class, &phdr);
+    }
+    if (!lay->shnum) {
+        return;
+    }
+
+    uint8_t *sh = out + lay->shoff;
+    memset(sh, 0, shsize);
+    for (int i = 1; i < shnum; i++) {
+        if (!lay->newidx[i] || get_section_by_index(elf, i, &shdr) != NO_ERR) {
+            continue;
+        }
+        out_shdr = shdr;
+        out_shdr.sh_offset = lay->header + (shdr.sh_addr - ld->lo);
+        out_shdr.sh_addr += ld->bias;
+        if (is_dynamic_section(shdr.sh_type)) {
+            out_shdr.sh_type = SHT_PROGBITS;
+            out_shdr.sh_flags &= ~SHF_INFO_LINK;
+            out_shdr.sh_link = out_shdr.sh_info = 0;
+        } else {
+            out_shdr.sh_link = shdr.sh_link < shnum? lay->newidx[shdr.sh_link]: 0;
+            out_shdr.sh_info = shdr.sh_flags & SHF_INFO_LINK && shdr.sh_info < shnum? lay->newidx[shdr.sh_info]: shdr.sh_info;
+        }
+        put_shdr(sh + lay->newidx[i] * shsize, class, &out_shdr);
+    }
+
+    int next = lay->shnum - (lay->symsec >= 0? (lay->copy_str? 3: 2): 1);
+    if (lay->symsec >= 0) {
+        get_section_by_index(elf, lay->symsec, &shdr);
+        size_t count = shdr.sh_size / symsize;
+        for (size_t i = 0; i < count; i++) {
+            Elf64_Sym sym;
+            get_sym_by_table(elf, elf->mem + shdr.sh_offset, i, &sym);
+            if (sym.st_shndx != SHN_UNDEF && sym.st_shndx < SHN_LORESERVE) {
+                if (ELF64_ST_TYPE(sym.st_info) != STT_TLS) {
+                    sym.st_value += ld->bias;
+                }
+                sym.st_shndx = sym.st_shndx < shnum && lay->newidx[sym.st_shndx]? lay->newidx[sym.st_shndx]: SHN_ABS;
+            }
+            put_sym(out + lay->sym_off + i * symsize, class, &sym);
+        }
+        out_shdr = shdr;
+        out_shdr.sh_type = SHT_SYMTAB;
+        out_shdr.sh_flags = 0;
+        out_shdr.sh_addr = 0;
+        out_shdr.sh_offset = lay->sym_off;
+        out_shdr.sh_link = lay->strsec < 0? 0: lay->copy_str? next + 1: lay->newidx[lay->strsec];
+        put_shdr(sh + next++ * shsize, class, &out_shdr);
+        if (lay->copy_str) {
+            get_section_by_index(elf, lay->strsec, &shdr);
+            memcpy(out + lay->str_off, elf->mem + shdr.sh_offset, shdr.sh_size);
+            out_shdr = shdr;
+            out_shdr.sh_offset = lay->str_off;
+            put_shdr(sh + next++ * shsize, class, &out_shdr);
+        }
+    }
+    get_section_by_index(elf, lay->shstrsec, &shdr);
+    memcpy(out + lay->shstr_off, elf->mem + shdr.sh_offset, shdr.sh_size);
+    out_shdr = shdr;
+    out_shdr.sh_offset = lay->shstr_off;
+    put_shdr(sh + next * shsize, class, &out_shdr);
+}
+
+int loader_emulate(char *elf_name, const char *out, uint64_t base, int format, const char *sysroot) {
+    loader_t ld;
+    Elf elf;
+    elf_layout_t lay;
+    reloc_info_t info;
+    resolver_t *resolver = NULL;
+    uint8_t *map = MAP_FAILED;
+    uint64_t size = 0, header = 0;
+    int fd = -1, phnum, err;
+
+    memset(&ld, 0, sizeof(ld));
+    memset(&lay, 0, sizeof(lay));
+    err = init(elf_name, &elf, true);
+    if (err != NO_ERR) {
+        return err;
+    }
+    ld.elf = &elf;
+    ld.word = elf.class == ELFCLASS32? 4: 8;
+    ld.lo = UINT64_MAX;
+    phnum = elf.class == ELFCLASS32? elf.data.elf32.ehdr->e_phnum: elf.data.elf64.ehdr->e_phnum;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(&elf, i, &phdr) == NO_ERR && phdr.p_type == PT_LOAD && phdr.p_memsz) {
+            ld.lo = PAGE_FLOOR(phdr.p_vaddr) < ld.lo? PAGE_FLOOR(phdr.p_vaddr): ld.lo;
+            ld.hi = PAGE_CEIL(phdr.p_vaddr + phdr.p_memsz) > ld.hi? PAGE_CEIL(phdr.p_vaddr + phdr.p_memsz): ld.hi;
+        }
+    }
+    int type = elf.class == ELFCLASS32? elf.data.elf32.ehdr->e_type: elf.data.elf64.ehdr->e_type;
+    if (ld.lo == UINT64_MAX || (type != ET_DYN && type != ET_EXEC)) {
+        err = ERR_ELF_TYPE;
+        goto out;
+    }
+    if (base & (ONE_PAGE - 1)) {
+        err = ERR_ARGS;
+        goto out;
+    }
+    if (type == ET_DYN && base) {
+        ld.bias = base - ld.lo;
+    } else if (type == ET_EXEC && base && base != ld.lo) {
+        PRINT_WARNING("ET_EXEC can not be moved, loaded at 0x%lx\n", ld.lo);
+    }
+
+    if (sysroot) {
+        resolver = calloc(1, sizeof(resolver_t));
+        dso_t *main = resolver? (resolver_init(resolver, sysroot) == NO_ERR? resolver_open(resolver, elf_name): NULL): NULL;
+        if (!main || main->status != NO_ERR || resolver_load_scope(resolver, main, &ld.scope) != NO_ERR ||
+            place_scope(&ld) != NO_ERR) {
+            err = main? ERR_MEM: ERR_FILE_OPEN;
+            goto out;
+        }
+        ld.bind = true;
+        for (uint32_t i = 0; i < ld.scope.missing_count; i++) {
+            PRINT_WARNING("%s not found\n", ld.scope.missing[i]);
+        }
+    }
+
+    /* a sparse file, only the pages written below take space */
+    if (format == LOADER_ELF) {
+        err = elf_layout(&ld, &lay);
+        if (err != NO_ERR) {
+            goto out;
+        }
+        size = lay.size;
+        header = lay.header;
+    } else {
+        size = ld.hi - ld.lo;
+    }
+    ld.touched = calloc((ld.hi - ld.lo) / ONE_PAGE + 1, 1);
+    fd = open(out, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (!ld.touched || fd < 0) {
+        err = ld.touched? ERR_FILE_OPEN: ERR_MEM;
+        goto out;
+    }
+    if (ftruncate(fd, size) < 0 ||
+        (map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+        err = ERR_MEM;
+        goto out;
+    }
+    ld.image = map + header;
+
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(&elf, i, &phdr) == NO_ERR && phdr.p_type == PT_LOAD && phdr.p_memsz) {
+            map_segment(&ld, &phdr);
+        }
+    }
+    if (reloc_info(&elf, &info) == NO_ERR) {
+        reloc_foreach(&elf, &info, apply_reloc, &ld);
+    }
+    if (format == LOADER_ELF) {
+        elf_write(&ld, &lay, map);
+    }
+
+    PRINT_INFO("%s: 0x%lx-0x%lx written to %s, %lu of %lu pages touched\n", elf_name, ld.lo + ld.bias,
+        ld.hi + ld.bias, out, ld.touched_count, (ld.hi - ld.lo) / ONE_PAGE);
+    if (ld.bind) {
+        for (uint32_t k = 1; k < ld.scope.count; k++) {
+            PRINT_VERBOSE("0x%016lx %s\n", ld.bases[k], ld.scope.objs[k]->path);
+        }
+    }
+    printf("    ");
+    for (int i = 0; i < ST_MAX; i++) {
+        printf("%s: %lu%s", stat_names[i], ld.stat[i], i + 1 < ST_MAX? ", ": "\n");
+    }
+    if (ld.stat[ST_UNRESOLVED]) {
+        PRINT_WARNING("%lu symbol relocations are unresolved%s\n", ld.stat[ST_UNRESOLVED],
+            ld.bind? "": ", bind them with -s <sysroot>");
+    }
+    err = NO_ERR;
+
+out:
+    if (map != MAP_FAILED) {
+        munmap(map, size);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (resolver) {
+        if (ld.bind) {
+            scope_fini(&ld.scope);
+        }
+        resolver_fini(resolver);
+        free(resolver);
+    }
+    free(ld.bases);
+    free(ld.touched);
+    free(lay.newidx);
+    finit(&elf);
+    return err;
+}
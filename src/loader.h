@@ -0,0 +1,54 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __LOADER_H
+#define __LOADER_H
+
+/* dependencies are laid out after the image at this alignment */
+#define LOADER_DSO_ALIGN    0x200000
+
+enum LOADER_FORMAT {
+    LOADER_FLAT,            // the memory image from the lowest PT_LOAD page
+    LOADER_ELF,             // an ET_EXEC which maps the image, relocations already applied
+};
+
+/**
+ * @brief 模拟ld.so加载ELF：按页映射PT_LOAD，补零memsz，施加RELATIVE重定位，
+ * 指定sysroot时将符号重定位绑定到依赖库，输出平坦镜像或ET_EXEC格式的ELF。
+ * 输出文件以稀疏方式映射，只写入被触及的页
+ * emulate ld.so: map the PT_LOAD pages, zero fill up to memsz and apply the
+ * RELATIVE relocations. With a sysroot the symbol relocations are bound to
+ * the dependencies, which are laid out after the image. The output is a flat
+ * image or an ET_EXEC elf, mapped sparse so that only touched pages are written
+ * @param elf_name elf file name
+ * @param out output file name
+ * @param base load address of an ET_DYN, 0 for the link address
+ * @param format enum LOADER_FORMAT
+ * @param sysroot root of the dependencies, NULL to bind local symbols only
+ * @return error code
+ */
+int loader_emulate(char *elf_name, const char *out, uint64_t base, int format, const char *sysroot);
+
+#endif
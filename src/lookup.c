@@ -0,0 +1,318 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "resolve.h"
+#include "lookup.h"
+
+/* result of one simulated lookup */
+typedef struct Probe {
+    uint32_t hash;
+    bool bloom;             // passed the bloom filter
+    uint32_t probes;        // chain entries visited
+    uint32_t compares;      // string compares, the chain hash matched
+    int64_t index;          // symbol index, -1 if not found
+} probe_t;
+
+/**
+ * @brief 按照ld.so的do_lookup_x遍历.gnu.hash：bloom过滤、桶、哈希链
+ * walk .gnu.hash the way do_lookup_x of ld.so does: bloom filter, bucket, chain
+ * @param d dso, must have a .gnu.hash
+ * @param name symbol name
+ * @param hash gnu hash of the name
+ * @param p output counters, may be NULL when only the result matters
+ * @return symbol index, or -1 if not defined
+ */
+static int64_t gnu_lookup(dso_t *d, const char *name, uint32_t hash, probe_t *p) {
+    uint32_t bits = d->elf.class == ELFCLASS32? 32: 64;
+    uint32_t *end = (uint32_t *)(d->elf.mem + d->elf.size);
+    Elf64_Sym sym;
+
+    if (p) {
+        memset(p, 0, sizeof(probe_t));
+        p->hash = hash;
+        p->index = -1;
+    }
+    if (d->bloom_size) {
+        uint32_t n = (hash / bits) & (d->bloom_size - 1);
+        uint64_t word = bits == 32? ((uint32_t *)d->bloom)[n]: ((uint64_t *)d->bloom)[n];
+        if (!((word >> (hash % bits)) & (word >> ((hash >> d->bloom_shift) % bits)) & 1)) {
+            return -1;
+        }
+    }
+    if (p) {
+        p->bloom = true;
+    }
+
+    uint32_t i = d->buckets[hash % d->nbuckets];
+    if (i < d->symoffset) {
+        return -1;
+    }
+    uint32_t *hasharr = &d->chain[i - d->symoffset];
+    do {
+        if (hasharr >= end) {
+            break;
+        }
+        if (p) {
+            p->probes++;
+        }
+        if (((*hasharr ^ hash) >> 1) == 0) {
+            if (p) {
+                p->compares++;
+            }
+            uint32_t index = d->symoffset + (hasharr - d->chain);
+            char *s = dso_sym(d, index, &sym);
+            if (is_exported_def(&sym) && !strcmp(s, name)) {
+                if (p) {
+                    p->index = index;
+                }
+                return index;
+            }
+        }
+    } while ((*hasharr++ & 1) == 0);
+    return -1;
+}
+
+static int add_name(char ***list, uint32_t *count, uint32_t *capacity, const char *name) {
+    if (!*name) {
+        return NO_ERR;
+    }
+    if (*count == *capacity) {
+        uint32_t n = *capacity? *capacity * 2: 64;
+        char **p = realloc(*list, n * sizeof(char *));
+        if (!p) {
+            return ERR_MEM;
+        }
+        *list = p;
+        *capacity = n;
+    }
+    (*list)[*count] = strdup(name);
+    if (!(*list)[*count]) {
+        return ERR_MEM;
+    }
+    (*count)++;
+    return NO_ERR;
+}
+
+/**
+ * @brief 收集要查找的名称：-s中的逗号列表，以及名称列表文件或导入方ELF的未定义动态符号
+ * collect the names to look up: the comma list of -s, and a list file or the
+ * undefined dynamic symbols of an importing elf
+ */
+static int collect_names(resolver_t *r, char *names, char *source, char ***list, uint32_t *count) {
+    uint32_t capacity = 0;
+    char line[MAX_PATH_LEN];
+    int err = NO_ERR;
+
+    if (names && *names) {
+        char *copy = strdup(names);
+        if (!copy) {
+            return ERR_MEM;
+        }
+        for (char *s = strtok(copy, ","); s && err == NO_ERR; s = strtok(NULL, ",")) {
+            err = add_name(list, count, &capacity, s);
+        }
+        free(copy);
+    }
+    if (err != NO_ERR || !source || !*source) {
+        return err;
+    }
+
+    FILE *fp = fopen(source, "rb");
+    if (!fp) {
+        return ERR_FILE_OPEN;
+    }
+    size_t n = fread(line, 1, SELFMAG, fp);
+    if (n == SELFMAG && !memcmp(line, ELFMAG, SELFMAG)) {
+        fclose(fp);
+        dso_t *d = resolver_open(r, source);
+        if (!d) {
+            return ERR_FILE_OPEN;
+        }
+        if (d->status != NO_ERR) {
+            return d->status;
+        }
+        for (uint32_t i = 1; i < d->nsyms && err == NO_ERR; i++) {
+            Elf64_Sym sym;
+            char *name = dso_sym(d, i, &sym);
+            if (sym.st_shndx == SHN_UNDEF && ELF64_ST_BIND(sym.st_info) != STB_LOCAL) {
+                err = add_name(list, count, &capacity, name);
+            }
+        }
+        return err;
+    }
+
+    rewind(fp);
+    while (err == NO_ERR && fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        err = add_name(list, count, &capacity, line);
+    }
+    fclose(fp);
+    return err;
+}
+
+static double elapsed_ns(struct timespec *start, struct timespec *stop) {
+    return (stop->tv_sec - start->tv_sec) * 1e9 + (stop->tv_nsec - start->tv_nsec);
+}
+
+/**
+ * @brief 微基准测试：轮流查找所有名称，分别测量预先计算哈希与包含dl_new_hash的耗时
+ * microbenchmark: look up the names round robin, once with precomputed hashes
+ * and once including dl_new_hash
+ */
+static void benchmark(dso_t *d, char **list, uint32_t *hashes, uint32_t count, uint64_t iterations) {
+    struct timespec start, stop;
+    volatile int64_t sink = 0;
+    uint32_t k = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < iterations; i++) {
+        sink += gnu_lookup(d, list[k], hashes[k], NULL);
+        if (++k == count) {
+            k = 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    double lookup = elapsed_ns(&start, &stop);
+
+    k = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint64_t i = 0; i < iterations; i++) {
+        sink += gnu_lookup(d, list[k], dl_new_hash(list[k]), NULL);
+        if (++k == count) {
+            k = 0;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    double hashed = elapsed_ns(&start, &stop);
+
+    PRINT_INFO("benchmark: %lu lookups of %u names\n", iterations, count);
+    printf("    precomputed hash: %.3f ms, %.1f ns per lookup\n", lookup / 1e6, lookup / iterations);
+    printf("    with dl_new_hash: %.3f ms, %.1f ns per lookup\n", hashed / 1e6, hashed / iterations);
+}
+
+/**
+ * @brief 在共享库的.gnu.hash上执行与ld.so相同的符号查找，报告每个名称的探测次数、
+ * bloom命中与未命中，并对查找做微基准测试
+ * run the GNU hash lookup of ld.so against the on-disk table of a shared
+ * object, report the probes and bloom filter result of every name and time
+ * the lookups as a microbenchmark
+ * @param elf_name object that defines the symbols
+ * @param names comma separated symbol names, may be empty
+ * @param source file with one name per line, or an importing elf whose
+ * undefined dynamic symbols are looked up, may be empty
+ * @param iterations lookups of the benchmark, 0 means LOOKUP_ITERATIONS
+ * @return error code
+ */
+int lookup_simulate(char *elf_name, char *names, char *source, uint64_t iterations) {
+    resolver_t r;
+    char **list = NULL;
+    uint32_t *hashes = NULL;
+    uint32_t count = 0;
+    uint32_t found = 0, rejected = 0, false_pos = 0, empty = 0;
+    uint64_t probes = 0, compares = 0, max_probes = 0;
+    probe_t p;
+    int err;
+
+    resolver_init(&r, NULL);
+    dso_t *d = resolver_open(&r, elf_name);
+    if (!d) {
+        err = ERR_FILE_OPEN;
+        goto out;
+    }
+    if (d->status != NO_ERR) {
+        err = d->status;
+        goto out;
+    }
+    if (!d->nbuckets) {
+        PRINT_WARNING("%s: no usable .gnu.hash\n", elf_name);
+        err = ERR_SEC_NOTFOUND;
+        goto out;
+    }
+    err = collect_names(&r, names, source, &list, &count);
+    if (err != NO_ERR) {
+        goto out;
+    }
+    if (!count) {
+        PRINT_WARNING("no names to look up, use -s or -f\n");
+        err = ERR_ARGS;
+        goto out;
+    }
+    hashes = malloc(count * sizeof(uint32_t));
+    if (!hashes) {
+        err = ERR_MEM;
+        goto out;
+    }
+
+    PRINT_INFO("%s: %u buckets, symoffset %u, %u bloom words of %d bits, shift %u\n", elf_name,
+        d->nbuckets, d->symoffset, d->bloom_size, d->elf.class == ELFCLASS32? 32: 64, d->bloom_shift);
+    printf("    [%4s] %-10s %-5s %6s %4s %8s %s\n", "Nr", "Hash", "Bloom", "Probes", "Cmp", "Index", "Name");
+    for (uint32_t i = 0; i < count; i++) {
+        hashes[i] = dl_new_hash(list[i]);
+        gnu_lookup(d, list[i], hashes[i], &p);
+        if (p.index >= 0) {
+            printf("    [%4u] 0x%08x %-5s %6u %4u %8ld %s\n", i, p.hash, p.bloom? "hit": "miss",
+                p.probes, p.compares, p.index, list[i]);
+            found++;
+        } else {
+            printf("    [%4u] 0x%08x %-5s %6u %4u %8s %s\n", i, p.hash, p.bloom? "hit": "miss",
+                p.probes, p.compares, "-", list[i]);
+            if (!p.bloom) {
+                rejected++;
+            } else if (!p.probes) {
+                empty++;
+            } else {
+                false_pos++;
+            }
+        }
+        probes += p.probes;
+        compares += p.compares;
+        if (p.probes > max_probes) {
+            max_probes = p.probes;
+        }
+    }
+
+    PRINT_INFO("%u names: %u found, %u rejected by the bloom filter, %u bloom false positives (%u empty buckets, %u chain misses)\n",
+        count, found, rejected, empty + false_pos, empty, false_pos);
+    printf("    probes: total %lu, mean %.2f, max %lu; string compares: %lu\n",
+        probes, (double)probes / count, max_probes, compares);
+
+    benchmark(d, list, hashes, count, iterations? iterations: LOOKUP_ITERATIONS);
+
+out:
+    for (uint32_t i = 0; i < count; i++) {
+        free(list[i]);
+    }
+    free(list);
+    free(hashes);
+    resolver_fini(&r);
+    return err;
+}
@@ -0,0 +1,46 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __LOOKUP_H
+#define __LOOKUP_H
+
+#define LOOKUP_ITERATIONS   1000000
+
+/**
+ * @brief 在共享库的.gnu.hash上执行与ld.so相同的符号查找，报告每个名称的探测次数、
+ * bloom命中与未命中，并对查找做微基准测试
+ * run the GNU hash lookup of ld.so against the on-disk table of a shared
+ * object, report the probes and bloom filter result of every name and time
+ * the lookups as a microbenchmark
+ * @param elf_name object that defines the symbols
+ * @param names comma separated symbol names, may be empty
+ * @param source file with one name per line, or an importing elf whose
+ * undefined dynamic symbols are looked up, may be empty
+ * @param iterations lookups of the benchmark, 0 means LOOKUP_ITERATIONS
+ * @return error code
+ */
+int lookup_simulate(char *elf_name, char *names, char *source, uint64_t iterations);
+
+#endif
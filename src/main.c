@@ -36,6 +36,23 @@
 #include "edit.h"
 #include "infect.h"
 #include "forensic.h"
+#include "resolve.h"
+#include "batch.h"
+#include "scan.h"
+#include "rule.h"
+#include "got.h"
+#include "detect.h"
+#include "baseline.h"
+#include "watch.h"
+#include "live.h"
+#include "loader.h"
+#include "prelink.h"
+#include "core.h"
+#include "export.h"
+#include "lookup.h"
+#include "size.h"
+#include "diff.h"
+#include "abi.h"
 
 #define VERSION "2.0.0.beta"
 #define CONTENT_LENGTH 1024 * 1024
@@ -61,6 +78,8 @@ uint32_t value;
 uint32_t row;
 uint32_t column;
 uint32_t length;
+int jobs;
+char format[LENGTH];
 parser_opt_t po;
 /* Additional long parameters */
 static int g_long_option;
@@ -85,6 +104,9 @@ enum LONG_OPTION {
     TO_BIN2ELF,
     TO_SCRIPT,
     INJECT_HOOK,
+    PRUNE_NEEDED,
+    SHRINK_RPATH,
+    PRELINK,
 };
 
 /**
@@ -118,9 +140,9 @@ static void init_main() {
     size = 0;
     off = 0;
     err = 0;
-    get_version(ver_elfspirt, LENGTH);
     po.index = 0;
     memset(po.options, 0, sizeof(po.options));
+    filter_init(&po.filter);
 }
 static void init_shellcode() {
     if (strlen(string)) {
@@ -152,6 +174,17 @@ static const struct option longopts[] = {
     {"row", required_argument, NULL, 'i'},
     {"column", required_argument, NULL, 'j'},
     {"length", required_argument, NULL, 'l'},
+    {"jobs", required_argument, NULL, 'J'},
+    {"format", required_argument, NULL, 'F'},
+    {"name", required_argument, NULL, 'N'},
+    {"regex", required_argument, NULL, 'X'},
+    {"type", required_argument, NULL, 'T'},
+    {"bind", required_argument, NULL, 'K'},
+    {"shndx", required_argument, NULL, 'Y'},
+    {"range", required_argument, NULL, 'V'},
+    {"rtype", required_argument, NULL, 'Q'},
+    {"start", required_argument, NULL, 'U'},
+    {"count", required_argument, NULL, 'C'},
     {"edit-pointer", no_argument, &g_long_option, EDIT_POINTER},
     {"edit-hex", no_argument, &g_long_option, EDIT_CONTENT},
     {"edit-extract", no_argument, &g_long_option, EDIT_EXTRACT},
@@ -172,6 +205,9 @@ static const struct option longopts[] = {
     {"to-bin2elf", no_argument, &g_long_option, TO_BIN2ELF},
     {"to-script", no_argument, &g_long_option, TO_SCRIPT},
     {"inject-hook", no_argument, &g_long_option, INJECT_HOOK},
+    {"prune-needed", no_argument, &g_long_option, PRUNE_NEEDED},
+    {"shrink-rpath", no_argument, &g_long_option, SHRINK_RPATH},
+    {"prelink", no_argument, &g_long_option, PRELINK},
     {0, 0, 0, 0}
 };
 
@@ -185,10 +221,14 @@ static const char *help =
     "  edit         Modify ELF file information freely\n"
     "  shellcode    Extract binary fragments and convert shellcode. [extract, hex2bin]\n"
     "  firmware     Add ELF info to firmware or join mutli bin file. [bin2elf, joinelf]\n"
-    "  patch        Patch ELF. [--set-interpreter, --set-rpath, --set-runpath]\n"
+    "  load         Emulate the loader and write the relocated memory image. [load]\n"
+    "  patch        Patch ELF. [--set-interpreter, --set-rpath, --set-runpath, --shrink-rpath, --prune-needed, --prelink]\n"
     "  confuse      Obfuscate ELF symbols. [--rm-section, --rm-shdr, --rm-strip]\n"
     "  infect       Infect ELF like virus. [--infect-silvio, --infect-skeksi, --infect-data, exe2so]\n"
-    "  forensic     Analyze the Legitimacy of ELF File Structure. [checksec]\n"
+    "  forensic     Analyze the Legitimacy of ELF File Structure. [checksec, got, detect, live, core]\n"
+    "  bind         Bind undefined dynamic symbols to libraries in load order. [bind, needed]\n"
+    "  batch        Apply a patch to many files in parallel. [batch]\n"
+    "  integrity    Record ELF fingerprints and verify them later. [baseline, verify, watch]\n"
     "Currently defined options:\n"
     "  -n, --section-name=<section name>         Set section name\n"
     "  -z, --section-size=<section size>         Set section size\n"
@@ -198,11 +238,13 @@ static const char *help =
     "      --value=<math value>                  Reserve value(e.g. 7=111=rwx)\n"
     "  -a, --architecture=<ELF architecture>     ELF architecture\n"
     "  -e, --endian=<ELF endian>                 ELF endian(e.g. little, big, etc.)\n"
-    "  -b, --base=<ELF base address>             ELF base address\n"
+    "  -b, --base=<ELF base address>             ELF base address, hex with 0x, decimal otherwise\n"
     "  -o, --offset=<injection offset>           Offset of injection point\n"
     "  -i, --row=<object index>                  Index of the object to be read or written\n"
     "  -j, --column=<vertical axis>              The vertical axis of the object to be read or written\n"
     "  -l, --length=<string length>              Display the maximum length of the string\n"
+    "      --jobs=<worker count>                 Worker threads of batch functions and large parse tables, default one per CPU\n"
+    "      --format=<json|ndjson|csv|flat|elf>   Output format of parse, the checksec scanner, verify and load\n"
     "  -h, --help[={none|English|Chinese}]       Display this output\n"
     "  -A, (no argument)                         Display all ELF file infomation\n"
     "  -H, (no argument)                         Display | Edit ELF file header\n"
@@ -214,16 +256,46 @@ static const char *help =
     "  -R, (no argument)                         Display | Edit relocation section\n"
     "  -I, (no argument)                         Display | Edit pointer(e.g. .init_array, etc.)\n"
     "  -G, (no argument)                         Display hash table\n"
+    "Filters of parse -B|D|R: \n"
+    "      --name=<glob>                         Symbol name, shell glob, an exact name uses .gnu.hash\n"
+    "      --regex=<regex>                       Symbol name, extended regular expression\n"
+    "      --type=<NOTYPE|OBJECT|FUNC|...>       Symbol type\n"
+    "      --bind=<LOCAL|GLOBAL|WEAK|UNIQUE>     Symbol bind\n"
+    "      --shndx=<n|UND|ABS|COMMON>            Section index of the symbol\n"
+    "      --range=<lo-hi>                       Symbol value or relocation offset range\n"
+    "      --rtype=<glob|n>                      Relocation type\n"
+    "      --start=<n>                           First index of the table\n"
+    "      --count=<n>                           Number of indexes from --start\n"
     "Detailed Usage: \n"
-    "  elfspirit parse    [-A|H|S|P|B|D|R|I|G] ELF\n"
+    "  elfspirit parse    [-A|H|S|P|B|D|R|I|G] [<filters>] [--format=<json|ndjson>] [--jobs=<n>] ELF\n"
     "  elfspirit edit     [-H|S|P|B|D|R|I] [-i]<row> [-j]<column> [-m|-s]<int|string value> ELF\n" 
     "  elfspirit checksec ELF\n"
+    "  elfspirit checksec [--format=<ndjson|csv>] [--jobs=<n>] DIR|GLOB|@LIST|ELF...\n"
+    "  elfspirit got      ELF\n"
+    "  elfspirit detect   ELF\n"
+    "  elfspirit live     [--jobs=<n>] PID\n"
+    "  elfspirit core     [-b]<address> [-z]<size> CORE\n"
+    "  elfspirit lookup   [-s]<name,...> [-f]<list|ELF> [-z]<iterations> ELF\n"
+    "  elfspirit size     [-z]<top symbols> ELF [NEW_ELF]\n"
+    "  elfspirit diff     [-z]<rows> [--jobs=<n>] ELF NEW_ELF\n"
+    "  elfspirit abi      [-z]<rows> SO NEW_SO\n"
+    "  elfspirit load     [-b]<base> [-f]<output> [-s]<sysroot> [--format=<flat|elf>] ELF\n"
+    "  elfspirit baseline [-f]<database> [--jobs=<n>] FILE|DIR|GLOB|@LIST...\n"
+    "  elfspirit verify   [-f]<database> [--format=ndjson] [FILE|DIR|GLOB|@LIST...]\n"
+    "  elfspirit watch    [--jobs=<n>] DIR...\n"
+    "  elfspirit bind     [-s]<sysroot> ELF...\n"
+    "  elfspirit needed   [-s]<sysroot> ELF...\n"
+    "  elfspirit batch    {--set-interp|--set-rpath|--set-runpath} [-s]<string> FILE|DIR|GLOB|@LIST...\n"
+    "  elfspirit batch    {--rm-strip|--refresh-hash} [--jobs=<n>] FILE|DIR|GLOB|@LIST...\n"
     "  elfspirit --edit-hex      [-o]<offset> [-s]<hex string> [-z]<size> file\n"
     "  elfspirit --edit-pointer  [-o]<offset> [-m]<pointer value> file\n"
     "  elfspirit --edit-extract  [-o]<file offset> [-z]<size> file\n"
     "  elfspirit --set-interp  [-s]<new interpreter> ELF\n"
     "  elfspirit --set-rpath   [-s]<rpath> ELF\n"
     "  elfspirit --set-runpath [-s]<runpath> ELF\n"
+    "  elfspirit --shrink-rpath [-s]<sysroot> ELF\n"
+    "  elfspirit --prune-needed [-s]<sysroot> ELF\n"
+    "  elfspirit --prelink [-b]<base address> ELF\n"
     "  elfspirit --add-section [-z]<size> [-n]<section name> ELF\n"
     "  elfspirit --add-segment [-z]<size> ELF\n"
     "                          [-f]<segment file> ELF\n"
@@ -247,10 +319,14 @@ static const char *help_chinese =
     "  edit         自由修改ELF每个字节\n"
     "  shellcode    从目标文件中提取二进制片段，将shellcode转化为二进制. [extract, hex2bin]\n"
     "  firmware     用于IOT固件，比如将二进制转换为elf文件，连接多个bin文件. [bin2elf, joinelf]\n"
-    "  patch        修补ELF. [--set-interpreter, --set-rpath, --set-runpath]\n"
+    "  load         模拟加载器，输出重定位后的内存镜像. [load]\n"
+    "  patch        修补ELF. [--set-interpreter, --set-rpath, --set-runpath, --shrink-rpath, --prune-needed, --prelink]\n"
     "  confuse      删除节、过滤符号表、删除节头表，混淆ELF符号. [--rm-section, --rm-shdr, --rm-strip]\n"
     "  infect       ELF文件感染. [--infect-silvio, --infect-skeksi, --infect-data, exe2so]\n"
-    "  forensic     分析ELF文件结构的合法性. [checksec]\n"
+    "  forensic     分析ELF文件结构的合法性. [checksec, got, detect, live, core]\n"
+    "  bind         按照加载顺序将未定义的动态符号绑定到共享库. [bind, needed]\n"
+    "  batch        并行修补大量文件. [batch]\n"
+    "  integrity    记录ELF文件指纹并在之后校验. [baseline, verify, watch]\n"
     "支持的选项:\n"
     "  -n, --section-name=<section name>         设置节名\n"
     "  -z, --section-size=<section size>         设置节大小\n"
@@ -260,11 +336,13 @@ static const char *help_chinese =
     "      --value=<math value>                  预留的参数，可以用于传递数值(e.g. 7=111=rwx)\n"
     "  -a, --architecture=<ELF architecture>     ELF文件的架构(预留选项，非必须)\n"
     "  -e, --endian=<ELF endian>                 设置ELF大小端(little, big)\n"
-    "  -b, --base=<ELF base address>             设置ELF入口地址\n"
+    "  -b, --base=<ELF base address>             设置ELF入口地址，0x开头为十六进制，否则为十进制\n"
     "  -o, --offset=<injection offset>           注入点的偏移位置(预留选项，非必须)\n"
     "  -i, --row=<object index>                  待读出或者写入的对象的下标\n"
     "  -j, --column=<vertical axis>              待读出或者写入的对象的纵坐标\n"
     "  -l, --length=<string length>              解析ELF文件时，显示字符串的最大长度\n"
+    "      --jobs=<worker count>                 批量处理和解析大表的工作线程数，默认每个CPU一个\n"
+    "      --format=<json|ndjson|csv|flat|elf>   parse、checksec扫描器、verify和load的输出格式\n"
     "  -h, --help[={none|English|Chinese}]       帮助\n"
     "  -A, 不需要参数                    显示ELF解析器解析的所有信息\n"
     "  -H, 不需要参数                    显示|编辑ELF: ELF头\n"
@@ -276,16 +354,46 @@ static const char *help_chinese =
     "  -R, 不需要参数                    显示|编辑ELF: 重定位表\n"
     "  -R, 不需要参数                    显示|编辑ELF: 指针(e.g. .init_array, etc.)\n"
     "  -G, 不需要参数                    显示hash表\n"
+    "parse -B|D|R的过滤条件: \n"
+    "      --name=<glob>                         符号名称通配符，精确名称通过.gnu.hash查找\n"
+    "      --regex=<regex>                       符号名称扩展正则表达式\n"
+    "      --type=<NOTYPE|OBJECT|FUNC|...>       符号类型\n"
+    "      --bind=<LOCAL|GLOBAL|WEAK|UNIQUE>     符号绑定\n"
+    "      --shndx=<n|UND|ABS|COMMON>            符号所在节的下标\n"
+    "      --range=<lo-hi>                       符号值或重定位偏移的范围\n"
+    "      --rtype=<glob|n>                      重定位类型\n"
+    "      --start=<n>                           表项的起始下标\n"
+    "      --count=<n>                           从--start开始的表项数量\n"
     "细节: \n"
-    "  elfspirit parse    [-A|H|S|P|B|D|R|I|G] ELF\n"
+    "  elfspirit parse    [-A|H|S|P|B|D|R|I|G] [<filters>] [--format=<json|ndjson>] [--jobs=<n>] ELF\n"
     "  elfspirit edit     [-H|S|P|B|D|R] [-i]<第几行> [-j]<第几列> [-m|-s]<int|str修改值> ELF\n"
     "  elfspirit checksec ELF\n"
+    "  elfspirit checksec [--format=<ndjson|csv>] [--jobs=<n>] DIR|GLOB|@LIST|ELF...\n"
+    "  elfspirit got      ELF\n"
+    "  elfspirit detect   ELF\n"
+    "  elfspirit live     [--jobs=<n>] PID\n"
+    "  elfspirit core     [-b]<address> [-z]<size> CORE\n"
+    "  elfspirit lookup   [-s]<name,...> [-f]<list|ELF> [-z]<iterations> ELF\n"
+    "  elfspirit size     [-z]<top symbols> ELF [NEW_ELF]\n"
+    "  elfspirit diff     [-z]<rows> [--jobs=<n>] ELF NEW_ELF\n"
+    "  elfspirit abi      [-z]<rows> SO NEW_SO\n"
+    "  elfspirit load     [-b]<base> [-f]<output> [-s]<sysroot> [--format=<flat|elf>] ELF\n"
+    "  elfspirit baseline [-f]<database> [--jobs=<n>] FILE|DIR|GLOB|@LIST...\n"
+    "  elfspirit verify   [-f]<database> [--format=ndjson] [FILE|DIR|GLOB|@LIST...]\n"
+    "  elfspirit watch    [--jobs=<n>] DIR...\n"
+    "  elfspirit bind     [-s]<sysroot> ELF...\n"
+    "  elfspirit needed   [-s]<sysroot> ELF...\n"
+    "  elfspirit batch    {--set-interp|--set-rpath|--set-runpath} [-s]<string> FILE|DIR|GLOB|@LIST...\n"
+    "  elfspirit batch    {--rm-strip|--refresh-hash} [--jobs=<n>] FILE|DIR|GLOB|@LIST...\n"
     "  elfspirit --edit-hex      [-o]<偏移> [-s]<hex string> [-z]<size> file\n"
     "  elfspirit --edit-pointer  [-o]<偏移> [-m]<指针值> file\n"
     "  elfspirit --edit-extract  [-o]<节的偏移> [-z]<size> file\n"
     "  elfspirit --set-interp  [-s]<新的链接器> ELF\n"
     "  elfspirit --set-rpath   [-s]<rpath> ELF\n"
     "  elfspirit --set-runpath [-s]<runpath> ELF\n"
+    "  elfspirit --shrink-rpath [-s]<sysroot> ELF\n"
+    "  elfspirit --prune-needed [-s]<sysroot> ELF\n"
+    "  elfspirit --prelink [-b]<基地址> ELF\n"
     "  elfspirit --add-section [-z]<size> [-n]<节的名字> ELF\n"
     "  elfspirit --add-segment [-z]<size> ELF\n"
     "                          [-f]<segment file> ELF\n"
@@ -305,6 +413,7 @@ static const char *help_chinese =
 static void readcmdline(int argc, char *argv[]) {
     int opt;
     if (argc == 1) {
+        get_version(ver_elfspirt, LENGTH);
         printf("Current version: %s\n", ver_elfspirt);
         fputs(help, stdout);
     }
@@ -363,12 +472,12 @@ static void readcmdline(int argc, char *argv[]) {
 
             // set base address
             case 'b':
-                if (optarg[0] == '0' && optarg[1] == 'x') {
-                    base_addr = hex2int(optarg);
+                /* hex only with an explicit 0x, a leading 0 is still decimal */
+                if (optarg[0] == '0' && (optarg[1] == 'x' || optarg[1] == 'X')) {
+                    base_addr = strtoull(optarg + 2, NULL, 16);
+                } else {
+                    base_addr = strtoull(optarg, NULL, 10);
                 }
-                else{
-                    base_addr = atoi(optarg);
-                }                
                 break;
             /***** add elf info to firmware for IDA - END *****/
 
@@ -383,6 +492,7 @@ static void readcmdline(int argc, char *argv[]) {
                 break;
             
             case 'h':
+                get_version(ver_elfspirt, LENGTH);
                 if (optarg != NULL && !strcmp(optarg, "Chinese")){       
                     fputs(help_chinese, stdout);
                     printf("当前版本: %s\n", ver_elfspirt);
@@ -412,6 +522,32 @@ static void readcmdline(int argc, char *argv[]) {
                 }                
                 break;
 
+            case 'J':
+                jobs = atoi(optarg);
+                break;
+
+            case 'F':
+                strncpy(format, optarg, LENGTH - 1);
+                break;
+
+            /* filters of the parser's tables */
+            case 'N':
+            case 'X':
+            case 'T':
+            case 'K':
+            case 'Y':
+            case 'V':
+            case 'Q':
+            case 'U':
+            case 'C': {
+                static const char keys[] = "NXTKYVQUC";     // in the order of FILTER_KEY_T
+                if (filter_set(&po.filter, strchr(keys, opt) - keys, optarg) != NO_ERR) {
+                    PRINT_ERROR("invalid filter: %s\n", optarg);
+                    exit(-1);
+                }
+                break;
+            }
+
             case 'l':
                 if (strlen(optarg) > 1 && optarg[0] == '0' && optarg[1] == 'x') {
                     length = hex2int(optarg);
@@ -466,6 +602,147 @@ static void readcmdline(int argc, char *argv[]) {
         }
     }
 
+    /* handle functions which accept many ELF files */
+    if (argc - optind >= 2 && !strcmp(argv[optind], "checksec")) {
+        struct stat st;
+        if (argc - optind > 2 || strlen(format) || (stat(argv[optind + 1], &st) == 0 && S_ISDIR(st.st_mode))) {
+            err = scan_run(&argv[optind + 1], argc - optind - 1, strcmp(format, "csv")? SCAN_NDJSON: SCAN_CSV, jobs);
+            exit(err? -1: 0);
+        }
+    }
+
+    if (argc - optind >= 2 && !strcmp(argv[optind], "batch")) {
+        batch_op_t op;
+        switch (g_long_option) {
+            case SET_INTERPRETER: op = BATCH_SET_INTERPRETER; break;
+            case SET_RPATH: op = BATCH_SET_RPATH; break;
+            case SET_RUNPATH: op = BATCH_SET_RUNPATH; break;
+            case REMOVE_STRIP: op = BATCH_STRIP; break;
+            case REFRESH_HASH: op = BATCH_REFRESH_HASH; break;
+            default:
+                PRINT_WARNING("batch supports --set-interp, --set-rpath, --set-runpath, --rm-strip and --refresh-hash\n");
+                exit(-1);
+        }
+        err = batch_run(op, string, &argv[optind + 1], argc - optind - 1, jobs);
+        if (err < 0) {
+            print_error(err);
+        }
+        exit(err? -1: 0);
+    }
+
+    if (argc - optind >= 2 && (!strcmp(argv[optind], "bind") || !strcmp(argv[optind], "needed"))) {
+        resolver_t resolver;
+        int problems = 0;
+        resolver_init(&resolver, strlen(string)? string: NULL);
+        for (int i = optind + 1; i < argc; i++) {
+            if (!strcmp(argv[optind], "bind")) {
+                err = bind_report(&resolver, argv[i]);
+            } else {
+                /* unused entries are the report, not a failure */
+                int unused = 0;
+                err = needed_report(&resolver, argv[i], NULL, &unused);
+                err = err == NO_ERR? 0: err;
+            }
+            if (err < 0) {
+                PRINT_ERROR("%s\n", argv[i]);
+                print_error(err);
+            }
+            problems += err? 1: 0;
+        }
+        resolver_fini(&resolver);
+        exit(problems? -1: 0);
+    }
+
+    if (argc - optind >= 1 && (!strcmp(argv[optind], "baseline") || !strcmp(argv[optind], "verify"))) {
+        const char *db = strlen(file)? file: BASELINE_DEFAULT;
+        if (!strcmp(argv[optind], "baseline"))
+            err = baseline_record(db, &argv[optind + 1], argc - optind - 1, jobs);
+        else
+            err = baseline_verify(db, &argv[optind + 1], argc - optind - 1, jobs, !strcmp(format, "ndjson"));
+        if (err < 0) {
+            print_error(err);
+        }
+        exit(err? -1: 0);
+    }
+
+    if (argc - optind == 2 && !strcmp(argv[optind], "load")) {
+        char out[MAX_PATH_LEN];
+        int fmt = strcmp(format, "elf")? LOADER_FLAT: LOADER_ELF;
+        if (strlen(file))
+            snprintf(out, sizeof(out), "%s", file);
+        else
+            snprintf(out, sizeof(out), "%s.%s", argv[optind + 1], fmt == LOADER_ELF? "elf": "image");
+        err = loader_emulate(argv[optind + 1], out, base_addr, fmt, strlen(string)? string: NULL);
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR? -1: 0);
+    }
+
+    if (argc - optind == 2 && !strcmp(argv[optind], "core")) {
+        Elf elf;
+        err = init(argv[optind + 1], &elf, true);
+        if (err == NO_ERR) {
+            err = core_report(&elf, base_addr, size);
+            finit(&elf);
+        }
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR? -1: 0);
+    }
+
+    if (argc - optind == 2 && !strcmp(argv[optind], "lookup")) {
+        err = lookup_simulate(argv[optind + 1], string, file, size);
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR? -1: 0);
+    }
+
+    if ((argc - optind == 2 || argc - optind == 3) && !strcmp(argv[optind], "size")) {
+        err = size_report(argv[optind + 1], argc - optind == 3? argv[optind + 2]: NULL, size);
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR? -1: 0);
+    }
+
+    if (argc - optind == 3 && !strcmp(argv[optind], "diff")) {
+        err = elf_diff(argv[optind + 1], argv[optind + 2], jobs, size);
+        if (err < 0) {
+            print_error(err);
+        }
+        exit(err? -1: 0);
+    }
+
+    if (argc - optind == 3 && !strcmp(argv[optind], "abi")) {
+        int broken = 0;
+        err = abi_check(argv[optind + 1], argv[optind + 2], size, &broken);
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR || broken? -1: 0);
+    }
+
+    if (argc - optind == 2 && !strcmp(argv[optind], "live")) {
+        char *end;
+        long pid = strtol(argv[optind + 1], &end, 10);
+        err = *end || pid <= 0? ERR_ARGS: live_compare(pid, jobs);
+        if (err < 0) {
+            print_error(err);
+        }
+        exit(err? -1: 0);
+    }
+
+    if (argc - optind >= 2 && !strcmp(argv[optind], "watch")) {
+        err = watch_run(&argv[optind + 1], argc - optind - 1, jobs);
+        if (err != NO_ERR) {
+            print_error(err);
+        }
+        exit(err != NO_ERR? -1: 0);
+    }
+
     /* handle additional long parameters */
     Elf elf;
     if (optind == argc - 1) {
@@ -505,6 +782,31 @@ static void readcmdline(int argc, char *argv[]) {
                     print_error(err);
                     break;
 
+                case SHRINK_RPATH:
+                    /* keep only the rpath directories which are used */
+                    resolver_t shrink_resolver;
+                    resolver_init(&shrink_resolver, strlen(string)? string: NULL);
+                    err = rpath_shrink(&shrink_resolver, elf_name, &elf);
+                    resolver_fini(&shrink_resolver);
+                    print_error(err);
+                    break;
+
+                case PRUNE_NEEDED:
+                    /* remove unused DT_NEEDED entries */
+                    resolver_t resolver;
+                    int unused = 0;
+                    resolver_init(&resolver, strlen(string)? string: NULL);
+                    err = needed_report(&resolver, elf_name, &elf, &unused);
+                    resolver_fini(&resolver);
+                    print_error(err);
+                    break;
+
+                case PRELINK:
+                    /* bake the relative relocations at a fixed base */
+                    err = prelink(&elf, base_addr);
+                    print_error(err < 0? err: NO_ERR);
+                    break;
+
                 case ADD_SEGMENT:
                     uint64_t index = 0;
                     if (strlen(file) == 0)
@@ -636,12 +938,26 @@ static void readcmdline(int argc, char *argv[]) {
     init(elf_name, &elf, true);     /* true: elf read only */
     /* ELF parser */
     if (!strcmp(function, "parse")) {
-        parse(&elf, &po, length);
+        out_init();
+        po.jobs = jobs;
+        if (!strcmp(format, "json") || !strcmp(format, "ndjson"))
+            parse_export(&elf, &po, strcmp(format, "json")? EXPORT_NDJSON: EXPORT_JSON);
+        else
+            parse(&elf, &po, length);
     }
 
     /* forensics */
     if (!strcmp(function, "checksec")) {
         err = checksec_t1(&elf);
+        if (err == NO_ERR) {
+            err = checksec_t0(&elf);
+        }
+    }
+    if (!strcmp(function, "got")) {
+        err = got_report(&elf);
+    }
+    if (!strcmp(function, "detect")) {
+        err = infect_report(&elf);
     }
     finit(&elf);
 
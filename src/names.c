@@ -0,0 +1,1278 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <elf.h>
+#include "names.h"
+
+/* the tables are indexed by the numeric values, so that they do not depend
+ * on how new the elf.h of the build system is */
+
+/* names of one machine, indexed by value */
+typedef struct NameTable {
+    uint16_t machine;
+    uint32_t count;
+    const char *const *names;
+} name_table_t;
+
+typedef struct TagName {
+    int64_t tag;
+    const char *name;
+} tag_name_t;
+
+/* e_machine descriptions, indexed by e_machine */
+static const char *const machine_names[] = {
+    [0] = "An unknown machine",
+    [1] = "AT&T WE 32100",
+    [2] = "Sun Microsystems SPARC",
+    [3] = "Intel 80386",
+    [4] = "Motorola 68000",
+    [5] = "Motorola 88000",
+    [6] = "Intel MCU",
+    [7] = "Intel 80860",
+    [8] = "MIPS RS3000 (big-endian only)",
+    [9] = "IBM System/370",
+    [10] = "MIPS R3000 little-endian",
+    [15] = "HP/PA",
+    [17] = "Fujitsu VPP500",
+    [18] = "Sun's \"v8plus\"",
+    [19] = "Intel 80960",
+    [20] = "PowerPC",
+    [21] = "PowerPC 64-bit",
+    [22] = "IBM S/390",
+    [23] = "IBM SPU/SPC",
+    [36] = "NEC V800 series",
+    [37] = "Fujitsu FR20",
+    [38] = "TRW RH-32",
+    [39] = "Motorola RCE",
+    [40] = "ARM",
+    [41] = "Digital Alpha",
+    [42] = "Hitachi SH",
+    [43] = "SPARC v9 64-bit",
+    [44] = "Siemens Tricore",
+    [45] = "Argonaut RISC Core",
+    [46] = "Hitachi H8/300",
+    [47] = "Hitachi H8/300H",
+    [48] = "Hitachi H8S",
+    [49] = "Hitachi H8/500",
+    [50] = "Intel Itanium",
+    [51] = "Stanford MIPS-X",
+    [52] = "Motorola Coldfire",
+    [53] = "Motorola M68HC12",
+    [54] = "Fujitsu MMA Multimedia Accelerator",
+    [55] = "Siemens PCP",
+    [56] = "Sony nCPU embeeded RISC",
+    [57] = "Denso NDR1 microprocessor",
+    [58] = "Motorola Start*Core processor",
+    [59] = "Toyota ME16 processor",
+    [60] = "STMicroelectronic ST100 processor",
+    [61] = "Advanced Logic Corp. Tinyj emb.fam",
+    [62] = "AMD x86-64",
+    [63] = "Sony DSP Processor",
+    [64] = "Digital PDP-10",
+    [65] = "Digital PDP-11",
+    [66] = "Siemens FX66 microcontroller",
+    [67] = "STMicroelectronics ST9+ 8/16 mc",
+    [68] = "STmicroelectronics ST7 8 bit mc",
+    [69] = "Motorola MC68HC16 microcontroller",
+    [70] = "Motorola MC68HC11 microcontroller",
+    [71] = "Motorola MC68HC08 microcontroller",
+    [72] = "Motorola MC68HC05 microcontroller",
+    [73] = "Silicon Graphics SVx",
+    [74] = "STMicroelectronics ST19 8 bit mc",
+    [75] = "DEC Vax",
+    [76] = "Axis Communications 32-bit emb.proc",
+    [77] = "Infineon Technologies 32-bit emb.proc",
+    [78] = "Element 14 64-bit DSP Processor",
+    [79] = "LSI Logic 16-bit DSP Processor",
+    [80] = "Donald Knuth's educational 64-bit proc",
+    [81] = "Harvard University machine-independent object files",
+    [82] = "SiTera Prism",
+    [83] = "Atmel AVR 8-bit microcontroller",
+    [84] = "Fujitsu FR30",
+    [85] = "Mitsubishi D10V",
+    [86] = "Mitsubishi D30V",
+    [87] = "NEC v850",
+    [88] = "Mitsubishi M32R",
+    [89] = "Matsushita MN10300",
+    [90] = "Matsushita MN10200",
+    [91] = "picoJava",
+    [92] = "OpenRISC 32-bit embedded processor",
+    [93] = "ARC International ARCompact",
+    [94] = "Tensilica Xtensa Architecture",
+    [95] = "Alphamosaic VideoCore",
+    [96] = "Thompson Multimedia General Purpose Proc",
+    [97] = "National Semi. 32000",
+    [98] = "Tenor Network TPC",
+    [99] = "Trebia SNP 1000",
+    [100] = "STMicroelectronics ST200",
+    [101] = "Ubicom IP2xxx",
+    [102] = "MAX processor",
+    [103] = "National Semi. CompactRISC",
+    [104] = "Fujitsu F2MC16",
+    [105] = "Texas Instruments msp430",
+    [106] = "Analog Devices Blackfin DSP",
+    [107] = "Seiko Epson S1C33 family",
+    [108] = "Sharp embedded microprocessor",
+    [109] = "Arca RISC",
+    [110] = "PKU-Unity & MPRC Peking Uni. mc series",
+    [111] = "eXcess configurable cpu",
+    [112] = "Icera Semi. Deep Execution Processor",
+    [113] = "Altera Nios II",
+    [114] = "National Semi. CompactRISC CRX",
+    [115] = " Motorola XGATE",
+    [116] = " Infineon C16x/XC16x",
+    [117] = "Renesas M16C",
+    [118] = "Microchip Technology dsPIC30F",
+    [119] = "Freescale Communication Engine RISC",
+    [120] = "Renesas M32C",
+    [131] = "Altium TSK3000",
+    [132] = "Freescale RS08",
+    [133] = "Analog Devices SHARC family",
+    [134] = "Cyan Technology eCOG2",
+    [135] = "Sunplus S+core7 RISC",
+    [136] = "New Japan Radio (NJR) 24-bit DSP",
+    [137] = "Broadcom VideoCore III",
+    [138] = "RISC for Lattice FPGA",
+    [139] = "Seiko Epson C17",
+    [140] = "Texas Instruments TMS320C6000 DSPP",
+    [141] = "Texas Instruments TMS320C2000 DSP",
+    [142] = "Texas Instruments TMS320C55x DSP",
+    [143] = "Texas Instruments App. Specific RISC",
+    [144] = "Texas Instruments Prog. Realtime Unit",
+    [160] = "STMicroelectronics 64bit VLIW DSP",
+    [161] = "Cypress M8CP",
+    [162] = "Renesas R32C",
+    [163] = "NXP Semi. TriMedia",
+    [164] = "QUALCOMM DSP6",
+    [165] = "Intel 8051 and variants",
+    [166] = "STMicroelectronics STxP7x",
+    [167] = "Andes Tech. compact code emb. RISC",
+    [168] = "Cyan Technology eCOG1X",
+    [169] = "Dallas Semi. MAXQ30 mc",
+    [170] = "New Japan Radio (NJR) 16-bit DSP",
+    [171] = "M2000 Reconfigurable RISC",
+    [172] = "Cray NV2 vector architecture",
+    [173] = "Renesas RX",
+    [174] = "Imagination Tech. META",
+    [175] = "MCST Elbrus",
+    [176] = "Cyan Technology eCOG16",
+    [177] = "National Semi. CompactRISC CR16",
+    [178] = "Freescale Extended Time Processing Unit",
+    [179] = "Infineon Tech. SLE9X",
+    [180] = "Intel L10M",
+    [181] = "Intel K10M",
+    [183] = "ARM AARCH64",
+    [185] = "Amtel 32-bit microprocessor",
+    [186] = "STMicroelectronics STM8",
+    [187] = "Tilera TILE64",
+    [188] = "Tilera TILEPro",
+    [189] = "Xilinx MicroBlaze",
+    [190] = "NVIDIA CUDA",
+    [191] = "Tilera TILE-Gx",
+    [192] = "CloudShield",
+    [193] = "KIPO-KAIST Core-A 1st gen",
+    [194] = "KIPO-KAIST Core-A 2nd gen",
+    [195] = "Synopsys ARCv2 ISA",
+    [196] = "Open8 RISC",
+    [197] = "Renesas RL78",
+    [198] = "Broadcom VideoCore V",
+    [199] = "Renesas 78KOR",
+    [200] = "Freescale 56800EX DSC",
+    [201] = "Beyond BA1",
+    [202] = "Beyond BA2",
+    [203] = "XMOS xCORE",
+    [204] = "Microchip 8-bit PIC(r)",
+    [205] = "Intel Graphics Technology",
+    [210] = "KM211 KM32",
+    [211] = "KM211 KMX32",
+    [212] = "KM211 KMX16",
+    [213] = "KM211 KMX8",
+    [214] = "KM211 KVARC",
+    [215] = "Paneve CD",
+    [216] = "Cognitive Smart Memory Processor",
+    [217] = "Bluechip CoolEngine",
+    [218] = "Nanoradio Optimized RISC",
+    [219] = "CSR Kalimba",
+    [220] = "Zilog Z80",
+    [221] = "Controls and Data Services VISIUMcore",
+    [222] = "FTDI Chip FT32",
+    [223] = "Moxie processor",
+    [224] = "AMD GPU",
+    [243] = "RISC-V",
+    [247] = "Linux BPF -- in-kernel virtual machine",
+    [252] = "C-SKY",
+    [258] = "LoongArch",
+};
+
+/* relocation types of EM_386 and EM_IAMCU, indexed by r_type */
+static const char *const x86_relocs[] = {
+    [0] = "R_386_NONE",
+    [1] = "R_386_32",
+    [2] = "R_386_PC32",
+    [3] = "R_386_GOT32",
+    [4] = "R_386_PLT32",
+    [5] = "R_386_COPY",
+    [6] = "R_386_GLOB_DAT",
+    [7] = "R_386_JMP_SLOT",
+    [8] = "R_386_RELATIVE",
+    [9] = "R_386_GOTOFF",
+    [10] = "R_386_GOTPC",
+    [11] = "R_386_32PLT",
+    [14] = "R_386_TLS_TPOFF",
+    [15] = "R_386_TLS_IE",
+    [16] = "R_386_TLS_GOTIE",
+    [17] = "R_386_TLS_LE",
+    [18] = "R_386_TLS_GD",
+    [19] = "R_386_TLS_LDM",
+    [20] = "R_386_16",
+    [21] = "R_386_PC16",
+    [22] = "R_386_8",
+    [23] = "R_386_PC8",
+    [24] = "R_386_TLS_GD_32",
+    [25] = "R_386_TLS_GD_PUSH",
+    [26] = "R_386_TLS_GD_CALL",
+    [27] = "R_386_TLS_GD_POP",
+    [28] = "R_386_TLS_LDM_32",
+    [29] = "R_386_TLS_LDM_PUSH",
+    [30] = "R_386_TLS_LDM_CALL",
+    [31] = "R_386_TLS_LDM_POP",
+    [32] = "R_386_TLS_LDO_32",
+    [33] = "R_386_TLS_IE_32",
+    [34] = "R_386_TLS_LE_32",
+    [35] = "R_386_TLS_DTPMOD32",
+    [36] = "R_386_TLS_DTPOFF32",
+    [37] = "R_386_TLS_TPOFF32",
+    [38] = "R_386_SIZE32",
+    [39] = "R_386_TLS_GOTDESC",
+    [40] = "R_386_TLS_DESC_CALL",
+    [41] = "R_386_TLS_DESC",
+    [42] = "R_386_IRELATIVE",
+    [43] = "R_386_GOT32X",
+};
+
+/* relocation types of EM_X86_64, indexed by r_type */
+static const char *const x86_64_relocs[] = {
+    [0] = "R_X86_64_NONE",
+    [1] = "R_X86_64_64",
+    [2] = "R_X86_64_PC32",
+    [3] = "R_X86_64_GOT32",
+    [4] = "R_X86_64_PLT32",
+    [5] = "R_X86_64_COPY",
+    [6] = "R_X86_64_GLOB_DAT",
+    [7] = "R_X86_64_JUMP_SLOT",
+    [8] = "R_X86_64_RELATIVE",
+    [9] = "R_X86_64_GOTPCREL",
+    [10] = "R_X86_64_32",
+    [11] = "R_X86_64_32S",
+    [12] = "R_X86_64_16",
+    [13] = "R_X86_64_PC16",
+    [14] = "R_X86_64_8",
+    [15] = "R_X86_64_PC8",
+    [16] = "R_X86_64_DTPMOD64",
+    [17] = "R_X86_64_DTPOFF64",
+    [18] = "R_X86_64_TPOFF64",
+    [19] = "R_X86_64_TLSGD",
+    [20] = "R_X86_64_TLSLD",
+    [21] = "R_X86_64_DTPOFF32",
+    [22] = "R_X86_64_GOTTPOFF",
+    [23] = "R_X86_64_TPOFF32",
+    [24] = "R_X86_64_PC64",
+    [25] = "R_X86_64_GOTOFF64",
+    [26] = "R_X86_64_GOTPC32",
+    [27] = "R_X86_64_GOT64",
+    [28] = "R_X86_64_GOTPCREL64",
+    [29] = "R_X86_64_GOTPC64",
+    [30] = "R_X86_64_GOTPLT64",
+    [31] = "R_X86_64_PLTOFF64",
+    [32] = "R_X86_64_SIZE32",
+    [33] = "R_X86_64_SIZE64",
+    [34] = "R_X86_64_GOTPC32_TLSDESC",
+    [35] = "R_X86_64_TLSDESC_CALL",
+    [36] = "R_X86_64_TLSDESC",
+    [37] = "R_X86_64_IRELATIVE",
+    [38] = "R_X86_64_RELATIVE64",
+    [41] = "R_X86_64_GOTPCRELX",
+    [42] = "R_X86_64_REX_GOTPCRELX",
+};
+
+/* relocation types of EM_ARM, indexed by r_type */
+static const char *const arm_relocs[] = {
+    [0] = "R_ARM_NONE",
+    [1] = "R_ARM_PC24",
+    [2] = "R_ARM_ABS32",
+    [3] = "R_ARM_REL32",
+    [4] = "R_ARM_PC13",
+    [5] = "R_ARM_ABS16",
+    [6] = "R_ARM_ABS12",
+    [7] = "R_ARM_THM_ABS5",
+    [8] = "R_ARM_ABS8",
+    [9] = "R_ARM_SBREL32",
+    [10] = "R_ARM_THM_PC22",
+    [11] = "R_ARM_THM_PC8",
+    [12] = "R_ARM_AMP_VCALL9",
+    [13] = "R_ARM_TLS_DESC",
+    [14] = "R_ARM_THM_SWI8",
+    [15] = "R_ARM_XPC25",
+    [16] = "R_ARM_THM_XPC22",
+    [17] = "R_ARM_TLS_DTPMOD32",
+    [18] = "R_ARM_TLS_DTPOFF32",
+    [19] = "R_ARM_TLS_TPOFF32",
+    [20] = "R_ARM_COPY",
+    [21] = "R_ARM_GLOB_DAT",
+    [22] = "R_ARM_JUMP_SLOT",
+    [23] = "R_ARM_RELATIVE",
+    [24] = "R_ARM_GOTOFF",
+    [25] = "R_ARM_GOTPC",
+    [26] = "R_ARM_GOT32",
+    [27] = "R_ARM_PLT32",
+    [28] = "R_ARM_CALL",
+    [29] = "R_ARM_JUMP24",
+    [30] = "R_ARM_THM_JUMP24",
+    [31] = "R_ARM_BASE_ABS",
+    [32] = "R_ARM_ALU_PCREL_7_0",
+    [33] = "R_ARM_ALU_PCREL_15_8",
+    [34] = "R_ARM_ALU_PCREL_23_15",
+    [35] = "R_ARM_LDR_SBREL_11_0",
+    [36] = "R_ARM_ALU_SBREL_19_12",
+    [37] = "R_ARM_ALU_SBREL_27_20",
+    [38] = "R_ARM_TARGET1",
+    [39] = "R_ARM_SBREL31",
+    [40] = "R_ARM_V4BX",
+    [41] = "R_ARM_TARGET2",
+    [42] = "R_ARM_PREL31",
+    [43] = "R_ARM_MOVW_ABS_NC",
+    [44] = "R_ARM_MOVT_ABS",
+    [45] = "R_ARM_MOVW_PREL_NC",
+    [46] = "R_ARM_MOVT_PREL",
+    [47] = "R_ARM_THM_MOVW_ABS_NC",
+    [48] = "R_ARM_THM_MOVT_ABS",
+    [49] = "R_ARM_THM_MOVW_PREL_NC",
+    [50] = "R_ARM_THM_MOVT_PREL",
+    [51] = "R_ARM_THM_JUMP19",
+    [52] = "R_ARM_THM_JUMP6",
+    [53] = "R_ARM_THM_ALU_PREL_11_0",
+    [54] = "R_ARM_THM_PC12",
+    [55] = "R_ARM_ABS32_NOI",
+    [56] = "R_ARM_REL32_NOI",
+    [57] = "R_ARM_ALU_PC_G0_NC",
+    [58] = "R_ARM_ALU_PC_G0",
+    [59] = "R_ARM_ALU_PC_G1_NC",
+    [60] = "R_ARM_ALU_PC_G1",
+    [61] = "R_ARM_ALU_PC_G2",
+    [62] = "R_ARM_LDR_PC_G1",
+    [63] = "R_ARM_LDR_PC_G2",
+    [64] = "R_ARM_LDRS_PC_G0",
+    [65] = "R_ARM_LDRS_PC_G1",
+    [66] = "R_ARM_LDRS_PC_G2",
+    [67] = "R_ARM_LDC_PC_G0",
+    [68] = "R_ARM_LDC_PC_G1",
+    [69] = "R_ARM_LDC_PC_G2",
+    [70] = "R_ARM_ALU_SB_G0_NC",
+    [71] = "R_ARM_ALU_SB_G0",
+    [72] = "R_ARM_ALU_SB_G1_NC",
+    [73] = "R_ARM_ALU_SB_G1",
+    [74] = "R_ARM_ALU_SB_G2",
+    [75] = "R_ARM_LDR_SB_G0",
+    [76] = "R_ARM_LDR_SB_G1",
+    [77] = "R_ARM_LDR_SB_G2",
+    [78] = "R_ARM_LDRS_SB_G0",
+    [79] = "R_ARM_LDRS_SB_G1",
+    [80] = "R_ARM_LDRS_SB_G2",
+    [81] = "R_ARM_LDC_SB_G0",
+    [82] = "R_ARM_LDC_SB_G1",
+    [83] = "R_ARM_LDC_SB_G2",
+    [84] = "R_ARM_MOVW_BREL_NC",
+    [85] = "R_ARM_MOVT_BREL",
+    [86] = "R_ARM_MOVW_BREL",
+    [87] = "R_ARM_THM_MOVW_BREL_NC",
+    [88] = "R_ARM_THM_MOVT_BREL",
+    [89] = "R_ARM_THM_MOVW_BREL",
+    [90] = "R_ARM_TLS_GOTDESC",
+    [91] = "R_ARM_TLS_CALL",
+    [92] = "R_ARM_TLS_DESCSEQ",
+    [93] = "R_ARM_THM_TLS_CALL",
+    [94] = "R_ARM_PLT32_ABS",
+    [95] = "R_ARM_GOT_ABS",
+    [96] = "R_ARM_GOT_PREL",
+    [97] = "R_ARM_GOT_BREL12",
+    [98] = "R_ARM_GOTOFF12",
+    [99] = "R_ARM_GOTRELAX",
+    [100] = "R_ARM_GNU_VTENTRY",
+    [101] = "R_ARM_GNU_VTINHERIT",
+    [102] = "R_ARM_THM_PC11",
+    [103] = "R_ARM_THM_PC9",
+    [104] = "R_ARM_TLS_GD32",
+    [105] = "R_ARM_TLS_LDM32",
+    [106] = "R_ARM_TLS_LDO32",
+    [107] = "R_ARM_TLS_IE32",
+    [108] = "R_ARM_TLS_LE32",
+    [109] = "R_ARM_TLS_LDO12",
+    [110] = "R_ARM_TLS_LE12",
+    [111] = "R_ARM_TLS_IE12GP",
+    [128] = "R_ARM_ME_TOO",
+    [129] = "R_ARM_THM_TLS_DESCSEQ",
+    [130] = "R_ARM_THM_TLS_DESCSEQ32",
+    [131] = "R_ARM_THM_GOT_BREL12",
+    [160] = "R_ARM_IRELATIVE",
+    [249] = "R_ARM_RXPC25",
+    [250] = "R_ARM_RSBREL32",
+    [251] = "R_ARM_THM_RPC22",
+    [252] = "R_ARM_RREL32",
+    [253] = "R_ARM_RABS22",
+    [254] = "R_ARM_RPC24",
+    [255] = "R_ARM_RBASE",
+};
+
+/* relocation types of EM_AARCH64, indexed by r_type */
+static const char *const aarch64_relocs[] = {
+    [0] = "R_AARCH64_NONE",
+    [1] = "R_AARCH64_P32_ABS32",
+    [180] = "R_AARCH64_P32_COPY",
+    [181] = "R_AARCH64_P32_GLOB_DAT",
+    [182] = "R_AARCH64_P32_JUMP_SLOT",
+    [183] = "R_AARCH64_P32_RELATIVE",
+    [184] = "R_AARCH64_P32_TLS_DTPMOD",
+    [185] = "R_AARCH64_P32_TLS_DTPREL",
+    [186] = "R_AARCH64_P32_TLS_TPREL",
+    [187] = "R_AARCH64_P32_TLSDESC",
+    [188] = "R_AARCH64_P32_IRELATIVE",
+    [257] = "R_AARCH64_ABS64",
+    [258] = "R_AARCH64_ABS32",
+    [259] = "R_AARCH64_ABS16",
+    [260] = "R_AARCH64_PREL64",
+    [261] = "R_AARCH64_PREL32",
+    [262] = "R_AARCH64_PREL16",
+    [263] = "R_AARCH64_MOVW_UABS_G0",
+    [264] = "R_AARCH64_MOVW_UABS_G0_NC",
+    [265] = "R_AARCH64_MOVW_UABS_G1",
+    [266] = "R_AARCH64_MOVW_UABS_G1_NC",
+    [267] = "R_AARCH64_MOVW_UABS_G2",
+    [268] = "R_AARCH64_MOVW_UABS_G2_NC",
+    [269] = "R_AARCH64_MOVW_UABS_G3",
+    [270] = "R_AARCH64_MOVW_SABS_G0",
+    [271] = "R_AARCH64_MOVW_SABS_G1",
+    [272] = "R_AARCH64_MOVW_SABS_G2",
+    [273] = "R_AARCH64_LD_PREL_LO19",
+    [274] = "R_AARCH64_ADR_PREL_LO21",
+    [275] = "R_AARCH64_ADR_PREL_PG_HI21",
+    [276] = "R_AARCH64_ADR_PREL_PG_HI21_NC",
+    [277] = "R_AARCH64_ADD_ABS_LO12_NC",
+    [278] = "R_AARCH64_LDST8_ABS_LO12_NC",
+    [279] = "R_AARCH64_TSTBR14",
+    [280] = "R_AARCH64_CONDBR19",
+    [282] = "R_AARCH64_JUMP26",
+    [283] = "R_AARCH64_CALL26",
+    [284] = "R_AARCH64_LDST16_ABS_LO12_NC",
+    [285] = "R_AARCH64_LDST32_ABS_LO12_NC",
+    [286] = "R_AARCH64_LDST64_ABS_LO12_NC",
+    [287] = "R_AARCH64_MOVW_PREL_G0",
+    [288] = "R_AARCH64_MOVW_PREL_G0_NC",
+    [289] = "R_AARCH64_MOVW_PREL_G1",
+    [290] = "R_AARCH64_MOVW_PREL_G1_NC",
+    [291] = "R_AARCH64_MOVW_PREL_G2",
+    [292] = "R_AARCH64_MOVW_PREL_G2_NC",
+    [293] = "R_AARCH64_MOVW_PREL_G3",
+    [299] = "R_AARCH64_LDST128_ABS_LO12_NC",
+    [300] = "R_AARCH64_MOVW_GOTOFF_G0",
+    [301] = "R_AARCH64_MOVW_GOTOFF_G0_NC",
+    [302] = "R_AARCH64_MOVW_GOTOFF_G1",
+    [303] = "R_AARCH64_MOVW_GOTOFF_G1_NC",
+    [304] = "R_AARCH64_MOVW_GOTOFF_G2",
+    [305] = "R_AARCH64_MOVW_GOTOFF_G2_NC",
+    [306] = "R_AARCH64_MOVW_GOTOFF_G3",
+    [307] = "R_AARCH64_GOTREL64",
+    [308] = "R_AARCH64_GOTREL32",
+    [309] = "R_AARCH64_GOT_LD_PREL19",
+    [310] = "R_AARCH64_LD64_GOTOFF_LO15",
+    [311] = "R_AARCH64_ADR_GOT_PAGE",
+    [312] = "R_AARCH64_LD64_GOT_LO12_NC",
+    [313] = "R_AARCH64_LD64_GOTPAGE_LO15",
+    [512] = "R_AARCH64_TLSGD_ADR_PREL21",
+    [513] = "R_AARCH64_TLSGD_ADR_PAGE21",
+    [514] = "R_AARCH64_TLSGD_ADD_LO12_NC",
+    [515] = "R_AARCH64_TLSGD_MOVW_G1",
+    [516] = "R_AARCH64_TLSGD_MOVW_G0_NC",
+    [517] = "R_AARCH64_TLSLD_ADR_PREL21",
+    [518] = "R_AARCH64_TLSLD_ADR_PAGE21",
+    [519] = "R_AARCH64_TLSLD_ADD_LO12_NC",
+    [520] = "R_AARCH64_TLSLD_MOVW_G1",
+    [521] = "R_AARCH64_TLSLD_MOVW_G0_NC",
+    [522] = "R_AARCH64_TLSLD_LD_PREL19",
+    [523] = "R_AARCH64_TLSLD_MOVW_DTPREL_G2",
+    [524] = "R_AARCH64_TLSLD_MOVW_DTPREL_G1",
+    [525] = "R_AARCH64_TLSLD_MOVW_DTPREL_G1_NC",
+    [526] = "R_AARCH64_TLSLD_MOVW_DTPREL_G0",
+    [527] = "R_AARCH64_TLSLD_MOVW_DTPREL_G0_NC",
+    [528] = "R_AARCH64_TLSLD_ADD_DTPREL_HI12",
+    [529] = "R_AARCH64_TLSLD_ADD_DTPREL_LO12",
+    [530] = "R_AARCH64_TLSLD_ADD_DTPREL_LO12_NC",
+    [531] = "R_AARCH64_TLSLD_LDST8_DTPREL_LO12",
+    [532] = "R_AARCH64_TLSLD_LDST8_DTPREL_LO12_NC",
+    [533] = "R_AARCH64_TLSLD_LDST16_DTPREL_LO12",
+    [534] = "R_AARCH64_TLSLD_LDST16_DTPREL_LO12_NC",
+    [535] = "R_AARCH64_TLSLD_LDST32_DTPREL_LO12",
+    [536] = "R_AARCH64_TLSLD_LDST32_DTPREL_LO12_NC",
+    [537] = "R_AARCH64_TLSLD_LDST64_DTPREL_LO12",
+    [538] = "R_AARCH64_TLSLD_LDST64_DTPREL_LO12_NC",
+    [539] = "R_AARCH64_TLSIE_MOVW_GOTTPREL_G1",
+    [540] = "R_AARCH64_TLSIE_MOVW_GOTTPREL_G0_NC",
+    [541] = "R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21",
+    [542] = "R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC",
+    [543] = "R_AARCH64_TLSIE_LD_GOTTPREL_PREL19",
+    [544] = "R_AARCH64_TLSLE_MOVW_TPREL_G2",
+    [545] = "R_AARCH64_TLSLE_MOVW_TPREL_G1",
+    [546] = "R_AARCH64_TLSLE_MOVW_TPREL_G1_NC",
+    [547] = "R_AARCH64_TLSLE_MOVW_TPREL_G0",
+    [548] = "R_AARCH64_TLSLE_MOVW_TPREL_G0_NC",
+    [549] = "R_AARCH64_TLSLE_ADD_TPREL_HI12",
+    [550] = "R_AARCH64_TLSLE_ADD_TPREL_LO12",
+    [551] = "R_AARCH64_TLSLE_ADD_TPREL_LO12_NC",
+    [552] = "R_AARCH64_TLSLE_LDST8_TPREL_LO12",
+    [553] = "R_AARCH64_TLSLE_LDST8_TPREL_LO12_NC",
+    [554] = "R_AARCH64_TLSLE_LDST16_TPREL_LO12",
+    [555] = "R_AARCH64_TLSLE_LDST16_TPREL_LO12_NC",
+    [556] = "R_AARCH64_TLSLE_LDST32_TPREL_LO12",
+    [557] = "R_AARCH64_TLSLE_LDST32_TPREL_LO12_NC",
+    [558] = "R_AARCH64_TLSLE_LDST64_TPREL_LO12",
+    [559] = "R_AARCH64_TLSLE_LDST64_TPREL_LO12_NC",
+    [560] = "R_AARCH64_TLSDESC_LD_PREL19",
+    [561] = "R_AARCH64_TLSDESC_ADR_PREL21",
+    [562] = "R_AARCH64_TLSDESC_ADR_PAGE21",
+    [563] = "R_AARCH64_TLSDESC_LD64_LO12",
+    [564] = "R_AARCH64_TLSDESC_ADD_LO12",
+    [565] = "R_AARCH64_TLSDESC_OFF_G1",
+    [566] = "R_AARCH64_TLSDESC_OFF_G0_NC",
+    [567] = "R_AARCH64_TLSDESC_LDR",
+    [568] = "R_AARCH64_TLSDESC_ADD",
+    [569] = "R_AARCH64_TLSDESC_CALL",
+    [570] = "R_AARCH64_TLSLE_LDST128_TPREL_LO12",
+    [571] = "R_AARCH64_TLSLE_LDST128_TPREL_LO12_NC",
+    [572] = "R_AARCH64_TLSLD_LDST128_DTPREL_LO12",
+    [573] = "R_AARCH64_TLSLD_LDST128_DTPREL_LO12_NC",
+    [1024] = "R_AARCH64_COPY",
+    [1025] = "R_AARCH64_GLOB_DAT",
+    [1026] = "R_AARCH64_JUMP_SLOT",
+    [1027] = "R_AARCH64_RELATIVE",
+    [1028] = "R_AARCH64_TLS_DTPMOD",
+    [1029] = "R_AARCH64_TLS_DTPREL",
+    [1030] = "R_AARCH64_TLS_TPREL",
+    [1031] = "R_AARCH64_TLSDESC",
+    [1032] = "R_AARCH64_IRELATIVE",
+};
+
+/* relocation types of EM_MIPS and EM_MIPS_RS3_LE, indexed by r_type */
+static const char *const mips_relocs[] = {
+    [0] = "R_MIPS_NONE",
+    [1] = "R_MIPS_16",
+    [2] = "R_MIPS_32",
+    [3] = "R_MIPS_REL32",
+    [4] = "R_MIPS_26",
+    [5] = "R_MIPS_HI16",
+    [6] = "R_MIPS_LO16",
+    [7] = "R_MIPS_GPREL16",
+    [8] = "R_MIPS_LITERAL",
+    [9] = "R_MIPS_GOT16",
+    [10] = "R_MIPS_PC16",
+    [11] = "R_MIPS_CALL16",
+    [12] = "R_MIPS_GPREL32",
+    [16] = "R_MIPS_SHIFT5",
+    [17] = "R_MIPS_SHIFT6",
+    [18] = "R_MIPS_64",
+    [19] = "R_MIPS_GOT_DISP",
+    [20] = "R_MIPS_GOT_PAGE",
+    [21] = "R_MIPS_GOT_OFST",
+    [22] = "R_MIPS_GOT_HI16",
+    [23] = "R_MIPS_GOT_LO16",
+    [24] = "R_MIPS_SUB",
+    [25] = "R_MIPS_INSERT_A",
+    [26] = "R_MIPS_INSERT_B",
+    [27] = "R_MIPS_DELETE",
+    [28] = "R_MIPS_HIGHER",
+    [29] = "R_MIPS_HIGHEST",
+    [30] = "R_MIPS_CALL_HI16",
+    [31] = "R_MIPS_CALL_LO16",
+    [32] = "R_MIPS_SCN_DISP",
+    [33] = "R_MIPS_REL16",
+    [34] = "R_MIPS_ADD_IMMEDIATE",
+    [35] = "R_MIPS_PJUMP",
+    [36] = "R_MIPS_RELGOT",
+    [37] = "R_MIPS_JALR",
+    [38] = "R_MIPS_TLS_DTPMOD32",
+    [39] = "R_MIPS_TLS_DTPREL32",
+    [40] = "R_MIPS_TLS_DTPMOD64",
+    [41] = "R_MIPS_TLS_DTPREL64",
+    [42] = "R_MIPS_TLS_GD",
+    [43] = "R_MIPS_TLS_LDM",
+    [44] = "R_MIPS_TLS_DTPREL_HI16",
+    [45] = "R_MIPS_TLS_DTPREL_LO16",
+    [46] = "R_MIPS_TLS_GOTTPREL",
+    [47] = "R_MIPS_TLS_TPREL32",
+    [48] = "R_MIPS_TLS_TPREL64",
+    [49] = "R_MIPS_TLS_TPREL_HI16",
+    [50] = "R_MIPS_TLS_TPREL_LO16",
+    [51] = "R_MIPS_GLOB_DAT",
+    [126] = "R_MIPS_COPY",
+    [127] = "R_MIPS_JUMP_SLOT",
+};
+
+/* relocation types of EM_PPC, indexed by r_type */
+static const char *const ppc_relocs[] = {
+    [0] = "R_PPC_NONE",
+    [1] = "R_PPC_ADDR32",
+    [2] = "R_PPC_ADDR24",
+    [3] = "R_PPC_ADDR16",
+    [4] = "R_PPC_ADDR16_LO",
+    [5] = "R_PPC_ADDR16_HI",
+    [6] = "R_PPC_ADDR16_HA",
+    [7] = "R_PPC_ADDR14",
+    [8] = "R_PPC_ADDR14_BRTAKEN",
+    [9] = "R_PPC_ADDR14_BRNTAKEN",
+    [10] = "R_PPC_REL24",
+    [11] = "R_PPC_REL14",
+    [12] = "R_PPC_REL14_BRTAKEN",
+    [13] = "R_PPC_REL14_BRNTAKEN",
+    [14] = "R_PPC_GOT16",
+    [15] = "R_PPC_GOT16_LO",
+    [16] = "R_PPC_GOT16_HI",
+    [17] = "R_PPC_GOT16_HA",
+    [18] = "R_PPC_PLTREL24",
+    [19] = "R_PPC_COPY",
+    [20] = "R_PPC_GLOB_DAT",
+    [21] = "R_PPC_JMP_SLOT",
+    [22] = "R_PPC_RELATIVE",
+    [23] = "R_PPC_LOCAL24PC",
+    [24] = "R_PPC_UADDR32",
+    [25] = "R_PPC_UADDR16",
+    [26] = "R_PPC_REL32",
+    [27] = "R_PPC_PLT32",
+    [28] = "R_PPC_PLTREL32",
+    [29] = "R_PPC_PLT16_LO",
+    [30] = "R_PPC_PLT16_HI",
+    [31] = "R_PPC_PLT16_HA",
+    [32] = "R_PPC_SDAREL16",
+    [33] = "R_PPC_SECTOFF",
+    [34] = "R_PPC_SECTOFF_LO",
+    [35] = "R_PPC_SECTOFF_HI",
+    [36] = "R_PPC_SECTOFF_HA",
+    [67] = "R_PPC_TLS",
+    [68] = "R_PPC_DTPMOD32",
+    [69] = "R_PPC_TPREL16",
+    [70] = "R_PPC_TPREL16_LO",
+    [71] = "R_PPC_TPREL16_HI",
+    [72] = "R_PPC_TPREL16_HA",
+    [73] = "R_PPC_TPREL32",
+    [74] = "R_PPC_DTPREL16",
+    [75] = "R_PPC_DTPREL16_LO",
+    [76] = "R_PPC_DTPREL16_HI",
+    [77] = "R_PPC_DTPREL16_HA",
+    [78] = "R_PPC_DTPREL32",
+    [79] = "R_PPC_GOT_TLSGD16",
+    [80] = "R_PPC_GOT_TLSGD16_LO",
+    [81] = "R_PPC_GOT_TLSGD16_HI",
+    [82] = "R_PPC_GOT_TLSGD16_HA",
+    [83] = "R_PPC_GOT_TLSLD16",
+    [84] = "R_PPC_GOT_TLSLD16_LO",
+    [85] = "R_PPC_GOT_TLSLD16_HI",
+    [86] = "R_PPC_GOT_TLSLD16_HA",
+    [87] = "R_PPC_GOT_TPREL16",
+    [88] = "R_PPC_GOT_TPREL16_LO",
+    [89] = "R_PPC_GOT_TPREL16_HI",
+    [90] = "R_PPC_GOT_TPREL16_HA",
+    [91] = "R_PPC_GOT_DTPREL16",
+    [92] = "R_PPC_GOT_DTPREL16_LO",
+    [93] = "R_PPC_GOT_DTPREL16_HI",
+    [94] = "R_PPC_GOT_DTPREL16_HA",
+    [95] = "R_PPC_TLSGD",
+    [96] = "R_PPC_TLSLD",
+    [101] = "R_PPC_EMB_NADDR32",
+    [102] = "R_PPC_EMB_NADDR16",
+    [103] = "R_PPC_EMB_NADDR16_LO",
+    [104] = "R_PPC_EMB_NADDR16_HI",
+    [105] = "R_PPC_EMB_NADDR16_HA",
+    [106] = "R_PPC_EMB_SDAI16",
+    [107] = "R_PPC_EMB_SDA2I16",
+    [108] = "R_PPC_EMB_SDA2REL",
+    [109] = "R_PPC_EMB_SDA21",
+    [110] = "R_PPC_EMB_MRKREF",
+    [111] = "R_PPC_EMB_RELSEC16",
+    [112] = "R_PPC_EMB_RELST_LO",
+    [113] = "R_PPC_EMB_RELST_HI",
+    [114] = "R_PPC_EMB_RELST_HA",
+    [115] = "R_PPC_EMB_BIT_FLD",
+    [116] = "R_PPC_EMB_RELSDA",
+    [180] = "R_PPC_DIAB_SDA21_LO",
+    [181] = "R_PPC_DIAB_SDA21_HI",
+    [182] = "R_PPC_DIAB_SDA21_HA",
+    [183] = "R_PPC_DIAB_RELSDA_LO",
+    [184] = "R_PPC_DIAB_RELSDA_HI",
+    [185] = "R_PPC_DIAB_RELSDA_HA",
+    [248] = "R_PPC_IRELATIVE",
+    [249] = "R_PPC_REL16",
+    [250] = "R_PPC_REL16_LO",
+    [251] = "R_PPC_REL16_HI",
+    [252] = "R_PPC_REL16_HA",
+    [255] = "R_PPC_TOC16",
+};
+
+/* relocation types of EM_PPC64, indexed by r_type */
+static const char *const ppc64_relocs[] = {
+    [0] = "R_PPC64_NONE",
+    [1] = "R_PPC64_ADDR32",
+    [2] = "R_PPC64_ADDR24",
+    [3] = "R_PPC64_ADDR16",
+    [4] = "R_PPC64_ADDR16_LO",
+    [5] = "R_PPC64_ADDR16_HI",
+    [6] = "R_PPC64_ADDR16_HA",
+    [7] = "R_PPC64_ADDR14",
+    [8] = "R_PPC64_ADDR14_BRTAKEN",
+    [9] = "R_PPC64_ADDR14_BRNTAKEN",
+    [10] = "R_PPC64_REL24",
+    [11] = "R_PPC64_REL14",
+    [12] = "R_PPC64_REL14_BRTAKEN",
+    [13] = "R_PPC64_REL14_BRNTAKEN",
+    [14] = "R_PPC64_GOT16",
+    [15] = "R_PPC64_GOT16_LO",
+    [16] = "R_PPC64_GOT16_HI",
+    [17] = "R_PPC64_GOT16_HA",
+    [19] = "R_PPC64_COPY",
+    [20] = "R_PPC64_GLOB_DAT",
+    [21] = "R_PPC64_JMP_SLOT",
+    [22] = "R_PPC64_RELATIVE",
+    [24] = "R_PPC64_UADDR32",
+    [25] = "R_PPC64_UADDR16",
+    [26] = "R_PPC64_REL32",
+    [27] = "R_PPC64_PLT32",
+    [28] = "R_PPC64_PLTREL32",
+    [29] = "R_PPC64_PLT16_LO",
+    [30] = "R_PPC64_PLT16_HI",
+    [31] = "R_PPC64_PLT16_HA",
+    [33] = "R_PPC64_SECTOFF",
+    [34] = "R_PPC64_SECTOFF_LO",
+    [35] = "R_PPC64_SECTOFF_HI",
+    [36] = "R_PPC64_SECTOFF_HA",
+    [37] = "R_PPC64_ADDR30",
+    [38] = "R_PPC64_ADDR64",
+    [39] = "R_PPC64_ADDR16_HIGHER",
+    [40] = "R_PPC64_ADDR16_HIGHERA",
+    [41] = "R_PPC64_ADDR16_HIGHEST",
+    [42] = "R_PPC64_ADDR16_HIGHESTA",
+    [43] = "R_PPC64_UADDR64",
+    [44] = "R_PPC64_REL64",
+    [45] = "R_PPC64_PLT64",
+    [46] = "R_PPC64_PLTREL64",
+    [47] = "R_PPC64_TOC16",
+    [48] = "R_PPC64_TOC16_LO",
+    [49] = "R_PPC64_TOC16_HI",
+    [50] = "R_PPC64_TOC16_HA",
+    [51] = "R_PPC64_TOC",
+    [52] = "R_PPC64_PLTGOT16",
+    [53] = "R_PPC64_PLTGOT16_LO",
+    [54] = "R_PPC64_PLTGOT16_HI",
+    [55] = "R_PPC64_PLTGOT16_HA",
+    [56] = "R_PPC64_ADDR16_DS",
+    [57] = "R_PPC64_ADDR16_LO_DS",
+    [58] = "R_PPC64_GOT16_DS",
+    [59] = "R_PPC64_GOT16_LO_DS",
+    [60] = "R_PPC64_PLT16_LO_DS",
+    [61] = "R_PPC64_SECTOFF_DS",
+    [62] = "R_PPC64_SECTOFF_LO_DS",
+    [63] = "R_PPC64_TOC16_DS",
+    [64] = "R_PPC64_TOC16_LO_DS",
+    [65] = "R_PPC64_PLTGOT16_DS",
+    [66] = "R_PPC64_PLTGOT16_LO_DS",
+    [67] = "R_PPC64_TLS",
+    [68] = "R_PPC64_DTPMOD64",
+    [69] = "R_PPC64_TPREL16",
+    [70] = "R_PPC64_TPREL16_LO",
+    [71] = "R_PPC64_TPREL16_HI",
+    [72] = "R_PPC64_TPREL16_HA",
+    [73] = "R_PPC64_TPREL64",
+    [74] = "R_PPC64_DTPREL16",
+    [75] = "R_PPC64_DTPREL16_LO",
+    [76] = "R_PPC64_DTPREL16_HI",
+    [77] = "R_PPC64_DTPREL16_HA",
+    [78] = "R_PPC64_DTPREL64",
+    [79] = "R_PPC64_GOT_TLSGD16",
+    [80] = "R_PPC64_GOT_TLSGD16_LO",
+    [81] = "R_PPC64_GOT_TLSGD16_HI",
+    [82] = "R_PPC64_GOT_TLSGD16_HA",
+    [83] = "R_PPC64_GOT_TLSLD16",
+    [84] = "R_PPC64_GOT_TLSLD16_LO",
+    [85] = "R_PPC64_GOT_TLSLD16_HI",
+    [86] = "R_PPC64_GOT_TLSLD16_HA",
+    [87] = "R_PPC64_GOT_TPREL16_DS",
+    [88] = "R_PPC64_GOT_TPREL16_LO_DS",
+    [89] = "R_PPC64_GOT_TPREL16_HI",
+    [90] = "R_PPC64_GOT_TPREL16_HA",
+    [91] = "R_PPC64_GOT_DTPREL16_DS",
+    [92] = "R_PPC64_GOT_DTPREL16_LO_DS",
+    [93] = "R_PPC64_GOT_DTPREL16_HI",
+    [94] = "R_PPC64_GOT_DTPREL16_HA",
+    [95] = "R_PPC64_TPREL16_DS",
+    [96] = "R_PPC64_TPREL16_LO_DS",
+    [97] = "R_PPC64_TPREL16_HIGHER",
+    [98] = "R_PPC64_TPREL16_HIGHERA",
+    [99] = "R_PPC64_TPREL16_HIGHEST",
+    [100] = "R_PPC64_TPREL16_HIGHESTA",
+    [101] = "R_PPC64_DTPREL16_DS",
+    [102] = "R_PPC64_DTPREL16_LO_DS",
+    [103] = "R_PPC64_DTPREL16_HIGHER",
+    [104] = "R_PPC64_DTPREL16_HIGHERA",
+    [105] = "R_PPC64_DTPREL16_HIGHEST",
+    [106] = "R_PPC64_DTPREL16_HIGHESTA",
+    [107] = "R_PPC64_TLSGD",
+    [108] = "R_PPC64_TLSLD",
+    [109] = "R_PPC64_TOCSAVE",
+    [110] = "R_PPC64_ADDR16_HIGH",
+    [111] = "R_PPC64_ADDR16_HIGHA",
+    [112] = "R_PPC64_TPREL16_HIGH",
+    [113] = "R_PPC64_TPREL16_HIGHA",
+    [114] = "R_PPC64_DTPREL16_HIGH",
+    [115] = "R_PPC64_DTPREL16_HIGHA",
+    [247] = "R_PPC64_JMP_IREL",
+    [248] = "R_PPC64_IRELATIVE",
+    [249] = "R_PPC64_REL16",
+    [250] = "R_PPC64_REL16_LO",
+    [251] = "R_PPC64_REL16_HI",
+    [252] = "R_PPC64_REL16_HA",
+};
+
+/* relocation types of EM_RISCV, indexed by r_type */
+static const char *const riscv_relocs[] = {
+    [0] = "R_RISCV_NONE",
+    [1] = "R_RISCV_32",
+    [2] = "R_RISCV_64",
+    [3] = "R_RISCV_RELATIVE",
+    [4] = "R_RISCV_COPY",
+    [5] = "R_RISCV_JUMP_SLOT",
+    [6] = "R_RISCV_TLS_DTPMOD32",
+    [7] = "R_RISCV_TLS_DTPMOD64",
+    [8] = "R_RISCV_TLS_DTPREL32",
+    [9] = "R_RISCV_TLS_DTPREL64",
+    [10] = "R_RISCV_TLS_TPREL32",
+    [11] = "R_RISCV_TLS_TPREL64",
+    [12] = "R_RISCV_TLSDESC",
+    [16] = "R_RISCV_BRANCH",
+    [17] = "R_RISCV_JAL",
+    [18] = "R_RISCV_CALL",
+    [19] = "R_RISCV_CALL_PLT",
+    [20] = "R_RISCV_GOT_HI20",
+    [21] = "R_RISCV_TLS_GOT_HI20",
+    [22] = "R_RISCV_TLS_GD_HI20",
+    [23] = "R_RISCV_PCREL_HI20",
+    [24] = "R_RISCV_PCREL_LO12_I",
+    [25] = "R_RISCV_PCREL_LO12_S",
+    [26] = "R_RISCV_HI20",
+    [27] = "R_RISCV_LO12_I",
+    [28] = "R_RISCV_LO12_S",
+    [29] = "R_RISCV_TPREL_HI20",
+    [30] = "R_RISCV_TPREL_LO12_I",
+    [31] = "R_RISCV_TPREL_LO12_S",
+    [32] = "R_RISCV_TPREL_ADD",
+    [33] = "R_RISCV_ADD8",
+    [34] = "R_RISCV_ADD16",
+    [35] = "R_RISCV_ADD32",
+    [36] = "R_RISCV_ADD64",
+    [37] = "R_RISCV_SUB8",
+    [38] = "R_RISCV_SUB16",
+    [39] = "R_RISCV_SUB32",
+    [40] = "R_RISCV_SUB64",
+    [41] = "R_RISCV_GNU_VTINHERIT",
+    [42] = "R_RISCV_GNU_VTENTRY",
+    [43] = "R_RISCV_ALIGN",
+    [44] = "R_RISCV_RVC_BRANCH",
+    [45] = "R_RISCV_RVC_JUMP",
+    [46] = "R_RISCV_RVC_LUI",
+    [47] = "R_RISCV_GPREL_I",
+    [48] = "R_RISCV_GPREL_S",
+    [49] = "R_RISCV_TPREL_I",
+    [50] = "R_RISCV_TPREL_S",
+    [51] = "R_RISCV_RELAX",
+    [52] = "R_RISCV_SUB6",
+    [53] = "R_RISCV_SET6",
+    [54] = "R_RISCV_SET8",
+    [55] = "R_RISCV_SET16",
+    [56] = "R_RISCV_SET32",
+    [57] = "R_RISCV_32_PCREL",
+    [58] = "R_RISCV_IRELATIVE",
+    [60] = "R_RISCV_SET_ULEB128",
+    [61] = "R_RISCV_SUB_ULEB128",
+    [62] = "R_RISCV_TLSDESC_HI20",
+    [63] = "R_RISCV_TLSDESC_LOAD_LO12",
+    [64] = "R_RISCV_TLSDESC_ADD_LO12",
+    [65] = "R_RISCV_TLSDESC_CALL",
+};
+
+/* relocation types of EM_LOONGARCH, indexed by r_type */
+static const char *const loongarch_relocs[] = {
+    [0] = "R_LARCH_NONE",
+    [1] = "R_LARCH_32",
+    [2] = "R_LARCH_64",
+    [3] = "R_LARCH_RELATIVE",
+    [4] = "R_LARCH_COPY",
+    [5] = "R_LARCH_JUMP_SLOT",
+    [6] = "R_LARCH_TLS_DTPMOD32",
+    [7] = "R_LARCH_TLS_DTPMOD64",
+    [8] = "R_LARCH_TLS_DTPREL32",
+    [9] = "R_LARCH_TLS_DTPREL64",
+    [10] = "R_LARCH_TLS_TPREL32",
+    [11] = "R_LARCH_TLS_TPREL64",
+    [12] = "R_LARCH_IRELATIVE",
+    [13] = "R_LARCH_TLS_DESC32",
+    [14] = "R_LARCH_TLS_DESC64",
+    [20] = "R_LARCH_MARK_LA",
+    [21] = "R_LARCH_MARK_PCREL",
+    [22] = "R_LARCH_SOP_PUSH_PCREL",
+    [23] = "R_LARCH_SOP_PUSH_ABSOLUTE",
+    [24] = "R_LARCH_SOP_PUSH_DUP",
+    [25] = "R_LARCH_SOP_PUSH_GPREL",
+    [26] = "R_LARCH_SOP_PUSH_TLS_TPREL",
+    [27] = "R_LARCH_SOP_PUSH_TLS_GOT",
+    [28] = "R_LARCH_SOP_PUSH_TLS_GD",
+    [29] = "R_LARCH_SOP_PUSH_PLT_PCREL",
+    [30] = "R_LARCH_SOP_ASSERT",
+    [31] = "R_LARCH_SOP_NOT",
+    [32] = "R_LARCH_SOP_SUB",
+    [33] = "R_LARCH_SOP_SL",
+    [34] = "R_LARCH_SOP_SR",
+    [35] = "R_LARCH_SOP_ADD",
+    [36] = "R_LARCH_SOP_AND",
+    [37] = "R_LARCH_SOP_IF_ELSE",
+    [38] = "R_LARCH_SOP_POP_32_S_10_5",
+    [39] = "R_LARCH_SOP_POP_32_U_10_12",
+    [40] = "R_LARCH_SOP_POP_32_S_10_12",
+    [41] = "R_LARCH_SOP_POP_32_S_10_16",
+    [42] = "R_LARCH_SOP_POP_32_S_10_16_S2",
+    [43] = "R_LARCH_SOP_POP_32_S_5_20",
+    [44] = "R_LARCH_SOP_POP_32_S_0_5_10_16_S2",
+    [45] = "R_LARCH_SOP_POP_32_S_0_10_10_16_S2",
+    [46] = "R_LARCH_SOP_POP_32_U",
+    [47] = "R_LARCH_ADD8",
+    [48] = "R_LARCH_ADD16",
+    [49] = "R_LARCH_ADD24",
+    [50] = "R_LARCH_ADD32",
+    [51] = "R_LARCH_ADD64",
+    [52] = "R_LARCH_SUB8",
+    [53] = "R_LARCH_SUB16",
+    [54] = "R_LARCH_SUB24",
+    [55] = "R_LARCH_SUB32",
+    [56] = "R_LARCH_SUB64",
+    [57] = "R_LARCH_GNU_VTINHERIT",
+    [58] = "R_LARCH_GNU_VTENTRY",
+    [64] = "R_LARCH_B16",
+    [65] = "R_LARCH_B21",
+    [66] = "R_LARCH_B26",
+    [67] = "R_LARCH_ABS_HI20",
+    [68] = "R_LARCH_ABS_LO12",
+    [69] = "R_LARCH_ABS64_LO20",
+    [70] = "R_LARCH_ABS64_HI12",
+    [71] = "R_LARCH_PCALA_HI20",
+    [72] = "R_LARCH_PCALA_LO12",
+    [73] = "R_LARCH_PCALA64_LO20",
+    [74] = "R_LARCH_PCALA64_HI12",
+    [75] = "R_LARCH_GOT_PC_HI20",
+    [76] = "R_LARCH_GOT_PC_LO12",
+    [77] = "R_LARCH_GOT64_PC_LO20",
+    [78] = "R_LARCH_GOT64_PC_HI12",
+    [79] = "R_LARCH_GOT_HI20",
+    [80] = "R_LARCH_GOT_LO12",
+    [81] = "R_LARCH_GOT64_LO20",
+    [82] = "R_LARCH_GOT64_HI12",
+    [83] = "R_LARCH_TLS_LE_HI20",
+    [84] = "R_LARCH_TLS_LE_LO12",
+    [85] = "R_LARCH_TLS_LE64_LO20",
+    [86] = "R_LARCH_TLS_LE64_HI12",
+    [87] = "R_LARCH_TLS_IE_PC_HI20",
+    [88] = "R_LARCH_TLS_IE_PC_LO12",
+    [89] = "R_LARCH_TLS_IE64_PC_LO20",
+    [90] = "R_LARCH_TLS_IE64_PC_HI12",
+    [91] = "R_LARCH_TLS_IE_HI20",
+    [92] = "R_LARCH_TLS_IE_LO12",
+    [93] = "R_LARCH_TLS_IE64_LO20",
+    [94] = "R_LARCH_TLS_IE64_HI12",
+    [95] = "R_LARCH_TLS_LD_PC_HI20",
+    [96] = "R_LARCH_TLS_LD_HI20",
+    [97] = "R_LARCH_TLS_GD_PC_HI20",
+    [98] = "R_LARCH_TLS_GD_HI20",
+    [99] = "R_LARCH_32_PCREL",
+    [100] = "R_LARCH_RELAX",
+    [102] = "R_LARCH_ALIGN",
+    [103] = "R_LARCH_PCREL20_S2",
+    [105] = "R_LARCH_ADD6",
+    [106] = "R_LARCH_SUB6",
+    [107] = "R_LARCH_ADD_ULEB128",
+    [108] = "R_LARCH_SUB_ULEB128",
+    [109] = "R_LARCH_64_PCREL",
+    [110] = "R_LARCH_CALL36",
+};
+
+#define NAMES(machine, table)  {machine, sizeof(table) / sizeof(table[0]), table}
+
+/* relocation type names keyed by e_machine */
+static const name_table_t reloc_names[] = {
+    NAMES(3, x86_relocs),             // EM_386
+    NAMES(6, x86_relocs),             // EM_IAMCU
+    NAMES(62, x86_64_relocs),         // EM_X86_64
+    NAMES(40, arm_relocs),            // EM_ARM
+    NAMES(183, aarch64_relocs),       // EM_AARCH64
+    NAMES(8, mips_relocs),            // EM_MIPS
+    NAMES(10, mips_relocs),           // EM_MIPS_RS3_LE
+    NAMES(20, ppc_relocs),            // EM_PPC
+    NAMES(21, ppc64_relocs),          // EM_PPC64
+    NAMES(243, riscv_relocs),         // EM_RISCV
+    NAMES(258, loongarch_relocs),     // EM_LOONGARCH
+};
+
+/* d_tag names, DT_NULL ~ DT_RELRENT */
+static const char *const dyn_tags[] = {
+    [0] = "DT_NULL",
+    [1] = "DT_NEEDED",
+    [2] = "DT_PLTRELSZ",
+    [3] = "DT_PLTGOT",
+    [4] = "DT_HASH",
+    [5] = "DT_STRTAB",
+    [6] = "DT_SYMTAB",
+    [7] = "DT_RELA",
+    [8] = "DT_RELASZ",
+    [9] = "DT_RELAENT",
+    [10] = "DT_STRSZ",
+    [11] = "DT_SYMENT",
+    [12] = "DT_INIT",
+    [13] = "DT_FINI",
+    [14] = "DT_SONAME",
+    [15] = "DT_RPATH",
+    [16] = "DT_SYMBOLIC",
+    [17] = "DT_REL",
+    [18] = "DT_RELSZ",
+    [19] = "DT_RELENT",
+    [20] = "DT_PLTREL",
+    [21] = "DT_DEBUG",
+    [22] = "DT_TEXTREL",
+    [23] = "DT_JMPREL",
+    [24] = "DT_BIND_NOW",
+    [25] = "DT_INIT_ARRAY",
+    [26] = "DT_FINI_ARRAY",
+    [27] = "DT_INIT_ARRAYSZ",
+    [28] = "DT_FINI_ARRAYSZ",
+    [29] = "DT_RUNPATH",
+    [30] = "DT_FLAGS",
+    [32] = "DT_PREINIT_ARRAY",
+    [33] = "DT_PREINIT_ARRAYSZ",
+    [34] = "DT_SYMTAB_SHNDX",
+    [35] = "DT_RELRSZ",
+    [36] = "DT_RELR",
+    [37] = "DT_RELRENT",
+};
+
+/* d_tag names of the OS range, sorted */
+static const tag_name_t os_tags[] = {
+    {0x6ffffdf5, "DT_GNU_PRELINKED"},
+    {0x6ffffdf6, "DT_GNU_CONFLICTSZ"},
+    {0x6ffffdf7, "DT_GNU_LIBLISTSZ"},
+    {0x6ffffdf8, "DT_CHECKSUM"},
+    {0x6ffffdf9, "DT_PLTPADSZ"},
+    {0x6ffffdfa, "DT_MOVEENT"},
+    {0x6ffffdfb, "DT_MOVESZ"},
+    {0x6ffffdfc, "DT_FEATURE_1"},
+    {0x6ffffdfd, "DT_POSFLAG_1"},
+    {0x6ffffdfe, "DT_SYMINSZ"},
+    {0x6ffffdff, "DT_SYMINENT"},
+    {0x6ffffef5, "DT_GNU_HASH"},
+    {0x6ffffef6, "DT_TLSDESC_PLT"},
+    {0x6ffffef7, "DT_TLSDESC_GOT"},
+    {0x6ffffef8, "DT_GNU_CONFLICT"},
+    {0x6ffffef9, "DT_GNU_LIBLIST"},
+    {0x6ffffefa, "DT_CONFIG"},
+    {0x6ffffefb, "DT_DEPAUDIT"},
+    {0x6ffffefc, "DT_AUDIT"},
+    {0x6ffffefd, "DT_PLTPAD"},
+    {0x6ffffefe, "DT_MOVETAB"},
+    {0x6ffffeff, "DT_SYMINFO"},
+    {0x6ffffff0, "DT_VERSYM"},
+    {0x6ffffff9, "DT_RELACOUNT"},
+    {0x6ffffffa, "DT_RELCOUNT"},
+    {0x6ffffffb, "DT_FLAGS_1"},
+    {0x6ffffffc, "DT_VERDEF"},
+    {0x6ffffffd, "DT_VERDEFNUM"},
+    {0x6ffffffe, "DT_VERNEED"},
+    {0x6fffffff, "DT_VERNEEDNUM"},
+};
+
+/* d_tag names of EM_MIPS and EM_MIPS_RS3_LE, indexed by d_tag - DT_LOPROC */
+static const char *const mips_tags[] = {
+    [1] = "DT_MIPS_RLD_VERSION",
+    [2] = "DT_MIPS_TIME_STAMP",
+    [3] = "DT_MIPS_ICHECKSUM",
+    [4] = "DT_MIPS_IVERSION",
+    [5] = "DT_MIPS_FLAGS",
+    [6] = "DT_MIPS_BASE_ADDRESS",
+    [7] = "DT_MIPS_MSYM",
+    [8] = "DT_MIPS_CONFLICT",
+    [9] = "DT_MIPS_LIBLIST",
+    [10] = "DT_MIPS_LOCAL_GOTNO",
+    [11] = "DT_MIPS_CONFLICTNO",
+    [16] = "DT_MIPS_LIBLISTNO",
+    [17] = "DT_MIPS_SYMTABNO",
+    [18] = "DT_MIPS_UNREFEXTNO",
+    [19] = "DT_MIPS_GOTSYM",
+    [20] = "DT_MIPS_HIPAGENO",
+    [22] = "DT_MIPS_RLD_MAP",
+    [23] = "DT_MIPS_DELTA_CLASS",
+    [24] = "DT_MIPS_DELTA_CLASS_NO",
+    [25] = "DT_MIPS_DELTA_INSTANCE",
+    [26] = "DT_MIPS_DELTA_INSTANCE_NO",
+    [27] = "DT_MIPS_DELTA_RELOC",
+    [28] = "DT_MIPS_DELTA_RELOC_NO",
+    [29] = "DT_MIPS_DELTA_SYM",
+    [30] = "DT_MIPS_DELTA_SYM_NO",
+    [32] = "DT_MIPS_DELTA_CLASSSYM",
+    [33] = "DT_MIPS_DELTA_CLASSSYM_NO",
+    [34] = "DT_MIPS_CXX_FLAGS",
+    [35] = "DT_MIPS_PIXIE_INIT",
+    [36] = "DT_MIPS_SYMBOL_LIB",
+    [37] = "DT_MIPS_LOCALPAGE_GOTIDX",
+    [38] = "DT_MIPS_LOCAL_GOTIDX",
+    [39] = "DT_MIPS_HIDDEN_GOTIDX",
+    [40] = "DT_MIPS_PROTECTED_GOTIDX",
+    [41] = "DT_MIPS_OPTIONS",
+    [42] = "DT_MIPS_INTERFACE",
+    [43] = "DT_MIPS_DYNSTR_ALIGN",
+    [44] = "DT_MIPS_INTERFACE_SIZE",
+    [45] = "DT_MIPS_RLD_TEXT_RESOLVE_ADDR",
+    [46] = "DT_MIPS_PERF_SUFFIX",
+    [47] = "DT_MIPS_COMPACT_SIZE",
+    [48] = "DT_MIPS_GP_VALUE",
+    [49] = "DT_MIPS_AUX_DYNAMIC",
+    [50] = "DT_MIPS_PLTGOT",
+    [52] = "DT_MIPS_RWPLT",
+    [53] = "DT_MIPS_RLD_MAP_REL",
+    [54] = "DT_MIPS_XHASH",
+};
+
+/* d_tag names of EM_PPC, indexed by d_tag - DT_LOPROC */
+static const char *const ppc_tags[] = {
+    [0] = "DT_PPC_GOT",
+    [1] = "DT_PPC_OPT",
+};
+
+/* d_tag names of EM_PPC64, indexed by d_tag - DT_LOPROC */
+static const char *const ppc64_tags[] = {
+    [0] = "DT_PPC64_GLINK",
+    [1] = "DT_PPC64_OPD",
+    [2] = "DT_PPC64_OPDSZ",
+    [3] = "DT_PPC64_OPT",
+};
+
+/* d_tag names of EM_AARCH64, indexed by d_tag - DT_LOPROC */
+static const char *const aarch64_tags[] = {
+    [1] = "DT_AARCH64_BTI_PLT",
+    [3] = "DT_AARCH64_PAC_PLT",
+    [5] = "DT_AARCH64_VARIANT_PCS",
+};
+
+/* d_tag names of EM_RISCV, indexed by d_tag - DT_LOPROC */
+static const char *const riscv_tags[] = {
+    [1] = "DT_RISCV_VARIANT_CC",
+};
+
+/* processor specific d_tag names keyed by e_machine */
+static const name_table_t proc_tags[] = {
+    NAMES(8, mips_tags),              // EM_MIPS
+    NAMES(10, mips_tags),             // EM_MIPS_RS3_LE
+    NAMES(20, ppc_tags),              // EM_PPC
+    NAMES(21, ppc64_tags),            // EM_PPC64
+    NAMES(183, aarch64_tags),         // EM_AARCH64
+    NAMES(243, riscv_tags),           // EM_RISCV
+};
+
+#define COUNT(table)    (sizeof(table) / sizeof(table[0]))
+
+static const char *find_name(const name_table_t *tables, size_t n, uint16_t machine, uint64_t value) {
+    for (size_t i = 0; i < n; i++) {
+        if (tables[i].machine == machine) {
+            return value < tables[i].count? tables[i].names[value]: NULL;
+        }
+    }
+    return NULL;
+}
+
+const char *machine_name(uint16_t machine) {
+    return machine < COUNT(machine_names)? machine_names[machine]: NULL;
+}
+
+const char *reloc_type_name(uint16_t machine, uint32_t type) {
+    return find_name(reloc_names, COUNT(reloc_names), machine, type);
+}
+
+const char *dyn_tag_name(uint16_t machine, int64_t tag) {
+    if (tag >= 0 && tag < COUNT(dyn_tags)) {
+        return dyn_tags[tag];
+    }
+    if (tag >= 0x70000000 && tag <= 0x7fffffff) {
+        return find_name(proc_tags, COUNT(proc_tags), machine, tag - 0x70000000);
+    }
+    /* binary search of the OS range */
+    size_t lo = 0, hi = COUNT(os_tags);
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (os_tags[mid].tag == tag) {
+            return os_tags[mid].name;
+        }
+        if (os_tags[mid].tag < tag) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return NULL;
+}
+
+const char *section_type_name(uint32_t type) {
+    static const char *names[] = {
+        "NULL", "PROGBITS", "SYMTAB", "STRTAB", "RELA", "HASH", "DYNAMIC", "NOTE", "NOBITS", "REL",
+        "SHLIB", "DYNSYM", NULL, NULL, "INIT_ARRAY", "FINI_ARRAY", "PREINIT_ARRAY", "GROUP",
+        "SYMTAB_SHNDX", "RELR",
+    };
+    switch (type) {
+        case SHT_GNU_HASH: return "GNU_HASH";
+        case SHT_GNU_verdef: return "VERDEF";
+        case SHT_GNU_verneed: return "VERNEED";
+        case SHT_GNU_versym: return "VERSYM";
+        case SHT_GNU_ATTRIBUTES: return "GNU_ATTRIBUTES";
+        default: return type < COUNT(names)? names[type]: NULL;
+    }
+}
+
+const char *segment_type_name(uint32_t type) {
+    static const char *names[] = {"NULL", "LOAD", "DYNAMIC", "INTERP", "NOTE", "SHLIB", "PHDR", "TLS"};
+    switch (type) {
+        case PT_GNU_EH_FRAME: return "GNU_EH_FRAME";
+        case PT_GNU_STACK: return "GNU_STACK";
+        case PT_GNU_RELRO: return "GNU_RELRO";
+        case PT_GNU_PROPERTY: return "GNU_PROPERTY";
+        default: return type < COUNT(names)? names[type]: NULL;
+    }
+}
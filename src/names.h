@@ -0,0 +1,71 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __NAMES_H
+#define __NAMES_H
+
+/**
+ * @brief 获取e_machine的描述
+ * get the description of e_machine
+ * @param machine e_machine
+ * @return description, NULL if unknown
+ */
+const char *machine_name(uint16_t machine);
+
+/**
+ * @brief 获取重定位类型名称，按(e_machine, r_type)查表
+ * get the name of a relocation type, looked up by (e_machine, r_type)
+ * @param machine e_machine
+ * @param type r_type
+ * @return name, NULL if unknown
+ */
+const char *reloc_type_name(uint16_t machine, uint32_t type);
+
+/**
+ * @brief 获取动态段标签名称，处理器相关的标签按e_machine查表
+ * get the name of a dynamic tag, processor specific tags are looked up by e_machine
+ * @param machine e_machine
+ * @param tag d_tag
+ * @return name, NULL if unknown
+ */
+const char *dyn_tag_name(uint16_t machine, int64_t tag);
+
+/**
+ * @brief 获取节类型名称
+ * get the name of a section type
+ * @param type sh_type
+ * @return name, NULL if unknown
+ */
+const char *section_type_name(uint32_t type);
+
+/**
+ * @brief 获取段类型名称
+ * get the name of a segment type
+ * @param type p_type
+ * @return name, NULL if unknown
+ */
+const char *segment_type_name(uint32_t type);
+
+#endif
@@ -27,6 +27,7 @@
 #include "lib/elfutil.h"
 #ifndef __PARSE_H
 #define __PARSE_H
+#include <regex.h>
 typedef enum PARSE_OPT {
     ALL = 1,
     HEADERS,
@@ -41,14 +42,85 @@ typedef enum PARSE_OPT {
     END
 } PARSE_OPT_T;
 
+/* filter keys of the symbol and relocation tables */
+typedef enum FILTER_KEY {
+    FILTER_NAME,        // --name, shell glob of the symbol name
+    FILTER_REGEX,       // --regex, extended regular expression of the symbol name
+    FILTER_TYPE,        // --type, STT_* name or number
+    FILTER_BIND,        // --bind, STB_* name or number
+    FILTER_SHNDX,       // --shndx, section index, UND, ABS or COMMON
+    FILTER_RANGE,       // --range, value or offset range, lo-hi
+    FILTER_RTYPE,       // --rtype, relocation type glob or number
+    FILTER_START,       // --start, first entry index
+    FILTER_COUNT,       // --count, entry count from start
+} FILTER_KEY_T;
+
+typedef struct parse_filter {
+    bool active;
+    char *name;
+    bool regex;
+    regex_t re;
+    int type;           // -1 means any
+    int bind;           // -1 means any
+    int shndx;          // -1 means any
+    uint64_t min;
+    uint64_t max;
+    char *rtype;
+    size_t start;
+    size_t count;       // 0 means to the end of the table
+} parse_filter_t;
+
 typedef struct parser_opt {
     char options[END];
     int index;
+    int jobs;           // workers formatting large tables, 0 means one per CPU
+    parse_filter_t filter;
 } parser_opt_t;
 #endif
 
 int parse(Elf *elf, parser_opt_t *po, uint32_t length);
 
+/**
+ * @brief 初始化过滤条件，默认匹配所有表项
+ * initialize the filter, which matches every entry
+ * @param f filter
+ */
+void filter_init(parse_filter_t *f);
+
+/**
+ * @brief 设置一个过滤条件
+ * set one filter condition
+ * @param f filter
+ * @param key FILTER_KEY_T
+ * @param value option argument
+ * @return error code
+ */
+int filter_set(parse_filter_t *f, int key, const char *value);
+
+/**
+ * @brief 判断符号是否满足过滤条件
+ * check whether a symbol passes the filter
+ * @param f filter
+ * @param index symbol index
+ * @param name symbol name
+ * @param sym symbol, widened to the 64-bit layout
+ * @return true or false
+ */
+bool filter_sym(parse_filter_t *f, size_t index, const char *name, Elf64_Sym *sym);
+
+/**
+ * @brief 判断重定位是否满足过滤条件
+ * check whether a relocation passes the filter
+ * @param f filter
+ * @param index relocation index
+ * @param offset r_offset
+ * @param type relocation type number
+ * @param type_name relocation type name, may be NULL
+ * @param name symbol name, may be NULL
+ * @return true or false
+ */
+bool filter_rel(parse_filter_t *f, size_t index, uint64_t offset, uint32_t type, const char *type_name, const char *name);
+
 /**
  * @description: Judge whether the option is true
  * @param {parser_opt_t} po
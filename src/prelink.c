@@ -0,0 +1,310 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "reloc.h"
+#include "prelink.h"
+
+#ifndef DT_RELRSZ
+#define DT_RELRSZ   35
+#define DT_RELR     36
+#endif
+#ifndef SHT_RELR
+#define SHT_RELR    19
+#endif
+
+static const char *class_names[] = {
+    "none", "relative", "glob_dat", "jump_slot", "abs", "irelative", "copy", "tls", "other",
+};
+
+typedef struct Prelink {
+    Elf *elf;
+    size_t word;
+    uint64_t bias;
+    size_t relative;        // applied and dropped
+    size_t remaining[RELOC_OTHER + 1];
+    int nr;
+} prelink_t;
+
+static uint8_t *word_at(Elf *elf, uint64_t vaddr, size_t word) {
+    uint64_t off;
+    if (vaddr_to_offset(elf, vaddr, &off) != NO_ERR || off + word > elf->size) {
+        return NULL;
+    }
+    return elf->mem + off;
+}
+
+static uint64_t get_word(uint8_t *p, size_t word) {
+    return word == 4? *(uint32_t *)p: *(uint64_t *)p;
+}
+
+static void put_word(uint8_t *p, size_t word, uint64_t value) {
+    if (word == 4) {
+        *(uint32_t *)p = value;
+    } else {
+        *(uint64_t *)p = value;
+    }
+}
+
+/* everything that depends on the load address is written with the final value */
+static int bake(void *arg, reloc_t *rel) {
+    prelink_t *pl = (prelink_t *)arg;
+    uint8_t *p = word_at(pl->elf, rel->offset, pl->word);
+
+    switch (rel->klass) {
+        case RELOC_RELATIVE:
+            if (p) {
+                put_word(p, pl->word, rel->addend + pl->bias);
+            }
+            pl->relative++;
+            return NO_ERR;
+        case RELOC_JUMP_SLOT:
+            /* a lazy slot holds the PLT stub, ld.so only adds the load bias */
+            if (p && get_word(p, pl->word)) {
+                put_word(p, pl->word, get_word(p, pl->word) + pl->bias);
+            }
+            break;
+        case RELOC_IRELATIVE:
+            if (rel->table == RELOC_REL) {
+                if (p) {
+                    put_word(p, pl->word, get_word(p, pl->word) + pl->bias);
+                }
+            } else {
+                put_word(pl->elf->mem + rel->entry + pl->word * 2, pl->word, rel->addend + pl->bias);
+            }
+            break;
+        default:
+            break;
+    }
+
+    pl->remaining[rel->klass]++;
+    printf("    [%4d] %016lx %-6u %-10s %s\n", pl->nr++, rel->offset + pl->bias, rel->type,
+        class_names[rel->klass], rel->name? rel->name: "");
+    return NO_ERR;
+}
+
+/* drop the RELATIVE entries, shift r_offset of the others, return the new size */
+static uint64_t compact(prelink_t *pl, reloc_info_t *info, int t) {
+    reloc_table_t *table = &info->tables[t];
+    reloc_table_t *jmprel = &info->tables[RELOC_JMPREL];
+    size_t word = pl->word, entsize = table->rela? word * 3: word * 2;
+    uint64_t end = table->offset + table->size, dst = table->offset;
+    bool overlap = t != RELOC_JMPREL && jmprel->size && jmprel->offset >= table->offset && jmprel->offset < end;
+
+    if (overlap) {
+        end = jmprel->offset;
+    }
+    for (uint64_t off = table->offset; off + entsize <= end; off += entsize) {
+        uint8_t *p = pl->elf->mem + off;
+        uint64_t r_info = get_word(p + word, word);
+        uint32_t type = word == 4? ELF32_R_TYPE(r_info): ELF64_R_TYPE(r_info);
+        int klass = reloc_class(info->machine, type);
+        if (t != RELOC_JMPREL && (klass == RELOC_RELATIVE || klass == RELOC_NONE)) {
+            continue;
+        }
+        put_word(p, word, get_word(p, word) + pl->bias);
+        if (dst != off) {
+            memmove(pl->elf->mem + dst, p, entsize);
+        }
+        dst += entsize;
+    }
+    /* JMPREL follows inside DT_RELA, keep the size and fill with R_NONE */
+    memset(pl->elf->mem + dst, 0, end - dst);
+    return overlap? table->size: dst - table->offset;
+}
+
+static bool is_pointer_tag(int64_t tag) {
+    switch (tag) {
+        case DT_PLTGOT: case DT_HASH: case DT_STRTAB: case DT_SYMTAB: case DT_RELA: case DT_INIT: case DT_FINI:
+        case DT_REL: case DT_JMPREL: case DT_INIT_ARRAY: case DT_FINI_ARRAY: case DT_PREINIT_ARRAY:
+        case DT_GNU_HASH: case DT_VERSYM: case DT_VERDEF: case DT_VERNEED: case DT_RELR:
+        case DT_TLSDESC_PLT: case DT_TLSDESC_GOT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static void shift_symbols(prelink_t *pl, Elf64_Shdr *shdr) {
+    Elf *elf = pl->elf;
+    size_t symsize = elf->class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    if (shdr->sh_offset + shdr->sh_size > elf->size) {
+        return;
+    }
+    for (size_t i = 0; i < shdr->sh_size / symsize; i++) {
+        Elf64_Sym sym;
+        get_sym_by_table(elf, elf->mem + shdr->sh_offset, i, &sym);
+        if (sym.st_shndx == SHN_UNDEF || sym.st_shndx >= SHN_LORESERVE || ELF64_ST_TYPE(sym.st_info) == STT_TLS) {
+            continue;
+        }
+        if (elf->class == ELFCLASS32) {
+            ((Elf32_Sym *)(elf->mem + shdr->sh_offset))[i].st_value += pl->bias;
+        } else {
+            ((Elf64_Sym *)(elf->mem + shdr->sh_offset))[i].st_value += pl->bias;
+        }
+    }
+}
+
+int prelink(Elf *elf, uint64_t base) {
+    prelink_t pl;
+    reloc_info_t info;
+    uint64_t lo = UINT64_MAX, align = ONE_PAGE, dynamic = 0, size[RELOC_TABLES];
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    int shnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_shnum: elf->data.elf64.ehdr->e_shnum;
+    int type = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_type: elf->data.elf64.ehdr->e_type;
+    bool interp = false;
+    uint8_t *p;
+
+    if (type != ET_DYN) {
+        return ERR_ELF_TYPE;
+    }
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        get_segment_by_index(elf, i, &phdr);
+        if (phdr.p_type == PT_LOAD) {
+            lo = phdr.p_vaddr < lo? phdr.p_vaddr: lo;
+            align = phdr.p_align > align? phdr.p_align: align;
+        }
+        if (phdr.p_type == PT_DYNAMIC) {
+            dynamic = phdr.p_vaddr;
+        }
+        interp |= phdr.p_type == PT_INTERP;
+    }
+    if (!base || lo == UINT64_MAX || base & (align - 1)) {
+        PRINT_WARNING("choose a base aligned to 0x%lx with -b\n", align);
+        return ERR_ARGS;
+    }
+    if (reloc_info(elf, &info) != NO_ERR) {
+        return ERR_DYN_NOTFOUND;
+    }
+
+    memset(&pl, 0, sizeof(pl));
+    pl.elf = elf;
+    pl.word = info.word;
+    pl.bias = base - (lo & ~(align - 1));
+
+    /* the file words first, vaddr_to_offset needs the old addresses */
+    PRINT_INFO("relocations which still need runtime binding\n");
+    printf("    [%4s] %-16s %-6s %-10s %s\n", "Nr", "Offset", "Type", "Class", "Symbol");
+    reloc_foreach(elf, &info, bake, &pl);
+    if (info.pltgot && dynamic && (p = word_at(elf, info.pltgot, pl.word)) && get_word(p, pl.word) == dynamic) {
+        put_word(p, pl.word, dynamic + pl.bias);
+    }
+
+    for (int t = RELOC_JMPREL; t <= RELOC_REL; t++) {
+        size[t] = info.tables[t].size? compact(&pl, &info, t): 0;
+    }
+    for (int i = 1; i < shnum; i++) {
+        Elf64_Shdr shdr;
+        get_section_by_index(elf, i, &shdr);
+        for (int t = RELOC_RELA; t <= RELOC_REL; t++) {
+            if (info.tables[t].size && shdr.sh_offset == info.tables[t].offset &&
+                (shdr.sh_type == SHT_RELA || shdr.sh_type == SHT_REL) && shdr.sh_size > size[t]) {
+                shdr.sh_size = size[t];
+            }
+        }
+        if (shdr.sh_type == SHT_RELR) {
+            shdr.sh_size = 0;
+        }
+        if (shdr.sh_type == SHT_SYMTAB || shdr.sh_type == SHT_DYNSYM) {
+            shift_symbols(&pl, &shdr);
+        }
+        if (shdr.sh_flags & SHF_ALLOC) {
+            shdr.sh_addr += pl.bias;
+        }
+        if (elf->class == ELFCLASS32) {
+            elf->data.elf32.shdr[i].sh_addr = shdr.sh_addr;
+            elf->data.elf32.shdr[i].sh_size = shdr.sh_size;
+        } else {
+            elf->data.elf64.shdr[i].sh_addr = shdr.sh_addr;
+            elf->data.elf64.shdr[i].sh_size = shdr.sh_size;
+        }
+    }
+
+    /* .dynamic, ld.so must not process the dropped entries again */
+    int count = elf->class == ELFCLASS32? elf->data.elf32.dyn_count: elf->data.elf64.dyn_count;
+    for (int i = 0; i < count; i++) {
+        Elf64_Dyn dyn;
+        get_dyn_by_index(elf, i, &dyn);
+        if (dyn.d_tag == DT_NULL) {
+            break;
+        }
+        if (is_pointer_tag(dyn.d_tag) && dyn.d_un.d_ptr) {
+            dyn.d_un.d_ptr += pl.bias;
+        }
+        switch (dyn.d_tag) {
+            case DT_RELASZ: dyn.d_un.d_val = size[RELOC_RELA]; break;
+            case DT_RELSZ: dyn.d_un.d_val = size[RELOC_REL]; break;
+            case DT_RELACOUNT: case DT_RELCOUNT: case DT_RELRSZ: dyn.d_un.d_val = 0; break;
+            case DT_FLAGS_1: if (interp) dyn.d_un.d_val &= ~DF_1_PIE; break;
+            default: break;
+        }
+        if (elf->class == ELFCLASS32) {
+            elf->data.elf32.dyn[i].d_un.d_val = dyn.d_un.d_val;
+        } else {
+            elf->data.elf64.dyn[i].d_un.d_val = dyn.d_un.d_val;
+        }
+    }
+
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        get_segment_by_index(elf, i, &phdr);
+        if (phdr.p_type == PT_GNU_STACK) {
+            continue;
+        }
+        set_segment_vaddr_by_index(elf, i, phdr.p_vaddr + pl.bias);
+        set_segment_paddr_by_index(elf, i, phdr.p_paddr + pl.bias);
+    }
+    /* a program is mapped at its addresses by the kernel */
+    if (elf->class == ELFCLASS32) {
+        elf->data.elf32.ehdr->e_entry += elf->data.elf32.ehdr->e_entry? pl.bias: 0;
+        elf->data.elf32.ehdr->e_type = interp? ET_EXEC: ET_DYN;
+    } else {
+        elf->data.elf64.ehdr->e_entry += elf->data.elf64.ehdr->e_entry? pl.bias: 0;
+        elf->data.elf64.ehdr->e_type = interp? ET_EXEC: ET_DYN;
+    }
+
+    size_t remaining = 0;
+    for (int i = 0; i <= RELOC_OTHER; i++) {
+        remaining += pl.remaining[i];
+    }
+    PRINT_INFO("based at 0x%lx, %lu relative relocations applied, DT_RELA %lu -> %lu bytes, DT_REL %lu -> %lu bytes\n",
+        base, pl.relative, info.tables[RELOC_RELA].size, size[RELOC_RELA], info.tables[RELOC_REL].size, size[RELOC_REL]);
+    if (remaining) {
+        PRINT_WARNING("%lu relocations still need runtime binding: %lu glob_dat, %lu jump_slot, %lu abs, "
+            "%lu irelative, %lu copy, %lu tls, %lu other\n", remaining, pl.remaining[RELOC_GLOB_DAT],
+            pl.remaining[RELOC_JUMP_SLOT], pl.remaining[RELOC_ABS], pl.remaining[RELOC_IRELATIVE],
+            pl.remaining[RELOC_COPY], pl.remaining[RELOC_TLS], pl.remaining[RELOC_OTHER]);
+    }
+    if (!interp) {
+        PRINT_WARNING("the shared object must be loaded at 0x%lx, it can not be relocated any more\n", base);
+    }
+    return remaining;
+}
@@ -0,0 +1,44 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#ifndef __PRELINK_H
+#define __PRELINK_H
+
+/**
+ * @brief 将ET_DYN预链接到固定基址：原地施加所有RELATIVE重定位并从.rela.dyn中删除，
+ * 平移p_vaddr、sh_addr、符号和.dynamic中的指针，报告仍需运行时绑定的重定位。
+ * 带PT_INTERP的程序转换为ET_EXEC，由内核加载到该基址
+ * prelink an ET_DYN to a fixed base: apply every RELATIVE relocation in place
+ * and drop it from .rela.dyn, shift p_vaddr, sh_addr, the symbols and the
+ * pointers of .dynamic, and report the relocations that still need runtime
+ * binding. A program with PT_INTERP becomes ET_EXEC so the kernel maps it at
+ * the base
+ * @param elf elf file custom structure, opened for writing
+ * @param base new load address, aligned to the largest p_align
+ * @return number of remaining relocations, or error code
+ */
+int prelink(Elf *elf, uint64_t base);
+
+#endif
@@ -0,0 +1,274 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "reloc.h"
+
+#ifndef DT_RELR
+#define DT_RELRSZ   35
+#define DT_RELR     36
+#endif
+
+#ifndef EM_LOONGARCH
+#define EM_LOONGARCH 258
+#endif
+
+/* relocation types of one machine, 0 for none */
+typedef struct RelocTypes {
+    uint16_t machine;
+    uint32_t relative;
+    uint32_t glob_dat;
+    uint32_t jump_slot;
+    uint32_t abs;
+    uint32_t irelative;
+    uint32_t copy;
+    uint32_t tls[6];
+} reloc_types_t;
+
+static const reloc_types_t reloc_types[] = {
+    {EM_386,     8,    6,    7,    1,   42,   5,    {14, 35, 36, 37, 41}},
+    {EM_X86_64,  8,    6,    7,    1,   37,   5,    {16, 17, 18, 36}},
+    {EM_ARM,     23,   21,   22,   2,   160,  20,   {13, 17, 18, 19}},
+    {EM_AARCH64, 1027, 1025, 1026, 257, 1032, 1024, {1028, 1029, 1030, 1031}},
+    {EM_RISCV,   3,    0,    5,    2,   58,   4,    {6, 7, 8, 9, 10, 11}},
+    {EM_PPC,     22,   20,   21,   1,   248,  19,   {68, 73, 78}},
+    {EM_PPC64,   22,   20,   21,   38,  248,  19,   {68, 73, 78}},
+    {EM_MIPS,    0,    51,   127,  2,   0,    126,  {38, 39, 40, 41, 47, 48}},
+    {EM_LOONGARCH, 3,  0,    5,    2,   12,   4,    {6, 7, 8, 9, 10, 11}},
+};
+
+static const reloc_types_t *find_types(uint16_t machine) {
+    for (int i = 0; i < sizeof(reloc_types) / sizeof(reloc_types[0]); i++) {
+        if (reloc_types[i].machine == machine) {
+            return &reloc_types[i];
+        }
+    }
+    return NULL;
+}
+
+int reloc_class(uint16_t machine, uint32_t type) {
+    const reloc_types_t *t = find_types(machine);
+    if (!type) {
+        return RELOC_NONE;
+    }
+    if (!t) {
+        return RELOC_OTHER;
+    }
+    if (type == t->relative) return RELOC_RELATIVE;
+    if (type == t->glob_dat) return RELOC_GLOB_DAT;
+    if (type == t->jump_slot) return RELOC_JUMP_SLOT;
+    if (type == t->irelative) return RELOC_IRELATIVE;
+    if (type == t->copy) return RELOC_COPY;
+    /* R_RISCV_32 and R_RISCV_64, R_LARCH_32 and R_LARCH_64 */
+    if (type == t->abs || ((machine == EM_RISCV || machine == EM_LOONGARCH) && type == 1)) return RELOC_ABS;
+    for (int i = 0; i < 6 && t->tls[i]; i++) {
+        if (type == t->tls[i]) {
+            return RELOC_TLS;
+        }
+    }
+    return RELOC_OTHER;
+}
+
+int reloc_info(Elf *elf, reloc_info_t *info) {
+    int phnum = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_phnum: elf->data.elf64.ehdr->e_phnum;
+    uint64_t pltrel = DT_RELA;
+    Elf64_Phdr dynamic = {0};
+
+    memset(info, 0, sizeof(reloc_info_t));
+    info->machine = elf->class == ELFCLASS32? elf->data.elf32.ehdr->e_machine: elf->data.elf64.ehdr->e_machine;
+    info->word = elf->class == ELFCLASS32? 4: 8;
+    for (int i = 0; i < phnum; i++) {
+        Elf64_Phdr phdr;
+        if (get_segment_by_index(elf, i, &phdr) == NO_ERR && phdr.p_type == PT_DYNAMIC) {
+            dynamic = phdr;
+        }
+    }
+    if (!dynamic.p_filesz || dynamic.p_offset + dynamic.p_filesz > elf->size) {
+        return ERR_DYN_NOTFOUND;
+    }
+
+    for (uint64_t off = 0; off + info->word * 2 <= dynamic.p_filesz; off += info->word * 2) {
+        uint8_t *p = elf->mem + dynamic.p_offset + off;
+        int64_t tag = info->word == 4? *(int32_t *)p: *(int64_t *)p;
+        uint64_t val = info->word == 4? *(uint32_t *)(p + 4): *(uint64_t *)(p + 8);
+        if (tag == DT_NULL) {
+            break;
+        }
+        switch (tag) {
+            case DT_SYMTAB: info->symtab = val; break;
+            case DT_STRTAB: info->strtab = val; break;
+            case DT_STRSZ: info->strsz = val; break;
+            case DT_PLTGOT: info->pltgot = val; break;
+            case DT_JMPREL: info->tables[RELOC_JMPREL].addr = val; break;
+            case DT_PLTRELSZ: info->tables[RELOC_JMPREL].size = val; break;
+            case DT_PLTREL: pltrel = val; break;
+            case DT_RELA: info->tables[RELOC_RELA].addr = val; break;
+            case DT_RELASZ: info->tables[RELOC_RELA].size = val; break;
+            case DT_REL: info->tables[RELOC_REL].addr = val; break;
+            case DT_RELSZ: info->tables[RELOC_REL].size = val; break;
+            case DT_RELR: info->tables[RELOC_RELR].addr = val; break;
+            case DT_RELRSZ: info->tables[RELOC_RELR].size = val; break;
+            default: break;
+        }
+    }
+    info->tables[RELOC_JMPREL].rela = pltrel == DT_RELA;
+    info->tables[RELOC_RELA].rela = true;
+
+    for (int t = 0; t < RELOC_TABLES; t++) {
+        reloc_table_t *table = &info->tables[t];
+        if (!table->addr || vaddr_to_offset(elf, table->addr, &table->offset) != NO_ERR) {
+            table->size = 0;
+            continue;
+        }
+        if (table->offset + table->size > elf->size) {
+            table->size = elf->size - table->offset;
+        }
+    }
+    if (vaddr_to_offset(elf, info->symtab, &info->symtab) != NO_ERR ||
+        vaddr_to_offset(elf, info->strtab, &info->strtab) != NO_ERR || info->strtab + info->strsz > elf->size) {
+        info->symtab = info->strtab = info->strsz = 0;
+    }
+    return NO_ERR;
+}
+
+static uint64_t read_word(Elf *elf, uint64_t vaddr, size_t word) {
+    uint64_t off;
+    if (vaddr_to_offset(elf, vaddr, &off) != NO_ERR || off + word > elf->size) {
+        return 0;
+    }
+    return word == 4? *(uint32_t *)(elf->mem + off): *(uint64_t *)(elf->mem + off);
+}
+
+static void read_symbol(Elf *elf, reloc_info_t *info, reloc_t *rel) {
+    size_t symsize = info->word == 4? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    memset(&rel->symbol, 0, sizeof(Elf64_Sym));
+    rel->name = NULL;
+    if (!rel->sym || !info->symtab || info->symtab + (rel->sym + 1) * symsize > elf->size) {
+        return;
+    }
+    get_sym_by_table(elf, elf->mem + info->symtab, rel->sym, &rel->symbol);
+    if (rel->symbol.st_name < info->strsz &&
+        memchr(elf->mem + info->strtab + rel->symbol.st_name, '\0', info->strsz - rel->symbol.st_name)) {
+        rel->name = (const char *)elf->mem + info->strtab + rel->symbol.st_name;
+    }
+}
+
+/* DT_RELR: an even entry is an address, an odd entry a bitmap of the following words */
+static int foreach_relr(Elf *elf, reloc_info_t *info, reloc_visit_t visit, void *arg) {
+    reloc_table_t *table = &info->tables[RELOC_RELR];
+    const reloc_types_t *types = find_types(info->machine);
+    size_t word = info->word;
+    uint64_t next = 0;
+    reloc_t rel;
+
+    memset(&rel, 0, sizeof(rel));
+    rel.table = RELOC_RELR;
+    rel.type = types? types->relative: 0;
+    rel.klass = RELOC_RELATIVE;
+    for (uint64_t off = table->offset; off + word <= table->offset + table->size; off += word) {
+        uint64_t entry = word == 4? *(uint32_t *)(elf->mem + off): *(uint64_t *)(elf->mem + off);
+        rel.entry = off;
+        if (!(entry & 1)) {
+            rel.offset = entry;
+            rel.value = rel.addend = read_word(elf, entry, word);
+            int err = visit(arg, &rel);
+            if (err != NO_ERR) {
+                return err;
+            }
+            next = entry + word;
+            continue;
+        }
+        for (int bit = 1; bit < word * 8; bit++) {
+            if (entry >> bit & 1) {
+                rel.offset = next + (bit - 1) * word;
+                rel.value = rel.addend = read_word(elf, rel.offset, word);
+                int err = visit(arg, &rel);
+                if (err != NO_ERR) {
+                    return err;
+                }
+            }
+        }
+        next += (word * 8 - 1) * word;
+    }
+    return NO_ERR;
+}
+
+int reloc_foreach(Elf *elf, reloc_info_t *info, reloc_visit_t visit, void *arg) {
+    reloc_table_t *jmprel = &info->tables[RELOC_JMPREL];
+    size_t word = info->word;
+
+    for (int t = RELOC_JMPREL; t <= RELOC_REL; t++) {
+        reloc_table_t *table = &info->tables[t];
+        size_t entsize = table->rela? word * 3: word * 2;
+        uint64_t end = table->offset + table->size;
+        for (uint64_t off = table->offset; table->size && off + entsize <= end; off += entsize) {
+            /* DT_RELA may cover DT_JMPREL on some linkers */
+            if (t != RELOC_JMPREL && jmprel->size && off >= jmprel->offset && off < jmprel->offset + jmprel->size) {
+                continue;
+            }
+            uint8_t *p = elf->mem + off;
+            uint64_t r_info;
+            reloc_t rel;
+            rel.table = t;
+            rel.entry = off;
+            if (word == 4) {
+                rel.offset = *(uint32_t *)p;
+                r_info = *(uint32_t *)(p + 4);
+                rel.type = ELF32_R_TYPE(r_info);
+                rel.sym = ELF32_R_SYM(r_info);
+                rel.addend = table->rela? *(int32_t *)(p + 8): 0;
+            } else {
+                rel.offset = *(uint64_t *)p;
+                r_info = *(uint64_t *)(p + 8);
+                rel.type = ELF64_R_TYPE(r_info);
+                rel.sym = ELF64_R_SYM(r_info);
+                rel.addend = table->rela? *(int64_t *)(p + 16): 0;
+            }
+            rel.klass = reloc_class(info->machine, rel.type);
+            if (rel.klass == RELOC_NONE) {
+                continue;
+            }
+            rel.value = read_word(elf, rel.offset, word);
+            /* GLOB_DAT and JUMP_SLOT of REL ignore the word in place */
+            if (!table->rela && rel.klass != RELOC_GLOB_DAT && rel.klass != RELOC_JUMP_SLOT) {
+                rel.addend = word == 4? (int32_t)rel.value: (int64_t)rel.value;
+            }
+            read_symbol(elf, info, &rel);
+            int err = visit(arg, &rel);
+            if (err != NO_ERR) {
+                return err;
+            }
+        }
+    }
+    if (info->tables[RELOC_RELR].size) {
+        return foreach_relr(elf, info, visit, arg);
+    }
+    return NO_ERR;
+}
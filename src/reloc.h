@@ -0,0 +1,117 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef __RELOC_H
+#define __RELOC_H
+
+/* what a dynamic relocation asks the loader to do */
+enum RELOC_CLASS {
+    RELOC_NONE,
+    RELOC_RELATIVE,         // base + addend
+    RELOC_GLOB_DAT,         // address of a symbol
+    RELOC_JUMP_SLOT,        // address of a function, may be bound lazily
+    RELOC_ABS,              // address of a symbol + addend
+    RELOC_IRELATIVE,        // result of an ifunc resolver
+    RELOC_COPY,             // copy the data of a symbol
+    RELOC_TLS,              // thread local storage
+    RELOC_OTHER,
+};
+
+/* tables located through .dynamic */
+enum RELOC_TABLE {
+    RELOC_JMPREL,
+    RELOC_RELA,
+    RELOC_REL,
+    RELOC_RELR,
+    RELOC_TABLES,
+};
+
+typedef struct RelocTable {
+    uint64_t addr;          // DT_JMPREL, DT_RELA, DT_REL or DT_RELR
+    uint64_t offset;        // file offset of the table
+    uint64_t size;
+    bool rela;
+} reloc_table_t;
+
+typedef struct Reloc {
+    int table;              // enum RELOC_TABLE
+    uint64_t entry;         // file offset of the entry
+    uint64_t offset;        // r_offset
+    uint32_t type;          // r_type, the RELATIVE type for DT_RELR
+    uint32_t sym;           // symbol index
+    int64_t addend;         // r_addend, or the implicit addend of REL and RELR
+    uint64_t value;         // the word at r_offset in the file
+    int klass;              // enum RELOC_CLASS
+    const char *name;       // symbol name, NULL if none
+    Elf64_Sym symbol;       // zeroed if none
+} reloc_t;
+
+/* dynamic relocation information of an elf file */
+typedef struct RelocInfo {
+    uint16_t machine;
+    size_t word;            // 4 or 8
+    reloc_table_t tables[RELOC_TABLES];
+    uint64_t symtab;        // file offset of DT_SYMTAB
+    uint64_t strtab;        // file offset of DT_STRTAB
+    uint64_t strsz;
+    uint64_t pltgot;        // DT_PLTGOT address
+} reloc_info_t;
+
+/* return NO_ERR to continue, anything else stops the walk and is returned */
+typedef int (*reloc_visit_t)(void *arg, reloc_t *rel);
+
+/**
+ * @brief 获取重定位类型的类别
+ * get the class of a relocation type
+ * @param machine e_machine
+ * @param type r_type
+ * @return enum RELOC_CLASS, RELOC_OTHER for an unknown machine
+ */
+int reloc_class(uint16_t machine, uint32_t type);
+
+/**
+ * @brief 通过.dynamic定位动态重定位表和符号表
+ * locate the dynamic relocation tables and the symbol table through .dynamic
+ * @param elf elf file custom structure
+ * @param info output information
+ * @return error code, ERR_DYN_NOTFOUND if there is no PT_DYNAMIC
+ */
+int reloc_info(Elf *elf, reloc_info_t *info);
+
+/**
+ * @brief 按DT_JMPREL、DT_RELA、DT_REL、DT_RELR的顺序遍历所有动态重定位，
+ * DT_RELA与DT_JMPREL重叠的部分只访问一次
+ * visit every dynamic relocation, DT_JMPREL first, then DT_RELA, DT_REL and
+ * DT_RELR. Entries of DT_RELA that overlap DT_JMPREL are visited once
+ * @param elf elf file custom structure
+ * @param info information from reloc_info
+ * @param visit callback
+ * @param arg callback argument
+ * @return error code, or the first value returned by visit other than NO_ERR
+ */
+int reloc_foreach(Elf *elf, reloc_info_t *info, reloc_visit_t visit, void *arg);
+
+#endif
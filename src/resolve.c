@@ -0,0 +1,1147 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <libgen.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "resolve.h"
+
+#define BIND_UNRESOLVED     1
+#define BIND_WEAK           2
+#define BIND_MISMATCH       3
+
+/* check that [vaddr, vaddr + len) is backed by the file, return the mapped address */
+static void *map_vaddr(Elf *elf, uint64_t vaddr, uint64_t len) {
+    uint64_t offset;
+    if (vaddr_to_offset(elf, vaddr, &offset) != NO_ERR) {
+        return NULL;
+    }
+    if (offset + len > elf->size || offset + len < offset) {
+        return NULL;
+    }
+    return elf->mem + offset;
+}
+
+static bool in_file(dso_t *d, void *p, uint64_t len) {
+    uint8_t *b = (uint8_t *)p;
+    return b >= d->elf.mem && b + len <= d->elf.mem + d->elf.size && b + len >= b;
+}
+
+char *dso_sym(dso_t *d, uint32_t index, Elf64_Sym *sym) {
+    get_sym_by_table(&d->elf, d->symtab, index, sym);
+    if (sym->st_name >= d->strsz) {
+        return "";
+    }
+    return d->strtab + sym->st_name;
+}
+
+bool is_exported_def(Elf64_Sym *sym) {
+    int bind = ELF64_ST_BIND(sym->st_info);
+    int type = ELF64_ST_TYPE(sym->st_info);
+    int vis = ELF64_ST_VISIBILITY(sym->st_other);
+    if (sym->st_shndx == SHN_UNDEF) {
+        return false;
+    }
+    if (bind != STB_GLOBAL && bind != STB_WEAK && bind != STB_GNU_UNIQUE) {
+        return false;
+    }
+    if (vis == STV_HIDDEN || vis == STV_INTERNAL) {
+        return false;
+    }
+    if (type == STT_SECTION || type == STT_FILE) {
+        return false;
+    }
+    /* undefined TLS and common symbols are references */
+    if (sym->st_value == 0 && type != STT_TLS && sym->st_shndx != SHN_ABS) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 计算.gnu.hash覆盖的符号数量
+ * count the symbols covered by .gnu.hash
+ */
+static uint32_t gnuhash_nsyms(dso_t *d) {
+    uint32_t max = 0;
+    for (uint32_t i = 0; i < d->nbuckets; i++) {
+        if (d->buckets[i] > max) {
+            max = d->buckets[i];
+        }
+    }
+    if (max < d->symoffset) {
+        return d->symoffset;
+    }
+    while (in_file(d, &d->chain[max - d->symoffset], sizeof(uint32_t))) {
+        if (d->chain[max - d->symoffset] & 1) {
+            return max + 1;
+        }
+        max++;
+    }
+    return max;
+}
+
+/**
+ * @brief 没有.gnu.hash时，使用gnu hash值自行建立索引
+ * build an index with the gnu hash values when the object has no .gnu.hash
+ */
+static int build_index(dso_t *d) {
+    uint32_t n = 1;
+    Elf64_Sym sym;
+
+    while (n < d->nsyms) {
+        n <<= 1;
+    }
+    d->idx_mask = n - 1;
+    d->idx_buckets = malloc(n * sizeof(uint32_t));
+    d->idx_next = malloc((d->nsyms + 1) * sizeof(uint32_t));
+    d->idx_hash = malloc((d->nsyms + 1) * sizeof(uint32_t));
+    if (!d->idx_buckets || !d->idx_next || !d->idx_hash) {
+        return ERR_MEM;
+    }
+    memset(d->idx_buckets, 0xff, n * sizeof(uint32_t));
+    for (uint32_t i = 0; i < d->nsyms; i++) {
+        char *name = dso_sym(d, i, &sym);
+        d->idx_next[i] = UINT32_MAX;
+        if (!is_exported_def(&sym)) {
+            continue;
+        }
+        uint32_t h = dl_new_hash(name);
+        d->idx_hash[i] = h;
+        d->idx_next[i] = d->idx_buckets[h & d->idx_mask];
+        d->idx_buckets[h & d->idx_mask] = i;
+    }
+    return NO_ERR;
+}
+
+/**
+ * @brief 解析版本定义和版本需求
+ * parse version definitions and version requirements
+ */
+static void load_versions(dso_t *d, uint64_t verdef, uint64_t verdefnum, uint64_t verneed, uint64_t verneednum) {
+    if (verdef && verdefnum) {
+        Elf64_Verdef *vd = map_vaddr(&d->elf, verdef, sizeof(Elf64_Verdef));
+        uint32_t max = 0;
+        /* first pass: the highest index */
+        for (Elf64_Verdef *p = vd; p && in_file(d, p, sizeof(*p)); ) {
+            if (p->vd_ndx > max) max = p->vd_ndx;
+            if (!p->vd_next) break;
+            p = (Elf64_Verdef *)((uint8_t *)p + p->vd_next);
+        }
+        d->verdef = calloc(max + 1, sizeof(char *));
+        d->verdef_count = d->verdef? max + 1: 0;
+        for (Elf64_Verdef *p = vd; d->verdef && p && in_file(d, p, sizeof(*p)); ) {
+            Elf64_Verdaux *aux = (Elf64_Verdaux *)((uint8_t *)p + p->vd_aux);
+            if (in_file(d, aux, sizeof(*aux)) && aux->vda_name < d->strsz) {
+                d->verdef[p->vd_ndx] = d->strtab + aux->vda_name;
+                /* the base definition names the object itself */
+            }
+            if (!p->vd_next) break;
+            p = (Elf64_Verdef *)((uint8_t *)p + p->vd_next);
+        }
+    }
+
+    if (verneed && verneednum) {
+        Elf64_Verneed *vn = map_vaddr(&d->elf, verneed, sizeof(Elf64_Verneed));
+        uint32_t count = 0;
+        for (Elf64_Verneed *p = vn; p && in_file(d, p, sizeof(*p)); ) {
+            count += p->vn_cnt;
+            if (!p->vn_next) break;
+            p = (Elf64_Verneed *)((uint8_t *)p + p->vn_next);
+        }
+        d->verneed = calloc(count + 1, sizeof(verneed_t));
+        for (Elf64_Verneed *p = vn; d->verneed && p && in_file(d, p, sizeof(*p)); ) {
+            Elf64_Vernaux *aux = (Elf64_Vernaux *)((uint8_t *)p + p->vn_aux);
+            for (int i = 0; i < p->vn_cnt && in_file(d, aux, sizeof(*aux)) && d->verneed_count < count; i++) {
+                if (aux->vna_name < d->strsz && p->vn_file < d->strsz) {
+                    d->verneed[d->verneed_count].ndx = aux->vna_other;
+                    d->verneed[d->verneed_count].file = d->strtab + p->vn_file;
+                    d->verneed[d->verneed_count].name = d->strtab + aux->vna_name;
+                    d->verneed_count++;
+                }
+                if (!aux->vna_next) break;
+                aux = (Elf64_Vernaux *)((uint8_t *)aux + aux->vna_next);
+            }
+            if (!p->vn_next) break;
+            p = (Elf64_Verneed *)((uint8_t *)p + p->vn_next);
+        }
+    }
+}
+
+/**
+ * @brief 通过PT_DYNAMIC定位动态符号表、字符串表、哈希表和版本信息
+ * locate the dynamic symbol table, string table, hash tables and versions through PT_DYNAMIC
+ * @param d dso
+ * @return error code
+ */
+static int load_dynamic(dso_t *d) {
+    Elf64_Dyn dyn;
+    uint64_t symtab = 0, strtab = 0, strsz = 0, gnuhash = 0, hash = 0, versym = 0;
+    uint64_t verdef = 0, verdefnum = 0, verneed = 0, verneednum = 0;
+    uint64_t soname = 0, rpath = 0, runpath = 0;
+    int dyn_count = d->elf.class == ELFCLASS32? d->elf.data.elf32.dyn_count: d->elf.data.elf64.dyn_count;
+    int needed = 0;
+
+    for (int i = 0; i < dyn_count; i++) {
+        get_dyn_by_index(&d->elf, i, &dyn);
+        if (dyn.d_tag == DT_NULL) {
+            dyn_count = i;
+            break;
+        }
+        switch (dyn.d_tag) {
+            case DT_SYMTAB: symtab = dyn.d_un.d_ptr; break;
+            case DT_STRTAB: strtab = dyn.d_un.d_ptr; break;
+            case DT_STRSZ: strsz = dyn.d_un.d_val; break;
+            case DT_GNU_HASH: gnuhash = dyn.d_un.d_ptr; break;
+            case DT_HASH: hash = dyn.d_un.d_ptr; break;
+            case DT_VERSYM: versym = dyn.d_un.d_ptr; break;
+            case DT_VERDEF: verdef = dyn.d_un.d_ptr; break;
+            case DT_VERDEFNUM: verdefnum = dyn.d_un.d_val; break;
+            case DT_VERNEED: verneed = dyn.d_un.d_ptr; break;
+            case DT_VERNEEDNUM: verneednum = dyn.d_un.d_val; break;
+            case DT_SONAME: soname = dyn.d_un.d_val; break;
+            case DT_RPATH: rpath = dyn.d_un.d_val + 1; break;
+            case DT_RUNPATH: runpath = dyn.d_un.d_val + 1; break;
+            case DT_NEEDED: needed++; break;
+            default: break;
+        }
+    }
+
+    if (!strtab || !symtab) {
+        return NO_ERR;
+    }
+    d->strtab = map_vaddr(&d->elf, strtab, strsz);
+    if (!d->strtab) {
+        return ERR_OUT_OF_BOUNDS;
+    }
+    d->strsz = strsz;
+    d->symtab = map_vaddr(&d->elf, symtab, 0);
+    if (!d->symtab) {
+        return ERR_OUT_OF_BOUNDS;
+    }
+
+    if (soname < strsz && soname) d->soname = d->strtab + soname;
+    if (rpath && rpath - 1 < strsz) d->rpath = d->strtab + rpath - 1;
+    if (runpath && runpath - 1 < strsz) d->runpath = d->strtab + runpath - 1;
+
+    d->needed = calloc(needed + 1, sizeof(char *));
+    for (int i = 0; d->needed && i < dyn_count; i++) {
+        get_dyn_by_index(&d->elf, i, &dyn);
+        if (dyn.d_tag == DT_NEEDED && dyn.d_un.d_val < strsz) {
+            d->needed[d->needed_count++] = d->strtab + dyn.d_un.d_val;
+        }
+    }
+
+    /* .gnu.hash: nbuckets, symoffset, bloom_size, bloom_shift, bloom[], buckets[], chain[] */
+    size_t word = d->elf.class == ELFCLASS32? 4: 8;
+    uint32_t *gh = gnuhash? map_vaddr(&d->elf, gnuhash, 16): NULL;
+    if (gh) {
+        d->nbuckets = gh[0];
+        d->symoffset = gh[1];
+        d->bloom_size = gh[2];
+        d->bloom_shift = gh[3];
+        d->bloom = (uint8_t *)&gh[4];
+        d->buckets = (uint32_t *)(d->bloom + d->bloom_size * word);
+        d->chain = &d->buckets[d->nbuckets];
+        if (!d->nbuckets || !in_file(d, d->bloom, (uint64_t)d->bloom_size * word + (uint64_t)d->nbuckets * 4)
+            || (d->bloom_size & (d->bloom_size - 1))) {
+            d->nbuckets = 0;
+        }
+    }
+
+    if (d->nbuckets) {
+        d->nsyms = gnuhash_nsyms(d);
+    } else if (hash && map_vaddr(&d->elf, hash, 8)) {
+        d->nsyms = ((uint32_t *)map_vaddr(&d->elf, hash, 8))[1];
+    } else {
+        d->nsyms = d->elf.class == ELFCLASS32? d->elf.data.elf32.dynsym_count: d->elf.data.elf64.dynsym_count;
+    }
+    size_t entsize = d->elf.class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    if (!in_file(d, d->symtab, (uint64_t)d->nsyms * entsize)) {
+        d->nsyms = (d->elf.mem + d->elf.size - d->symtab) / entsize;
+    }
+
+    if (versym) {
+        d->versym = map_vaddr(&d->elf, versym, (uint64_t)d->nsyms * sizeof(uint16_t));
+    }
+    load_versions(d, verdef, verdefnum, verneed, verneednum);
+
+    if (!d->nbuckets) {
+        return build_index(d);
+    }
+    return NO_ERR;
+}
+
+static uint32_t path_hash(dev_t dev, ino_t ino) {
+    uint64_t h = (uint64_t)ino * 0x9e3779b97f4a7c15ULL ^ (uint64_t)dev;
+    return (uint32_t)(h >> 32) % DSO_CACHE_SIZE;
+}
+
+dso_t *resolver_open(resolver_t *r, const char *path) {
+    struct stat st;
+    dso_t *d;
+    int class;
+
+    if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+        return NULL;
+    }
+
+    uint32_t h = path_hash(st.st_dev, st.st_ino);
+    for (d = r->cache[h]; d; d = d->next) {
+        if (d->dev == st.st_dev && d->ino == st.st_ino) {
+            return d;
+        }
+    }
+
+    d = calloc(1, sizeof(dso_t));
+    if (!d) {
+        return NULL;
+    }
+    strncpy(d->path, path, MAX_PATH_LEN - 1);
+    d->dev = st.st_dev;
+    d->ino = st.st_ino;
+    d->next = r->cache[h];
+    r->cache[h] = d;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        d->status = ERR_FILE_OPEN;
+        return d;
+    }
+    d->status = probe_elf(fd, st.st_size, &class, &d->machine);
+    close(fd);
+    if (d->status != NO_ERR) {
+        return d;
+    }
+
+    d->status = init((char *)path, &d->elf, true);
+    if (d->status != NO_ERR) {
+        return d;
+    }
+    /* keep the mapping only, thousands of objects would exhaust file descriptors */
+    close(d->elf.fd);
+    d->elf.fd = -1;
+    d->status = load_dynamic(d);
+    return d;
+}
+
+static void dso_free(dso_t *d) {
+    if (d->elf.mem) {
+        munmap(d->elf.mem, d->elf.size);
+    }
+    free(d->idx_buckets);
+    free(d->idx_next);
+    free(d->idx_hash);
+    free(d->verdef);
+    free(d->verneed);
+    free(d->needed);
+    free(d);
+}
+
+/* split a colon separated list and append every entry */
+static void add_dirs(char ***dirs, uint32_t *count, const char *list, const char *prefix) {
+    char *copy = strdup(list);
+    char *save = NULL;
+    if (!copy) {
+        return;
+    }
+    for (char *p = strtok_r(copy, ":;", &save); p; p = strtok_r(NULL, ":;", &save)) {
+        char **tmp = realloc(*dirs, (*count + 1) * sizeof(char *));
+        if (!tmp) {
+            break;
+        }
+        *dirs = tmp;
+        char buf[MAX_PATH_LEN];
+        snprintf(buf, sizeof(buf), "%s%s", prefix, p);
+        (*dirs)[(*count)++] = strdup(buf);
+    }
+    free(copy);
+}
+
+/**
+ * @brief 解析ld.so.conf，支持include
+ * parse ld.so.conf, including the files matched by include directives
+ */
+static void read_ld_conf(resolver_t *r, const char *conf, int depth) {
+    char line[MAX_PATH_LEN];
+    char path[MAX_PATH_LEN];
+    FILE *fp;
+
+    snprintf(path, sizeof(path), "%s%s", r->sysroot, conf);
+    fp = fopen(path, "r");
+    if (!fp || depth > 8) {
+        if (fp) fclose(fp);
+        return;
+    }
+
+    while (fgets(line, sizeof(line), fp)) {
+        char *p = line;
+        char *hash = strchr(p, '#');
+        if (hash) *hash = '\0';
+        while (*p == ' ' || *p == '\t') p++;
+        p[strcspn(p, " \t\r\n")] = '\0';
+        if (!*p) {
+            continue;
+        }
+        if (!strcmp(p, "include")) {
+            /* include takes the rest of the original line */
+            char *pattern = p + strlen(p) + 1;
+            while (*pattern == ' ' || *pattern == '\t') pattern++;
+            pattern[strcspn(pattern, " \t\r\n")] = '\0';
+            char full[MAX_PATH_LEN];
+            glob_t g;
+            if (pattern[0] == '/') {
+                snprintf(full, sizeof(full), "%s%s", r->sysroot, pattern);
+            } else {
+                char dir[MAX_PATH_LEN];
+                strncpy(dir, conf, sizeof(dir) - 1);
+                dir[sizeof(dir) - 1] = '\0';
+                snprintf(full, sizeof(full), "%s%s/%s", r->sysroot, dirname(dir), pattern);
+            }
+            if (!glob(full, 0, NULL, &g)) {
+                for (size_t i = 0; i < g.gl_pathc; i++) {
+                    read_ld_conf(r, g.gl_pathv[i] + strlen(r->sysroot), depth + 1);
+                }
+                globfree(&g);
+            }
+            continue;
+        }
+        if (!strcmp(p, "hwcap")) {
+            continue;
+        }
+        add_dirs(&r->sys_dirs, &r->sys_count, p, r->sysroot);
+    }
+    fclose(fp);
+}
+
+int resolver_init(resolver_t *r, const char *sysroot) {
+    memset(r, 0, sizeof(resolver_t));
+    if (sysroot) {
+        strncpy(r->sysroot, sysroot, MAX_PATH_LEN - 1);
+    } else {
+        /* LD_LIBRARY_PATH only describes the host */
+        char *env = getenv("LD_LIBRARY_PATH");
+        if (env) {
+            add_dirs(&r->env_dirs, &r->env_count, env, "");
+        }
+    }
+    read_ld_conf(r, "/etc/ld.so.conf", 0);
+    add_dirs(&r->sys_dirs, &r->sys_count, "/lib64:/usr/lib64:/lib:/usr/lib", r->sysroot);
+    return NO_ERR;
+}
+
+void resolver_fini(resolver_t *r) {
+    for (int i = 0; i < DSO_CACHE_SIZE; i++) {
+        dso_t *d = r->cache[i];
+        while (d) {
+            dso_t *next = d->next;
+            dso_free(d);
+            d = next;
+        }
+    }
+    for (uint32_t i = 0; i < r->env_count; i++) free(r->env_dirs[i]);
+    for (uint32_t i = 0; i < r->sys_count; i++) free(r->sys_dirs[i]);
+    free(r->env_dirs);
+    free(r->sys_dirs);
+}
+
+/**
+ * @brief 展开RPATH/RUNPATH中的$ORIGIN、$LIB和$PLATFORM
+ * expand $ORIGIN, $LIB and $PLATFORM in RPATH/RUNPATH
+ */
+static void expand_dst(resolver_t *r, dso_t *d, const char *dir, char *out, size_t len) {
+    char origin[MAX_PATH_LEN];
+    const char *lib = d->elf.class == ELFCLASS64? "lib64": "lib";
+    const char *platform = d->machine == EM_X86_64? "x86_64":
+                           d->machine == EM_386? "i686":
+                           d->machine == EM_AARCH64? "aarch64": "";
+    size_t n = 0;
+
+    /* dirname() returns "." for a bare file name without touching the buffer */
+    strncpy(origin, d->path, sizeof(origin) - 1);
+    origin[sizeof(origin) - 1] = '\0';
+    const char *dir_of = dirname(origin);
+
+    if (dir[0] == '/') {
+        n = snprintf(out, len, "%s", r->sysroot);
+    }
+    for (const char *p = dir; *p && n + 1 < len; ) {
+        const char *rep = NULL;
+        if (!strncmp(p, "$ORIGIN", 7) || !strncmp(p, "${ORIGIN}", 9)) {
+            rep = dir_of;
+            p += p[1] == '{'? 9: 7;
+        } else if (!strncmp(p, "$LIB", 4) || !strncmp(p, "${LIB}", 6)) {
+            rep = lib;
+            p += p[1] == '{'? 6: 4;
+        } else if (!strncmp(p, "$PLATFORM", 9) || !strncmp(p, "${PLATFORM}", 11)) {
+            rep = platform;
+            p += p[1] == '{'? 11: 9;
+        }
+        if (rep) {
+            n += snprintf(out + n, len - n, "%s", rep);
+        } else {
+            out[n++] = *p++;
+        }
+        if (n >= len) n = len - 1;
+    }
+    out[n] = '\0';
+}
+
+/* check whether the library is usable by the main object */
+static bool compatible(dso_t *main, dso_t *d) {
+    return d && d->status == NO_ERR && d->elf.class == main->elf.class && d->machine == main->machine;
+}
+
+static dso_t *try_dir(resolver_t *r, dso_t *main, const char *dir, const char *name, char *dir_out) {
+    char path[MAX_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    dso_t *d = resolver_open(r, path);
+    if (compatible(main, d)) {
+        if (dir_out) {
+            strncpy(dir_out, dir, MAX_PATH_LEN - 1);
+            dir_out[MAX_PATH_LEN - 1] = '\0';
+        }
+        return d;
+    }
+    return NULL;
+}
+
+/* try every directory of a RPATH/RUNPATH string */
+static dso_t *try_path(resolver_t *r, dso_t *main, dso_t *owner, const char *list, const char *name, char *dir_out) {
+    char *copy = strdup(list);
+    char *save = NULL;
+    dso_t *d = NULL;
+    if (!copy) {
+        return NULL;
+    }
+    for (char *p = strtok_r(copy, ":", &save); p && !d; p = strtok_r(NULL, ":", &save)) {
+        char dir[MAX_PATH_LEN];
+        expand_dst(r, owner, p, dir, sizeof(dir));
+        d = try_dir(r, main, dir, name, dir_out);
+        /* report the directory as written in the string */
+        if (d && dir_out) {
+            strncpy(dir_out, p, MAX_PATH_LEN - 1);
+        }
+    }
+    free(copy);
+    return d;
+}
+
+dso_t *resolver_find_needed(resolver_t *r, scope_t *s, int requester, const char *name, char *dir_out) {
+    dso_t *main = s->objs[0];
+    dso_t *owner = s->objs[requester];
+    dso_t *d = NULL;
+
+    if (dir_out) {
+        dir_out[0] = '\0';
+    }
+
+    /* a name with a slash is used as is */
+    if (strchr(name, '/')) {
+        char path[MAX_PATH_LEN];
+        expand_dst(r, owner, name, path, sizeof(path));
+        d = resolver_open(r, path);
+        return compatible(main, d)? d: NULL;
+    }
+
+    /* RPATH of the requester and its loaders, unless the requester has RUNPATH */
+    if (!owner->runpath) {
+        for (int i = requester; i >= 0 && !d; i = i? s->parent[i]: -1) {
+            if (s->objs[i]->runpath) {
+                break;
+            }
+            if (s->objs[i]->rpath) {
+                d = try_path(r, main, s->objs[i], s->objs[i]->rpath, name, dir_out);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < r->env_count && !d; i++) {
+        d = try_dir(r, main, r->env_dirs[i], name, dir_out);
+    }
+    if (!d && owner->runpath) {
+        d = try_path(r, main, owner, owner->runpath, name, dir_out);
+    }
+    for (uint32_t i = 0; i < r->sys_count && !d; i++) {
+        d = try_dir(r, main, r->sys_dirs[i], name, dir_out);
+    }
+    return d;
+}
+
+static int scope_add(scope_t *s, dso_t *d, int parent) {
+    if (s->count == s->capacity) {
+        uint32_t cap = s->capacity? s->capacity * 2: 16;
+        dso_t **objs = realloc(s->objs, cap * sizeof(dso_t *));
+        if (!objs) return ERR_MEM;
+        s->objs = objs;
+        int *p = realloc(s->parent, cap * sizeof(int));
+        if (!p) return ERR_MEM;
+        s->parent = p;
+        s->capacity = cap;
+    }
+    s->objs[s->count] = d;
+    s->parent[s->count] = parent;
+    s->count++;
+    return NO_ERR;
+}
+
+/**
+ * @brief 广度优先加载依赖，skip标记主程序中被忽略的DT_NEEDED
+ * load the dependencies breadth first, skip marks DT_NEEDED entries of the main object to ignore
+ */
+static int load_scope(resolver_t *r, dso_t *main, scope_t *s, bool *skip) {
+    memset(s, 0, sizeof(scope_t));
+    if (scope_add(s, main, -1) != NO_ERR) {
+        return ERR_MEM;
+    }
+
+    /* breadth first, which is both the load order and the lookup order */
+    for (uint32_t i = 0; i < s->count; i++) {
+        dso_t *cur = s->objs[i];
+        for (uint32_t j = 0; j < cur->needed_count; j++) {
+            char *name = cur->needed[j];
+            if (i == 0 && skip && skip[j]) {
+                continue;
+            }
+            bool loaded = false;
+            for (uint32_t k = 0; k < s->count; k++) {
+                if (s->objs[k]->soname && !strcmp(s->objs[k]->soname, name)) {
+                    loaded = true;
+                    break;
+                }
+            }
+            if (loaded) {
+                continue;
+            }
+            dso_t *d = resolver_find_needed(r, s, i, name, NULL);
+            if (!d) {
+                bool known = false;
+                for (uint32_t k = 0; k < s->missing_count; k++) {
+                    if (!strcmp(s->missing[k], name)) known = true;
+                }
+                if (!known) {
+                    s->missing = realloc(s->missing, (s->missing_count + 1) * sizeof(char *));
+                    s->missing_parent = realloc(s->missing_parent, (s->missing_count + 1) * sizeof(int));
+                    s->missing[s->missing_count] = name;
+                    s->missing_parent[s->missing_count++] = i;
+                }
+                continue;
+            }
+            for (uint32_t k = 0; k < s->count; k++) {
+                if (s->objs[k] == d) {
+                    loaded = true;
+                    break;
+                }
+            }
+            if (!loaded && scope_add(s, d, i) != NO_ERR) {
+                return ERR_MEM;
+            }
+        }
+    }
+    return NO_ERR;
+}
+
+int resolver_load_scope(resolver_t *r, dso_t *main, scope_t *s) {
+    return load_scope(r, main, s, NULL);
+}
+
+void scope_fini(scope_t *s) {
+    free(s->objs);
+    free(s->parent);
+    free(s->missing);
+    free(s->missing_parent);
+    memset(s, 0, sizeof(scope_t));
+}
+
+char *dso_sym_version(dso_t *d, uint32_t index) {
+    if (!d->versym || index >= d->nsyms) {
+        return NULL;
+    }
+    uint16_t ndx = d->versym[index] & 0x7fff;
+    if (ndx < 2) {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < d->verneed_count; i++) {
+        if (d->verneed[i].ndx == ndx) {
+            return d->verneed[i].name;
+        }
+    }
+    if (ndx < d->verdef_count) {
+        return d->verdef[ndx];
+    }
+    return NULL;
+}
+
+/**
+ * @brief 检查候选符号是否满足引用的名字和版本
+ * check whether a candidate satisfies the name and version of the reference
+ */
+static bool match_sym(dso_t *d, uint32_t index, const char *name, const char *version, bool *mismatch) {
+    Elf64_Sym sym;
+    char *sym_name = dso_sym(d, index, &sym);
+    if (!is_exported_def(&sym) || strcmp(sym_name, name)) {
+        return false;
+    }
+    /* unversioned library accepts everything */
+    if (!d->versym || !d->verdef_count) {
+        return true;
+    }
+    uint16_t vs = d->versym[index];
+    uint16_t ndx = vs & 0x7fff;
+    if (!version) {
+        /* unversioned reference binds to the default version */
+        return !(vs & 0x8000) || ndx < 2;
+    }
+    if (ndx < d->verdef_count && d->verdef[ndx] && !strcmp(d->verdef[ndx], version)) {
+        return true;
+    }
+    *mismatch = true;
+    return false;
+}
+
+int dso_lookup(dso_t *d, const char *name, uint32_t hash, const char *version, bool *mismatch) {
+    if (d->status != NO_ERR || !d->symtab) {
+        return -1;
+    }
+
+    if (!d->nbuckets) {
+        if (!d->idx_buckets) {
+            return -1;
+        }
+        for (uint32_t i = d->idx_buckets[hash & d->idx_mask]; i != UINT32_MAX; i = d->idx_next[i]) {
+            if (d->idx_hash[i] == hash && match_sym(d, i, name, version, mismatch)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /* bloom filter, two bits per symbol */
+    if (d->bloom_size) {
+        uint32_t bits = d->elf.class == ELFCLASS32? 32: 64;
+        uint32_t n = (hash / bits) & (d->bloom_size - 1);
+        uint64_t word = bits == 32? ((uint32_t *)d->bloom)[n]: ((uint64_t *)d->bloom)[n];
+        uint64_t mask = (1ULL << (hash % bits)) | (1ULL << ((hash >> d->bloom_shift) % bits));
+        if ((word & mask) != mask) {
+            return -1;
+        }
+    }
+
+    uint32_t i = d->buckets[hash % d->nbuckets];
+    if (i < d->symoffset) {
+        return -1;
+    }
+    for (; i < d->nsyms && in_file(d, &d->chain[i - d->symoffset], sizeof(uint32_t)); i++) {
+        uint32_t h = d->chain[i - d->symoffset];
+        if ((h | 1) == (hash | 1) && match_sym(d, i, name, version, mismatch)) {
+            return i;
+        }
+        if (h & 1) {
+            break;
+        }
+    }
+    return -1;
+}
+
+static const char *short_name(dso_t *d) {
+    const char *p = strrchr(d->path, '/');
+    return p? p + 1: d->path;
+}
+
+/**
+ * @brief 检查版本需求对应的库是否定义了该版本节点
+ * check that the library named by each version requirement defines the version node
+ */
+static int check_version_nodes(scope_t *s) {
+    int problems = 0;
+    for (uint32_t i = 0; i < s->count; i++) {
+        dso_t *d = s->objs[i];
+        for (uint32_t j = 0; j < d->verneed_count; j++) {
+            dso_t *lib = NULL;
+            for (uint32_t k = 0; k < s->count; k++) {
+                if (s->objs[k]->soname && !strcmp(s->objs[k]->soname, d->verneed[j].file)) {
+                    lib = s->objs[k];
+                    break;
+                }
+            }
+            if (!lib || !lib->verdef_count) {
+                continue;
+            }
+            bool found = false;
+            for (uint32_t k = 0; k < lib->verdef_count && !found; k++) {
+                if (lib->verdef[k] && !strcmp(lib->verdef[k], d->verneed[j].name)) {
+                    found = true;
+                }
+            }
+            if (!found) {
+                PRINT_WARNING("version %s not found in %s (required by %s)\n",
+                    d->verneed[j].name, lib->path, short_name(d));
+                problems++;
+            }
+        }
+    }
+    return problems;
+}
+
+/**
+ * @brief 绑定一个对象的所有未定义符号
+ * bind every undefined symbol of one object in the scope
+ * @param s scope
+ * @param obj index of the object
+ * @param verbose print the binding table
+ * @param stat output counters: bound, unresolved, weak, mismatch, interposed
+ * @return number of problems
+ */
+static int bind_object(scope_t *s, uint32_t obj, bool verbose, uint32_t *stat) {
+    dso_t *d = s->objs[obj];
+    Elf64_Sym sym;
+    int problems = 0;
+
+    if (verbose) {
+        printf("    [%4s] %-32s %-16s %s\n", "Nr", "Symbol", "Version", "Provider");
+    }
+    for (uint32_t i = 1; i < d->nsyms; i++) {
+        char *name = dso_sym(d, i, &sym);
+        int bind = ELF64_ST_BIND(sym.st_info);
+        if (sym.st_shndx != SHN_UNDEF || !*name || bind == STB_LOCAL) {
+            continue;
+        }
+
+        char *version = dso_sym_version(d, i);
+        uint32_t hash = dl_new_hash(name);
+        bool mismatch = false;
+        int provider = -1;
+        int first_other = -1;
+
+        for (uint32_t k = 0; k < s->count; k++) {
+            bool m = false;
+            if (dso_lookup(s->objs[k], name, hash, version, &m) >= 0) {
+                if (provider < 0) {
+                    provider = k;
+                } else if (first_other < 0) {
+                    first_other = k;
+                    break;
+                }
+            }
+            mismatch |= m;
+        }
+
+        if (provider >= 0) {
+            stat[0]++;
+            if (verbose) {
+                printf("    [%4d] %-32s %-16s %s\n", i, name, version? version: "", short_name(s->objs[provider]));
+            }
+            if (first_other >= 0) {
+                stat[4]++;
+                PRINT_VERBOSE("interposed: %s in %s shadows %s (%s)\n", name,
+                    short_name(s->objs[provider]), short_name(s->objs[first_other]), short_name(d));
+            }
+        } else if (mismatch) {
+            stat[3]++;
+            problems++;
+            PRINT_WARNING("version mismatch: %s@%s required by %s\n", name, version? version: "", short_name(d));
+        } else if (bind == STB_WEAK) {
+            stat[2]++;
+        } else {
+            stat[1]++;
+            problems++;
+            PRINT_WARNING("unresolved: %s%s%s required by %s\n", name, version? "@": "", version? version: "", short_name(d));
+        }
+    }
+    return problems;
+}
+
+int bind_report(resolver_t *r, char *elf_name) {
+    scope_t s;
+    uint32_t stat[5] = {0};
+    int problems = 0;
+
+    dso_t *main = resolver_open(r, elf_name);
+    if (!main) {
+        return ERR_FILE_OPEN;
+    }
+    if (main->status != NO_ERR) {
+        return main->status;
+    }
+    if (!main->symtab) {
+        PRINT_INFO("%s: no dynamic symbols, nothing to bind\n", elf_name);
+        return 0;
+    }
+
+    int err = resolver_load_scope(r, main, &s);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    PRINT_INFO("%s: %d objects in load order\n", elf_name, s.count);
+    printf("    [%2s] %-32s %s\n", "Nr", "Object", "Path");
+    for (uint32_t i = 1; i < s.count; i++) {
+        printf("    [%2d] %-32s %s\n", i, s.objs[i]->soname? s.objs[i]->soname: short_name(s.objs[i]), s.objs[i]->path);
+    }
+    for (uint32_t i = 0; i < s.missing_count; i++) {
+        PRINT_WARNING("%s not found (required by %s)\n", s.missing[i], short_name(s.objs[s.missing_parent[i]]));
+        problems++;
+    }
+
+    PRINT_INFO("bindings of %s\n", elf_name);
+    for (uint32_t i = 0; i < s.count; i++) {
+        problems += bind_object(&s, i, i == 0, stat);
+    }
+    problems += check_version_nodes(&s);
+
+    PRINT_INFO("%u bound, %u unresolved, %u weak unresolved, %u version mismatches, %u interposed\n",
+        stat[0], stat[1], stat[2], stat[3], stat[4]);
+    scope_fini(&s);
+    return problems;
+}
+
+/* the first object of the scope which defines the symbol */
+static dso_t *find_provider(scope_t *s, const char *name, uint32_t hash, const char *version) {
+    for (uint32_t k = 0; k < s->count; k++) {
+        bool m = false;
+        if (dso_lookup(s->objs[k], name, hash, version, &m) >= 0) {
+            return s->objs[k];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 检查缩减后的加载范围内，每个引用是否仍然绑定到相同的提供者
+ * check that every reference of the reduced scope still binds to the same provider
+ */
+static bool same_bindings(scope_t *full, scope_t *reduced) {
+    Elf64_Sym sym;
+    for (uint32_t k = 0; k < reduced->count; k++) {
+        dso_t *d = reduced->objs[k];
+        for (uint32_t i = 1; i < d->nsyms; i++) {
+            char *name = dso_sym(d, i, &sym);
+            if (sym.st_shndx != SHN_UNDEF || !*name || ELF64_ST_BIND(sym.st_info) == STB_LOCAL) {
+                continue;
+            }
+            char *version = dso_sym_version(d, i);
+            uint32_t hash = dl_new_hash(name);
+            if (find_provider(full, name, hash, version) != find_provider(reduced, name, hash, version)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int needed_report(resolver_t *r, char *elf_name, Elf *prune, int *unused) {
+    scope_t full, reduced;
+    Elf64_Sym sym;
+    int err;
+
+    *unused = 0;
+    dso_t *main = resolver_open(r, elf_name);
+    if (!main) {
+        return ERR_FILE_OPEN;
+    }
+    if (main->status != NO_ERR) {
+        return main->status;
+    }
+    if (!main->needed_count) {
+        PRINT_INFO("%s: no DT_NEEDED entries\n", elf_name);
+        return NO_ERR;
+    }
+
+    err = load_scope(r, main, &full, NULL);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    uint32_t n = main->needed_count;
+    dso_t **libs = calloc(n, sizeof(dso_t *));
+    uint32_t *used = calloc(n, sizeof(uint32_t));
+    bool *removed = calloc(n, sizeof(bool));
+    const char **status = calloc(n, sizeof(char *));
+    if (!libs || !used || !removed || !status) {
+        err = ERR_MEM;
+        goto out;
+    }
+
+    for (uint32_t j = 0; j < n; j++) {
+        libs[j] = resolver_find_needed(r, &full, 0, main->needed[j], NULL);
+    }
+
+    /* direct references of the object */
+    for (uint32_t i = 1; i < main->nsyms; i++) {
+        char *name = dso_sym(main, i, &sym);
+        if (sym.st_shndx != SHN_UNDEF || !*name || ELF64_ST_BIND(sym.st_info) == STB_LOCAL) {
+            continue;
+        }
+        dso_t *p = find_provider(&full, name, dl_new_hash(name), dso_sym_version(main, i));
+        for (uint32_t j = 0; p && j < n; j++) {
+            if (libs[j] == p) {
+                used[j]++;
+            }
+        }
+    }
+
+    /* try to drop every unreferenced entry, keeping the earlier decisions */
+    for (uint32_t j = 0; j < n; j++) {
+        if (!libs[j]) {
+            status[j] = "not found";
+            continue;
+        }
+        if (used[j]) {
+            status[j] = "used";
+            continue;
+        }
+        bool versioned = false;
+        for (uint32_t k = 0; k < main->verneed_count; k++) {
+            if (libs[j]->soname && !strcmp(main->verneed[k].file, libs[j]->soname)) {
+                versioned = true;
+            }
+        }
+        if (versioned) {
+            status[j] = "version requirement";
+            continue;
+        }
+
+        removed[j] = true;
+        err = load_scope(r, main, &reduced, removed);
+        if (err != NO_ERR) {
+            goto out;
+        }
+        if (!same_bindings(&full, &reduced)) {
+            /* another loaded object depends on it without declaring it */
+            status[j] = "required transitively";
+            removed[j] = false;
+        } else {
+            status[j] = "unused";
+        }
+        scope_fini(&reduced);
+    }
+
+    PRINT_INFO("%s: %d DT_NEEDED entries\n", elf_name, n);
+    printf("    [%2s] %-32s %8s %s\n", "Nr", "Library", "Symbols", "Status");
+    for (uint32_t j = 0; j < n; j++) {
+        printf("    [%2d] %-32s %8u %s\n", j, main->needed[j], used[j], status[j]);
+    }
+
+    err = load_scope(r, main, &reduced, removed);
+    if (err != NO_ERR) {
+        goto out;
+    }
+    PRINT_INFO("mapped libraries: %u -> %u\n", full.count - 1, reduced.count - 1);
+    scope_fini(&reduced);
+
+    for (uint32_t j = 0; j < n; j++) {
+        if (!removed[j]) {
+            continue;
+        }
+        (*unused)++;
+        if (prune) {
+            int ret = delete_needed(prune, main->needed[j]);
+            if (ret != NO_ERR) {
+                err = ret;
+                goto out;
+            }
+            PRINT_VERBOSE("removed DT_NEEDED %s\n", main->needed[j]);
+        }
+    }
+
+out:
+    free(libs);
+    free(used);
+    free(removed);
+    free(status);
+    scope_fini(&full);
+    return err;
+}
+
+/* keep the directories of a RPATH/RUNPATH string which provide a DT_NEEDED library first */
+static int shrink_path(resolver_t *r, dso_t *main, Elf *elf, int tag, const char *list) {
+    char *copy = strdup(list);
+    char *kept = calloc(strlen(list) + 1, 1);
+    bool *resolved = calloc(main->needed_count + 1, sizeof(bool));
+    char *save = NULL;
+    int err;
+
+    if (!copy || !kept || !resolved) {
+        free(copy);
+        free(kept);
+        free(resolved);
+        return ERR_MEM;
+    }
+    for (char *p = strtok_r(copy, ":", &save); p; p = strtok_r(NULL, ":", &save)) {
+        char dir[MAX_PATH_LEN];
+        bool keep = false;
+        expand_dst(r, main, p, dir, sizeof(dir));
+        for (uint32_t j = 0; j < main->needed_count; j++) {
+            if (!resolved[j] && !strchr(main->needed[j], '/') && try_dir(r, main, dir, main->needed[j], NULL)) {
+                resolved[j] = true;
+                keep = true;
+            }
+        }
+        if (keep) {
+            if (*kept) {
+                strcat(kept, ":");
+            }
+            strcat(kept, p);
+        } else {
+            PRINT_VERBOSE("remove %s from %s\n", p, tag == DT_RPATH? "rpath": "runpath");
+        }
+    }
+    err = replace_dyn_string(elf, tag, kept);
+    if (err == NO_ERR) {
+        PRINT_INFO("new %s: %s\n", tag == DT_RPATH? "rpath": "runpath", kept);
+    }
+    free(copy);
+    free(kept);
+    free(resolved);
+    return err;
+}
+
+int rpath_shrink(resolver_t *r, char *elf_name, Elf *elf) {
+    int err = ERR_DYN_NOTFOUND;
+
+    dso_t *main = resolver_open(r, elf_name);
+    if (!main) {
+        return ERR_FILE_OPEN;
+    }
+    if (main->status != NO_ERR) {
+        return main->status;
+    }
+    if (main->rpath) {
+        err = shrink_path(r, main, elf, DT_RPATH, main->rpath);
+    }
+    if (main->runpath && (err == NO_ERR || err == ERR_DYN_NOTFOUND)) {
+        err = shrink_path(r, main, elf, DT_RUNPATH, main->runpath);
+    }
+    return err;
+}
@@ -0,0 +1,228 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <sys/types.h>
+#ifndef __RESOLVE_H
+#define __RESOLVE_H
+
+#define DSO_CACHE_SIZE 4096
+
+/* version requirement, parsed from .gnu.version_r */
+typedef struct VersionNeed {
+    uint16_t ndx;           // vna_other, the index used by .gnu.version
+    char *file;             // vn_file, the library expected to define it
+    char *name;             // vna_name
+} verneed_t;
+
+/* a shared object, loaded once and shared by every scope that uses it */
+typedef struct Dso {
+    char path[MAX_PATH_LEN];
+    char *soname;
+    Elf elf;
+    int status;             // NO_ERR, or the reason why it cannot be used
+    dev_t dev;
+    ino_t ino;
+    uint16_t machine;
+
+    /* dynamic symbol table, located through PT_DYNAMIC */
+    uint8_t *symtab;
+    uint32_t nsyms;
+    char *strtab;
+    uint64_t strsz;
+    uint16_t *versym;
+
+    /* .gnu.hash of the object */
+    uint32_t nbuckets;
+    uint32_t symoffset;
+    uint32_t bloom_size;
+    uint32_t bloom_shift;
+    uint8_t *bloom;
+    uint32_t *buckets;
+    uint32_t *chain;
+
+    /* built index, used when the object has no .gnu.hash */
+    uint32_t idx_mask;
+    uint32_t *idx_buckets;
+    uint32_t *idx_next;
+    uint32_t *idx_hash;
+
+    /* symbol versioning */
+    char **verdef;          // indexed by vd_ndx
+    uint32_t verdef_count;
+    verneed_t *verneed;
+    uint32_t verneed_count;
+
+    /* dependencies and search paths */
+    char **needed;
+    uint32_t needed_count;
+    char *rpath;
+    char *runpath;
+
+    struct Dso *next;       // cache chain
+} dso_t;
+
+/* shared object cache and loader search configuration */
+typedef struct Resolver {
+    dso_t *cache[DSO_CACHE_SIZE];
+    char sysroot[MAX_PATH_LEN];
+    char **env_dirs;        // LD_LIBRARY_PATH
+    uint32_t env_count;
+    char **sys_dirs;        // /etc/ld.so.conf and default directories
+    uint32_t sys_count;
+} resolver_t;
+
+/* load order of one executable */
+typedef struct Scope {
+    dso_t **objs;           // objs[0] is the main object
+    int *parent;            // index of the object which loaded objs[i]
+    uint32_t count;
+    uint32_t capacity;
+    char **missing;         // DT_NEEDED names that were not found
+    int *missing_parent;
+    uint32_t missing_count;
+} scope_t;
+
+/**
+ * @brief 初始化解析器，读取LD_LIBRARY_PATH和ld.so.conf
+ * initialize the resolver, read LD_LIBRARY_PATH and ld.so.conf
+ * @param r resolver
+ * @param sysroot optional root directory of the target system, may be NULL
+ * @return error code
+ */
+int resolver_init(resolver_t *r, const char *sysroot);
+
+/**
+ * @brief 释放解析器及缓存的所有共享库
+ * release the resolver and every cached shared object
+ * @param r resolver
+ */
+void resolver_fini(resolver_t *r);
+
+/**
+ * @brief 加载共享库并建立符号索引，同一个文件只加载一次
+ * load a shared object and build its symbol index, each file is loaded once
+ * @param r resolver
+ * @param path file path
+ * @return dso, or NULL if the file does not exist
+ */
+dso_t *resolver_open(resolver_t *r, const char *path);
+
+/**
+ * @brief 按照动态链接器的顺序，查找DT_NEEDED对应的库
+ * search a DT_NEEDED library in the same order as the dynamic loader
+ * @param r resolver
+ * @param s scope of the main object, used for RPATH inheritance
+ * @param requester index of the object which needs the library
+ * @param name DT_NEEDED name
+ * @param dir_out the directory which provided the library, may be NULL
+ * @return dso, or NULL if not found
+ */
+dso_t *resolver_find_needed(resolver_t *r, scope_t *s, int requester, const char *name, char *dir_out);
+
+/**
+ * @brief 广度优先加载主程序的依赖，得到符号查找顺序
+ * load the dependencies of the main object breadth first, which is the symbol lookup order
+ * @param r resolver
+ * @param main main object
+ * @param s output scope
+ * @return error code
+ */
+int resolver_load_scope(resolver_t *r, dso_t *main, scope_t *s);
+void scope_fini(scope_t *s);
+
+/**
+ * @brief 在共享库中查找符号定义
+ * look up a symbol definition in a shared object
+ * @param d dso
+ * @param name symbol name
+ * @param hash gnu hash of the name
+ * @param version required version, NULL if the reference is unversioned
+ * @param mismatch set to true if the name exists but the version does not match
+ * @return symbol index, or -1 if not defined
+ */
+int dso_lookup(dso_t *d, const char *name, uint32_t hash, const char *version, bool *mismatch);
+
+/**
+ * @brief 获取符号引用所需的版本
+ * get the version required by a symbol reference
+ * @param d dso
+ * @param index symbol index
+ * @return version name, NULL if unversioned
+ */
+char *dso_sym_version(dso_t *d, uint32_t index);
+
+/**
+ * @brief 读取符号，统一转换为64位结构
+ * read a dynamic symbol, widened to the 64-bit layout
+ * @param d dso
+ * @param index symbol index
+ * @param sym output symbol
+ * @return symbol name
+ */
+char *dso_sym(dso_t *d, uint32_t index, Elf64_Sym *sym);
+
+/**
+ * @brief 检查符号是否为可被其他模块引用的定义
+ * check whether a symbol is a definition visible to other objects
+ * @param sym symbol
+ * @return true or false
+ */
+bool is_exported_def(Elf64_Sym *sym);
+
+/**
+ * @brief 将可执行程序的所有未定义符号绑定到提供者，报告未解析、符号介入和版本不匹配
+ * bind every undefined dynamic symbol to its provider in load order,
+ * report unresolved symbols, interposed duplicates and version mismatches
+ * @param r resolver, shared by all files of a run
+ * @param elf_name elf file name
+ * @return number of problems, or error code
+ */
+int bind_report(resolver_t *r, char *elf_name);
+
+/**
+ * @brief 检查每个DT_NEEDED是否被使用，可选择删除未使用的条目
+ * check whether each DT_NEEDED entry is used, optionally delete the unused ones
+ * @param r resolver, shared by all files of a run
+ * @param elf_name elf file name
+ * @param prune elf opened for writing, unused entries are deleted from it, may be NULL
+ * @param unused output, number of unused entries
+ * @return error code
+ */
+int needed_report(resolver_t *r, char *elf_name, Elf *prune, int *unused);
+
+/**
+ * @brief 收缩rpath/runpath，只保留实际提供DT_NEEDED的目录，并原地改写字符串。
+ * 目录按动态链接器的规则展开($ORIGIN、$LIB、$PLATFORM和sysroot)
+ * shrink rpath/runpath: keep only the directories which provide a DT_NEEDED
+ * library, preserving their order, and rewrite the string in place. The
+ * directories are expanded like the dynamic loader does ($ORIGIN, $LIB,
+ * $PLATFORM and the sysroot)
+ * @param r resolver
+ * @param elf_name elf file name
+ * @param elf elf opened for writing
+ * @return error code
+ */
+int rpath_shrink(resolver_t *r, char *elf_name, Elf *elf);
+
+#endif
@@ -0,0 +1,426 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "forensic.h"
+#include "rule.h"
+#include "got.h"
+#include "detect.h"
+
+#ifndef DF_1_PIE
+#define DF_1_PIE 0x08000000
+#endif
+
+/* the name is usable only when its terminator is inside the file */
+static const char *safe_name(Elf *elf, uint64_t offset) {
+    if (offset >= elf->size || !memchr(elf->mem + offset, '\0', elf->size - offset)) {
+        return NULL;
+    }
+    return (const char *)elf->mem + offset;
+}
+
+static void note_section(facts_t *facts, int i, const char *name) {
+    if (!strcmp(name, ".text")) facts->text = i;
+    else if (!strcmp(name, ".plt")) facts->plt = i;
+    else if (!strcmp(name, ".got.plt")) facts->got_plt = i;
+    else if (!strcmp(name, ".rela.plt") || !strcmp(name, ".rel.plt")) facts->rel_plt = i;
+    else if (!strcmp(name, ".interp")) facts->interp = i;
+    else if (!strcmp(name, ".dynstr")) facts->dynstr = i;
+    else if (!strcmp(name, ".dynsym")) facts->dynsym = i;
+}
+
+static void collect_segments(facts_t *facts) {
+    int last = -1;
+
+    facts->load_continuous = true;
+    for (int i = 0; i < facts->phnum; i++) {
+        Elf64_Phdr *phdr = &facts->phdr[i];
+        get_segment_by_index(facts->elf, i, phdr);
+        switch (phdr->p_type) {
+            case PT_LOAD:
+                facts->load_count++;
+                if (phdr->p_flags & PF_X) {
+                    facts->exec_load_count++;
+                }
+                if (last != -1 && i - last != 1) {
+                    facts->load_continuous = false;
+                }
+                last = i;
+                if (facts->entry_segment == -1 && facts->entry >= phdr->p_vaddr &&
+                    facts->entry < phdr->p_vaddr + phdr->p_memsz) {
+                    facts->entry_segment = i;
+                }
+                break;
+            case PT_INTERP: facts->has_interp = true; break;
+            case PT_DYNAMIC: facts->dynamic = true; break;
+            default: break;
+        }
+    }
+}
+
+static void collect_sections(facts_t *facts, int shstrndx) {
+    Elf *elf = facts->elf;
+    Elf64_Shdr shstrtab;
+    bool names = get_section_by_index(elf, shstrndx, &shstrtab) == NO_ERR &&
+                 shstrtab.sh_offset + shstrtab.sh_size <= elf->size;
+
+    for (int i = 0; i < facts->shnum; i++) {
+        fact_section_t *sec = &facts->shdr[i];
+        get_section_by_index(elf, i, &sec->hdr);
+        sec->name = NULL;
+        if (names && sec->hdr.sh_name < shstrtab.sh_size) {
+            sec->name = safe_name(elf, shstrtab.sh_offset + sec->hdr.sh_name);
+        }
+        if (!sec->name) {
+            facts->corrupt = true;
+            sec->name = "";
+            continue;
+        }
+        note_section(facts, i, sec->name);
+        if (facts->entry_section == -1 && (sec->hdr.sh_flags & SHF_ALLOC) && sec->hdr.sh_size &&
+            facts->entry >= sec->hdr.sh_addr && facts->entry < sec->hdr.sh_addr + sec->hdr.sh_size) {
+            facts->entry_section = i;
+        }
+    }
+}
+
+static void collect_dynamic(facts_t *facts, bool *pie_flag) {
+    int last = -1;
+
+    facts->needed_continuous = true;
+    for (int i = 0; i < facts->dyn_count; i++) {
+        Elf64_Dyn *dyn = &facts->dyn[i];
+        get_dyn_by_index(facts->elf, i, dyn);
+        switch (dyn->d_tag) {
+            case DT_NULL:
+                facts->dyn_count = i;
+                break;
+            case DT_NEEDED:
+                facts->needed_count++;
+                if (last != -1 && i - last != 1) {
+                    facts->needed_continuous = false;
+                }
+                last = i;
+                break;
+            case DT_BIND_NOW: facts->bind_now = true; break;
+            case DT_FLAGS: if (dyn->d_un.d_val & DF_BIND_NOW) facts->bind_now = true; break;
+            case DT_FLAGS_1:
+                if (dyn->d_un.d_val & DF_1_NOW) facts->bind_now = true;
+                if (dyn->d_un.d_val & DF_1_PIE) *pie_flag = true;
+                break;
+            default: break;
+        }
+    }
+}
+
+static void collect_got(void *arg, got_slot_t *slot) {
+    facts_t *facts = (facts_t *)arg;
+    facts->got_slots++;
+    if (slot->anomalous && !facts->got_anomalies++) {
+        facts->got_first_addr = slot->addr;
+        facts->got_first_value = slot->value;
+        facts->got_first_symbol = slot->symbol;
+    }
+}
+
+static void collect_infect(void *arg, infect_sig_t *sig) {
+    facts_t *facts = (facts_t *)arg;
+    if (!facts->infect_sigs) {
+        snprintf(facts->infect_first, RULE_EVIDENCE_LEN, "%s, %s", sig->name, sig->evidence);
+    }
+    facts->infect_sigs |= sig->sig;
+}
+
+static void collect_strings(facts_t *facts) {
+    Elf *elf = facts->elf;
+
+    if (facts->dynstr >= 0) {
+        Elf64_Shdr *s = &facts->shdr[facts->dynstr].hdr;
+        if (s->sh_offset + s->sh_size > elf->size) {
+            facts->corrupt = true;
+        } else {
+            /* the linker never emits an empty string after index 0 */
+            const char *base = (const char *)elf->mem + s->sh_offset;
+            uint64_t pos = 1;
+            while (pos < s->sh_size) {
+                size_t len = strnlen(base + pos, s->sh_size - pos);
+                if (len) {
+                    facts->dynstr_strings++;
+                } else if (!facts->dynstr_holes++) {
+                    facts->dynstr_hole_offset = pos;
+                }
+                pos += len + 1;
+            }
+        }
+    }
+
+    if (facts->interp >= 0) {
+        Elf64_Shdr *s = &facts->shdr[facts->interp].hdr;
+        if (s->sh_offset + s->sh_size > elf->size) {
+            facts->corrupt = true;
+        } else {
+            facts->interp_len = strnlen((const char *)elf->mem + s->sh_offset, s->sh_size);
+        }
+    }
+}
+
+int facts_collect(Elf *elf, facts_t *facts) {
+    bool pie_flag = false;
+    size_t phentsize, shentsize;
+    uint64_t phoff;
+    int shstrndx;
+
+    memset(facts, 0, sizeof(facts_t));
+    facts->elf = elf;
+    facts->class = elf->class;
+    if (elf->class == ELFCLASS32) {
+        Elf32_Ehdr *ehdr = elf->data.elf32.ehdr;
+        facts->e_type = ehdr->e_type;
+        facts->machine = ehdr->e_machine;
+        facts->entry = ehdr->e_entry;
+        facts->phnum = ehdr->e_phnum;
+        facts->shnum = ehdr->e_shnum;
+        facts->shoff = ehdr->e_shoff;
+        facts->dyn_count = elf->data.elf32.dyn_count;
+        phoff = ehdr->e_phoff;
+        shstrndx = ehdr->e_shstrndx;
+        phentsize = sizeof(Elf32_Phdr);
+        shentsize = sizeof(Elf32_Shdr);
+    } else if (elf->class == ELFCLASS64) {
+        Elf64_Ehdr *ehdr = elf->data.elf64.ehdr;
+        facts->e_type = ehdr->e_type;
+        facts->machine = ehdr->e_machine;
+        facts->entry = ehdr->e_entry;
+        facts->phnum = ehdr->e_phnum;
+        facts->shnum = ehdr->e_shnum;
+        facts->shoff = ehdr->e_shoff;
+        facts->dyn_count = elf->data.elf64.dyn_count;
+        phoff = ehdr->e_phoff;
+        shstrndx = ehdr->e_shstrndx;
+        phentsize = sizeof(Elf64_Phdr);
+        shentsize = sizeof(Elf64_Shdr);
+    } else {
+        return ERR_ELF_CLASS;
+    }
+    facts->text = facts->plt = facts->got_plt = facts->rel_plt = -1;
+    facts->interp = facts->dynstr = facts->dynsym = -1;
+    facts->entry_section = facts->entry_segment = -1;
+
+    /* tables which do not fit in the file are dropped, the rules see them as missing */
+    if (phoff + (uint64_t)facts->phnum * phentsize > elf->size) {
+        facts->corrupt = true;
+        facts->phnum = 0;
+    }
+    if (facts->shoff + (uint64_t)facts->shnum * shentsize > elf->size) {
+        facts->corrupt = true;
+        facts->shnum = 0;
+    }
+    if (facts->dyn_count < 0) {
+        facts->dyn_count = 0;
+    }
+
+    facts->phdr = calloc(facts->phnum + 1, sizeof(Elf64_Phdr));
+    facts->shdr = calloc(facts->shnum + 1, sizeof(fact_section_t));
+    facts->dyn = calloc(facts->dyn_count + 1, sizeof(Elf64_Dyn));
+    if (!facts->phdr || !facts->shdr || !facts->dyn) {
+        facts_fini(facts);
+        return ERR_MEM;
+    }
+
+    collect_segments(facts);
+    collect_sections(facts, shstrndx);
+    collect_dynamic(facts, &pie_flag);
+    collect_strings(facts);
+    got_verify(facts, collect_got, facts);
+
+    if (!facts->dynamic && facts->e_type == ET_EXEC) {
+        facts->type = ELF_STATIC;
+    } else if (facts->e_type == ET_DYN && !facts->has_interp && !pie_flag) {
+        facts->type = ELF_SHARED;
+    } else {
+        facts->type = facts->bind_now? ELF_EXE_NOW: ELF_EXE_LAZY;
+    }
+    facts->infect_score = infect_detect(facts, collect_infect, facts);
+    return NO_ERR;
+}
+
+void facts_fini(facts_t *facts) {
+    free(facts->phdr);
+    free(facts->shdr);
+    free(facts->dyn);
+    facts->phdr = NULL;
+    facts->shdr = NULL;
+    facts->dyn = NULL;
+}
+
+#define RESULT(r, s, ...) do { (r)->severity = (s); snprintf((r)->evidence, RULE_EVIDENCE_LEN, __VA_ARGS__); } while (0)
+
+static void rule_entry(facts_t *facts, rule_result_t *r) {
+    if (facts->type == ELF_SHARED && facts->entry == 0) {
+        RESULT(r, RULE_NA, "na(shared library)");
+    } else if (facts->text < 0) {
+        RESULT(r, RULE_NA, "na(no .text section)");
+    } else if (facts->entry == facts->shdr[facts->text].hdr.sh_addr) {
+        RESULT(r, RULE_PASS, "normal");
+    } else if (facts->entry_section == facts->text) {
+        RESULT(r, RULE_WARN, "is NOT at the start of the .TEXT section");
+    } else if (facts->entry_section >= 0) {
+        RESULT(r, RULE_FAIL, "is inside %.32s, NOT the .TEXT section", facts->shdr[facts->entry_section].name);
+    } else {
+        RESULT(r, RULE_FAIL, "is NOT inside the .TEXT section");
+    }
+}
+
+static void rule_hook(facts_t *facts, rule_result_t *r) {
+    if (facts->type == ELF_STATIC) {
+        RESULT(r, RULE_NA, "na(statically linked)");
+    } else if (!facts->got_slots) {
+        RESULT(r, RULE_NA, "na(no GOT relocations)");
+    } else if (facts->got_anomalies) {
+        RESULT(r, RULE_FAIL, "%u hooked, %.24s 0x%lx -> 0x%lx", facts->got_anomalies,
+            facts->got_first_symbol, facts->got_first_addr, facts->got_first_value);
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_load_flags(facts_t *facts, rule_result_t *r) {
+    if (facts->exec_load_count > 1) {
+        RESULT(r, RULE_FAIL, "%d executable segments", facts->exec_load_count);
+    } else if (facts->exec_load_count == 1) {
+        RESULT(r, RULE_PASS, "normal");
+    } else {
+        RESULT(r, RULE_NA, "na(no executable elf file)");
+    }
+}
+
+static void rule_load_continuity(facts_t *facts, rule_result_t *r) {
+    if (!facts->load_count) {
+        RESULT(r, RULE_NA, "na");
+    } else if (!facts->load_continuous) {
+        RESULT(r, RULE_FAIL, "load segments are NOT continuous");
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_needed_continuity(facts_t *facts, rule_result_t *r) {
+    if (!facts->dyn_count) {
+        RESULT(r, RULE_NA, "na(statically linked)");
+    } else if (!facts->needed_continuous) {
+        RESULT(r, RULE_FAIL, "DT_NEEDED libraries are NOT continuous");
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_shdr(facts_t *facts, rule_result_t *r) {
+    size_t entsize = facts->class == ELFCLASS32? sizeof(Elf32_Shdr): sizeof(Elf64_Shdr);
+    if (facts->shoff == 0 || facts->shnum == 0) {
+        RESULT(r, RULE_FAIL, "NO section header table");
+    } else if (facts->shoff != facts->elf->size - entsize * facts->shnum) {
+        RESULT(r, RULE_WARN, "is NOT at the end of the file");
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_dynstr(facts_t *facts, rule_result_t *r) {
+    if (facts->dynstr < 0) {
+        RESULT(r, RULE_NA, "na(no .dynstr section)");
+    } else if (facts->dynstr_holes) {
+        RESULT(r, RULE_FAIL, "modified symbol is detected, .dynstr+0x%lx", facts->dynstr_hole_offset);
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_interp(facts_t *facts, rule_result_t *r) {
+    if (facts->interp < 0) {
+        RESULT(r, RULE_NA, "na(no .interp section)");
+    } else if (facts->interp_len + 1 != facts->shdr[facts->interp].hdr.sh_size) {
+        RESULT(r, RULE_FAIL, "modified interpreter is detected");
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static void rule_infect(facts_t *facts, rule_result_t *r) {
+    if (!facts->load_count) {
+        RESULT(r, RULE_NA, "na(no loadable segment)");
+    } else if (facts->infect_score >= 50) {
+        RESULT(r, RULE_FAIL, "%d/100, %.90s", facts->infect_score, facts->infect_first);
+    } else if (facts->infect_score) {
+        RESULT(r, RULE_WARN, "%d/100, %.90s", facts->infect_score, facts->infect_first);
+    } else {
+        RESULT(r, RULE_PASS, "normal");
+    }
+}
+
+static rule_t rules[RULE_MAX] = {
+    {"entry point", rule_entry},
+    {"GOT/PLT hook", rule_hook},
+    {"segment flags", rule_load_flags},
+    {"segment continuity", rule_load_continuity},
+    {"DLL injection", rule_needed_continuity},
+    {"section header table", rule_shdr},
+    {"symbol injection", rule_dynstr},
+    {"interp injection", rule_interp},
+    {"infection", rule_infect},
+};
+static int rule_count = 9;
+
+int rule_register(const char *name, rule_check_t check) {
+    if (rule_count >= RULE_MAX) {
+        return ERR_OUT_OF_BOUNDS;
+    }
+    rules[rule_count].name = name;
+    rules[rule_count].check = check;
+    rule_count++;
+    return NO_ERR;
+}
+
+int rule_run(facts_t *facts, rule_report_t report, void *arg) {
+    int findings = 0;
+    rule_result_t result;
+
+    for (int i = 0; i < rule_count; i++) {
+        result.severity = RULE_NA;
+        result.evidence[0] = '\0';
+        rules[i].check(facts, &result);
+        if (result.severity == RULE_WARN || result.severity == RULE_FAIL) {
+            findings++;
+        }
+        if (report) {
+            report(arg, &rules[i], &result);
+        }
+    }
+    return findings;
+}
@@ -0,0 +1,152 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <elf.h>
+#ifndef __RULE_H
+#define __RULE_H
+
+#define RULE_MAX 64
+#define RULE_EVIDENCE_LEN 128
+
+/* severity of one rule result */
+enum RULE_SEVERITY {
+    RULE_NA,                // not applicable to this file
+    RULE_PASS,
+    RULE_WARN,
+    RULE_FAIL,
+};
+
+/* section header with its resolved name */
+typedef struct FactSection {
+    Elf64_Shdr hdr;
+    const char *name;       // "" when sh_name is out of .shstrtab
+} fact_section_t;
+
+/* everything the rules need, digested from the file in one pass */
+typedef struct Facts {
+    Elf *elf;
+    int class;
+    int type;               // enum ELF_TYPE
+    uint16_t e_type;
+    uint16_t machine;
+    uint64_t entry;
+    int entry_section;      // section holding the entry point, -1 if none
+    int entry_segment;      // PT_LOAD holding the entry point, -1 if none
+    bool corrupt;           // a header or a name points out of the file
+
+    /* headers, normalized to 64-bit */
+    Elf64_Phdr *phdr;
+    int phnum;
+    fact_section_t *shdr;
+    int shnum;
+    uint64_t shoff;
+    Elf64_Dyn *dyn;
+    int dyn_count;
+
+    /* well-known sections, -1 when missing */
+    int text;
+    int plt;
+    int got_plt;
+    int rel_plt;            // .rel.plt or .rela.plt
+    int interp;
+    int dynstr;
+    int dynsym;
+
+    /* segments */
+    int load_count;
+    int exec_load_count;
+    bool load_continuous;
+    bool has_interp;
+    bool dynamic;
+
+    /* dynamic tags */
+    bool bind_now;
+    int needed_count;
+    bool needed_continuous;
+
+    /* GLOB_DAT and JUMP_SLOT slots, see got_verify */
+    uint32_t got_slots;
+    uint32_t got_anomalies;
+    uint64_t got_first_addr;    // first redirected slot
+    uint64_t got_first_value;
+    const char *got_first_symbol;
+
+    /* infection signatures, see infect_detect */
+    int infect_score;
+    uint32_t infect_sigs;       // enum INFECT_SIG bits
+    char infect_first[RULE_EVIDENCE_LEN];
+
+    /* string tables */
+    uint32_t dynstr_strings;
+    uint32_t dynstr_holes;  // empty strings inside .dynstr
+    uint64_t dynstr_hole_offset;
+    size_t interp_len;      // strnlen of .interp
+} facts_t;
+
+typedef struct RuleResult {
+    int severity;           // enum RULE_SEVERITY
+    char evidence[RULE_EVIDENCE_LEN];
+} rule_result_t;
+
+typedef void (*rule_check_t)(facts_t *facts, rule_result_t *result);
+
+typedef struct Rule {
+    const char *name;
+    rule_check_t check;
+} rule_t;
+
+typedef void (*rule_report_t)(void *arg, const rule_t *rule, rule_result_t *result);
+
+/**
+ * @brief 一次性解析elf文件，生成规则所需的事实
+ * digest the elf file once into the facts used by every rule
+ * @param elf elf file custom structure
+ * @param facts output facts, release with facts_fini
+ * @return error code
+ */
+int facts_collect(Elf *elf, facts_t *facts);
+void facts_fini(facts_t *facts);
+
+/**
+ * @brief 注册一条规则，应在扫描开始前调用
+ * register a rule, call it before any scan starts
+ * @param name rule name, shown in reports
+ * @param check rule function
+ * @return error code
+ */
+int rule_register(const char *name, rule_check_t check);
+
+/**
+ * @brief 在事实上运行所有规则
+ * run every registered rule over the facts
+ * @param facts facts of one file
+ * @param report callback for each result, may be NULL
+ * @param arg callback argument
+ * @return number of warnings and failures
+ */
+int rule_run(facts_t *facts, rule_report_t report, void *arg);
+
+#endif
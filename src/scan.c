@@ -0,0 +1,320 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "forensic.h"
+#include "rule.h"
+#include "batch.h"
+#include "json.h"
+#include "scan.h"
+
+/* aggregate counters, updated with atomic adds */
+typedef struct ScanStat {
+    size_t files;
+    size_t elf;
+    size_t skipped;
+    size_t failed;
+    size_t pie;
+    size_t nx;
+    size_t canary;
+    size_t relro_full;
+    size_t relro_partial;
+    size_t hook;
+    size_t fortify;
+    size_t ibt;
+    size_t shstk;
+    size_t rpath;
+    size_t stripped;
+    size_t findings;
+} scan_stat_t;
+
+/* warnings and failures of the forensic rules for one file */
+typedef struct ScanFindings {
+    int count;
+    const char *rule[RULE_MAX];
+    int severity[RULE_MAX];
+    char evidence[RULE_MAX][RULE_EVIDENCE_LEN];
+} scan_findings_t;
+
+typedef struct ScanJob {
+    fileset_t *files;
+    scan_format_t format;
+    scan_stat_t stat;
+} scan_job_t;
+
+static const char *type_name(int type) {
+    switch (type) {
+        case ELF_STATIC: return "static";
+        case ELF_EXE_NOW:
+        case ELF_EXE_LAZY: return "exec";
+        case ELF_SHARED: return "shared";
+        default: return "unknown";
+    }
+}
+
+static const char *relro_name(int relro) {
+    return relro == 2? "full": relro == 1? "partial": "none";
+}
+
+static const char *pie_name(int pie) {
+    return pie == true? "1": pie == false? "0": "na";
+}
+
+static const char *hook_name(int hook) {
+    return hook == true? "normal": hook == false? "detected": "na";
+}
+
+static void collect_finding(void *arg, const rule_t *rule, rule_result_t *result) {
+    scan_findings_t *f = (scan_findings_t *)arg;
+    if (result->severity != RULE_WARN && result->severity != RULE_FAIL) {
+        return;
+    }
+    f->rule[f->count] = rule->name;
+    f->severity[f->count] = result->severity;
+    memcpy(f->evidence[f->count], result->evidence, RULE_EVIDENCE_LEN);
+    f->count++;
+}
+
+/* quote a csv field when it contains a separator, a quote or a newline */
+static void csv_field(char *out, size_t len, const char *s) {
+    size_t n = 0;
+    if (!strpbrk(s, ",\"\r\n")) {
+        snprintf(out, len, "%s", s);
+        return;
+    }
+    out[n++] = '"';
+    for (; *s && n + 3 < len; s++) {
+        if (*s == '"') {
+            out[n++] = '"';
+        }
+        out[n++] = *s;
+    }
+    out[n++] = '"';
+    out[n] = '\0';
+}
+
+/* the error row is derived from this header so the column count cannot drift */
+static const char csv_header[] =
+    "path,class,type,pie,nx,canary,relro,hook,fortify,ibt,shstk,rpath,runpath,stripped,findings";
+
+static void scan_emit(scan_format_t format, const char *event, const char *path, secinfo_t *info,
+                      scan_findings_t *findings, int err) {
+    if (format == SCAN_CSV) {
+        char field[MAX_PATH_LEN * 2 + 3];
+        char row[sizeof(field) + sizeof(csv_header) + 64];
+        int n;
+        csv_field(field, sizeof(field), path);
+        if (err != NO_ERR) {
+            /* path, error and an empty field for every other column */
+            n = snprintf(row, sizeof(row), "%s,error", field);
+            for (const char *c = strchr(csv_header, ',') + 1; (c = strchr(c, ',')); c++) {
+                row[n++] = ',';
+            }
+            row[n++] = '\n';
+        } else {
+            n = snprintf(row, sizeof(row), "%s,%d,%s,%s,%d,%d,%s,%s,%d,%d,%d,%d,%d,%d,%d\n", field,
+                info->class == ELFCLASS32? 32: 64, type_name(info->type), pie_name(info->pie), info->nx,
+                info->canary, relro_name(info->relro), hook_name(info->hook), info->fortify,
+                !!(info->cet & (SEC_CET_IBT | SEC_ARM_BTI)), !!(info->cet & (SEC_CET_SHSTK | SEC_ARM_PAC)),
+                info->rpath, info->runpath, info->stripped, findings->count);
+        }
+        /* one write per row, the workers share stdout */
+        fwrite(row, 1, n, stdout);
+        return;
+    }
+
+    json_t j;
+    json_init(&j, stdout);
+    json_object_begin(&j);
+    if (event) {
+        JSON_KV_STRING(&j, "event", event);
+    }
+    JSON_KV_STRING(&j, "path", path);
+    if (err != NO_ERR) {
+        JSON_KV_INT(&j, "error", err);
+    } else {
+        JSON_KV_INT(&j, "class", info->class == ELFCLASS32? 32: 64);
+        JSON_KV_STRING(&j, "type", type_name(info->type));
+        json_key(&j, "pie");
+        if (info->pie == true || info->pie == false) {
+            json_bool(&j, info->pie);
+        } else {
+            json_null(&j);
+        }
+        JSON_KV_BOOL(&j, "nx", info->nx);
+        JSON_KV_BOOL(&j, "canary", info->canary);
+        JSON_KV_STRING(&j, "relro", relro_name(info->relro));
+        JSON_KV_STRING(&j, "hook", hook_name(info->hook));
+        JSON_KV_BOOL(&j, "fortify", info->fortify);
+        JSON_KV_UINT(&j, "fortified", info->fortified);
+        JSON_KV_UINT(&j, "fortifiable", info->fortifiable);
+        JSON_KV_BOOL(&j, "ibt", info->cet & (SEC_CET_IBT | SEC_ARM_BTI));
+        JSON_KV_BOOL(&j, "shstk", info->cet & (SEC_CET_SHSTK | SEC_ARM_PAC));
+        JSON_KV_BOOL(&j, "rpath", info->rpath);
+        JSON_KV_BOOL(&j, "runpath", info->runpath);
+        JSON_KV_BOOL(&j, "stripped", info->stripped);
+        JSON_KV_UINT(&j, "symbols", info->symtab_count);
+        JSON_KV_UINT(&j, "dynsyms", info->dynsym_count);
+        json_key(&j, "findings");
+        json_array_begin(&j);
+        for (int i = 0; i < findings->count; i++) {
+            json_object_begin(&j);
+            JSON_KV_STRING(&j, "rule", findings->rule[i]);
+            JSON_KV_STRING(&j, "severity", findings->severity[i] == RULE_FAIL? "fail": "warn");
+            JSON_KV_STRING(&j, "evidence", findings->evidence[i]);
+            json_object_end(&j);
+        }
+        json_array_end(&j);
+    }
+    json_object_end(&j);
+    json_newline(&j);
+    json_fini(&j);
+}
+
+/* analyze one file, *elf is false when it is not an elf file */
+static int scan_analyze(const char *path, secinfo_t *info, scan_findings_t *findings, bool *is_elf) {
+    facts_t facts;
+    struct stat st;
+    Elf elf;
+    int class;
+    uint16_t machine;
+    int err;
+
+    /* a header read is enough to skip everything that is not an elf */
+    *is_elf = false;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return ERR_FILE_OPEN;
+    }
+    err = fstat(fd, &st) < 0? ERR_FILE_STAT: probe_elf(fd, st.st_size, &class, &machine);
+    close(fd);
+    if (err != NO_ERR) {
+        return err;
+    }
+
+    *is_elf = true;
+    findings->count = 0;
+    err = init((char *)path, &elf, true);
+    if (err == NO_ERR) {
+        err = checksec_collect(&elf, info);
+        if (err == NO_ERR && facts_collect(&elf, &facts) == NO_ERR) {
+            rule_run(&facts, collect_finding, findings);
+            facts_fini(&facts);
+        }
+        finit(&elf);
+    }
+    return err;
+}
+
+int scan_file(const char *path, const char *event) {
+    secinfo_t info;
+    scan_findings_t findings;
+    bool is_elf;
+
+    int err = scan_analyze(path, &info, &findings, &is_elf);
+    if (!is_elf) {
+        return FALSE;
+    }
+    scan_emit(SCAN_NDJSON, event, path, &info, &findings, err);
+    return TRUE;
+}
+
+static void scan_task(void *arg, size_t index) {
+    scan_job_t *job = (scan_job_t *)arg;
+    char *path = job->files->paths[index];
+    secinfo_t info;
+    scan_findings_t findings;
+    bool is_elf;
+    int err;
+
+    __atomic_add_fetch(&job->stat.files, 1, __ATOMIC_RELAXED);
+    err = scan_analyze(path, &info, &findings, &is_elf);
+    if (!is_elf) {
+        __atomic_add_fetch(&job->stat.skipped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    __atomic_add_fetch(&job->stat.elf, 1, __ATOMIC_RELAXED);
+    scan_emit(job->format, NULL, path, &info, &findings, err);
+    if (err != NO_ERR) {
+        __atomic_add_fetch(&job->stat.failed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    if (info.pie == true) __atomic_add_fetch(&job->stat.pie, 1, __ATOMIC_RELAXED);
+    if (info.nx) __atomic_add_fetch(&job->stat.nx, 1, __ATOMIC_RELAXED);
+    if (info.canary) __atomic_add_fetch(&job->stat.canary, 1, __ATOMIC_RELAXED);
+    if (info.relro == 2) __atomic_add_fetch(&job->stat.relro_full, 1, __ATOMIC_RELAXED);
+    if (info.relro == 1) __atomic_add_fetch(&job->stat.relro_partial, 1, __ATOMIC_RELAXED);
+    if (info.hook == false) __atomic_add_fetch(&job->stat.hook, 1, __ATOMIC_RELAXED);
+    if (info.fortify) __atomic_add_fetch(&job->stat.fortify, 1, __ATOMIC_RELAXED);
+    if (info.cet & (SEC_CET_IBT | SEC_ARM_BTI)) __atomic_add_fetch(&job->stat.ibt, 1, __ATOMIC_RELAXED);
+    if (info.cet & (SEC_CET_SHSTK | SEC_ARM_PAC)) __atomic_add_fetch(&job->stat.shstk, 1, __ATOMIC_RELAXED);
+    if (info.rpath || info.runpath) __atomic_add_fetch(&job->stat.rpath, 1, __ATOMIC_RELAXED);
+    if (info.stripped) __atomic_add_fetch(&job->stat.stripped, 1, __ATOMIC_RELAXED);
+    if (findings.count) __atomic_add_fetch(&job->stat.findings, 1, __ATOMIC_RELAXED);
+}
+
+int scan_run(char **args, int count, scan_format_t format, int workers) {
+    fileset_t files = {0};
+    scan_job_t job = {0};
+
+    for (int i = 0; i < count; i++) {
+        if (fileset_add(&files, args[i]) != NO_ERR) {
+            fprintf(stderr, "%s: no such file\n", args[i]);
+        }
+    }
+
+    /* stdout carries the records only, keep it fully buffered */
+    setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    if (format == SCAN_CSV) {
+        printf("%s\n", csv_header);
+    }
+
+    job.files = &files;
+    job.format = format;
+    pool_run(workers, files.count, scan_task, &job);
+    fflush(stdout);
+
+    scan_stat_t *s = &job.stat;
+    fprintf(stderr, "files: %zu, elf: %zu, skipped: %zu, failed: %zu\n", s->files, s->elf, s->skipped, s->failed);
+    fprintf(stderr, "pie: %zu, nx: %zu, canary: %zu, relro: %zu full / %zu partial, hook anomalies: %zu\n",
+        s->pie, s->nx, s->canary, s->relro_full, s->relro_partial, s->hook);
+    fprintf(stderr, "fortify: %zu, ibt/bti: %zu, shstk/pac: %zu, rpath/runpath: %zu, stripped: %zu\n",
+        s->fortify, s->ibt, s->shstk, s->rpath, s->stripped);
+    fprintf(stderr, "files with forensic findings: %zu\n", s->findings);
+    fileset_fini(&files);
+    return s->failed;
+}
@@ -0,0 +1,55 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef __SCAN_H
+#define __SCAN_H
+
+/* output format of the scanner */
+typedef enum SCAN_FORMAT {
+    SCAN_NDJSON = 1,
+    SCAN_CSV,
+} scan_format_t;
+
+/**
+ * @brief 扫描目录树或文件列表中的所有ELF文件，逐个输出安全属性，最后输出汇总
+ * scan every elf file of the directory trees or file lists, stream the security
+ * properties of each file, then print the aggregate counts to stderr
+ * @param args input arguments: files, directories, globs or @list files
+ * @param count argument count
+ * @param format output format
+ * @param workers worker count, <= 0 means one per CPU
+ * @return number of files which could not be analyzed, or error code
+ */
+int scan_run(char **args, int count, scan_format_t format, int workers);
+
+/**
+ * @brief 分析单个文件并输出一条NDJSON记录，非ELF文件不输出
+ * analyze one file and print one NDJSON record, nothing for non-elf files
+ * @param path file path
+ * @param event value of the "event" key, NULL to omit it
+ * @return TRUE if a record was printed
+ */
+int scan_file(const char *path, const char *event);
+
+#endif
@@ -0,0 +1,601 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "size.h"
+
+typedef struct Interval {
+    uint64_t start;
+    uint64_t end;
+    uint32_t shndx;         // group of the interval, sorted first
+    uint32_t index;         // symbol index
+} interval_t;
+
+/* one name in both builds */
+typedef struct SizeDelta {
+    char *name;
+    uint8_t kind;
+    bool in_old;
+    bool in_new;
+    uint64_t old_file, old_vm;
+    uint64_t new_file, new_vm;
+} size_delta_t;
+
+static const char *kind_names[SIZE_KINDS] = {"segments", "sections", "symbols"};
+
+static int interval_cmp(const void *a, const void *b) {
+    const interval_t *x = a, *y = b;
+    if (x->shndx != y->shndx) {
+        return x->shndx < y->shndx? -1: 1;
+    }
+    if (x->start != y->start) {
+        return x->start < y->start? -1: 1;
+    }
+    /* the widest of the aliases gets the bytes */
+    if (x->end != y->end) {
+        return x->end > y->end? -1: 1;
+    }
+    return x->index < y->index? -1: x->index > y->index;
+}
+
+/**
+ * @brief 已排序区间的并集在[lo, hi)内的长度
+ * length of the union of sorted intervals, clipped to [lo, hi)
+ */
+static uint64_t union_length(interval_t *v, size_t n, uint64_t lo, uint64_t hi) {
+    uint64_t total = 0, cur = lo;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t start = v[i].start > cur? v[i].start: cur;
+        uint64_t end = v[i].end < hi? v[i].end: hi;
+        if (end > start) {
+            total += end - start;
+            cur = end;
+        }
+    }
+    return total;
+}
+
+static int add_entry(size_report_t *r, int kind, char *name, bool owned, uint64_t file, uint64_t vm) {
+    if (r->count == r->capacity) {
+        size_t n = r->capacity? r->capacity * 2: 256;
+        size_entry_t *p = realloc(r->entries, n * sizeof(size_entry_t));
+        if (!p) {
+            if (owned) {
+                free(name);
+            }
+            return ERR_MEM;
+        }
+        r->entries = p;
+        r->capacity = n;
+    }
+    size_entry_t *e = &r->entries[r->count++];
+    e->name = name;
+    e->owned = owned;
+    e->kind = kind;
+    e->file = file;
+    e->vm = vm;
+    return NO_ERR;
+}
+
+static int add_label(size_report_t *r, int kind, uint64_t file, uint64_t vm, const char *label) {
+    char *name = strdup(label);
+    if (!name) {
+        return ERR_MEM;
+    }
+    return add_entry(r, kind, name, true, file, vm);
+}
+
+/**
+ * @brief 段：每个PT_LOAD的文件与内存字节，以及没有被任何PT_LOAD加载的文件字节
+ * segments: file and memory bytes of each PT_LOAD, and the file bytes that no PT_LOAD maps
+ */
+static int attribute_segments(size_report_t *r, Elf64_Phdr *phdr, int phnum) {
+    interval_t *loads = calloc(phnum + 1, sizeof(interval_t));
+    char label[32];
+    size_t n = 0;
+    int err = NO_ERR;
+
+    if (!loads) {
+        return ERR_MEM;
+    }
+    for (int i = 0; i < phnum && err == NO_ERR; i++) {
+        if (phdr[i].p_type != PT_LOAD) {
+            continue;
+        }
+        snprintf(label, sizeof(label), "LOAD#%zu %c%c%c", n, phdr[i].p_flags & PF_R? 'R': '-',
+            phdr[i].p_flags & PF_W? 'W': '-', phdr[i].p_flags & PF_X? 'X': '-');
+        err = add_label(r, SIZE_SEGMENT, phdr[i].p_filesz, phdr[i].p_memsz, label);
+        loads[n].start = phdr[i].p_offset;
+        loads[n].end = phdr[i].p_offset + phdr[i].p_filesz;
+        n++;
+        r->vm += phdr[i].p_memsz;
+    }
+    if (err == NO_ERR) {
+        qsort(loads, n, sizeof(interval_t), interval_cmp);
+        err = add_entry(r, SIZE_SEGMENT, "[not loaded]", false, r->elf.size - union_length(loads, n, 0, r->elf.size), 0);
+    }
+    free(loads);
+    return err;
+}
+
+/* does a PT_LOAD map the file range */
+static bool is_mapped(Elf64_Phdr *phdr, int phnum, uint64_t start, uint64_t end) {
+    for (int i = 0; i < phnum; i++) {
+        if (phdr[i].p_type == PT_LOAD && start >= phdr[i].p_offset && end <= phdr[i].p_offset + phdr[i].p_filesz) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 节：ELF头、程序头表、节头表和每个节的字节，以及文件空隙和PT_LOAD内的内存空隙
+ * sections: bytes of the elf header, the header tables and each section,
+ * the gaps of the file and the padding inside the PT_LOADs
+ */
+static int attribute_sections(size_report_t *r, Elf64_Ehdr *ehdr, Elf64_Phdr *phdr, int phnum, Elf64_Shdr *shdr, int shnum) {
+    interval_t *file = calloc(shnum + 3, sizeof(interval_t));
+    interval_t *mem = calloc(shnum + 3, sizeof(interval_t));
+    const char *labels[3] = {"[ELF header]", "[program headers]", "[section headers]"};
+    uint64_t starts[3] = {0, ehdr->e_phoff, ehdr->e_shoff};
+    uint64_t sizes[3] = {ehdr->e_ehsize, (uint64_t)ehdr->e_phentsize * phnum, (uint64_t)ehdr->e_shentsize * shnum};
+    size_t nfile = 0, nmem = 0;
+    int err = NO_ERR;
+
+    if (!file || !mem) {
+        free(file);
+        free(mem);
+        return ERR_MEM;
+    }
+
+    for (int i = 0; i < 3 && err == NO_ERR; i++) {
+        if (!sizes[i] || starts[i] + sizes[i] > r->elf.size) {
+            continue;
+        }
+        uint64_t end = starts[i] + sizes[i];
+        bool mapped = is_mapped(phdr, phnum, starts[i], end);
+        err = add_entry(r, SIZE_SECTION, (char *)labels[i], false, sizes[i], mapped? sizes[i]: 0);
+        file[nfile++] = (interval_t){starts[i], end, 0, 0};
+        if (mapped) {
+            /* headers are mapped at the start of the first PT_LOAD */
+            uint64_t off;
+            for (int j = 0; j < phnum; j++) {
+                if (phdr[j].p_type == PT_LOAD && starts[i] >= phdr[j].p_offset
+                    && end <= phdr[j].p_offset + phdr[j].p_filesz) {
+                    off = phdr[j].p_vaddr + starts[i] - phdr[j].p_offset;
+                    mem[nmem++] = (interval_t){off, off + sizes[i], 0, 0};
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int i = 1; i < shnum && err == NO_ERR; i++) {
+        Elf64_Shdr *s = &shdr[i];
+        bool nobits = s->sh_type == SHT_NOBITS;
+        /* .tbss only describes the initial image of each thread */
+        bool alloc = s->sh_flags & SHF_ALLOC && !(nobits && s->sh_flags & SHF_TLS);
+        if (!s->sh_size) {
+            continue;
+        }
+        err = add_entry(r, SIZE_SECTION, get_section_name(&r->elf, i), false, nobits? 0: s->sh_size, alloc? s->sh_size: 0);
+        if (!nobits && s->sh_offset + s->sh_size <= r->elf.size) {
+            file[nfile++] = (interval_t){s->sh_offset, s->sh_offset + s->sh_size, 0, i};
+        }
+        if (alloc) {
+            mem[nmem++] = (interval_t){s->sh_addr, s->sh_addr + s->sh_size, 0, i};
+        }
+    }
+
+    if (err == NO_ERR) {
+        qsort(file, nfile, sizeof(interval_t), interval_cmp);
+        err = add_entry(r, SIZE_SECTION, "[file padding]", false, r->elf.size - union_length(file, nfile, 0, r->elf.size), 0);
+    }
+    if (err == NO_ERR) {
+        uint64_t padding = 0;
+        qsort(mem, nmem, sizeof(interval_t), interval_cmp);
+        for (int i = 0; i < phnum; i++) {
+            if (phdr[i].p_type == PT_LOAD) {
+                padding += phdr[i].p_memsz - union_length(mem, nmem, phdr[i].p_vaddr, phdr[i].p_vaddr + phdr[i].p_memsz);
+            }
+        }
+        err = add_entry(r, SIZE_SECTION, "[load padding]", false, 0, padding);
+    }
+    free(file);
+    free(mem);
+    return err;
+}
+
+/**
+ * @brief 符号：按节对st_size区间做排序扫描，别名与重叠部分只计算一次，节内剩余字节列为未归属
+ * symbols: sweep the sorted st_size intervals of each section, aliases and
+ * overlaps are counted once, the rest of the section is listed as unattributed
+ */
+static int attribute_symbols(size_report_t *r, Elf64_Phdr *phdr, int phnum, Elf64_Shdr *shdr, int shnum, bool relocatable) {
+    size_t entsize = r->elf.class == ELFCLASS32? sizeof(Elf32_Sym): sizeof(Elf64_Sym);
+    uint64_t tls = 0;
+    interval_t *v = NULL;
+    size_t n = 0, nsyms = 0;
+    char *strtab = NULL;
+    uint64_t strsz = 0;
+    int table = -1;
+    int err = NO_ERR;
+
+    /* prefer .symtab, it also has the local symbols */
+    for (int i = 1; i < shnum; i++) {
+        if (shdr[i].sh_type == SHT_SYMTAB || (shdr[i].sh_type == SHT_DYNSYM && table < 0)) {
+            table = i;
+        }
+    }
+    if (table > 0 && shdr[table].sh_offset + shdr[table].sh_size <= r->elf.size && shdr[table].sh_link < shnum) {
+        Elf64_Shdr *s = &shdr[shdr[table].sh_link];
+        if (s->sh_offset + s->sh_size <= r->elf.size) {
+            strtab = (char *)r->elf.mem + s->sh_offset;
+            strsz = s->sh_size;
+            nsyms = shdr[table].sh_size / entsize;
+        }
+    }
+    for (int i = 0; i < phnum; i++) {
+        if (phdr[i].p_type == PT_TLS) {
+            tls = phdr[i].p_vaddr;
+        }
+    }
+
+    if (nsyms) {
+        v = malloc(nsyms * sizeof(interval_t));
+        if (!v) {
+            return ERR_MEM;
+        }
+    }
+    for (size_t i = 1; i < nsyms; i++) {
+        Elf64_Sym sym;
+        get_sym_by_table(&r->elf, r->elf.mem + shdr[table].sh_offset, i, &sym);
+        int type = ELF64_ST_TYPE(sym.st_info);
+        if (!sym.st_size || sym.st_shndx == SHN_UNDEF || sym.st_shndx >= shnum || sym.st_shndx >= SHN_LORESERVE
+            || type == STT_SECTION || type == STT_FILE) {
+            continue;
+        }
+        Elf64_Shdr *s = &shdr[sym.st_shndx];
+        if (!(s->sh_flags & SHF_ALLOC)) {
+            continue;
+        }
+        /* executables and libraries hold the offset of a tls symbol in PT_TLS */
+        uint64_t start = sym.st_value + (type == STT_TLS && !relocatable? tls: 0);
+        uint64_t lo = relocatable? 0: s->sh_addr;
+        uint64_t hi = lo + s->sh_size;
+        v[n].start = start > lo? start: lo;
+        v[n].end = start + sym.st_size < hi? start + sym.st_size: hi;
+        if (v[n].end > v[n].start) {
+            v[n].shndx = sym.st_shndx;
+            v[n].index = i;
+            n++;
+        }
+    }
+    qsort(v, n, sizeof(interval_t), interval_cmp);
+
+    size_t k = 0;
+    for (int i = 1; i < shnum && err == NO_ERR; i++) {
+        Elf64_Shdr *s = &shdr[i];
+        bool nobits = s->sh_type == SHT_NOBITS;
+        bool alloc = !(nobits && s->sh_flags & SHF_TLS);
+        uint64_t cur = 0, used = 0;
+        if (!(s->sh_flags & SHF_ALLOC) || !s->sh_size) {
+            continue;
+        }
+        for (; k < n && v[k].shndx == i && err == NO_ERR; k++) {
+            uint64_t start = v[k].start > cur? v[k].start: cur;
+            if (v[k].end <= start) {
+                continue;
+            }
+            Elf64_Sym sym;
+            get_sym_by_table(&r->elf, r->elf.mem + shdr[table].sh_offset, v[k].index, &sym);
+            char *name = sym.st_name < strsz? strtab + sym.st_name: "";
+            uint64_t bytes = v[k].end - start;
+            err = add_entry(r, SIZE_SYMBOL, name, false, nobits? 0: bytes, alloc? bytes: 0);
+            used += bytes;
+            cur = v[k].end;
+        }
+        if (err == NO_ERR && used < s->sh_size) {
+            char label[MAX_PATH_LEN];
+            uint64_t bytes = s->sh_size - used;
+            snprintf(label, sizeof(label), "[unattributed %s]", get_section_name(&r->elf, i));
+            err = add_label(r, SIZE_SYMBOL, nobits? 0: bytes, alloc? bytes: 0, label);
+        }
+    }
+    free(v);
+    return err;
+}
+
+/**
+ * @brief 将文件与内存字节依次归属到段、节和符号，未归属的空隙单独列出
+ * attribute the file and memory bytes to segments, sections and symbols,
+ * listing the unattributed gaps and padding explicitly
+ * @param elf_name elf file name
+ * @param report output report, release it with size_fini
+ * @return error code
+ */
+int size_build(char *elf_name, size_report_t *report) {
+    Elf64_Ehdr ehdr;
+    Elf64_Phdr *phdr = NULL;
+    Elf64_Shdr *shdr = NULL;
+    int phnum, shnum;
+
+    memset(report, 0, sizeof(size_report_t));
+    int err = init(elf_name, &report->elf, true);
+    if (err != NO_ERR) {
+        return err;
+    }
+    if (report->elf.class == ELFCLASS32) {
+        Elf32_Ehdr *h = report->elf.data.elf32.ehdr;
+        ehdr.e_type = h->e_type; ehdr.e_ehsize = h->e_ehsize;
+        ehdr.e_phoff = h->e_phoff; ehdr.e_phentsize = h->e_phentsize; ehdr.e_phnum = h->e_phnum;
+        ehdr.e_shoff = h->e_shoff; ehdr.e_shentsize = h->e_shentsize; ehdr.e_shnum = h->e_shnum;
+    } else {
+        ehdr = *report->elf.data.elf64.ehdr;
+    }
+    phnum = ehdr.e_phnum;
+    shnum = ehdr.e_shnum;
+
+    phdr = calloc(phnum + 1, sizeof(Elf64_Phdr));
+    shdr = calloc(shnum + 1, sizeof(Elf64_Shdr));
+    if (!phdr || !shdr) {
+        err = ERR_MEM;
+        goto out;
+    }
+    for (int i = 0; i < phnum; i++) {
+        get_segment_by_index(&report->elf, i, &phdr[i]);
+    }
+    for (int i = 0; i < shnum; i++) {
+        get_section_by_index(&report->elf, i, &shdr[i]);
+    }
+
+    err = attribute_segments(report, phdr, phnum);
+    if (err == NO_ERR) {
+        err = attribute_sections(report, &ehdr, phdr, phnum, shdr, shnum);
+    }
+    /* objects have no PT_LOAD, their memory is the allocated sections */
+    for (size_t i = 0; !phnum && i < report->count; i++) {
+        if (report->entries[i].kind == SIZE_SECTION) {
+            report->vm += report->entries[i].vm;
+        }
+    }
+    if (err == NO_ERR) {
+        err = attribute_symbols(report, phdr, phnum, shdr, shnum, ehdr.e_type == ET_REL);
+    }
+
+out:
+    free(phdr);
+    free(shdr);
+    if (err != NO_ERR) {
+        size_fini(report);
+    }
+    return err;
+}
+
+void size_fini(size_report_t *report) {
+    for (size_t i = 0; i < report->count; i++) {
+        if (report->entries[i].owned) {
+            free(report->entries[i].name);
+        }
+    }
+    free(report->entries);
+    report->entries = NULL;
+    report->count = report->capacity = 0;
+    finit(&report->elf);
+}
+
+static uint64_t entry_bytes(const size_entry_t *e) {
+    return e->file > e->vm? e->file: e->vm;
+}
+
+/* largest first, segments keep the program header order */
+static int entry_size_cmp(const void *a, const void *b) {
+    const size_entry_t *x = a, *y = b;
+    uint64_t sx = entry_bytes(x), sy = entry_bytes(y);
+    if (sx != sy) {
+        return sx > sy? -1: 1;
+    }
+    return strcmp(x->name, y->name);
+}
+
+static int entry_name_cmp(const void *a, const void *b) {
+    const size_entry_t *x = a, *y = b;
+    if (x->kind != y->kind) {
+        return x->kind < y->kind? -1: 1;
+    }
+    return strcmp(x->name, y->name);
+}
+
+static uint64_t delta_abs(uint64_t a, uint64_t b) {
+    return a > b? a - b: b - a;
+}
+
+static int delta_cmp(const void *a, const void *b) {
+    const size_delta_t *x = a, *y = b;
+    if (x->kind != y->kind) {
+        return x->kind < y->kind? -1: 1;
+    }
+    uint64_t fx = delta_abs(x->old_file, x->new_file), fy = delta_abs(y->old_file, y->new_file);
+    if (fx != fy) {
+        return fx > fy? -1: 1;
+    }
+    uint64_t vx = delta_abs(x->old_vm, x->new_vm), vy = delta_abs(y->old_vm, y->new_vm);
+    if (vx != vy) {
+        return vx > vy? -1: 1;
+    }
+    return strcmp(x->name, y->name);
+}
+
+static void print_report(char *elf_name, size_report_t *r, uint32_t top) {
+    size_t start = 0;
+
+    PRINT_INFO("%s: %lu bytes in file, %lu bytes in memory\n", elf_name, r->elf.size, r->vm);
+    for (int kind = 0; kind < SIZE_KINDS; kind++) {
+        size_t end = start;
+        while (end < r->count && r->entries[end].kind == kind) {
+            end++;
+        }
+        if (kind != SIZE_SEGMENT) {
+            qsort(&r->entries[start], end - start, sizeof(size_entry_t), entry_size_cmp);
+        }
+        if (kind == SIZE_SYMBOL) {
+            PRINT_INFO("%s (%zu, top %u)\n", kind_names[kind], end - start, top);
+        } else {
+            PRINT_INFO("%s\n", kind_names[kind]);
+        }
+        printf("    %-40s %12s %12s %7s\n", "Name", "File", "Memory", "File%");
+        for (size_t i = start; i < end && (kind != SIZE_SYMBOL || i - start < top); i++) {
+            size_entry_t *e = &r->entries[i];
+            printf("    %-40s %12lu %12lu %6.2f%%\n", e->name, e->file, e->vm,
+                r->elf.size? e->file * 100.0 / r->elf.size: 0);
+        }
+        start = end;
+    }
+}
+
+/**
+ * @brief 按类型与名称排序并合并同名条目，例如不同文件中的同名局部符号
+ * sort by kind and name, merging the entries with the same name, such as the
+ * local symbols of different files
+ */
+static size_t merge_names(size_report_t *r) {
+    size_t n = 0;
+    qsort(r->entries, r->count, sizeof(size_entry_t), entry_name_cmp);
+    for (size_t i = 0; i < r->count; i++) {
+        if (n && r->entries[n - 1].kind == r->entries[i].kind && !strcmp(r->entries[n - 1].name, r->entries[i].name)) {
+            r->entries[n - 1].file += r->entries[i].file;
+            r->entries[n - 1].vm += r->entries[i].vm;
+            /* the owned name of the merged entry is released here */
+            if (r->entries[i].owned) {
+                free(r->entries[i].name);
+            }
+            continue;
+        }
+        r->entries[n++] = r->entries[i];
+    }
+    r->count = n;
+    return n;
+}
+
+static void print_diff(size_report_t *a, size_report_t *b, uint32_t top) {
+    size_t na = merge_names(a), nb = merge_names(b);
+    size_delta_t *d = malloc((na + nb + 1) * sizeof(size_delta_t));
+    size_t n = 0, i = 0, j = 0;
+    size_t stat[SIZE_KINDS][4] = {0};
+
+    if (!d) {
+        print_error(ERR_MEM);
+        return;
+    }
+    /* merge join of the two sorted lists */
+    while (i < na || j < nb) {
+        int c = i == na? 1: j == nb? -1: entry_name_cmp(&a->entries[i], &b->entries[j]);
+        size_delta_t *x = &d[n];
+        memset(x, 0, sizeof(size_delta_t));
+        if (c <= 0) {
+            x->name = a->entries[i].name;
+            x->kind = a->entries[i].kind;
+            x->in_old = true;
+            x->old_file = a->entries[i].file;
+            x->old_vm = a->entries[i].vm;
+            i++;
+        }
+        if (c >= 0) {
+            x->name = b->entries[j].name;
+            x->kind = b->entries[j].kind;
+            x->in_new = true;
+            x->new_file = b->entries[j].file;
+            x->new_vm = b->entries[j].vm;
+            j++;
+        }
+        if (x->old_file != x->new_file || x->old_vm != x->new_vm || x->in_old != x->in_new) {
+            n++;
+        }
+    }
+    qsort(d, n, sizeof(size_delta_t), delta_cmp);
+
+    PRINT_INFO("file: %lu -> %lu (%+ld), memory: %lu -> %lu (%+ld)\n", a->elf.size, b->elf.size,
+        (int64_t)(b->elf.size - a->elf.size), a->vm, b->vm, (int64_t)(b->vm - a->vm));
+    size_t start = 0;
+    for (int kind = 0; kind < SIZE_KINDS; kind++) {
+        size_t end = start;
+        while (end < n && d[end].kind == kind) {
+            size_delta_t *x = &d[end++];
+            uint64_t before = x->old_file + x->old_vm, after = x->new_file + x->new_vm;
+            stat[kind][!x->in_old? 2: !x->in_new? 3: after > before? 0: 1]++;
+        }
+        PRINT_INFO("%s: %zu grew, %zu shrank, %zu added, %zu removed\n", kind_names[kind],
+            stat[kind][0], stat[kind][1], stat[kind][2], stat[kind][3]);
+        if (end > start) {
+            printf("    %-40s %12s %12s %12s %12s\n", "Name", "File", "Delta", "Memory", "Delta");
+        }
+        for (size_t k = start; k < end && (kind != SIZE_SYMBOL || k - start < top); k++) {
+            size_delta_t *x = &d[k];
+            printf("    %-40s %12lu %+12ld %12lu %+12ld%s\n", x->name, x->new_file, (int64_t)(x->new_file - x->old_file),
+                x->new_vm, (int64_t)(x->new_vm - x->old_vm), !x->in_old? " added": !x->in_new? " removed": "");
+        }
+        start = end;
+    }
+    free(d);
+}
+
+/**
+ * @brief 打印大小报告，若给出第二个文件则按差值排序打印两次构建的差异
+ * print the size report, or the difference between two builds sorted by delta
+ * @param old_name elf file name
+ * @param new_name elf file name of the newer build, may be NULL
+ * @param top number of symbols to print, 0 means SIZE_TOP_SYMBOLS
+ * @return error code
+ */
+int size_report(char *old_name, char *new_name, uint32_t top) {
+    size_report_t a, b;
+    int err;
+
+    top = top? top: SIZE_TOP_SYMBOLS;
+    err = size_build(old_name, &a);
+    if (err != NO_ERR) {
+        return err;
+    }
+    if (!new_name) {
+        print_report(old_name, &a, top);
+        size_fini(&a);
+        return NO_ERR;
+    }
+    err = size_build(new_name, &b);
+    if (err != NO_ERR) {
+        size_fini(&a);
+        return err;
+    }
+    PRINT_INFO("%s -> %s\n", old_name, new_name);
+    print_diff(&a, &b, top);
+    size_fini(&a);
+    size_fini(&b);
+    return NO_ERR;
+}
@@ -0,0 +1,77 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#ifndef __SIZE_H
+#define __SIZE_H
+
+#define SIZE_TOP_SYMBOLS    20
+
+enum SIZE_KIND {
+    SIZE_SEGMENT,
+    SIZE_SECTION,
+    SIZE_SYMBOL,
+    SIZE_KINDS,
+};
+
+/* bytes attributed to a segment, a section, a symbol or a gap */
+typedef struct SizeEntry {
+    char *name;
+    uint64_t file;          // bytes in the file
+    uint64_t vm;            // bytes in memory
+    uint8_t kind;           // enum SIZE_KIND
+    bool owned;             // name was allocated for this entry
+} size_entry_t;
+
+typedef struct SizeReport {
+    Elf elf;
+    size_entry_t *entries;
+    size_t count;
+    size_t capacity;
+    uint64_t vm;            // sum of PT_LOAD p_memsz
+} size_report_t;
+
+/**
+ * @brief 将文件与内存字节依次归属到段、节和符号，未归属的空隙单独列出
+ * attribute the file and memory bytes to segments, sections and symbols,
+ * listing the unattributed gaps and padding explicitly
+ * @param elf_name elf file name
+ * @param report output report, release it with size_fini
+ * @return error code
+ */
+int size_build(char *elf_name, size_report_t *report);
+void size_fini(size_report_t *report);
+
+/**
+ * @brief 打印大小报告，若给出第二个文件则按差值排序打印两次构建的差异
+ * print the size report, or the difference between two builds sorted by delta
+ * @param old_name elf file name
+ * @param new_name elf file name of the newer build, may be NULL
+ * @param top number of symbols to print, 0 means SIZE_TOP_SYMBOLS
+ * @return error code
+ */
+int size_report(char *old_name, char *new_name, uint32_t top);
+
+#endif
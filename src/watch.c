@@ -0,0 +1,393 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <ftw.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <elf.h>
+#include <stdbool.h>
+#include "lib/elfutil.h"
+#include "lib/util.h"
+#include "lib/pool.h"
+#include "json.h"
+#include "scan.h"
+#include "watch.h"
+
+#define WATCH_MASK (IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_ONLYDIR)
+
+/* a file waiting for its writes to settle */
+typedef struct Pending {
+    char *path;
+    uint64_t due;           // ms, CLOCK_MONOTONIC
+    bool created;
+    struct Pending *next;
+} pending_t;
+
+typedef struct Watcher {
+    int fd;
+    char **dirs;            // indexed by watch descriptor
+    int dir_capacity;
+    int watches;
+    pending_t *buckets[WATCH_BUCKETS];
+    size_t pending;
+    size_t analyzed;
+    size_t elf;
+    char **roots;
+    int root_count;
+    time_t synced;          // files changed since then may have lost their events
+    bool walk_queue;        // walk_dir queues the files it finds
+    time_t walk_since;      // only files whose ctime is not older, 0 means all
+} watcher_t;
+
+/* a batch of settled files, handed to pool_run */
+typedef struct WatchBatch {
+    pending_t **items;
+    size_t count;
+    size_t elf;
+} watch_batch_t;
+
+static volatile sig_atomic_t g_stop;
+static watcher_t *g_walk_watcher;
+
+static void on_signal(int sig) {
+    g_stop = sig;
+}
+
+static uint64_t now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000ULL + ts.tv_nsec / 1000000;
+}
+
+static void emit_event(const char *event, const char *path) {
+    json_t j;
+    json_init(&j, stdout);
+    json_object_begin(&j);
+    JSON_KV_STRING(&j, "event", event);
+    if (path) {
+        JSON_KV_STRING(&j, "path", path);
+    }
+    json_object_end(&j);
+    json_newline(&j);
+    json_fini(&j);
+    fflush(stdout);
+}
+
+static pending_t **pending_slot(watcher_t *w, const char *path) {
+    pending_t **pp = &w->buckets[hash64(path, strlen(path), 0) & (WATCH_BUCKETS - 1)];
+    while (*pp && strcmp((*pp)->path, path)) {
+        pp = &(*pp)->next;
+    }
+    return pp;
+}
+
+/* every write pushes the deadline, a linker writing in bursts is analyzed once */
+static void pending_touch(watcher_t *w, const char *path, bool created) {
+    pending_t **pp = pending_slot(w, path);
+    if (!*pp) {
+        pending_t *p = calloc(1, sizeof(pending_t));
+        if (!p || !(p->path = strdup(path))) {
+            free(p);
+            return;
+        }
+        *pp = p;
+        w->pending++;
+    }
+    (*pp)->due = now_ms() + WATCH_DEBOUNCE_MS;
+    (*pp)->created |= created;
+}
+
+static void pending_drop(watcher_t *w, const char *path) {
+    pending_t **pp = pending_slot(w, path);
+    if (*pp) {
+        pending_t *p = *pp;
+        *pp = p->next;
+        free(p->path);
+        free(p);
+        w->pending--;
+    }
+}
+
+static int add_watch(watcher_t *w, const char *dir) {
+    int wd = inotify_add_watch(w->fd, dir, WATCH_MASK);
+    if (wd < 0) {
+        return ERR_FILE_OPEN;
+    }
+    if (wd >= w->dir_capacity) {
+        int cap = w->dir_capacity? w->dir_capacity: 256;
+        while (cap <= wd) {
+            cap *= 2;
+        }
+        char **tmp = realloc(w->dirs, cap * sizeof(char *));
+        if (!tmp) {
+            return ERR_MEM;
+        }
+        memset(tmp + w->dir_capacity, 0, (cap - w->dir_capacity) * sizeof(char *));
+        w->dirs = tmp;
+        w->dir_capacity = cap;
+    }
+    if (!w->dirs[wd]) {
+        w->watches++;
+    }
+    free(w->dirs[wd]);
+    w->dirs[wd] = strdup(dir);
+    return NO_ERR;
+}
+
+/* files found in a new directory are queued, they may be complete already */
+static int walk_dir(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+    watcher_t *w = g_walk_watcher;
+    if (flag == FTW_D) {
+        add_watch(w, path);
+    } else if (flag == FTW_F && S_ISREG(st->st_mode) && ftw->level > 0 &&
+               w->walk_queue && st->st_ctime >= w->walk_since) {
+        pending_touch(w, path, !w->walk_since);
+    }
+    return 0;
+}
+
+/**
+ * @brief 监控目录树，queue为真时将其中ctime不早于since的文件加入待分析队列
+ * watch a directory tree, when queue is set the files whose ctime is not
+ * older than since are queued for analysis
+ * @param w watcher
+ * @param dir tree root
+ * @param queue queue the files found
+ * @param since ctime lower bound, 0 queues every file as created
+ */
+static void watch_tree(watcher_t *w, const char *dir, bool queue, time_t since) {
+    g_walk_watcher = w;
+    w->walk_queue = queue;
+    w->walk_since = since;
+    nftw(dir, walk_dir, 64, FTW_PHYS);
+}
+
+static bool under(const char *path, const char *dir, size_t len) {
+    return !strncmp(path, dir, len) && (path[len] == '\0' || path[len] == '/');
+}
+
+/* a directory left the tree, its watches would report events under the old path */
+static void unwatch_tree(watcher_t *w, const char *dir) {
+    size_t len = strlen(dir);
+    for (int wd = 0; wd < w->dir_capacity; wd++) {
+        if (w->dirs[wd] && under(w->dirs[wd], dir, len)) {
+            inotify_rm_watch(w->fd, wd);
+            free(w->dirs[wd]);
+            w->dirs[wd] = NULL;
+            w->watches--;
+        }
+    }
+    for (int i = 0; i < WATCH_BUCKETS; i++) {
+        pending_t **pp = &w->buckets[i];
+        while (*pp) {
+            if (under((*pp)->path, dir, len)) {
+                pending_t *p = *pp;
+                *pp = p->next;
+                free(p->path);
+                free(p);
+                w->pending--;
+            } else {
+                pp = &(*pp)->next;
+            }
+        }
+    }
+}
+
+/* events were dropped, re-walk every root and queue what changed since the last sync */
+static void rescan(watcher_t *w) {
+    time_t since = w->synced;
+    w->synced = time(NULL);
+    for (int i = 0; i < w->root_count; i++) {
+        watch_tree(w, w->roots[i], true, since);
+    }
+}
+
+static void handle_event(watcher_t *w, struct inotify_event *ev) {
+    char path[MAX_PATH_LEN];
+
+    if (ev->mask & IN_Q_OVERFLOW) {
+        emit_event("overflow", NULL);
+        rescan(w);
+        return;
+    }
+    if (ev->mask & IN_IGNORED) {
+        if (ev->wd >= 0 && ev->wd < w->dir_capacity && w->dirs[ev->wd]) {
+            free(w->dirs[ev->wd]);
+            w->dirs[ev->wd] = NULL;
+            w->watches--;
+        }
+        return;
+    }
+    if (ev->wd < 0 || ev->wd >= w->dir_capacity || !w->dirs[ev->wd] || !ev->len) {
+        return;
+    }
+    snprintf(path, sizeof(path), "%s/%s", w->dirs[ev->wd], ev->name);
+
+    if (ev->mask & IN_ISDIR) {
+        /* a move inside the trees is a MOVED_FROM followed by a MOVED_TO */
+        if (ev->mask & IN_MOVED_FROM) {
+            unwatch_tree(w, path);
+        } else if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+            watch_tree(w, path, true, 0);
+        }
+    } else if (ev->mask & (IN_DELETE | IN_MOVED_FROM)) {
+        pending_drop(w, path);
+    } else if (ev->mask & (IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO)) {
+        pending_touch(w, path, ev->mask & (IN_CREATE | IN_MOVED_TO));
+    }
+}
+
+static void watch_task(void *arg, size_t index) {
+    watch_batch_t *batch = (watch_batch_t *)arg;
+    pending_t *p = batch->items[index];
+    if (scan_file(p->path, p->created? "created": "modified") == TRUE) {
+        __atomic_add_fetch(&batch->elf, 1, __ATOMIC_RELAXED);
+    }
+}
+
+/* analyze the files whose deadline has passed, return the time to the next deadline */
+static int dispatch(watcher_t *w, int workers) {
+    watch_batch_t batch = {0};
+    uint64_t now = now_ms(), next = UINT64_MAX;
+
+    if (!w->pending) {
+        return -1;
+    }
+    batch.items = malloc(w->pending * sizeof(pending_t *));
+    if (!batch.items) {
+        return WATCH_DEBOUNCE_MS;
+    }
+    for (int i = 0; i < WATCH_BUCKETS; i++) {
+        pending_t **pp = &w->buckets[i];
+        while (*pp) {
+            if ((*pp)->due <= now) {
+                batch.items[batch.count++] = *pp;
+                *pp = (*pp)->next;
+                w->pending--;
+            } else {
+                if ((*pp)->due < next) {
+                    next = (*pp)->due;
+                }
+                pp = &(*pp)->next;
+            }
+        }
+    }
+    if (batch.count) {
+        pool_run(workers, batch.count, watch_task, &batch);
+        fflush(stdout);
+        w->analyzed += batch.count;
+        w->elf += batch.elf;
+    }
+    for (size_t i = 0; i < batch.count; i++) {
+        free(batch.items[i]->path);
+        free(batch.items[i]);
+    }
+    free(batch.items);
+    return next == UINT64_MAX? -1: (int)(next > now? next - now: 0);
+}
+
+int watch_run(char **dirs, int count, int workers) {
+    watcher_t *w = calloc(1, sizeof(watcher_t));
+    char buf[64 * 1024] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct sigaction sa;
+
+    if (!w) {
+        return ERR_MEM;
+    }
+    w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (w->fd < 0) {
+        free(w);
+        return ERR_FILE_OPEN;
+    }
+    w->roots = dirs;
+    w->root_count = count;
+    w->synced = time(NULL);
+    for (int i = 0; i < count; i++) {
+        struct stat st;
+        if (stat(dirs[i], &st) < 0 || !S_ISDIR(st.st_mode)) {
+            fprintf(stderr, "%s: not a directory\n", dirs[i]);
+            continue;
+        }
+        /* the initial trees are only watched, not analyzed */
+        watch_tree(w, dirs[i], false, 0);
+    }
+    if (!w->watches) {
+        close(w->fd);
+        free(w);
+        return ERR_FILE_OPEN;
+    }
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    fprintf(stderr, "watching %d directories\n", w->watches);
+
+    int timeout = -1;
+    while (!g_stop) {
+        struct pollfd pfd = {w->fd, POLLIN, 0};
+        int n = poll(&pfd, 1, timeout);
+        if (n < 0 && errno != EINTR) {
+            break;
+        }
+        if (n > 0) {
+            ssize_t len;
+            while ((len = read(w->fd, buf, sizeof(buf))) > 0) {
+                for (char *p = buf; p < buf + len; ) {
+                    struct inotify_event *ev = (struct inotify_event *)p;
+                    handle_event(w, ev);
+                    p += sizeof(struct inotify_event) + ev->len;
+                }
+            }
+        }
+        timeout = dispatch(w, workers);
+    }
+
+    fprintf(stderr, "%s, analyzed: %zu, elf: %zu, pending: %zu\n",
+            g_stop? strsignal(g_stop): "stopped", w->analyzed, w->elf, w->pending);
+    close(w->fd);
+    for (int i = 0; i < w->dir_capacity; i++) {
+        free(w->dirs[i]);
+    }
+    free(w->dirs);
+    for (int i = 0; i < WATCH_BUCKETS; i++) {
+        while (w->buckets[i]) {
+            pending_t *p = w->buckets[i];
+            w->buckets[i] = p->next;
+            free(p->path);
+            free(p);
+        }
+    }
+    free(w);
+    return NO_ERR;
+}
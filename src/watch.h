@@ -0,0 +1,45 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 SecNotes
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef __WATCH_H
+#define __WATCH_H
+
+/* a file is analyzed once it has been quiet for this long */
+#define WATCH_DEBOUNCE_MS   500
+#define WATCH_BUCKETS       4096
+
+/**
+ * @brief 使用inotify监控目录树，新建或修改的ELF文件在写入平静后交给线程池分析，
+ * 每个文件输出一条NDJSON事件，直到收到SIGINT或SIGTERM
+ * watch directory trees with inotify. Created or modified elf files are
+ * analyzed on the worker pool once the writes have settled, one NDJSON
+ * event per file, until SIGINT or SIGTERM
+ * @param dirs directories to watch
+ * @param count number of directories
+ * @param workers worker count, <= 0 means one per CPU
+ * @return error code
+ */
+int watch_run(char **dirs, int count, int workers);
+
+#endif
@@ -0,0 +1,51 @@
+#!/bin/sh
+# parse -B/-R throughput in lines per second, to a file and to a pipe
+# usage: bench_output.sh ELFSPIRIT [BASELINE_ELFSPIRIT] [ELF]
+# without ELF a shared object with 140000 symbols is built, ROUNDS sets the
+# number of runs, the best one is reported
+# 输出吞吐量测试，给出第二个elfspirit时对比两者
+
+. "$(dirname "$0")/common.sh"
+
+BASELINE=$2
+TARGET=$3
+ROUNDS=${ROUNDS:-5}
+if [ -z "$TARGET" ]; then
+    TARGET="$WORK/big.so"
+    make_big_dso "$TARGET" || { echo "cannot build the test object"; exit 1; }
+fi
+
+now() {
+    date +%s%N
+}
+
+# best lines per second of $ROUNDS runs: bench BINARY OPTION SINK
+bench() {
+    lines=$("$1" parse $2 "$TARGET" | wc -l)
+    best=0
+    i=0
+    while [ $i -lt "$ROUNDS" ]; do
+        start=$(now)
+        if [ "$3" = pipe ]; then
+            "$1" parse $2 "$TARGET" | cat > /dev/null
+        else
+            "$1" parse $2 "$TARGET" > /dev/null
+        fi
+        ns=$(( $(now) - start ))
+        [ $ns -gt 0 ] && rate=$(( lines * 1000000000 / ns )) || rate=0
+        [ $rate -gt $best ] && best=$rate
+        i=$((i + 1))
+    done
+    echo "$best"
+}
+
+printf '%s, lines per second, best of %d\n' "$TARGET" "$ROUNDS"
+printf '%-4s %-5s %14s %14s\n' opt sink "${BASELINE:+baseline}" current
+for option in -B -R; do
+    for sink in file pipe; do
+        before=
+        [ -n "$BASELINE" ] && before=$(bench "$BASELINE" $option $sink)
+        after=$(bench "$ELFSPIRIT" $option $sink)
+        printf '%-4s %-5s %14s %14s\n' $option $sink "$before" "$after"
+    done
+done
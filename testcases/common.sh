@@ -0,0 +1,35 @@
+# helpers of the check scripts, sourced with the elfspirit binary as $1
+# check脚本的公共函数
+
+ELFSPIRIT=${1:-../src/elfspirit}
+WORK=$(mktemp -d)
+FAILED=0
+trap 'rm -rf "$WORK"' EXIT
+
+pass() {
+    echo "PASS: $*"
+}
+
+fail() {
+    echo "FAIL: $*"
+    FAILED=1
+}
+
+# compare two output files
+# 比较两个输出文件
+expect_same() {
+    if cmp -s "$2" "$3"; then pass "$1"; else fail "$1"; fi
+}
+
+# a table of 70000 defined and 70000 undefined symbols, above the 64Ki
+# rows at which parse formats in parallel
+# 生成超过64Ki行的符号表与重定位表
+make_big_dso() {
+    awk 'BEGIN {
+        for (i = 0; i < 70000; i++) printf "extern int e%d; int v%d = %d;\n", i, i, i;
+        print "int *tab[] = {";
+        for (i = 0; i < 70000; i++) printf "&e%d,\n", i;
+        print "};";
+    }' > "$WORK/big.c"
+    ${CC:-cc} -shared -fPIC "$WORK/big.c" -o "$1"
+}
@@ -0,0 +1,26 @@
+#!/bin/sh
+# abi exit codes: an unversioned export that gains a default version is
+# compatible, a removed export is not, an unreadable file is an error
+# abi退出码：未版本化符号获得默认版本是兼容的，删除导出符号不兼容，无法读取的文件报错
+
+. "$(dirname "$0")/common.sh"
+
+printf 'int f(void) { return 1; }\nint g(void) { return 2; }\n' > "$WORK/f.c"
+echo 'V1 { global: f; g; local: *; };' > "$WORK/v1.map"
+echo 'V1 { global: f; local: *; };' > "$WORK/v1-g.map"
+${CC:-cc} -shared -fPIC "$WORK/f.c" -o "$WORK/libold.so" &&
+${CC:-cc} -shared -fPIC "$WORK/f.c" -Wl,--version-script="$WORK/v1.map" -o "$WORK/libver.so" &&
+${CC:-cc} -shared -fPIC "$WORK/f.c" -Wl,--version-script="$WORK/v1-g.map" -o "$WORK/libgone.so" ||
+    { fail "build test libraries"; exit 1; }
+
+"$ELFSPIRIT" abi "$WORK/libver.so" "$WORK/libver.so" > /dev/null \
+    && pass "abi of an identical object" || fail "abi of an identical object"
+"$ELFSPIRIT" abi "$WORK/libold.so" "$WORK/libver.so" > "$WORK/report" \
+    && pass "unversioned -> default version" || fail "unversioned -> default version"
+grep -q 'removed$' "$WORK/report" && fail "versioned export reported removed" || pass "versioned export kept"
+"$ELFSPIRIT" abi "$WORK/libold.so" "$WORK/libgone.so" > "$WORK/report" \
+    && fail "removed export exit code" || pass "removed export exit code"
+grep -q '\[-\] g .*removed' "$WORK/report" && pass "removed export" || fail "removed export"
+"$ELFSPIRIT" abi "$WORK/libold.so" "$WORK/nonexistent.so" > /dev/null 2>&1 \
+    && fail "missing file exit code" || pass "missing file exit code"
+exit $FAILED
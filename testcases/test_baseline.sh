@@ -0,0 +1,69 @@
+#!/bin/sh
+# baseline -> tamper -> verify: every modification must be reported
+# 记录基线、篡改文件、校验，每一处修改都必须被发现
+
+. "$(dirname "$0")/common.sh"
+
+mkdir "$WORK/bin"
+echo 'int main(void) { return 0; }' > "$WORK/main.c"
+${CC:-cc} "$WORK/main.c" -o "$WORK/bin/clean" || { fail "build test binary"; exit 1; }
+for f in touched segment text; do
+    cp "$WORK/bin/clean" "$WORK/bin/$f"
+done
+DB="$WORK/test.db"
+
+verify() {
+    "$ELFSPIRIT" verify -f "$DB" --format=ndjson "$WORK/bin" > "$WORK/events" 2> "$WORK/summary"
+}
+
+"$ELFSPIRIT" baseline -f "$DB" "$WORK/bin" > /dev/null
+if verify && grep -q "unchanged: 4," "$WORK/summary"; then
+    pass "verify right after baseline"
+else
+    fail "verify right after baseline"
+fi
+
+sleep 1
+touch "$WORK/bin/touched"
+# PT_NOTE turned into a PT_LOAD with an appended payload
+"$ELFSPIRIT" --add-segment -z 4096 "$WORK/bin/segment" > /dev/null
+# one byte of .text
+offset=$("$ELFSPIRIT" parse -S "$WORK/bin/text" | awk '{ for (i = 1; i < NF; i++) if ($i == ".text") { print $(i + 3); exit } }')
+printf '\314' | dd of="$WORK/bin/text" bs=1 seek=$(printf '%d' "0x$offset") conv=notrunc 2> /dev/null
+
+if verify; then
+    fail "verify exit code after tampering"
+else
+    pass "verify exit code after tampering"
+fi
+grep -q "unchanged: 1, touched: 1, changed: 2," "$WORK/summary" && pass "verify summary" || fail "verify summary"
+grep -q '"path":"[^"]*/touched","event":"touched"' "$WORK/events" && pass "touched file" || fail "touched file"
+grep -q '"path":"[^"]*/segment","event":"segment_modified"' "$WORK/events" && pass "PT_NOTE -> PT_LOAD" || fail "PT_NOTE -> PT_LOAD"
+grep -q '"path":"[^"]*/segment","event":"size"' "$WORK/events" && pass "appended payload" || fail "appended payload"
+grep -q '"path":"[^"]*/text","event":"section_modified","detail":".text, content changed"' "$WORK/events" \
+    && pass "patched .text" || fail "patched .text"
+grep -q '/clean"' "$WORK/events" && fail "untouched file reported" || pass "untouched file"
+
+# a file gone from /bin2 is not missing when /bin is verified
+mkdir "$WORK/bin2"
+cp "$WORK/bin/clean" "$WORK/bin2/gone"
+"$ELFSPIRIT" baseline -f "$DB" "$WORK/bin" "$WORK/bin2" > /dev/null
+rm "$WORK/bin2/gone"
+verify
+grep -q 'missing: 0$' "$WORK/summary" && pass "sibling directory prefix" || fail "sibling directory prefix"
+
+# ET_REL with several .group sections of different sizes, one of them patched
+printf 'template<class T> T f(T a) { return a + 1; }\ninline int g(int x) { static int c; return x + c++; }\nint use() { return f(1) + (int)f(2.0) + f(3L) + g(3); }\n' > "$WORK/group.cc"
+if ${CXX:-c++} -c "$WORK/group.cc" -o "$WORK/bin/group.o" 2> /dev/null; then
+    "$ELFSPIRIT" baseline -f "$DB" "$WORK/bin/group.o" > /dev/null
+    "$ELFSPIRIT" verify -f "$DB" --format=ndjson "$WORK/bin/group.o" > "$WORK/events" 2> /dev/null
+    [ ! -s "$WORK/events" ] && pass "duplicate section names" || fail "duplicate section names"
+    offset=$(readelf -SW "$WORK/bin/group.o" 2> /dev/null | awk '{ for (i = 1; i < NF; i++) if ($i == "GROUP" && $(i + 3) == "00000c") { print $(i + 2); exit } }')
+    if [ -n "$offset" ]; then
+        printf '\001' | dd of="$WORK/bin/group.o" bs=1 seek=$(( 0x$offset + 8 )) conv=notrunc 2> /dev/null
+        "$ELFSPIRIT" verify -f "$DB" --format=ndjson "$WORK/bin/group.o" > "$WORK/events" 2> /dev/null
+        [ "$(grep -c section_modified "$WORK/events")" -eq 1 ] && grep -q '.group, content changed' "$WORK/events" \
+            && pass "patched duplicate section" || fail "patched duplicate section"
+    fi
+fi
+exit $FAILED
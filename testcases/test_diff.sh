@@ -0,0 +1,23 @@
+#!/bin/sh
+# diff exit codes: 0 for identical files, non-zero for a one byte patch and
+# for an unreadable file, the patched byte is located exactly
+# diff退出码：相同文件返回0，单字节修改与无法读取的文件返回非0，并精确定位修改的字节
+
+. "$(dirname "$0")/common.sh"
+
+echo 'int f(void) { return 1; }' > "$WORK/f.c"
+${CC:-cc} -shared -fPIC "$WORK/f.c" -o "$WORK/a.so" || { fail "build test library"; exit 1; }
+cp "$WORK/a.so" "$WORK/same.so"
+cp "$WORK/a.so" "$WORK/patched.so"
+offset=$("$ELFSPIRIT" parse -S "$WORK/a.so" | awk '{ for (i = 1; i < NF; i++) if ($i == ".text") { print $(i + 3); exit } }')
+printf '\314' | dd of="$WORK/patched.so" bs=1 seek=$(( 0x$offset + 2 )) conv=notrunc 2> /dev/null
+
+"$ELFSPIRIT" diff "$WORK/a.so" "$WORK/same.so" > "$WORK/report" \
+    && pass "identical files exit code" || fail "identical files exit code"
+grep -q '0 differences' "$WORK/report" && pass "identical files" || fail "identical files"
+"$ELFSPIRIT" diff "$WORK/a.so" "$WORK/patched.so" > "$WORK/report" \
+    && fail "patched file exit code" || pass "patched file exit code"
+grep -q '\.text .*1 bytes, 1 ranges: 0x2-0x3' "$WORK/report" && pass "patched byte located" || fail "patched byte located"
+"$ELFSPIRIT" diff "$WORK/a.so" "$WORK/nonexistent.so" > /dev/null 2>&1 \
+    && fail "missing file exit code" || pass "missing file exit code"
+exit $FAILED
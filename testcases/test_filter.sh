@@ -0,0 +1,20 @@
+#!/bin/sh
+# an exact --name walks one .gnu.hash chain, --regex scans the table: the
+# selected rows must be the same
+# 精确的--name通过.gnu.hash查找，--regex遍历整个表，二者选中的行必须一致
+
+. "$(dirname "$0")/common.sh"
+
+make_big_dso "$WORK/libbig.so" || { fail "build libbig.so"; exit 1; }
+# hashed definitions, undefined symbols below symndx, and absent names
+for name in v0 v12345 v69999 e0 e777 nosuch v123456; do
+    "$ELFSPIRIT" parse -D --name="$name" "$WORK/libbig.so" > "$WORK/name"
+    "$ELFSPIRIT" parse -D --regex="^$name\$" "$WORK/libbig.so" > "$WORK/regex"
+    expect_same "--name=$name == --regex=^$name\$" "$WORK/name" "$WORK/regex"
+done
+rows=$("$ELFSPIRIT" parse -D --name=v12345 "$WORK/libbig.so" | grep -c ' v12345 *$')
+[ "$rows" = 1 ] && pass "--name=v12345 selects one row" || fail "--name=v12345 selects one row"
+"$ELFSPIRIT" parse -D --name='v1234?' "$WORK/libbig.so" > "$WORK/name"
+"$ELFSPIRIT" parse -D --regex='^v1234.$' "$WORK/libbig.so" > "$WORK/regex"
+expect_same "--name=v1234? == --regex=^v1234.\$" "$WORK/name" "$WORK/regex"
+exit $FAILED
@@ -0,0 +1,66 @@
+#!/bin/sh
+# golden output of the (e_machine, type) name tables: the relocation types of
+# a small shared object are rewritten for each machine and decoded by parse -R
+# 重定位类型与机器名称表的标准输出：改写各架构的e_machine与重定位类型后解码
+
+. "$(dirname "$0")/common.sh"
+
+printf '.data\n.globl s\ns:\n.quad s\n.quad s\n.quad s\n' > "$WORK/r64.s"
+printf '.data\n.globl s\ns:\n.long s\n.long s\n.long s\n' > "$WORK/r32.s"
+${CC:-cc} -shared -nostdlib "$WORK/r64.s" -o "$WORK/r64.so" || { fail "build test object"; exit 1; }
+# without a 32-bit toolchain only the ELF64 machines are checked
+${CC:-cc} -m32 -shared -nostdlib "$WORK/r32.s" -o "$WORK/r32.so" 2> /dev/null || rm -f "$WORK/r32.so"
+
+# write the little endian value $3 of $4 bytes at offset $2 of file $1
+poke() {
+    bytes=$(printf '\\%03o\\%03o\\%03o\\%03o' $(($3 & 255)) $(($3 >> 8 & 255)) $(($3 >> 16 & 255)) $(($3 >> 24 & 255)))
+    printf "$bytes" | head -c "$4" | dd of="$1" bs=1 seek="$2" conv=notrunc 2> /dev/null
+}
+
+# decode OBJECT MACHINE TYPE...: e_machine and the type of each dynamic relocation
+decode() {
+    obj=$WORK/$1.so
+    cp "$obj" "$WORK/p.so"
+    poke "$WORK/p.so" 18 "$2" 2
+    offset=$("$ELFSPIRIT" parse -S "$WORK/p.so" | awk '{ for (i = 1; i < NF; i++) if ($i ~ /^\.rela?\.dyn$/) { print $(i + 3); exit } }')
+    shift 2
+    i=0
+    for type in "$@"; do
+        case $obj in
+            *r64.so) poke "$WORK/p.so" $((0x$offset + i * 24 + 8)) "$type" 4 ;;
+            *) poke "$WORK/p.so" $((0x$offset + i * 8 + 4)) "$type" 1 ;;
+        esac
+        i=$((i + 1))
+    done
+    machine=$("$ELFSPIRIT" parse -H "$WORK/p.so" | sed -n 's/.*e_machine: *0x[0-9a-f]* (\(.*\))$/\1/p')
+    echo "$machine:" $("$ELFSPIRIT" parse -R "$WORK/p.so" | grep -o 'R_[A-Z0-9_]*')
+}
+
+{
+    decode r64 62 8 37 42
+    decode r64 183 257 1026 1027
+    decode r64 243 2 3 5
+    decode r64 21 38 21 22
+    decode r64 258 2 3 5
+    if [ -f "$WORK/r32.so" ]; then
+        decode r32 3 8 7 42
+        decode r32 40 2 22 23
+        decode r32 8 2 3 5
+        decode r32 20 1 21 22
+    fi
+} > "$WORK/names"
+
+cat > "$WORK/golden" <<'GOLDEN'
+AMD x86-64: R_X86_64_RELATIVE R_X86_64_IRELATIVE R_X86_64_REX_GOTPCRELX
+ARM AARCH64: R_AARCH64_ABS64 R_AARCH64_JUMP_SLOT R_AARCH64_RELATIVE
+RISC-V: R_RISCV_64 R_RISCV_RELATIVE R_RISCV_JUMP_SLOT
+PowerPC 64-bit: R_PPC64_ADDR64 R_PPC64_JMP_SLOT R_PPC64_RELATIVE
+LoongArch: R_LARCH_64 R_LARCH_RELATIVE R_LARCH_JUMP_SLOT
+Intel 80386: R_386_RELATIVE R_386_JMP_SLOT R_386_IRELATIVE
+ARM: R_ARM_ABS32 R_ARM_JUMP_SLOT R_ARM_RELATIVE
+MIPS RS3000 (big-endian only): R_MIPS_32 R_MIPS_REL32 R_MIPS_HI16
+PowerPC: R_PPC_ADDR32 R_PPC_JMP_SLOT R_PPC_RELATIVE
+GOLDEN
+head -n $(wc -l < "$WORK/names") "$WORK/golden" > "$WORK/expected"
+expect_same "machine and relocation names" "$WORK/expected" "$WORK/names"
+exit $FAILED
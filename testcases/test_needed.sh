@@ -0,0 +1,29 @@
+#!/bin/sh
+# needed reports an unused DT_NEEDED entry and exits 0, --prune-needed removes
+# it through the sysroot-aware resolver and the binary still runs
+# needed报告未使用的依赖库并返回0，--prune-needed删除后程序仍可运行
+
+. "$(dirname "$0")/common.sh"
+
+mkdir "$WORK/lib"
+echo 'int g(void) { return 7; }' > "$WORK/g.c"
+echo 'int h(void) { return 1; }' > "$WORK/h.c"
+echo 'int g(void); int main(void) { return g() - 7; }' > "$WORK/main.c"
+${CC:-cc} -shared -fPIC "$WORK/g.c" -o "$WORK/lib/libg.so" &&
+${CC:-cc} -shared -fPIC "$WORK/h.c" -o "$WORK/lib/libh.so" &&
+${CC:-cc} "$WORK/main.c" -L"$WORK/lib" -Wl,--no-as-needed -lg -lh \
+    -Wl,-rpath,"\$ORIGIN/lib" -o "$WORK/main" ||
+    { fail "build test binary"; exit 1; }
+
+"$ELFSPIRIT" needed "$WORK/main" > "$WORK/report"
+[ $? -eq 0 ] && pass "needed exits 0 with unused entries" \
+    || fail "needed exits 0 with unused entries"
+grep -q 'libh.so .* unused' "$WORK/report" \
+    && pass "libh.so reported unused" || fail "libh.so reported unused"
+
+"$ELFSPIRIT" --prune-needed "$WORK/main" > /dev/null
+"$ELFSPIRIT" parse -L "$WORK/main" > "$WORK/dyn"
+! grep -q 'libh.so' "$WORK/dyn" && grep -q 'libg.so' "$WORK/dyn" \
+    && pass "unused DT_NEEDED pruned" || fail "unused DT_NEEDED pruned"
+"$WORK/main" && pass "pruned binary runs" || fail "pruned binary runs"
+exit $FAILED
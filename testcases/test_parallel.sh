@@ -0,0 +1,17 @@
+#!/bin/sh
+# parse -B/-D/-R must print the same bytes with one worker and with many
+# 单线程与多线程格式化大表的输出必须逐字节一致
+
+. "$(dirname "$0")/common.sh"
+
+make_big_dso "$WORK/libbig.so" || { fail "build libbig.so"; exit 1; }
+for opt in -B -D -R; do
+    "$ELFSPIRIT" parse $opt --jobs=1 "$WORK/libbig.so" > "$WORK/serial"
+    "$ELFSPIRIT" parse $opt --jobs=8 "$WORK/libbig.so" > "$WORK/parallel"
+    if [ "$(wc -l < "$WORK/serial")" -le 65536 ]; then
+        fail "parse $opt: table below the parallel threshold"
+        continue
+    fi
+    expect_same "parse $opt serial == parallel" "$WORK/serial" "$WORK/parallel"
+done
+exit $FAILED
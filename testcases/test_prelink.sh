@@ -0,0 +1,30 @@
+#!/bin/sh
+# --prelink bakes the relative relocations of a PIE in at a fixed base, the
+# result is an ET_EXEC without R_*_RELATIVE entries that still runs
+# 预链接后程序变为ET_EXEC，不再包含相对重定位，且仍可运行
+
+. "$(dirname "$0")/common.sh"
+
+cat > "$WORK/main.c" <<'SRC'
+#include <stdio.h>
+static int g = 5;
+static int *p = &g;
+int main(void) { printf("%d\n", *p); return *p - 5; }
+SRC
+${CC:-cc} -fPIE -pie "$WORK/main.c" -o "$WORK/main" || { fail "build test binary"; exit 1; }
+cp "$WORK/main" "$WORK/unaligned"
+
+# the editing options always exit non-zero, the result is in the output
+"$ELFSPIRIT" --prelink -b 0x1234 "$WORK/unaligned" 2>&1 | grep -q 'success' \
+    && fail "unaligned base rejected" || pass "unaligned base rejected"
+cmp -s "$WORK/main" "$WORK/unaligned" && pass "rejected file untouched" || fail "rejected file untouched"
+
+"$ELFSPIRIT" --prelink -b 0x40000000 "$WORK/main" > "$WORK/report" 2>&1
+grep -q 'relative relocations applied' "$WORK/report" && grep -q 'success' "$WORK/report" \
+    && pass "prelink" || fail "prelink"
+"$ELFSPIRIT" parse -H "$WORK/main" | grep -q 'e_type: .*0x2 ' \
+    && pass "ET_DYN -> ET_EXEC" || fail "ET_DYN -> ET_EXEC"
+"$ELFSPIRIT" parse -R "$WORK/main" | grep -q '_RELATIVE' \
+    && fail "relative relocations dropped" || pass "relative relocations dropped"
+[ "$("$WORK/main")" = 5 ] && pass "prelinked binary runs" || fail "prelinked binary runs"
+exit $FAILED
@@ -0,0 +1,23 @@
+#!/bin/sh
+# --shrink-rpath keeps the directories that provide a DT_NEEDED library, the
+# binary still runs and the forensic rules do not flag the rewritten .dynstr
+# 收缩rpath后程序仍可运行，且.dynstr不会被规则判定为篡改
+
+. "$(dirname "$0")/common.sh"
+
+mkdir "$WORK/lib1" "$WORK/lib2" "$WORK/empty"
+echo 'int g(void) { return 7; }' > "$WORK/g.c"
+echo 'int g(void); int main(void) { return g() - 7; }' > "$WORK/main.c"
+${CC:-cc} -shared -fPIC "$WORK/g.c" -o "$WORK/lib2/libg.so" &&
+${CC:-cc} "$WORK/main.c" -L"$WORK/lib2" -lg -Wl,--disable-new-dtags \
+    -Wl,-rpath,"$WORK/empty:\$ORIGIN/lib1:\$ORIGIN/lib2:/nonexistent" -o "$WORK/main" ||
+    { fail "build test binary"; exit 1; }
+
+# run from another directory, $ORIGIN is the directory of the file
+(cd "$WORK/lib1" && "$ELFSPIRIT" --shrink-rpath ../main > /dev/null)
+"$ELFSPIRIT" parse -L "$WORK/main" | grep -q 'DT_RPATH .*\[\$ORIGIN/lib2\]' \
+    && pass "rpath shrunk to \$ORIGIN/lib2" || fail "rpath shrunk to \$ORIGIN/lib2"
+"$WORK/main" && pass "shrunk binary runs" || fail "shrunk binary runs"
+"$ELFSPIRIT" checksec "$WORK/main" | grep 'symbol injection' | grep -q 'normal' \
+    && pass "dynstr rule on the shrunk file" || fail "dynstr rule on the shrunk file"
+exit $FAILED